@@ -5,6 +5,11 @@
 #include <pico/mutex.h>
 
 #include "AudioProcessor.h"
+#include "CwSkimmer.h"
+#include "NavtexDecoder.h"
+#include "Psk31Decoder.h"
+#include "SignalClassifier.h"
+#include "WefaxDecoder.h"
 
 /**
  * @brief Core1 dedikált audio feldolgozó manager
@@ -26,7 +31,7 @@ class AudioCore1Manager {
         volatile uint16_t samplingFrequency; // Aktuális mintavételezési frekvencia
         volatile uint16_t fftSize;           // Aktuális FFT méret
         volatile float binWidthHz;
-        volatile float currentAutoGain;
+        volatile float currentAutoGain; // Az FFT bemenetére alkalmazott erősítés (auto vagy kézi)
 
         // Cache a legutóbbi FFT adatokhoz, amit a dekóder használhat (nem fogyasztó)
         float latestSpectrumBuffer[2048]; // Max FFT size
@@ -42,6 +47,7 @@ class AudioCore1Manager {
         // Audio konfiguráció
         float fftGainConfigAm;
         float fftGainConfigFm;
+        AudioSampleDecoder *volatile sampleDecoder; // Az aktív minta-alapú dekóder (nullptr: nincs)
         volatile bool configChanged;
 
         // EEPROM/Pause mutex védelem
@@ -59,6 +65,11 @@ class AudioCore1Manager {
     static bool initialized_;
     static float *currentGainConfigRef_;
     static bool collectOsci_; // Oszcilloszkóp minták gyűjtése
+    static Psk31Decoder *pPsk31Decoder_;
+    static CwSkimmer *pCwSkimmer_;
+    static NavtexDecoder *pNavtexDecoder_;
+    static WefaxDecoder *pWefaxDecoder_;
+    static SignalClassifier *pSignalClassifier_;
 
     // Core1 belső függvények
     static void core1Entry();
@@ -145,6 +156,44 @@ class AudioCore1Manager {
      */
     static bool setSamplingFrequency(uint16_t newSamplingFrequency);
 
+    /**
+     * @brief Minta-alapú dekóder aktiválása a core1-en (core0-ból hívható)
+     * @details Aktív dekóder mellett az ADC folyamatosan, DMA-val mintavételez.
+     * @param decoder A dekóder, vagy nullptr a kikapcsoláshoz
+     * @return true ha sikeres, false egyébként
+     */
+    static bool setSampleDecoder(AudioSampleDecoder *decoder);
+
+    /**
+     * @brief A PSK31 dekóder példány (első híváskor jön létre, utána megmarad)
+     * @return A dekóder pointere, vagy nullptr ha nem sikerült lefoglalni
+     */
+    static Psk31Decoder *getPsk31Decoder();
+
+    /**
+     * @brief A CW skimmer példány (első híváskor jön létre, utána megmarad)
+     * @return A skimmer pointere, vagy nullptr ha nem sikerült lefoglalni
+     */
+    static CwSkimmer *getCwSkimmer();
+
+    /**
+     * @brief A NAVTEX dekóder példány (első híváskor jön létre, utána megmarad az üzenet tárral együtt)
+     * @return A dekóder pointere, vagy nullptr ha nem sikerült lefoglalni
+     */
+    static NavtexDecoder *getNavtexDecoder();
+
+    /**
+     * @brief A WEFAX dekóder példány (első híváskor jön létre, utána megmarad)
+     * @return A dekóder pointere, vagy nullptr ha nem sikerült lefoglalni
+     */
+    static WefaxDecoder *getWefaxDecoder();
+
+    /**
+     * @brief A jeltípus osztályozó példány (az init() hozza létre, a core1 minden FFT keret után futtatja)
+     * @return Az osztályozó pointere, vagy nullptr ha nem sikerült lefoglalni
+     */
+    static SignalClassifier *getSignalClassifier() { return pSignalClassifier_; }
+
     /**
      * @brief Core1 állapot lekérése
      * @return true ha a core1 fut és működik
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "AudioSampleDecoder.h"
+#include "SignalClassifier.h"
 #include "arduinoFFT.h"
 #include "defines.h"
 #include <Arduino.h>
@@ -31,6 +33,11 @@ const uint8_t OSCI_SAMPLE_DECIMATION_FACTOR = 1; // Csökkentve 2-ről 1-re töb
 // Spektrum konstansok
 const float LOW_FREQ_ATTENUATION_THRESHOLD_HZ = 500.0f;
 const float LOW_FREQ_ATTENUATION_FACTOR = 10.0f;
+
+// Folyamatos (ADC FIFO + DMA) mintavételezés a minta-alapú dekóderekhez
+const uint8_t CAPTURE_RING_BITS = 12;                                               // A gyűrűs puffer mérete: 2^12 byte (a DMA ring miatt 2 hatványa és igazított)
+const uint16_t CAPTURE_RING_SAMPLES = (1u << CAPTURE_RING_BITS) / sizeof(uint16_t); // 2048 minta (12kHz-en ~170ms tartalék)
+const uint32_t ADC_CLOCK_HZ = 48000000;                                             // Az ADC órajele (clk_adc)
 } // namespace AudioProcessorConstants
 
 class AudioCore1Manager; // Előre deklaráció
@@ -65,12 +72,32 @@ class AudioProcessor {
     int osciSamples[AudioProcessorConstants::OSCI_SAMPLE_MAX_INTERNAL_WIDTH];
     int osciSampleCount = 0;
 
+    // A legutóbbi FFT keret RMS burkolója részblokkonként (a jeltípus osztályozóhoz)
+    float envelope_[SignalClassifierConstants::ENVELOPE_BLOCKS];
+
+    // Minta-alapú dekóder és a folyamatos mintavételezés állapota
+    AudioSampleDecoder *sampleDecoder_;
+    int dmaChannel_;          // A lefoglalt DMA csatorna (-1: nincs)
+    bool continuousCapture_;  // Fut-e az ADC FIFO + DMA mintavételezés
+    uint16_t captureReadIdx_; // A dekóder olvasási pozíciója a gyűrűs pufferben
+    uint32_t lastFeedMicros_; // Az utolsó dekóder etetés ideje (túlcsordulás detektálás)
+    uint32_t decoderBusyMicros_;
+    uint32_t decoderSampleCount_;
+    uint32_t decoderOverruns_;
+    uint8_t decoderLoadPercent_; // A legutóbbi etetés terhelése (a dekóder terheléskorlátozásához)
+
     // Belső függvények
     bool allocateFftArrays(uint16_t size);
     void deallocateFftArrays();
     bool validateFftSize(uint16_t size) const;
     void calculateBinWidthHz();
 
+    // Folyamatos mintavételezés kezelése
+    bool startContinuousCapture();
+    void stopContinuousCapture();
+    uint16_t getCaptureWriteIndex() const;
+    void feedSampleDecoder(uint16_t writeIdx);
+
   public:
     int getOscilloscopeSampleCount() const { return osciSampleCount; }
     /**
@@ -118,6 +145,12 @@ class AudioProcessor {
      */
     const int *getOscilloscopeData() const { return osciSamples; }
 
+    /**
+     * A legutóbbi FFT keret RMS burkolója
+     * @return SignalClassifierConstants::ENVELOPE_BLOCKS elemű tömb (a keret időtartománya egyenlő részekre bontva)
+     */
+    const float *getEnvelopeData() const { return envelope_; }
+
     /**
      * FFT bin szélesség lekérése Hz-ben
      */
@@ -128,6 +161,26 @@ class AudioProcessor {
      */
     float getCurrentAutoGain() const { return smoothed_auto_gain_factor_; }
 
+    /**
+     * Az FFT bemenetére ténylegesen alkalmazott erősítés: kézi módban a beállított érték, auto módban a simított faktor
+     * (a magnitúdók ennyiszeresei a nyers ADC mintákból számítottnak, a dBFS skála ezzel osztja vissza)
+     */
+    float getAppliedGain() const { return activeFftGainConfigRef > 0.0f ? activeFftGainConfigRef : (activeFftGainConfigRef == 0.0f ? smoothed_auto_gain_factor_ : 1.0f); }
+
+    /**
+     * Az aktív minta-alapú dekóder lekérése
+     * @return A dekóder pointere, vagy nullptr ha nincs aktív dekóder
+     */
+    AudioSampleDecoder *getSampleDecoder() const { return sampleDecoder_; }
+
+    /**
+     * A dekóder CPU terhelési statisztikájának kiolvasása és nullázása
+     * @param outBusyMicros A dekóderben töltött idő az előző lekérdezés óta (us)
+     * @param outSampleCount A feldolgozott minták száma az előző lekérdezés óta
+     * @param outOverruns A gyűrűs puffer túlcsordulások száma az előző lekérdezés óta
+     */
+    void takeDecoderLoadStats(uint32_t &outBusyMicros, uint32_t &outSampleCount, uint32_t &outOverruns);
+
   protected:
     /**
      * Mintavételezési frekvencia beállítása futási időben
@@ -142,6 +195,14 @@ class AudioProcessor {
      */
     bool setFftSize(uint16_t newSize);
 
+    /**
+     * Minta-alapú dekóder beállítása (nullptr: kikapcsolás)
+     * @details Aktív dekóder esetén az ADC folyamatosan, DMA-val mintavételez egy gyűrűs pufferbe,
+     * így az FFT számítás ideje alatt sem vesznek el minták.
+     * @param decoder Az új dekóder, vagy nullptr
+     */
+    void setSampleDecoder(AudioSampleDecoder *decoder);
+
     friend class AudioCore1Manager; // <-- csak ez az osztály férhet hozzá a protected és a private memberekhez
 
     // const float *getRvReal() const { return RvReal; }
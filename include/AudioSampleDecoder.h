@@ -0,0 +1,83 @@
+#pragma once
+
+#include <Arduino.h>
+
+/**
+ * @brief Minta-alapú (időtartománybeli) audio dekóderek közös őse
+ *
+ * A core1-en futó AudioProcessor a folyamatos (DMA) mintavételezés minden egyes mintáját
+ * átadja az aktív dekódernek. A dekódolt karaktereket egy lock-free, egy író (core1) /
+ * egy olvasó (core0) gyűrűs pufferen keresztül adja tovább a UI-nak.
+ */
+class AudioSampleDecoder {
+  public:
+    virtual ~AudioSampleDecoder() = default;
+
+    /**
+     * @brief Dekóder alaphelyzetbe állítása (core1-ről hívva)
+     * @param samplingFrequency Az aktuális mintavételezési frekvencia Hz-ben
+     */
+    virtual void reset(uint16_t samplingFrequency) = 0;
+
+    /**
+     * @brief Egy audio minta feldolgozása (core1-ről hívva)
+     * @param sample DC-mentes ADC minta (-2048...2047)
+     */
+    virtual void processSample(int16_t sample) = 0;
+
+    /**
+     * @brief A dekóder rövid neve (debug kiíráshoz)
+     */
+    virtual const char *getName() const = 0;
+
+    /**
+     * @brief Az aktuális FFT spektrum átadása (core1-ről hívva, minden FFT számítás után)
+     * @details Alapértelmezetten üres, a spektrumban jelet kereső dekóderek (pl. CW skimmer) írják felül
+     * @param magnitudeData FFT magnitúdó tömb
+     * @param fftSize FFT méret
+     * @param binWidthHz Egy bin szélessége Hz-ben
+     * @param loadPercent A mintafeldolgozás CPU terhelése a legutóbbi etetési periódusban (0-100%)
+     */
+    virtual void processSpectrum(const float *magnitudeData, uint16_t fftSize, float binWidthHz, uint8_t loadPercent) {}
+
+    /**
+     * @brief Egy dekódolt karakter kivétele a gyűrűs pufferből (core0-ról hívva)
+     * @param c Kimeneti karakter
+     * @return true ha volt karakter a pufferben
+     */
+    bool popDecodedChar(char &c) {
+        if (textTail_ == textHead_) {
+            return false;
+        }
+        c = textRing_[textTail_];
+        textTail_ = (textTail_ + 1) & TEXT_RING_MASK;
+        return true;
+    }
+
+    /**
+     * @brief A még ki nem olvasott karakterek eldobása (core0-ról hívva)
+     */
+    void flushDecodedText() { textTail_ = textHead_; }
+
+  protected:
+    /**
+     * @brief Dekódolt karakter betétele a gyűrűs pufferbe (core1-ről hívva)
+     * @details Ha a puffer tele van, a karakter elveszik (a UI nem olvasott elég gyorsan)
+     */
+    void pushDecodedChar(char c) {
+        uint8_t next = (textHead_ + 1) & TEXT_RING_MASK;
+        if (next == textTail_) {
+            return;
+        }
+        textRing_[textHead_] = c;
+        textHead_ = next;
+    }
+
+  private:
+    static constexpr uint8_t TEXT_RING_SIZE = 128; // 2 hatványa legyen!
+    static constexpr uint8_t TEXT_RING_MASK = TEXT_RING_SIZE - 1;
+
+    char textRing_[TEXT_RING_SIZE];
+    volatile uint8_t textHead_ = 0; // Csak a core1 írja
+    volatile uint8_t textTail_ = 0; // Csak a core0 írja
+};
@@ -46,6 +46,30 @@ template <typename StationListType, uint8_t MaxStations> class BaseStationStore
         return true;
     }
 
+    /**
+     * @brief Több állomás hozzáadása egyetlen mentéssel (pl. automatikus sávpásztázás eredménye)
+     * @details A duplikátumok és a memória megtelte után következők kimaradnak, a checkSave() csak a végén fut le egyszer
+     * @return A ténylegesen hozzáadott állomások száma
+     */
+    uint8_t addStations(const StationData *newStations, uint8_t count) {
+        uint8_t added = 0;
+        for (uint8_t i = 0; i < count && data.count < MaxStations; ++i) {
+            if (isStationExists(newStations[i])) {
+                continue;
+            }
+            data.stations[data.count] = newStations[i];
+            data.count++;
+            added++;
+        }
+
+        DEBUG("%s %d of %d stations added in batch\n", this->getClassName(), added, count);
+
+        if (added > 0) {
+            this->checkSave();
+        }
+        return added;
+    }
+
     /**
      * @brief Állomás frissítése
      */
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <Arduino.h>
+#include <algorithm>
+#include <vector>
+
+/**
+ * @brief Több FFT bin egy kijelző egységre (képpont, sor, sáv) vonásának módja
+ */
+enum class BinAggregation : uint8_t {
+    Max, // A legerősebb bin: a keskeny csúcsok széles binekben sem vesznek el
+    Mean // A binek átlaga: simább, tüskementes kép
+};
+
+/**
+ * @brief Kijelző egység -> FFT bin tartomány leképező tábla
+ * @details A [minFreqHz, maxFreqHz] tartomány binjei egyenletesen oszlanak el az egységek között: az i. egység első binje
+ *          ceil(i * numBins / slots), így minden bin pontosan egy egységhez tartozik. Ha több bin jut egy egységre, az aggregate()
+ *          az aggregation szerint vonja össze őket, ha kevesebb, a szomszédos egységek ugyanazt a bint mutatják.
+ *          Csak akkor épül újra, ha a paraméterei (FFT méret, bin szélesség, frekvencia tartomány, egységek száma) változnak,
+ *          így a renderelés keretenként csak egész tábla kikeresés. A spektrum komponens, a waterfall és az analizátor közös leképezése.
+ */
+class BinPixelMap {
+  public:
+    BinPixelMap();
+
+    /**
+     * @brief A tábla frissítése (csak ha a paraméterek változtak)
+     * @param slots A kijelző egységek (képpontok, sorok, sávok) száma
+     * @param minFreqHz A tartomány alsó frekvenciája
+     * @param maxFreqHz A tartomány felső frekvenciája (legfeljebb a Nyquist előtti bin)
+     * @param minBinLimit A legkisebb használható bin (DC környéke kimarad)
+     * @param fftSize Az FFT mérete
+     * @param binWidthHz Egy bin szélessége Hz-ben
+     * @param aggregation A több bines egységek összevonási módja
+     */
+    void update(uint16_t slots, float minFreqHz, float maxFreqHz, uint16_t minBinLimit, uint16_t fftSize, float binWidthHz, BinAggregation aggregation);
+
+    /**
+     * @brief Egy kijelző egységhez tartozó binek összevonása (a renderelés belső ciklusa, ezért inline)
+     * @param magnitudeData A magnitúdó spektrum
+     * @param slot A kijelző egység indexe (0..slots-1)
+     * @return A binek maximuma vagy átlaga
+     */
+    float aggregate(const float *magnitudeData, uint16_t slot) const {
+        const uint16_t first = firstBin_[slot];
+        const uint16_t end = std::max<uint16_t>(first + 1, firstBin_[slot + 1]);
+
+        float result = magnitudeData[first];
+        if (aggregation_ == BinAggregation::Max) {
+            for (uint16_t bin = first + 1; bin < end; bin++) {
+                result = std::max(result, magnitudeData[bin]);
+            }
+        } else {
+            for (uint16_t bin = first + 1; bin < end; bin++) {
+                result += magnitudeData[bin];
+            }
+            result /= (end - first);
+        }
+        return result;
+    }
+
+  private:
+    std::vector<uint16_t> firstBin_; // Egységenként az első bin, slots + 1 elem (az utolsó a tartomány vége utáni bin)
+    uint16_t slots_;
+    uint16_t fftSize_;
+    float binWidthHz_;
+    float minFreqHz_;
+    float maxFreqHz_;
+    uint16_t minBinLimit_;
+    BinAggregation aggregation_;
+};
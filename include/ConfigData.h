@@ -13,7 +13,10 @@ enum class AudioComponentType : uint8_t {
     ENVELOPE = 4,          // Burkológörbe
     WATERFALL = 5,         // Waterfall diagram
     CW_WATERFALL = 6,      // CW specifikus waterfall
-    RTTY_WATERFALL = 7     // RTTY specifikus waterfall
+    RTTY_WATERFALL = 7,    // RTTY specifikus waterfall
+    PSK_WATERFALL = 8,     // PSK31 specifikus waterfall (vivő kiválasztás érintéssel)
+    CW_SKIMMER = 9,        // Több csatornás CW skimmer (teljes hangsáv)
+    NAVTEX_WATERFALL = 10  // NAVTEX (SITOR-B) dekóder waterfall
 };
 
 // Konfig struktúra típusdefiníció
@@ -34,6 +37,10 @@ struct Config_t {
     uint8_t currentSquelch;
     bool squelchUsesRSSI; // A squlech RSSI alapú legyen?
 
+    // Seek küszöbök (seek csak FM sávon van)
+    uint8_t seekRssiThresholdFM; // FM seek RSSI küszöb dBuV-ban
+    uint8_t seekSnrThresholdFM;  // FM seek SNR küszöb dB-ben
+
     // FM RDS
     bool rdsEnabled;
 
@@ -65,9 +72,24 @@ struct Config_t {
     // RTTY frekvenciák
     uint16_t rttyMarkFrequencyHz; // RTTY Mark frekvencia Hz-ben
     uint16_t rttyShiftHz;         // RTTY Shift Hz-ben
+    // PSK31 frekvencia
+    uint16_t pskCarrierFrequencyHz; // PSK31 vivő (hangfrekvenciás offset) Hz-ben
+    // NAVTEX frekvencia
+    uint16_t navtexCenterFrequencyHz; // NAVTEX mark/space középfrekvencia Hz-ben
+    // WEFAX ferdeség korrekció
+    int16_t wefaxSlantPpm; // WEFAX sorórajel korrekció ppm-ben (a mintavételi óra hibája)
 
     // Audio processing beállítások
     uint8_t audioModeAM; // Utolsó audio mód AM képernyőn (AudioComponentType)
     uint8_t audioModeFM; // Utolsó audio mód FM képernyőn (AudioComponentType)
+    // Waterfall megjelenítés
+    uint8_t waterfallPalette; // Waterfall színpaletta (WaterfallPaletteType)
+    // Spektrum nyomvonalak (SpectrumHighRes)
+    uint8_t spectrumTraces;         // Megjelenített nyomvonalak bitmaszkja (SpectrumTraceFlags)
+    uint16_t traceAverageMs;        // Az átlag nyomvonal időállandója ms-ben
+    uint8_t tracePeakDecayDbPerSec; // A csúcstartás (és a minimum tartás) lecsengése dB/s-ban
+    // Spektrum amplitúdó skála
+    bool spectrumLogScale;   // true: dBFS skála zajszint követéssel, false: lineáris skála (auto/kézi erősítés)
+    uint8_t spectrumDbRange; // dB skálán a megjelenített tartomány dB-ben
     // float audioFftGain;    // Audio FFT erősítés (0.1 - 10.0)
 };
@@ -20,7 +20,18 @@ class CwDecoder {
     CwDecoder();
     void clear();
     void processFftData(const float *fftData, uint16_t fftSize, float binWidth);
-    String getDecodedText();
+
+    /**
+     * @brief Az előző lekérés óta dekódolt szöveg átvétele (a belső puffer kiürül)
+     * @param out Ide kerül az új szöveg
+     * @return true ha volt új szöveg
+     */
+    bool takeDecodedText(String &out);
+
+    // --- AFC (automatikus hangkeresés és követés) ---
+    void resetAfc();
+    bool isAfcLocked() const { return afcLocked_; }
+    float getLockedFrequencyHz() const { return afcLocked_ ? afcFrequencyHz_ : 0.0f; } // 0: nincs zárás
 
   private:
     // --- Jelfeldolgozás ---
@@ -33,6 +44,15 @@ class CwDecoder {
     bool isToneDetected;
     void detectTone(const float *fftData, uint16_t fftSize, float binWidth);
 
+    // --- AFC állapot ---
+    bool afcLocked_;
+    float afcFrequencyHz_;              // A zárt (követett) hangfrekvencia
+    float afcCandidateHz_;              // Befogás alatt álló jelölt frekvencia
+    uint8_t afcHits_;                   // A jelölt megerősítéseinek száma
+    unsigned long afcCandidateSinceMs_; // Mióta látjuk a jelöltet
+    unsigned long afcLastSeenMs_;       // Mikor láttuk utoljára a zárt hangot
+    void updateAfc(bool peakIsValid);
+
     // --- FIFO mintapuffer ---
     static constexpr int SAMPLE_BUF_SIZE = 128;
     uint8_t sampleBuf[SAMPLE_BUF_SIZE]; // 1: tone, 0: silence
@@ -40,7 +60,7 @@ class CwDecoder {
     int sampleCount;
 
     // --- Dekódolás ---
-    String decodedText;
+    String decodedText; // Még át nem vett dekódolt szöveg (korlátos hosszú)
     String currentSymbol;
     unsigned long lastEdgeMs;
     int toneSamples;
@@ -0,0 +1,127 @@
+#pragma once
+
+#include "AudioSampleDecoder.h"
+
+namespace CwSkimmerConstants {
+constexpr uint8_t MAX_CHANNELS = 6;               // Egyszerre dekódolt CW jelek maximális száma (statikus csatorna pool)
+constexpr uint8_t MAX_CANDIDATES = 12;            // Spektrumonként vizsgált csúcsok maximális száma
+constexpr uint8_t CHANNEL_TEXT_LENGTH = 48;       // Csatornánként megőrzött dekódolt karakterek száma
+constexpr uint16_t MIN_FREQUENCY_HZ = 300;        // A keresett hangfrekvenciás sáv alsó határa
+constexpr uint16_t MAX_FREQUENCY_HZ = 2700;       // ... és felső határa (SSB/CW áteresztősáv)
+constexpr uint8_t BLOCK_MS = 5;                   // Burkológörbe blokk hossza (integráló-ürítő)
+constexpr float MIN_CHANNEL_SPACING_HZ = 100.0f;  // Két csatorna minimális távolsága (a 2 blokkos ablak sávszélessége)
+constexpr float CHANNEL_MATCH_HZ = 40.0f;         // Ennyin belüli csúcs a meglévő csatornához tartozik
+constexpr float DETECT_FACTOR = 4.0f;             // Csúcs / zajszint arány a jel elfogadásához
+constexpr uint8_t CONFIRM_HITS = 3;               // Ennyi észlelés után jelenik meg a csatorna a listában
+constexpr uint32_t IDLE_TIMEOUT_MS = 15000;       // Ennyi idő után szabadul fel a nem látott csatorna
+constexpr uint32_t UNCONFIRMED_TIMEOUT_MS = 2000; // A meg nem erősített (pl. zaj) csatorna ennyi idő után szabadul fel
+constexpr uint8_t LOAD_HIGH_PERCENT = 45;         // E feletti terhelésnél csökkentjük az aktív csatornák számát
+constexpr uint8_t LOAD_LOW_PERCENT = 25;          // E alatti terhelésnél (tartósan) újra engedünk csatornát
+constexpr uint8_t LOAD_RECOVER_SPECTRA = 40;      // Ennyi egymást követő alacsony terhelésű spektrum kell a bővítéshez
+} // namespace CwSkimmerConstants
+
+/**
+ * @brief Több csatornás CW skimmer a core1-en
+ *
+ * A spektrumból (processSpectrum) a keskenysávú vivőket keresi a teljes hangsávban, és
+ * mindegyikhez egy csatornát rendel a statikus (allokációmentes) csatorna poolból.
+ * Csatornánként:
+ * - Fixpontos NCO keverő és integráló-ürítő burkoló (5 ms blokk, 10 ms ablak)
+ * - Adaptív zaj/csúcs követés, hiszterézises billentyű detektálás
+ * - Blokkszámláló alapú időzítés, adaptív pont hossz, morze dekódolás
+ *
+ * Ha a mintafeldolgozás terhelése túl nagy, a leggyengébb csatornákat elengedi, és
+ * csak tartósan alacsony terhelés mellett enged újra több csatornát.
+ */
+class CwSkimmer : public AudioSampleDecoder {
+  public:
+    /**
+     * @brief Egy csatorna állapotának másolata a UI számára
+     */
+    struct ChannelInfo {
+        uint16_t frequencyHz;
+        uint8_t wpm;
+        bool keyDown;
+        char text[CwSkimmerConstants::CHANNEL_TEXT_LENGTH + 1]; // Nullával lezárt, a legrégebbi karakter elöl
+    };
+
+    CwSkimmer();
+
+    // AudioSampleDecoder interface (core1)
+    void reset(uint16_t samplingFrequency) override;
+    void processSample(int16_t sample) override;
+    void processSpectrum(const float *magnitudeData, uint16_t fftSize, float binWidthHz, uint8_t loadPercent) override;
+    const char *getName() const override { return "CW Skimmer"; }
+
+    /**
+     * @brief Egy pool slot állapotának lekérése (core0-ról hívható)
+     * @param slot A slot indexe (0...MAX_CHANNELS-1)
+     * @param info Kimeneti másolat
+     * @return true ha a slot aktív és megerősített csatornát tartalmaz
+     */
+    bool getChannelInfo(uint8_t slot, ChannelInfo &info) const;
+
+    /**
+     * @brief Változásszámláló: minden új karakternél és csatorna változásnál nő (core0 frissítéshez)
+     */
+    uint32_t getChangeCounter() const { return changeCounter_; }
+
+    /**
+     * @brief A terhelés miatt jelenleg engedélyezett csatornák száma
+     */
+    uint8_t getChannelLimit() const { return channelLimit_; }
+
+  private:
+    struct Channel {
+        volatile bool active;
+        volatile bool confirmed;
+        volatile float frequencyHz;
+        uint32_t ncoPhase;
+        uint32_t ncoIncrement;
+        int32_t accI; // Aktuális blokk
+        int32_t accQ;
+        int32_t prevI; // Előző blokk (10 ms-os ablakhoz)
+        int32_t prevQ;
+        float noiseLevel;
+        float peakLevel;
+        volatile bool keyDown;
+        uint16_t runBlocks; // Az aktuális (hang/szünet) állapot hossza blokkokban
+        float dotBlocks;    // Adaptív pont hossz blokkokban
+        uint8_t symbolCode; // Morze kód: vezető 1-es bit után pont=0, vonás=1
+        bool charPending;   // Van lezáratlan karakter
+        bool spacePending;  // A szóköz még nincs kiírva
+        uint8_t hits;
+        uint32_t lastSeenMs;
+        char text[CwSkimmerConstants::CHANNEL_TEXT_LENGTH];
+        volatile uint8_t textHead;
+        volatile uint8_t textCount;
+    };
+
+    // --- NCO ---
+    static constexpr uint16_t NCO_TABLE_SIZE = 256;
+    static int16_t sinTable_[NCO_TABLE_SIZE];
+    static char morseTable_[128];
+    static bool tablesReady_;
+
+    // --- Csatorna pool (allokációmentes) ---
+    Channel channels_[CwSkimmerConstants::MAX_CHANNELS];
+    uint8_t activeSlots_[CwSkimmerConstants::MAX_CHANNELS]; // Az aktív slotok tömör listája a mintánkénti ciklushoz
+    uint8_t activeCount_;
+    volatile uint8_t channelLimit_;
+    uint8_t lowLoadSpectra_;
+
+    uint16_t samplingFrequency_;
+    uint16_t blockSamples_;
+    uint16_t blockCount_;
+    float blockMs_;
+    volatile uint32_t changeCounter_;
+
+    void releaseChannel(uint8_t slot);
+    void rebuildActiveList();
+    void assignChannel(uint8_t slot, float frequencyHz, uint32_t now);
+    void adaptChannelLimit(uint8_t loadPercent);
+    void processBlock(Channel &ch);
+    void finishCharacter(Channel &ch);
+    void pushChannelChar(Channel &ch, char c);
+    static void initTables();
+};
@@ -0,0 +1,173 @@
+#pragma once
+
+#include "AudioSampleDecoder.h"
+
+namespace NavtexConstants {
+constexpr float BAUD_RATE = 100.0f;                // SITOR-B jelsebesség (Bd)
+constexpr float SHIFT_HZ = 170.0f;                 // FSK eltolás (B = magasabb, Y = alacsonyabb hang)
+constexpr uint16_t TARGET_DECIMATED_RATE = 2000;   // Decimálás utáni mintavételi frekvencia (Hz)
+constexpr uint8_t MAX_BIT_SAMPLES = 32;            // Bit hosszú (illesztett) szűrő max. hossza decimált mintában
+constexpr uint16_t NCO_TABLE_SIZE = 256;           // NCO szinusz tábla mérete (2 hatványa!)
+constexpr uint8_t NCO_TABLE_BITS = 8;              // log2(NCO_TABLE_SIZE)
+constexpr int16_t NCO_AMPLITUDE = 4096;            // Q12 fixpontos szinusz amplitúdó
+constexpr uint16_t MIN_CENTER_FREQUENCY_HZ = 400;  // Választható középfrekvencia alsó határa
+constexpr uint16_t MAX_CENTER_FREQUENCY_HZ = 2600; // ... és felső határa
+constexpr uint16_t DEFAULT_CENTER_FREQUENCY_HZ = 1000;
+constexpr uint8_t SYNC_VALID_CHARS = 12;      // Ekkora érvényes (4B/3Y) karakter pontszám kell a karakter szinkronhoz
+constexpr uint8_t SYNC_LOSS_ERRORS = 16;      // Ennyi egymást követő hibás karakter után újraszinkronizálunk
+constexpr uint8_t MESSAGE_STORE_SIZE = 8;     // A tárolt üzenetek száma (gyűrű, a legrégebbi íródik felül)
+constexpr uint16_t MESSAGE_TEXT_LENGTH = 480; // Üzenetenként megőrzött karakterek száma
+} // namespace NavtexConstants
+
+/**
+ * @brief NAVTEX (SITOR-B, FEC) dekóder a core1-en
+ *
+ * Feldolgozási lánc:
+ * - Fixpontos NCO keverő a mark/space középfrekvenciájára, integráló-ürítő decimálás ~2 kHz-re
+ * - Két, egy bit hosszú (illesztett) komplex szűrő a +/-85 Hz-es hangokra, normált energia diszkriminátor
+ * - Bit szinkron a diszkriminátor nullátmeneteire zárt digitális PLL-lel
+ * - CCIR-476 karakter szinkron (4B/3Y súly ellenőrzés), automatikus polaritás felismeréssel
+ * - FEC: a DX és az 5 karakterrel később ismételt RX karakter összevetése (időbeli diverzitás)
+ * - ZCZC B1B2B3B4 ... NNNN üzenet keretezés, korlátos, duplikáció-mentes üzenet tár
+ *
+ * A dekódolt karakterek folyamatosan a közös karakter gyűrűbe kerülnek (élő szöveg),
+ * a teljes üzenetek a tárba. A tárat a core0 szekvencia-számlálóval védve olvassa.
+ */
+class NavtexDecoder : public AudioSampleDecoder {
+  public:
+    /**
+     * @brief Egy tárolt NAVTEX üzenet
+     */
+    struct Message {
+        char station;        // B1: adóállomás azonosító (A-Z)
+        char subject;        // B2: üzenet típus (A-Z, pl. A: navigációs figyelmeztetés, D: SAR)
+        uint8_t serial;      // B3B4: sorszám (00-99, a 00 mindig új üzenetnek számít)
+        uint16_t errorCount; // Javíthatatlan (DX és RX is hibás) karakterek száma
+        uint16_t length;     // A szöveg hossza
+        uint32_t receivedMs; // A vétel (lezárás) ideje
+        char text[NavtexConstants::MESSAGE_TEXT_LENGTH + 1];
+    };
+
+    NavtexDecoder();
+
+    // AudioSampleDecoder interface (core1)
+    void reset(uint16_t samplingFrequency) override;
+    void processSample(int16_t sample) override;
+    const char *getName() const override { return "NAVTEX"; }
+
+    /**
+     * @brief A mark/space középfrekvencia beállítása (core0-ról hívható)
+     * @param frequencyHz A két hang közötti középfrekvencia Hz-ben
+     */
+    void setCenterFrequency(float frequencyHz);
+    float getCenterFrequency() const { return requestedCenterHz_; }
+
+    /**
+     * @brief Van-e karakter szinkron (a dekóder érvényes SITOR-B jelet vesz)
+     */
+    bool isSynchronized() const { return charSynced_; }
+
+    /**
+     * @brief A tárolt üzenetek száma
+     */
+    uint8_t getMessageCount() const { return storeCount_; }
+
+    /**
+     * @brief Egy tárolt üzenet másolatának lekérése (core0-ról hívható)
+     * @param index 0: a legújabb üzenet
+     * @param out Kimeneti másolat
+     * @return true ha sikerült konzisztens másolatot készíteni
+     */
+    bool getMessage(uint8_t index, Message &out) const;
+
+    /**
+     * @brief A tár változásszámlálója (minden mentésnél nő, a UI frissítéshez)
+     */
+    uint32_t getStoreSequence() const { return storeSequence_ >> 1; }
+
+    /**
+     * @brief A tárolt üzenetek törlése (core0-ról kérhető, a core1 hajtja végre)
+     */
+    void clearMessages() { clearRequested_ = true; }
+
+  private:
+    enum class MessageState : uint8_t { Idle, Header, Body };
+
+    // --- NCO ---
+    static int16_t sinTable_[NavtexConstants::NCO_TABLE_SIZE];
+    static bool sinTableReady_;
+    uint32_t ncoPhase_;
+    uint32_t ncoIncrement_;
+    uint16_t samplingFrequency_;
+
+    // --- Decimálás ---
+    int32_t accI_;
+    int32_t accQ_;
+    uint16_t decimationFactor_;
+    uint16_t decimationCount_;
+    float decimationScale_;
+
+    // --- Mark/space szűrők (bit hosszú mozgó összeg) ---
+    float toneRotI_; // e^(j*2*pi*85/fs) forgató
+    float toneRotQ_;
+    float tonePhaseI_;
+    float tonePhaseQ_;
+    float markBufI_[NavtexConstants::MAX_BIT_SAMPLES];
+    float markBufQ_[NavtexConstants::MAX_BIT_SAMPLES];
+    float spaceBufI_[NavtexConstants::MAX_BIT_SAMPLES];
+    float spaceBufQ_[NavtexConstants::MAX_BIT_SAMPLES];
+    float markSumI_;
+    float markSumQ_;
+    float spaceSumI_;
+    float spaceSumQ_;
+    uint8_t filterLength_;
+    uint8_t filterPos_;
+
+    // --- Bit szinkron ---
+    float samplesPerBit_;
+    float bitClock_;
+    float prevDecision_;
+
+    // --- Karakter szinkron és FEC ---
+    uint8_t bitShift_;
+    uint8_t bitCount_;       // Szinkron nélkül: bitszámláló a fázis kereséshez, szinkronban: bit a karakteren belül
+    uint8_t validRun_[7];    // Fázisonkénti érvényes karakter pontszám
+    uint8_t invertedRun_[7]; // ... fordított polaritással (3B/4Y)
+    volatile bool charSynced_;
+    bool inverted_;
+    uint8_t errorRun_;
+    uint8_t slotCodes_[8]; // Az utolsó 8 karakter időrés kódja (a DX az RX előtt 5 réssel jön)
+    uint8_t slotIndex_;
+    int8_t rxParityVote_; // >0: a páratlan, <0: a páros rések az RX (ismétlő) rések
+    bool figureShift_;
+
+    // --- Üzenet keretezés (csak core1) ---
+    MessageState messageState_;
+    char lastChars_[4]; // Az utolsó 4 kiadott karakter (ZCZC / NNNN felismeréshez)
+    char header_[4];
+    uint8_t headerLength_;
+    Message current_;
+
+    // --- Üzenet tár (core1 írja, core0 olvassa) ---
+    Message store_[NavtexConstants::MESSAGE_STORE_SIZE];
+    volatile uint8_t storeHead_; // A következő írandó slot
+    volatile uint8_t storeCount_;
+    volatile uint32_t storeSequence_; // Páratlan: írás folyamatban
+    volatile bool clearRequested_;
+
+    // --- Core0 <-> Core1 ---
+    volatile float requestedCenterHz_;
+    volatile bool centerChanged_;
+
+    void updateNcoIncrement();
+    void resetSync();
+    void processDecimated(float i, float q);
+    void processBit(uint8_t bit);
+    void processSlot(uint8_t code);
+    void decodeCharacter(uint8_t code);
+    void emitChar(char c);
+    void startMessage();
+    void finishMessage();
+    void storeMessage(const Message &msg);
+    static bool isValidCode(uint8_t code);
+};
@@ -0,0 +1,115 @@
+#pragma once
+
+#include "AudioSampleDecoder.h"
+
+namespace Psk31Constants {
+constexpr float SYMBOL_RATE = 31.25f;              // BPSK31 szimbólumsebesség (Bd)
+constexpr uint16_t TARGET_DECIMATED_RATE = 500;    // Decimálás utáni mintavételi frekvencia (Hz)
+constexpr uint8_t MAX_MATCHED_FILTER_TAPS = 48;    // Illesztett szűrő max. hossza (2 szimbólum @ ~19 minta/szimbólum)
+constexpr uint16_t NCO_TABLE_SIZE = 256;           // NCO szinusz tábla mérete (2 hatványa!)
+constexpr uint8_t NCO_TABLE_BITS = 8;              // log2(NCO_TABLE_SIZE)
+constexpr int16_t NCO_AMPLITUDE = 4096;            // Q12 fixpontos szinusz amplitúdó
+constexpr uint16_t MIN_CARRIER_FREQUENCY_HZ = 200; // Választható vivő alsó határa
+constexpr uint16_t MAX_CARRIER_FREQUENCY_HZ = 3000;
+constexpr uint16_t DEFAULT_CARRIER_FREQUENCY_HZ = 1000;
+constexpr float AFC_RANGE_HZ = 50.0f;    // Az AFC ennyivel húzhatja el a vivőt a kiválasztotthoz képest
+constexpr float SQUELCH_THRESHOLD = 0.3f; // Jelminőség küszöb (0..1), ez alatt nem adunk ki karaktert
+} // namespace Psk31Constants
+
+/**
+ * @brief BPSK31 dekóder a core1-en
+ *
+ * Feldolgozási lánc:
+ * - Fixpontos NCO keverő a kiválasztott hangfrekvenciás vivőre (teljes mintavételi frekvencián)
+ * - Integráló-ürítő decimálás ~500 Hz-re
+ * - Illesztett (Hann, 2 szimbólum hosszú) FIR szűrő
+ * - Costas hurok (fázis + frekvencia) és négyzetre emelős AFC (FLL) a vivő követésére
+ * - Gardner szimbólum szinkron
+ * - Differenciális döntés és varicode dekódolás
+ */
+class Psk31Decoder : public AudioSampleDecoder {
+  public:
+    Psk31Decoder();
+
+    // AudioSampleDecoder interface (core1)
+    void reset(uint16_t samplingFrequency) override;
+    void processSample(int16_t sample) override;
+    const char *getName() const override { return "PSK31"; }
+
+    /**
+     * @brief A vivő (hangfrekvenciás offset) beállítása (core0-ról hívható)
+     * @param frequencyHz A vivő frekvenciája Hz-ben
+     */
+    void setCarrierFrequency(float frequencyHz);
+
+    /**
+     * @brief A kiválasztott vivő frekvenciája Hz-ben
+     */
+    float getCarrierFrequency() const { return requestedCarrierHz_; }
+
+    /**
+     * @brief Az AFC által követett tényleges vivő frekvencia Hz-ben
+     */
+    float getTrackedFrequency() const { return trackedFrequencyHz_; }
+
+    /**
+     * @brief Jelminőség 0-100% (a szimbólumok fázishibájából számolva)
+     */
+    uint8_t getSignalQuality() const { return signalQualityPercent_; }
+
+  private:
+    // --- NCO ---
+    static int16_t sinTable_[Psk31Constants::NCO_TABLE_SIZE];
+    static bool sinTableReady_;
+    uint32_t ncoPhase_;
+    uint32_t ncoIncrement_;
+    uint16_t samplingFrequency_;
+
+    // --- Decimálás ---
+    int32_t accI_;
+    int32_t accQ_;
+    uint16_t decimationFactor_;
+    uint16_t decimationCount_;
+    float decimationScale_;
+    float decimatedRate_;
+
+    // --- Illesztett szűrő ---
+    float mfTaps_[Psk31Constants::MAX_MATCHED_FILTER_TAPS];
+    float mfBufI_[Psk31Constants::MAX_MATCHED_FILTER_TAPS];
+    float mfBufQ_[Psk31Constants::MAX_MATCHED_FILTER_TAPS];
+    uint8_t mfLength_;
+    uint8_t mfPos_;
+
+    // --- Costas / AFC ---
+    float afcHz_;
+    float prevI_;
+    float prevQ_;
+    float inputPower_;    // Szűretlen (decimált) teljesítmény
+    float filteredPower_; // Illesztett szűrő kimeneti teljesítménye
+    float snrGate_;       // 0..1, az AFC/Costas erősítés súlyozása a jel/zaj alapján
+
+    // --- Szimbólum szinkron ---
+    float samplesPerSymbol_;
+    float symbolClock_;
+    bool midSampleTaken_;
+    float midI_;
+    float midQ_;
+    float prevSymI_;
+    float prevSymQ_;
+
+    // --- Döntés és varicode ---
+    uint16_t varicodeShiftReg_;
+    float quality_;
+
+    // --- Core0 <-> Core1 ---
+    volatile float requestedCarrierHz_;
+    volatile bool carrierChanged_;
+    volatile float trackedFrequencyHz_;
+    volatile uint8_t signalQualityPercent_;
+
+    void updateNcoIncrement();
+    void processDecimated(float i, float q);
+    void processSymbol(float i, float q);
+    void decodeBit(uint8_t bit);
+    static char varicodeToAscii(uint16_t code);
+};
@@ -0,0 +1,96 @@
+/**
+ * @file ScanHistory.h
+ * @brief A sáv aktivitása időben: az utolsó sweep-ek RSSI értékei rögzített méretű körpufferben, frekvenciánkénti statisztikával
+ */
+#pragma once
+
+#include <Arduino.h>
+
+namespace ScanHistoryConstants {
+constexpr uint16_t COLUMNS = 230;       // Frekvencia oszlopok a rögzítéskori nézetre (a 460 pixeles spektrumon 2 pixel oszloponként)
+constexpr uint8_t ROWS = 45;            // Tárolt sorok: 45 x 230 bájt, a spektrum 180 pixelén 4 pixel soronként
+constexpr uint8_t NO_DATA = 0xFF;       // Az oszlop abban a sweepben nem volt mérve (az RSSI legfeljebb 127 dBuV)
+constexpr uint8_t ACTIVE_MARGIN_DB = 6; // Aktív az oszlop, ha legalább ennyivel a sweep mediánja felett van
+} // namespace ScanHistoryConstants
+
+/**
+ * @brief Egy frekvencia oszlop statisztikája az összes rögzített sweep-re
+ */
+struct ScanHistoryStats {
+    uint8_t rssiMax;       // Legnagyobb RSSI (dBuV)
+    uint8_t rssiMean;      // Átlagos RSSI (dBuV)
+    uint8_t activePercent; // A sweep-ek hány százalékában volt aktív
+    uint16_t sweeps;       // Az oszlopot mérő sweep-ek száma (0: nincs adat)
+};
+
+/**
+ * @brief Sweep történet (idő x frekvencia hőtérkép adatai)
+ *
+ * - Soronként egy sweep oszloponkénti legnagyobb RSSI értéke (uint8, dBuV), körpufferben
+ * - Ha a puffer megtelt, két szomszédos régebbi sor összevonódik (oszloponként a maximum), így a memória
+ *   rögzített, a régi időszak egyre durvább felbontással, de megmarad
+ * - A statisztika oszloponként külön gyűlik minden sweep-ből, ezért az összevonás nem torzítja
+ * - Az oszlopok a rögzítéskori nézet frekvencia tartományát fedik (zoomolva is 2 pixel oszloponként);
+ *   más nézetben a következő sweep előbb törli a történetet, mert a régi oszlopok más frekvenciákhoz tartoznak
+ */
+class ScanHistory {
+  public:
+    ScanHistory();
+
+    /**
+     * @brief A történet és a statisztika törlése, az oszlopok frekvencia tartományának beállítása
+     * @param startFreq A lefedett tartomány kezdete
+     * @param endFreq A lefedett tartomány vége
+     */
+    void reset(uint32_t startFreq, uint32_t endFreq);
+
+    /**
+     * @brief Az oszlopok által lefedett frekvencia tartomány
+     */
+    uint32_t getStartFreq() const { return startFreq_; }
+    uint32_t getEndFreq() const { return endFreq_; }
+
+    /**
+     * @brief Egy sweep hozzáadása
+     * @param columns COLUMNS darab RSSI érték (NO_DATA: az oszlop nem volt mérve)
+     */
+    void addSweep(const uint8_t *columns);
+
+    /**
+     * @brief A tárolt sorok száma
+     */
+    uint8_t getRowCount() const { return count_; }
+
+    /**
+     * @brief Egy sor oszlopai
+     * @param age 0: a legújabb sor
+     */
+    const uint8_t *getRow(uint8_t age) const { return rows_[rowIndex(age)]; }
+
+    /**
+     * @brief Hány sweep van egy sorba összevonva
+     * @param age 0: a legújabb sor
+     */
+    uint16_t getRowSweeps(uint8_t age) const { return rowSweeps_[rowIndex(age)]; }
+
+    /**
+     * @brief Egy frekvencia oszlop statisztikája
+     */
+    ScanHistoryStats getStats(uint16_t column) const;
+
+  private:
+    uint8_t rows_[ScanHistoryConstants::ROWS][ScanHistoryConstants::COLUMNS]; // Körpuffer, a head_ a legújabb sor
+    uint16_t rowSweeps_[ScanHistoryConstants::ROWS];                           // Soronként az összevont sweep-ek száma
+    uint32_t startFreq_;                                                       // Az oszlopok tartományának kezdete
+    uint32_t endFreq_;                                                         // ... és vége
+    uint8_t head_;                                                             // A legújabb sor indexe
+    uint8_t count_;                                                            // A tárolt sorok száma
+    uint8_t statMax_[ScanHistoryConstants::COLUMNS];                           // Oszloponként a legnagyobb RSSI
+    uint32_t statSum_[ScanHistoryConstants::COLUMNS];                          // Oszloponként az RSSI összeg (átlaghoz)
+    uint16_t statSweeps_[ScanHistoryConstants::COLUMNS];                       // Oszloponként a mérő sweep-ek száma
+    uint16_t statActive_[ScanHistoryConstants::COLUMNS];                       // Oszloponként az aktív sweep-ek száma
+
+    uint8_t rowIndex(uint8_t age) const { return (head_ + ScanHistoryConstants::ROWS - age) % ScanHistoryConstants::ROWS; }
+    void decimate();
+    void updateStats(const uint8_t *columns);
+};
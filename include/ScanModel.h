@@ -0,0 +1,152 @@
+/**
+ * @file ScanModel.h
+ * @brief A pásztázás eredményeinek tárolója, amely túléli a képernyőváltást
+ */
+#pragma once
+
+#include "ScanHistory.h"
+#include "ScanPyramid.h"
+#include <Arduino.h>
+#include <bitset>
+
+namespace ScanModelConstants {
+constexpr uint16_t POINTS = 920;                   // A nézet adatpontjai (a 460 pixeles spektrumon 2 pont pixelenként)
+constexpr uint16_t STATE_BYTES = (POINTS + 3) / 4; // Az adat eredete pontonként 2 bit
+constexpr uint16_t CLASS_BYTES = (POINTS + 1) / 2; // A jeltípus pontonként 4 bit
+constexpr uint32_t RELEASE_FREE_HEAP = 64 * 1024;  // Képernyőváltáskor ennyi szabad heap alatt a piramis és a történet felszabadul
+} // namespace ScanModelConstants
+
+/**
+ * @brief A legutóbbi nézet, amelyhez a tárolt pontok tartoznak
+ */
+struct ScanModelView {
+    uint8_t bandIndex;   // A sáv indexe (más sávon a tárolt adat érvénytelen)
+    uint32_t startFreq;  // A nézet kezdete
+    uint32_t endFreq;    // A nézet vége
+    float zoomLevel;     // Zoom szint (1.0 = teljes sáv)
+    uint32_t cursorFreq; // A kurzor frekvenciája
+    uint16_t cursorPos;  // A kurzor pozíciója a nézetben
+    bool hasData;        // Van mért adat a nézetben
+};
+
+/**
+ * @brief A pásztázás eredményei eszköz egységekben, tömörítve
+ *
+ * - A nézet pontjai oszlopokban (structure of arrays): RSSI (dBuV) és SNR (dB) uint8 értékként,
+ *   a Y koordinátává alakítás csak rajzoláskor történik
+ * - Az állomás jelzés és a finomítandó pontok bitkészletben, az adat eredete 2, a jeltípus 4 biten
+ * - Itt van a teljes sáv piramisa és a sweep történet is, így a képernyő elhagyása és újbóli megnyitása
+ *   után a mérések megmaradnak, és más képernyők is olvashatják őket
+ *
+ * Az első get() hívásig nem foglal memóriát. A piramis és a történet (~37 kB) a reset()-kor foglalódik,
+ * és a release() szabadítja fel (sávváltás után, vagy ha kevés a szabad heap), a pontonkénti tömbök megmaradnak.
+ * A frekvenciák a ScreenScan egységében értendők (a BandTable frekvenciák tízszerese).
+ */
+class ScanModel {
+  public:
+    /**
+     * @brief A közös példány (az első hívásnál jön létre)
+     */
+    static ScanModel &get();
+
+    /**
+     * @brief A piramis és a sweep történet felszabadítása, ha a tárolt adat már nem kell
+     * @details Képernyőváltáskor hívandó, amikor a ScreenScan már nem él: más sávra váltás után az adat
+     *          úgyis érvénytelen, kevés szabad heap esetén pedig a többi képernyő sprite-jainak kell a hely.
+     * @param currentBandIndex Az aktuális sáv indexe
+     */
+    static void releaseIfUnused(uint8_t currentBandIndex);
+
+    /**
+     * @brief A piramis és a sweep történet felszabadítása, a tárolt adat érvénytelenné válik
+     * @details A következő reset() újra lefoglalja őket
+     */
+    void release();
+
+    /**
+     * @brief Az összes adat törlése és a lefedett sáv beállítása (a piramis és a történet szükség esetén lefoglalódik)
+     * @param bandIndex A sáv indexe
+     * @param bandStartFreq A sáv kezdete
+     * @param bandEndFreq A sáv vége
+     */
+    void reset(uint8_t bandIndex, uint32_t bandStartFreq, uint32_t bandEndFreq);
+
+    /**
+     * @brief Egy pont törlése (nincs adat, nincs jelzés)
+     */
+    void clearPoint(uint16_t pos);
+
+    /**
+     * @brief Egy pont mérési adatainak beírása
+     */
+    void setPoint(uint16_t pos, uint8_t rssi, uint8_t snr, ScanPointState state) {
+        rssi_[pos] = rssi;
+        snr_[pos] = snr;
+        setState(pos, state);
+    }
+
+    uint8_t getRssi(uint16_t pos) const { return rssi_[pos]; }
+    uint8_t getSnr(uint16_t pos) const { return snr_[pos]; }
+
+    /**
+     * @brief Egy pont adatának eredete
+     */
+    ScanPointState getState(uint16_t pos) const { return static_cast<ScanPointState>((state_[pos >> 2] >> ((pos & 3) * 2)) & 0x03); }
+    void setState(uint16_t pos, ScanPointState state);
+
+    /**
+     * @brief Állomás jelzés
+     */
+    bool isMarked(uint16_t pos) const { return mark_[pos]; }
+    void setMarked(uint16_t pos, bool marked) { mark_[pos] = marked; }
+
+    /**
+     * @brief A finomító (Refine) és kitöltő (Fill) menetben mérendő pontok
+     */
+    bool isRefine(uint16_t pos) const { return refine_[pos]; }
+    void setRefine(uint16_t pos, bool refine) { refine_[pos] = refine; }
+    void clearRefine() { refine_.reset(); }
+
+    /**
+     * @brief Jeltípus (SignalClass) a megállás utáni osztályozásból
+     */
+    uint8_t getSignalClass(uint16_t pos) const { return (signalClass_[pos >> 1] >> ((pos & 1) * 4)) & 0x0F; }
+    void setSignalClass(uint16_t pos, uint8_t signalClass);
+
+    /**
+     * @brief A teljes sáv mérései (zoom és eltolás után a nézet ebből töltődik), csak reset() után érvényes
+     */
+    ScanPyramid &getPyramid() { return *pPyramid_; }
+
+    /**
+     * @brief A teljes sweep-ek története (hőtérkép és frekvenciánkénti statisztika), csak reset() után érvényes
+     */
+    ScanHistory &getHistory() { return *pHistory_; }
+
+    /**
+     * @brief A legutóbbi nézet (a képernyő elhagyásakor mentve)
+     */
+    const ScanModelView &getView() const { return view_; }
+    void setView(const ScanModelView &view) { view_ = view; }
+
+    /**
+     * @brief Tartozik-e a tárolt adat a megadott sávhoz
+     */
+    bool isValidFor(uint8_t bandIndex) const { return valid_ && view_.bandIndex == bandIndex; }
+
+  private:
+    ScanModel();
+
+    static ScanModel *pInstance_;
+
+    uint8_t rssi_[ScanModelConstants::POINTS];             // RSSI (dBuV)
+    uint8_t snr_[ScanModelConstants::POINTS];              // SNR (dB)
+    uint8_t state_[ScanModelConstants::STATE_BYTES];       // Adat eredete (ScanPointState), 4 pont bájtonként
+    uint8_t signalClass_[ScanModelConstants::CLASS_BYTES]; // Jeltípus (SignalClass), 2 pont bájtonként
+    std::bitset<ScanModelConstants::POINTS> mark_;         // Állomás jelzők
+    std::bitset<ScanModelConstants::POINTS> refine_;       // A finomító és kitöltő menetben mérendő pontok
+    ScanPyramid *pPyramid_;                                // A teljes sáv mérései (release() után nullptr)
+    ScanHistory *pHistory_;                                // A teljes sweep-ek története (release() után nullptr)
+    ScanModelView view_;                                   // A legutóbbi nézet
+    bool valid_;                                           // Volt már reset(), a view_ sávja érvényes
+};
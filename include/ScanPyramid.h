@@ -0,0 +1,90 @@
+/**
+ * @file ScanPyramid.h
+ * @brief A pásztázás mérési eredményei a teljes sávra, több felbontásban (min/max/átlag piramis)
+ */
+#pragma once
+
+#include <Arduino.h>
+
+/**
+ * @brief Egy scan pont adatának eredete
+ */
+enum class ScanPointState : uint8_t {
+    None,         ///< Nincs adat
+    Interpolated, ///< A szomszédos durva pontokból interpolálva (nem mért)
+    Coarse,       ///< Durva menetben, egyetlen méréssel
+    Measured      ///< Teljes felbontással, átlagolt méréssel
+};
+
+namespace ScanPyramidConstants {
+constexpr uint16_t BASE_CELLS = 2048;                                         // Az alap szint cellái a teljes sávra (FM: 10 kHz, MW: < 1 kHz cellánként)
+constexpr uint8_t LEVELS = 3;                                                 // Szintek: 2048, 1024, 512 cella (az 1.0x nézet egy pontja ~2 alap cella)
+constexpr uint16_t TOTAL_CELLS = 2 * BASE_CELLS - (2 * BASE_CELLS >> LEVELS); // Az összes szint cellái egy tömbben
+} // namespace ScanPyramidConstants
+
+/**
+ * @brief Egy piramis cella: a lefedett mért alap cellák összesítése
+ */
+struct ScanCell {
+    uint8_t rssiMin;      // Legkisebb RSSI (dBuV)
+    uint8_t rssiMax;      // Legnagyobb RSSI (dBuV) - a kicsinyített nézet ezt mutatja, így a keskeny csúcs nem tűnik el
+    uint8_t rssiMean;     // Átlagos RSSI (dBuV) a mért alap cellákra
+    uint8_t snrMax;       // Legnagyobb SNR (dB)
+    uint8_t count;        // A lefedett mért alap cellák száma (0: nincs adat)
+    uint8_t signalClass;  // A legnagyobb SNR-ű mért alap cella jeltípusa (SignalClass)
+    ScanPointState state; // A lefedett mérések közül a legkevésbé pontos eredete
+};
+
+/**
+ * @brief Mip-map jellegű mérési tár a frekvencia tengely mentén
+ *
+ * - Az alap szint a teljes sávot BASE_CELLS egyforma cellára osztja, minden cella a legutolsó mérést tárolja
+ * - A felsőbb szintek cellái a két gyerek cella min/max/átlag összesítései, méréskor csak a cella felmenői frissülnek
+ * - A lekérdezés a kért tartomány szélességéhez illő szintről olvas, így bármely zoom és eltolás nézete
+ *   néhány cella összevonásával, újramérés nélkül előáll
+ *
+ * A frekvenciák a ScreenScan egységében értendők (a BandTable frekvenciák tízszerese).
+ */
+class ScanPyramid {
+  public:
+    ScanPyramid();
+
+    /**
+     * @brief Az összes adat törlése és a lefedett sáv beállítása
+     * @param bandStartFreq A sáv kezdete
+     * @param bandEndFreq A sáv vége
+     */
+    void reset(uint32_t bandStartFreq, uint32_t bandEndFreq);
+
+    /**
+     * @brief Egy mérés eltárolása (az alap cella felülíródik, a felmenői újraösszesítődnek)
+     * @param freq A mért frekvencia
+     * @param rssi RSSI (dBuV)
+     * @param snr SNR (dB)
+     * @param state A mérés eredete (Coarse vagy Measured)
+     */
+    void store(uint32_t freq, uint8_t rssi, uint8_t snr, ScanPointState state);
+
+    /**
+     * @brief A jeltípus eltárolása egy már mért alap cellához
+     */
+    void setSignalClass(uint32_t freq, uint8_t signalClass);
+
+    /**
+     * @brief A [fromFreq, toFreq) tartomány összesítése
+     * @return Az összesített cella (count == 0: a tartományban nincs mért adat)
+     */
+    ScanCell query(uint32_t fromFreq, uint32_t toFreq) const;
+
+  private:
+    uint32_t bandStartFreq_;                           // A lefedett sáv kezdete
+    uint32_t bandSpan_;                                // A lefedett sáv szélessége
+    ScanCell cells_[ScanPyramidConstants::TOTAL_CELLS]; // Szintenként egymás után, az alap szint az elején
+
+    static uint16_t levelOffset(uint8_t level) { return 2 * ScanPyramidConstants::BASE_CELLS - (2 * ScanPyramidConstants::BASE_CELLS >> level); }
+    static uint16_t levelSize(uint8_t level) { return ScanPyramidConstants::BASE_CELLS >> level; }
+    static void merge(ScanCell &target, const ScanCell &source);
+
+    uint16_t freqToBaseCell(uint32_t freq) const;
+    void propagate(uint16_t baseIndex);
+};
@@ -150,6 +150,12 @@ class ScreenAM : public ScreenRadioBase, public CommonVerticalButtons::Mixin<Scr
      */
     void updateBFOButtonState();
 
+    /**
+     * @brief ZBeat gomb állapotának frissítése
+     * @details Csak CW dekóder módban, zárt AFC mellett engedélyezett
+     */
+    void updateZeroBeatButtonState();
+
     // ===================================================================
     // AM specifikus gomb eseménykezelők
     // ===================================================================
@@ -189,11 +195,36 @@ class ScreenAM : public ScreenRadioBase, public CommonVerticalButtons::Mixin<Scr
      */
     void handleStepButton(const UIButton::ButtonEvent &event);
 
+    /**
+     * @brief Views gomb eseménykezelő - a teljes képernyős nézetek (WEFAX, waterfall, analizátor, NAVTEX) választó dialógusa
+     * @param event Gomb esemény (Clicked)
+     */
+    void handleViewsButton(const UIButton::ButtonEvent &event);
+
+    /**
+     * @brief ZBeat gomb eseménykezelő - CW auto zero-beat
+     * @param event Gomb esemény (Clicked)
+     */
+    void handleZeroBeatButton(const UIButton::ButtonEvent &event);
+
+    /**
+     * @brief CW auto zero-beat (a ZBeat gombra és a hangolássegéd érintésére)
+     */
+    void handleCwZeroBeat();
+
+    /**
+     * @brief A CW skimmer csatornáinak listája a szövegdobozba (soronként: frekvencia, WPM, szöveg)
+     */
+    void updateCwSkimmerList();
+
   private:
     // ===================================================================
     // AM specifikus tagváltozók
     // ===================================================================
     std::shared_ptr<CwDecoder> cwDecoder;
     std::shared_ptr<UITextBox> decodedTextBox;
+    uint32_t skimmerChangeCounter_ = 0; // A skimmer utoljára megjelenített állapota
+    uint32_t skimmerListUpdateMs_ = 0;  // A lista utolsó frissítése (ritkítás)
+    bool cwZeroBeatReady_ = false;      // A ZBeat gomb engedélyezett (CW dekóder mód, zárt AFC)
     SpectrumVisualizationComponent::DisplayMode lastSpectrumMode_ = SpectrumVisualizationComponent::DisplayMode::Off;
 };
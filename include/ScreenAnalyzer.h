@@ -0,0 +1,100 @@
+/**
+ * @file ScreenAnalyzer.h
+ * @brief Teljes képernyős audio spektrum analizátor képernyő (spektrum + waterfall, nagyítás, görgetés, kurzor)
+ * @details A spektrum részleges frissítéssel, a waterfall hardveres görgetéssel rajzol: teljes sprite kirakás nincs
+ */
+#pragma once
+
+#include <TFT_eSPI.h>
+
+#include "BinPixelMap.h"
+#include "SpectrumDbScale.h"
+#include "TftHardwareScroll.h"
+#include "UIScreen.h"
+
+namespace ScreenAnalyzerConstants {
+constexpr uint16_t FIXED_WIDTH = 200;                              // Bal oldali rögzített sáv (TFA): frekvencia skála + spektrum
+constexpr uint16_t LABEL_WIDTH = 38;                               // A frekvencia skála szélessége
+constexpr uint16_t SPECTRUM_WIDTH = FIXED_WIDTH - LABEL_WIDTH - 1; // A spektrum sávok maximális hossza (utána elválasztó vonal)
+constexpr uint16_t SCROLL_AREA = TFT_HEIGHT - FIXED_WIDTH;         // A görgetett waterfall terület (VSA) szélessége
+constexpr uint16_t READOUT_HEIGHT = 16;                            // Felső sáv a kurzor kiírásnak
+constexpr uint16_t AXIS_ROWS = TFT_WIDTH - READOUT_HEIGHT;         // A frekvencia tengely sorai (a spektrum és a waterfall közös tengelye)
+constexpr float MIN_FREQ_HZ = 300.0f;                              // A frekvencia tengely alja
+constexpr float MAX_FREQ_AM_HZ = 6000.0f;                          // A frekvencia tengely teteje AM-en...
+constexpr float MAX_FREQ_FM_HZ = 15000.0f;                         // ... és FM-en
+constexpr uint8_t MAX_ZOOM_LEVEL = 3;                              // Legnagyobb nagyítás: a teljes tartomány 1/8-a
+constexpr uint16_t MIN_FFT_SIZE = 256;                             // A választható legkisebb FFT méret
+constexpr uint8_t MIN_FPS = 15;                                    // Az FFT méret felső korlátja: egy keret mintái legfeljebb 1/MIN_FPS s alatt gyűlnek
+constexpr uint16_t INITIAL_FFT_SIZE = 512;                         // Az első keretig (a mintavételi frekvencia még ismeretlen)
+constexpr uint16_t DRAG_THRESHOLD_PX = 8;                          // Ennél nagyobb elmozdulás húzás (görgetés), egyébként koppintás (kurzor)
+constexpr uint16_t TOUCH_HOLD_POLL_MS = 10;                        // Nyomva tartás alatt az érintési pont olvasási periódusa (húzáshoz)
+constexpr uint16_t LABEL_MIN_SPACING_PX = 28;                      // A frekvencia feliratok minimális távolsága
+constexpr uint16_t READOUT_INTERVAL_MS = 200;                      // A kurzor kiírás frissítési periódusa
+constexpr uint16_t BAR_COLOR = TFT_SKYBLUE;                        // Spektrum sáv színe
+constexpr uint16_t CURSOR_BAR_COLOR = TFT_YELLOW;                  // A kurzor sorában a sáv színe...
+constexpr uint16_t CURSOR_LINE_COLOR = 0x4208;                     // ... és a sáv utáni vonal színe
+constexpr uint8_t BAR_INVALID = 0xFF;                              // A sor sávja teljes újrarajzolást kér (SPECTRUM_WIDTH < 0xFF)
+} // namespace ScreenAnalyzerConstants
+
+/**
+ * @brief Teljes képernyős audio spektrum analizátor
+ * @details Fekvő (rotation 1, MV) tájolásban a vezérlő hardveres görgetése vízszintesen mozgatja a képet (lásd ScreenWaterfall),
+ *          ezért a frekvencia tengely függőleges és közös: balra a rögzített sávban a frekvencia skála és a vízszintes
+ *          spektrum sávok, jobbra a görgetett waterfall, ahol az idő balról jobbra halad.
+ *          - Spektrum: soronként csak a sáv előző és új hossza közötti szakasz rajzolódik (növekedés: sáv szín, csökkenés: fekete)
+ *          - Waterfall: keretenként egyetlen 1 x AXIS_ROWS oszlop és a görgetési mutató léptetése
+ *          - Amplitúdó: SpectrumDbScale (dBFS, zajszint követés), a waterfall színe ugyanabból az ablakból
+ *          - Nagyítás: bin összevonás (soronként a binek maximuma), az FFT méret a látott tartományhoz nő,
+ *            de csak addig, amíg a keretidő belefér a MIN_FPS-be
+ *          Kezelés:
+ *          - Rotary forgatás: nagyítás/kicsinyítés a kurzor frekvenciája körül
+ *          - Rotary klikk: vissza az előző képernyőre, dupla klikk: teljes tartomány
+ *          - Érintés húzás (felengedéskor): a frekvencia tartomány görgetése, koppintás: kurzor az érintett sorra
+ */
+class ScreenAnalyzer : public UIScreen {
+  public:
+    ScreenAnalyzer();
+    virtual ~ScreenAnalyzer() = default;
+
+    // UIScreen interface implementáció
+    void activate() override;
+    void deactivate() override;
+    void drawContent() override;
+    void handleOwnLoop() override;
+    bool handleTouch(const TouchEvent &event) override;
+    bool handleRotary(const RotaryEvent &event) override;
+
+  private:
+    TftScrollColumnWriter columnWriter_;                        // A waterfall oszlopok kiírása és a görgetés léptetése
+    float maxFreqHz_;                                           // A teljes tartomány teteje (AM/FM)
+    float startHz_;                                             // A látott tartomány alja (a 0. sor alsó széle)
+    uint8_t zoomLevel_;                                         // Nagyítás: a látott tartomány a teljes 2^zoomLevel-ed része
+    uint16_t cursorRow_;                                        // A kurzor sora (0: alul)
+    uint16_t touchStartY_;                                      // Az érintés kezdő sora (húzás felismeréshez)
+    uint16_t touchHoldY_;                                       // Nyomva tartás alatt az utolsó olvasott pont (a felengedés a kezdő pontot hozza)
+    uint32_t lastHoldPollMs_;                                   // A nyomva tartott pont utolsó olvasása
+    bool touchActive_;                                          // Érintés folyamatban
+    uint32_t lastReadoutMs_;                                    // Az utolsó kurzor kiírás ideje
+    SpectrumDbScale dbScale_;                                   // dBFS skála és zajszint követés
+    BinPixelMap binMap_;                                        // Sor (alulról) -> FFT bin tábla a látott tartományra
+    uint8_t rowUnits_[ScreenAnalyzerConstants::AXIS_ROWS];      // Soronként a keret dB egysége
+    uint8_t barLevel_[ScreenAnalyzerConstants::AXIS_ROWS];      // Soronként a kirajzolt sáv hossza (részleges frissítéshez)
+    uint16_t columnBuffer_[ScreenAnalyzerConstants::AXIS_ROWS]; // Az új waterfall oszlop RGB565 képpontjai (felülről lefelé)
+
+    float getSpanHz() const;
+    float getHzPerRow() const { return getSpanHz() / ScreenAnalyzerConstants::AXIS_ROWS; }
+    float rowToHz(uint16_t row) const { return startHz_ + (row + 0.5f) * getHzPerRow(); }
+    uint16_t yToRow(uint16_t y) const;
+    int16_t rowToY(uint16_t row) const { return TFT_WIDTH - 1 - row; }
+
+    void trackTouchHold();
+    void setView(float startHz, uint8_t zoomLevel);
+    void zoomTo(uint8_t zoomLevel);
+    void redrawView();
+    void invalidateBars();
+    uint16_t selectFftSize(float samplingHz) const;
+    void drawFrequencyScale();
+    void drawReadout();
+    void drawFrame(const float *magnitudeData, uint16_t fftSize, float inputGain);
+    void drawSpectrumRow(uint16_t row, uint8_t level);
+};
@@ -42,14 +42,23 @@ class ScreenFM : public ScreenRadioBase, public CommonVerticalButtons::Mixin<Scr
      * - Automatikus Si4735 beállítás és band tábla mentés
      * - Frekvencia kijelző azonnali frissítése
      * - Dialógus aktív esetén esemény továbbítása
+     * - Futó seek alatt bármely rotary esemény megszakítja a seek-et
      */
     virtual bool handleRotary(const RotaryEvent &event) override;
 
+    /**
+     * @brief Érintés eseménykezelés - futó seek alatt bármely érintés megszakítja a seek-et
+     * @param event Érintés esemény
+     * @return true ha sikeresen kezelte az eseményt, false egyébként
+     */
+    virtual bool handleTouch(const TouchEvent &event) override;
+
     /**
      * @brief Folyamatos loop hívás - Optimalizált teljesítmény
      * @details Event-driven architektúra - NINCS gombállapot polling!
      *
      * Csak valóban szükséges frissítések:
+     * - Futó seek követése (nem blokkol)
      * - S-Meter (jelerősség) valós idejű frissítése
      *
      * Gombállapotok frissítése CSAK:
@@ -90,6 +99,12 @@ class ScreenFM : public ScreenRadioBase, public CommonVerticalButtons::Mixin<Scr
      */
     virtual void onDialogClosed(UIDialogBase *closedDialog) override;
 
+  protected:
+    /**
+     * @brief Seek befejezése után: RDS cache törlése és memória státusz frissítése
+     */
+    virtual void onSeekFinished() override;
+
   private:
     // ===================================================================
     // UI komponensek layout és management
@@ -153,6 +168,12 @@ class ScreenFM : public ScreenRadioBase, public CommonVerticalButtons::Mixin<Scr
      */
     void handleSeekUpButton(const UIButton::ButtonEvent &event);
 
+    /**
+     * @brief ANLZ gomb eseménykezelő - teljes képernyős spektrum analizátor
+     * @param event Gomb esemény (Clicked)
+     */
+    void handleAnalyzerButton(const UIButton::ButtonEvent &event);
+
     /**
      * @brief Egyedi MEMO gomb eseménykezelő - Intelligens memória kezelés
      * @param event Gomb esemény (Clicked)
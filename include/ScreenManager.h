@@ -7,6 +7,7 @@
 
 #include "Config.h"
 #include "IScreenManager.h"
+#include "ScanModel.h"
 #include "UIScreen.h"
 
 // Deferred action struktúra - biztonságos képernyőváltáshoz
@@ -149,6 +150,11 @@ class ScreenManager : public IScreenManager {
             DEBUG("ScreenManager: Destroyed screen '%s'\n", currentName);
         }
 
+        // A pásztázás piramisa és története nem foglalhatja a helyet, ha más sávra váltottunk vagy kevés a heap
+        if (!STREQ(screenName, SCREEN_NAME_SCAN)) {
+            ScanModel::releaseIfUnused(config.data.currentBandIdx);
+        }
+
         // TFT display törlése a képernyőváltás előtt
         ::tft.fillScreen(TFT_BLACK);
         DEBUG("ScreenManager: Display cleared for screen switch\n");
@@ -257,6 +263,8 @@ class ScreenManager : public IScreenManager {
 
             if (screenSaverTimeoutMs > 0 &&                                  // Ha a képernyővédő engedélyezve van (idő > 0)
                 !STREQ(currentScreen->getName(), SCREEN_NAME_SCREENSAVER) && // És nem a képernyővédőn vagyunk
+                !STREQ(currentScreen->getName(), SCREEN_NAME_WEFAX) &&       // És nem fut felügyelet nélküli fax vétel
+                !STREQ(currentScreen->getName(), SCREEN_NAME_NAVTEX) &&      // ... vagy NAVTEX vétel
                 lastActivityTime != 0 &&                                     // És volt már aktivitás
                 (millis() - lastActivityTime > screenSaverTimeoutMs)) {      // És lejárt az idő
 
@@ -0,0 +1,78 @@
+/**
+ * @file ScreenNavtex.h
+ * @brief A NAVTEX dekóder tárolt üzeneteinek listája és megjelenítése
+ */
+#pragma once
+
+#include "IScrollableListDataSource.h"
+#include "NavtexDecoder.h"
+#include "UIHorizontalButtonBar.h"
+#include "UIScreen.h"
+#include "UIScrollableListComponent.h"
+
+namespace ScreenNavtexConstants {
+constexpr int16_t MARGIN = 5;            // Képernyő margó
+constexpr int16_t TITLE_HEIGHT = 30;     // A cím sáv magassága
+constexpr int16_t LIST_WIDTH = 150;      // Az üzenet lista szélessége
+constexpr uint8_t LIST_ITEM_HEIGHT = 27; // Egy lista elem magassága
+constexpr uint16_t STORE_POLL_MS = 500;  // A dekóder tárának ellenőrzési periódusa
+constexpr uint8_t TEXT_CHAR_WIDTH = 6;   // Az alap font karakterszélessége (textSize 1)
+constexpr uint8_t TEXT_LINE_HEIGHT = 9;  // Sormagasság a szöveg területen
+} // namespace ScreenNavtexConstants
+
+/**
+ * @brief NAVTEX üzenetek képernyő
+ * @details Bal oldalon a dekóder tárának üzenetei (a legújabb felül, B1B2B3B4 azonosítóval és korral),
+ *          jobb oldalon a kiválasztott üzenet fejléce és szövege. A dekóder a képernyőn is fut, az új üzenet
+ *          a lista tetejére kerül és megjelenik. A szöveg közvetlenül a kijelzőre íródik (nincs sprite puffer).
+ */
+class ScreenNavtex : public UIScreen, public IScrollableListDataSource {
+  public:
+    ScreenNavtex();
+    virtual ~ScreenNavtex() = default;
+
+    // UIScreen interface
+    void activate() override;
+    void deactivate() override;
+    void drawContent() override;
+    void handleOwnLoop() override;
+    bool handleRotary(const RotaryEvent &event) override;
+
+    // IScrollableListDataSource interface
+    int getItemCount() const override;
+    String getItemLabelAt(int index) const override;
+    String getItemValueAt(int index) const override;
+    bool onItemClicked(int index) override;
+
+  private:
+    /**
+     * @brief Egy tárolt üzenet lista adatai (a szöveg csak a kiválasztott üzenetről készül másolat)
+     */
+    struct MessageHeader {
+        char station;
+        char subject;
+        uint8_t serial;
+        uint16_t errorCount;
+        uint32_t receivedMs;
+    };
+
+    NavtexDecoder *decoder_;
+    std::vector<MessageHeader> headers_;
+    NavtexDecoder::Message selected_; // A megjelenített üzenet másolata
+    int selectedIndex_;               // -1: nincs megjelenített üzenet
+    uint32_t storeSequence_;          // A tár utoljára betöltött változásszámlálója
+    uint32_t lastPollMs_;             // A tár utolsó ellenőrzése
+    bool lastSynced_;                 // A kirajzolt szinkron jelző állapota
+
+    std::shared_ptr<UIScrollableListComponent> messageList;
+    std::shared_ptr<UIHorizontalButtonBar> horizontalButtonBar;
+    std::shared_ptr<UIButton> backButton;
+
+    void layoutComponents();
+    void loadHeaders();
+    void drawTitle();
+    void drawSyncIndicator();
+    void drawMessage();
+    void showClearConfirmDialog();
+    static const char *getSubjectName(char subject);
+};
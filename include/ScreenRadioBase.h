@@ -6,9 +6,6 @@
 #include "StatusLine.h"
 #include "UIHorizontalButtonBar.h"
 
-// Forward deklaráció a seek callback függvényhez
-void radioSeekProgressCallback(uint16_t frequency);
-
 /**
  * @brief Közös vízszintes gombsor gomb azonosítók
  * @details Minden RadioScreen alapú képernyő közös gombjai
@@ -26,7 +23,7 @@ static constexpr uint8_t SCAN_BUTTON = 52; ///< Scan (folyamatos keresés)
  *
  * **Fő funkciók:**
  * - FrequDisplay (frekvencia kijelző) és akkumulátor állapot kijelző
- * - Seek (automatikus állomáskeresés) valós idejű frissítéssel
+ * - Seek (automatikus állomáskeresés) a főciklust nem blokkoló állapotgéppel, valós idejű frissítéssel
  * - Frekvencia és band kezelés
  * - Közös vízszintes gombsor (HAM, BAND, SCAN) kezelése
  * - S-Meter (jelerősség mérő) komponens integrációja
@@ -40,9 +37,6 @@ static constexpr uint8_t SCAN_BUTTON = 52; ///< Scan (folyamatos keresés)
  */
 class ScreenRadioBase : public ScreenFrequDisplayBase {
 
-    // Friend deklaráció a seek callback számára
-    friend void radioSeekProgressCallback(uint16_t frequency);
-
   public:
     // ===================================================================
     // Konstruktor és destruktor
@@ -115,6 +109,11 @@ class ScreenRadioBase : public ScreenFrequDisplayBase {
      */
     virtual void activate() override;
 
+    /**
+     * @brief RadioScreen deaktiválása - a futó seek megszakítása
+     */
+    virtual void deactivate() override;
+
     /**
      * @brief Lehetőség a leszármazott osztályoknak további gombok hozzáadására
      * @param buttonConfigs A már meglévő gomb konfigurációk vektora
@@ -210,29 +209,53 @@ class ScreenRadioBase : public ScreenFrequDisplayBase {
     // ===================================================================
 
     /**
-     * @brief Seek keresés indítása lefelé valós idejű frekvencia frissítéssel
-     * @details Beállítja a callback infrastruktúrát és indítja a seek-et
+     * @brief Seek keresés indítása lefelé (nem blokkol)
+     * @details A keresést a handleSeek() viszi végig a handleOwnLoop()-ból
      *
      * Művelet:
-     * 1. Callback infrastruktúra beállítása
-     * 2. SI4735 seekStationProgress hívás SEEK_DOWN irányban
-     * 3. Valós idejű frekvencia frissítés a callback-en keresztül
-     * 4. Konfiguráció és band tábla frissítése
+     * 1. Seek küszöbök beállítása a konfigból
+     * 2. SI4735 seek indítása SEEK_DOWN irányban, várakozás nélkül
+     * 3. Valós idejű frekvencia frissítés a handleSeek() lekérdezéseiből
+     * 4. A befejezéskor konfiguráció és band tábla frissítése, onSeekFinished()
      */
     void seekStationDown();
 
     /**
-     * @brief Seek keresés indítása felfelé valós idejű frekvencia frissítéssel
-     * @details Beállítja a callback infrastruktúrát és indítja a seek-et
+     * @brief Seek keresés indítása felfelé (nem blokkol)
+     * @details A keresést a handleSeek() viszi végig a handleOwnLoop()-ból
      *
      * Művelet:
-     * 1. Callback infrastruktúra beállítása
-     * 2. SI4735 seekStationProgress hívás SEEK_UP irányban
-     * 3. Valós idejű frekvencia frissítés a callback-en keresztül
-     * 4. Konfiguráció és band tábla frissítése
+     * 1. Seek küszöbök beállítása a konfigból
+     * 2. SI4735 seek indítása SEEK_UP irányban, várakozás nélkül
+     * 3. Valós idejű frekvencia frissítés a handleSeek() lekérdezéseiből
+     * 4. A befejezéskor konfiguráció és band tábla frissítése, onSeekFinished()
      */
     void seekStationUp();
 
+    /**
+     * @brief Fut-e seek keresés
+     */
+    inline bool isSeeking() const { return seekActive; }
+
+    /**
+     * @brief A futó seek keresés megszakítása (érintés, rotary, képernyő elhagyása)
+     * @details A rádió a seek által éppen elért frekvencián marad
+     */
+    void cancelSeek();
+
+    /**
+     * @brief A futó seek keresés követése - a leszármazott osztály handleOwnLoop()-jából hívandó
+     * @details Időközönként lekérdezi a chip STC bitjét és a közbenső frekvenciát (nem blokkol),
+     * a frekvencia kijelzőt menet közben frissíti, időtúllépéskor megszakít
+     */
+    void handleSeek();
+
+    /**
+     * @brief A seek befejeződött (állomás, sáv vége, megszakítás vagy időtúllépés)
+     * @details Virtuális függvény - a leszármazott osztályok itt frissítik a frekvenciafüggő állapotot (pl.: RDS, memória státusz)
+     */
+    virtual void onSeekFinished() {}
+
     // ===================================================================
     // Rádió-specifikus utility metódusok
     // ===================================================================
@@ -287,4 +310,23 @@ class ScreenRadioBase : public ScreenFrequDisplayBase {
 
     /// Flag annak jelzésére, hogy az utolsó dialógus band dialógus volt-e
     bool lastDialogWasBandDialog = false;
+
+    // ===================================================================
+    // Seek állapotgép
+    // ===================================================================
+    bool seekActive = false;        ///< Fut a seek keresés
+    uint32_t seekStartTime = 0;     ///< A keresés indítása (időtúllépéshez)
+    uint32_t seekLastPollTime = 0;  ///< Az utolsó STC lekérdezés ideje
+    uint16_t seekLastFrequency = 0; ///< Az utoljára kijelzett közbenső frekvencia
+
+    /**
+     * @brief Seek indítása a megadott irányban
+     * @param direction SEEK_UP vagy SEEK_DOWN
+     */
+    void startSeek(uint8_t direction);
+
+    /**
+     * @brief A befejeződött seek lezárása: STC nyugtázás, frekvencia mentés, kijelző frissítés
+     */
+    void finishSeek();
 };
@@ -7,7 +7,10 @@
 #pragma once
 
 #include "Config.h"
+#include "ScanModel.h"
 #include "Si4735Manager.h"
+#include "SignalClassifier.h"
+#include "StationData.h"
 #include "UIButton.h"
 #include "UIHorizontalButtonBar.h"
 #include "UIScreen.h"
@@ -22,6 +25,54 @@ enum class ScanState {
     Scanning ///< Aktívan pásztáz
 };
 
+/**
+ * @brief Egy sweep menetei (durva-finom pásztázás)
+ */
+enum class ScanPass : uint8_t {
+    Coarse, ///< Minden COARSE_STRIDE-adik pont, egyetlen méréssel
+    Refine, ///< Teljes felbontás átlagolással, csak a zajszint feletti pontok környezetében
+    Fill    ///< Zoom vagy eltolás után csak a nézet soha nem mért pontjai, egyetlen méréssel
+};
+
+/**
+ * @brief Automatikus állomás tárolás (Store gomb) fázisai
+ */
+enum class AutoStorePhase : uint8_t {
+    Off,   ///< Nincs folyamatban
+    Sweep, ///< A teljes sáv pásztázása
+    Survey ///< FM: a jelöltek RDS azonosítása (PI, PS, PTY) a chip RDS FIFO-jából
+};
+
+/**
+ * @brief Egy állomás az FM sávfelmérés eredményében (PI szerint egyedi, a legerősebb frekvenciával)
+ */
+struct FmSurveyEntry {
+    uint16_t frequency; // Frekvencia (chip egység, 10 kHz)
+    uint8_t rssi;       // RSSI (dBuV)
+    uint8_t snr;        // SNR (dB)
+    uint16_t pi;        // RDS PI kód (0: nincs RDS, vagy nem lett stabil)
+    uint8_t pty;        // RDS program típus (0-31, csak stabil PI mellett érvényes)
+    char ps[9];         // RDS PS név (üres: nem jött meg teljesen)
+};
+
+/**
+ * @brief Memória pásztázás (Mem gomb) fázisai
+ */
+enum class MemoryScanPhase : uint8_t {
+    Tune, ///< A hangolás kiadva, az STC után egyetlen RSQ minta dönt a csatornáról
+    Dwell ///< Aktív csatornán állunk szóló hanggal, tartós jelvesztés után továbblépünk
+};
+
+/**
+ * @brief Egy csatorna a memória pásztázás listájában
+ */
+struct MemoryScanChannel {
+    StationData station; // A tárolt állomás (chip egységű frekvencia)
+    uint8_t rssi;        // Az utolsó minta RSSI értéke (dBuV)
+    uint8_t snr;         // Az utolsó minta SNR értéke (dB)
+    bool measured;       // Volt már minta a csatornán
+};
+
 /**
  * @brief Scan módok
  */
@@ -62,14 +113,17 @@ class ScreenScan : public UIScreen {
     static constexpr uint8_t PLAY_PAUSE_BUTTON_ID = 41;
     static constexpr uint8_t ZOOM_IN_BUTTON_ID = 42;
     static constexpr uint8_t ZOOM_OUT_BUTTON_ID = 43;
-    static constexpr uint8_t RESET_BUTTON_ID = 44;    // Screen layout constants (480x320 display)
-    static constexpr uint16_t SCAN_AREA_WIDTH = 460;  // Spektrum szélessége (pixelben)
-    static constexpr uint16_t SCAN_RESOLUTION = 920;  // Mintavételi pontok száma (2x felbontás)
-    static constexpr uint16_t SCAN_AREA_HEIGHT = 180; // Spektrum magassága
-    static constexpr uint16_t SCAN_AREA_X = 10;       // Spektrum X pozíciója
-    static constexpr uint16_t SCAN_AREA_Y = 40;       // Spektrum Y pozíciója
-    static constexpr uint16_t SCALE_HEIGHT = 20;      // Skála magassága
-    static constexpr uint16_t INFO_AREA_Y = 250;      // Info terület Y pozíciója (frekvencia címkék után)
+    static constexpr uint8_t RESET_BUTTON_ID = 44;
+    static constexpr uint8_t AUTO_STORE_BUTTON_ID = 45;
+    static constexpr uint8_t HEATMAP_BUTTON_ID = 46;
+    static constexpr uint8_t MEMORY_SCAN_BUTTON_ID = 47;                    // Screen layout constants (480x320 display)
+    static constexpr uint16_t SCAN_AREA_WIDTH = 460;                        // Spektrum szélessége (pixelben)
+    static constexpr uint16_t SCAN_RESOLUTION = ScanModelConstants::POINTS; // Mintavételi pontok száma (2x felbontás)
+    static constexpr uint16_t SCAN_AREA_HEIGHT = 180;                       // Spektrum magassága
+    static constexpr uint16_t SCAN_AREA_X = 10;                             // Spektrum X pozíciója
+    static constexpr uint16_t SCAN_AREA_Y = 40;                             // Spektrum Y pozíciója
+    static constexpr uint16_t SCALE_HEIGHT = 20;                            // Skála magassága
+    static constexpr uint16_t INFO_AREA_Y = 250;                            // Info terület Y pozíciója (frekvencia címkék után)
 
     // UI komponensek
     std::shared_ptr<UIButton> backButton;
@@ -77,39 +131,78 @@ class ScreenScan : public UIScreen {
     std::shared_ptr<UIButton> zoomInButton;
     std::shared_ptr<UIButton> zoomOutButton;
     std::shared_ptr<UIButton> resetButton;
+    std::shared_ptr<UIButton> autoStoreButton;
+    std::shared_ptr<UIButton> heatmapButton;
+    std::shared_ptr<UIButton> memoryScanButton;
 
     // Scan állapot változók
     ScanState scanState;
     ScanMode scanMode;
     bool scanPaused;
-    uint32_t lastScanTime;    // Frekvencia és zoom kezelés
-    uint32_t currentScanFreq; // Aktuális scan frekvencia (kHz-ben)
-    uint32_t scanStartFreq;   // Scan tartomány kezdete
-    uint32_t scanEndFreq;     // Scan tartomány vége
-    float scanStep;           // Scan lépésköz (kHz)
-    float zoomLevel;          // Zoom szint (1.0 = teljes sáv)
-    uint16_t currentScanPos;  // Aktuális pozíció a spektrumban
-    uint8_t zoomGeneration;   // Zoom generációk száma (interpoláció limitáláshoz)
-
-    // RSSI/SNR adatok (nagyobb felbontással)
-    int16_t scanValueRSSI[SCAN_RESOLUTION]; // RSSI értékek
-    uint8_t scanValueSNR[SCAN_RESOLUTION];  // SNR értékek
-    bool scanMark[SCAN_RESOLUTION];         // Állomás jelzők
-    uint8_t scanScaleLine[SCAN_RESOLUTION]; // Skála vonalak
-    bool scanDataValid[SCAN_RESOLUTION];    // Érvényes adatok jelzői
+    uint32_t lastScanTime;        // Frekvencia és zoom kezelés
+    uint32_t lastTuneTime;        // Az utolsó hangolás ideje (jeltípus osztályozás várakozása)
+    bool tunePending;             // Pásztázás: a hangolás kiadva, az STC jelzésre várunk
+    uint32_t tuneStartTime;       // A függő hangolás kiadásának ideje (STC időtúllépéshez)
+    uint32_t sweepStartTime;      // Az aktuális sweep kezdete (0: nem a sáv elejéről indult, nem mérhető)
+    uint32_t lastSweepMs;         // Az utolsó teljes sweep ideje (0: még nincs)
+    uint16_t sweepMeasuredPoints; // Az aktuális sweep mért pontjai (durva + finomított)
+    uint32_t lastInfoTime;        // Az info panel utolsó frissítése pásztázás közben
+    uint32_t currentScanFreq;     // Aktuális scan frekvencia (kHz-ben)
+    uint32_t scanStartFreq;       // Scan tartomány kezdete
+    uint32_t scanEndFreq;         // Scan tartomány vége
+    float scanStep;               // Scan lépésköz (kHz)
+    float zoomLevel;              // Zoom szint (1.0 = teljes sáv)
+    uint16_t currentScanPos;      // Aktuális pozíció a spektrumban
+
+    // Mérési adatok: a nézet pontjai, a piramis és a sweep történet a képernyőnél tovább élő modellben
+    ScanModel &scanModel; // Pontok eszköz egységekben (dBuV, dB), bitkészletbe tömörített jelzőkkel
+    ScanPass scanPass;    // Az aktuális sweep menete
+    bool heatmapView;     // A spektrum helyén az idő x frekvencia hőtérkép látszik
 
     // Sáv határok
     int16_t scanBeginBand; // Sáv kezdete a spektrumban
     int16_t scanEndBand;   // Sáv vége a spektrumban
     uint8_t scanMarkSNR;   // SNR küszöb az állomás jelzéshez
     bool scanEmpty;        // Üres scan (inicializálás)
+    bool core1WasPaused;   // A core1 audio szünetelt a képernyő megnyitásakor (kilépéskor visszaállítjuk)
 
     // Konfiguráció
     uint8_t countScanSignal; // Jel mérések száma átlagoláshoz
     float signalScale;       // Jel skálázási tényező
 
+    // Automatikus állomás tárolás: a sáv pásztázása után a legjobb jelöltek egyetlen mentéssel kerülnek a memóriába
+    AutoStorePhase autoStorePhase;
+    std::vector<StationData> autoStoreStations; // A kiválasztott jelöltek SNR szerint csökkenő sorrendben
+    uint8_t autoStoreIndex;                     // Survey: az éppen hangolt jelölt
+    uint32_t autoStoreTuneTime;                 // Survey: a jelölt hangolásának ideje (RDS időtúllépéshez)
+    uint32_t autoStorePollTime;                 // Survey: az RDS FIFO utolsó kiolvasása
+
+    // FM sávfelmérés (AutoStorePhase::Survey): jelöltenként csak az RDS szinkronig és a stabil PI-ig (PS-ig) állunk meg
+    std::vector<FmSurveyEntry> surveyResults; // PI szerint egyedi eredmények (RDS nélküli állomások frekvenciánként)
+    FmSurveyEntry surveyCurrent;              // Az éppen azonosított jelölt
+    uint8_t surveyPiCount;                    // Ennyi egymást követő csoportban jött ugyanaz a PI
+    char surveyPs[9];                         // Az utolsó 0A csoport utáni PS puffer
+    uint8_t surveyPsCount;                    // Ennyi egymást követő 0A csoportban nem változott a teljes PS
+    bool surveySynced;                        // Jött már RDS csoport a jelöltön
+    uint32_t surveyStartTime;                 // A felmérés kezdete (a teljes időhöz)
+    bool surveyView;                          // A spektrum helyén a felmérés eredménytáblája látszik
+    uint8_t surveyTableTop;                   // A táblázat első látható sora (görgetés)
+
+    // Memória pásztázás (scanMode == ScanMode::Memory): a tárolt állomások végigjárása, aktív csatornán megállás
+    std::vector<MemoryScanChannel> memoryChannels; // Sávváltás szerint csoportosított sorrendben (lásd startMemoryScan())
+    uint8_t memoryScanIndex;                       // Az aktuális csatorna
+    MemoryScanPhase memoryScanPhase;               // Az aktuális csatorna fázisa
+    uint32_t memoryScanTuneTime;                   // Tune: a hangolás kiadásának ideje (STC időtúllépéshez)
+    uint32_t memoryScanPollTime;                   // Dwell: az utolsó minta ideje
+    uint32_t memoryScanSignalTime;                 // Dwell: az utolsó küszöb feletti minta ideje
+    uint8_t memoryScanStartBandIdx;                // Az indításkor aktív sáv (leállításkor más sávon a spektrum érvénytelen)
+
     // UI állapot cache (villogás elkerülésére)
-    String lastStatusText; // Előző státusz szöveg cache    // Metódusok
+    String lastTypeText;   // Előző jeltípus szöveg cache
+    String lastStatusText; // Előző státusz szöveg cache
+    String lastStatsText;  // Előző hőtérkép statisztika szöveg cache
+
+    // Metódusok
     void layoutComponents();
     void createHorizontalButtonBar();
     void initializeScan();
@@ -125,13 +218,55 @@ class ScreenScan : public UIScreen {
     void drawBandBoundaries();
     void drawScanInfoStatic();
     void drawScanInfo();
-    void getSignalQuality(int16_t &rssiY, uint8_t &snr);
+    void setHeatmapView(bool enabled);
+    void recordHistorySweep();
+    uint16_t freqToHistoryColumn(uint32_t freq);
+    void drawHeatmap();
+    void drawHeatmapColumn(uint16_t pixelX);
+    void drawHeatmapStats();
+    void getSignalQuality(int16_t &rssiY, uint8_t &snr, uint8_t samples);
+    void measureSignal(uint8_t &rssi, uint8_t &snr, uint8_t samples);
+    int16_t rssiToY(uint8_t rssi) const;
+    uint16_t nextScanPosition(uint16_t scanPos) const;
+    uint16_t firstScanPosition() const;
+    void finishCoarsePass();
+    uint8_t localNoiseFloor(uint16_t coarseIndex, uint16_t coarseCount) const;
+    bool isScaleLine(uint32_t freq) const;
+    void startAutoStore();
+    void collectAutoStoreCandidates();
+    void tuneSurveyCandidate();
+    void updateSurvey();
+    void finishSurveyCandidate();
+    void finishSurvey();
+    void finishAutoStore();
+    void drawSurveyTable();
+    void drawSurveyTitle();
+    void startMemoryScan();
+    void stopMemoryScan();
+    void setSpectrumButtonsEnabled(bool enabled);
+    void tuneMemoryChannel();
+    void advanceMemoryChannel(int8_t direction);
+    bool sampleMemoryChannel();
+    void updateMemoryScan();
+    void drawMemoryScan();
+    void drawMemoryChannel(uint8_t index);
+    void drawMemoryScanTitle();
     void setFrequency(uint32_t freq);
+    void tuneTo(uint32_t freq);
+    bool pollTuneComplete();
+    void waitTuneComplete();
+    void annotateCurrentPosition();
     void calculateScanParameters();
     void zoomIn();
     void zoomOut();
     uint32_t positionToFreq(uint16_t x);
     uint16_t freqToPosition(uint32_t freq);
     void handleZoom(float newZoomLevel);
+    void panView(int8_t direction);
+    void setViewRange(uint32_t startFreq, uint32_t endFreq);
+    void saveView();
+    bool restoreView();
+    void loadViewFromPyramid();
+    void scheduleGapFill();
     bool isDataValid(uint16_t scanPos) const;
 };
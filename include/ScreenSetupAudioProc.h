@@ -10,6 +10,8 @@
  * - RTTY shift beállítása (80Hz - 1000Hz)
  * - RTTY mark frequency beállítása (1200Hz - 2500Hz)
  * - FFT konfigurációk AM és FM módokhoz
+ * - Waterfall színpaletta
+ * - Spektrum nyomvonalak (átlag, csúcstartás, minimum tartás) és időzítésük
  */
 class ScreenSetupAudioProc : public ScreenSetupBase {
   private:
@@ -23,16 +25,29 @@ class ScreenSetupAudioProc : public ScreenSetupBase {
         RTTY_MARK_FREQUENCY,
         FFT_GAIN_AM,
         FFT_GAIN_FM,
+        WATERFALL_PALETTE,
+        SPECTRUM_TRACES,
+        TRACE_AVERAGE_TIME,
+        TRACE_PEAK_DECAY,
+        SPECTRUM_SCALE,
+        SPECTRUM_DB_RANGE,
     };
 
     // Segédfüggvények
     String decodeFFTGain(float value);
+    const char *decodeSpectrumTraces(uint8_t traceMask);
 
     // Audió feldolgozás specifikus dialógus kezelő függvények
     void handleCwOffsetDialog(int index);
     void handleRttyShiftDialog(int index);
     void handleRttyMarkFrequencyDialog(int index);
     void handleFFTGainDialog(int index, bool isAM);
+    void handleWaterfallPaletteDialog(int index);
+    void handleSpectrumTracesDialog(int index);
+    void handleTraceAverageTimeDialog(int index);
+    void handleTracePeakDecayDialog(int index);
+    void handleSpectrumScaleDialog(int index);
+    void handleSpectrumDbRangeDialog(int index);
 
   protected:
     // SetupScreenBase virtuális metódusok implementációja
@@ -7,6 +7,7 @@
  *
  * Ez a képernyő a Si4735 rádió chip specifikus beállításait kezeli:
  * - Zajzár (squelch) alapjának kiválasztása (RSSI/SNR)
+ * - Seek RSSI/SNR küszöbök FM sávra
  * - FFT konfigurációk AM és FM módokhoz
  * - Egyéb Si4735 specifikus paraméterek
  */
@@ -15,7 +16,17 @@ class ScreenSetupSi4735 : public ScreenSetupBase {
     /**
      * @brief Si4735 specifikus menüpont akciók
      */
-    enum class Si4735ItemAction { NONE = 0, SQUELCH_BASIS = 100, FFT_CONFIG_AM = 101, FFT_CONFIG_FM = 102, VOLUME_LEVEL = 103, AUDIO_MUTE = 104, STEREO_THRESHOLD = 105 };
+    enum class Si4735ItemAction {
+        NONE = 0,
+        SQUELCH_BASIS = 100,
+        FFT_CONFIG_AM = 101,
+        FFT_CONFIG_FM = 102,
+        VOLUME_LEVEL = 103,
+        AUDIO_MUTE = 104,
+        STEREO_THRESHOLD = 105,
+        SEEK_RSSI_FM = 106,
+        SEEK_SNR_FM = 107
+    };
 
     // Segédfüggvények
 
@@ -24,6 +35,7 @@ class ScreenSetupSi4735 : public ScreenSetupBase {
     void handleVolumeLevelDialog(int index);
     void handleToggleItem(int index, bool &configValue);
     void handleStereoThresholdDialog(int index);
+    void handleSeekThresholdDialog(int index, const char *title, uint8_t &configValue, const char *unit);
 
   protected:
     // SetupScreenBase virtuális metódusok implementációja
@@ -0,0 +1,65 @@
+/**
+ * @file ScreenWaterfall.h
+ * @brief Teljes képernyős, hardveresen görgetett audio waterfall képernyő
+ * @details A kijelző vezérlő függőleges görgetését (VSCRDEF/VSCRSADD) használja: keretenként csak az új oszlop íródik ki
+ */
+#pragma once
+
+#include <TFT_eSPI.h>
+
+#include "BinPixelMap.h"
+#include "TftHardwareScroll.h"
+#include "UIScreen.h"
+
+namespace ScreenWaterfallConstants {
+constexpr uint16_t LABEL_WIDTH = 40;                             // Bal oldali rögzített sáv (TFA) a frekvencia skálának
+constexpr uint16_t SCROLL_AREA = TFT_HEIGHT - LABEL_WIDTH;       // A görgetett terület (VSA) szélessége, a jobb szélig tart (BFA = 0)
+constexpr uint16_t COLUMN_HEIGHT = TFT_WIDTH;                    // Egy oszlop magassága: fekvő tájolásban a natív szélesség
+constexpr uint16_t FFT_SIZE = 512;                               // ~23 Hz/bin 12 kHz-en: a 320 képpontos frekvencia tengelyhez elég felbontás
+constexpr float MIN_FREQ_HZ = 300.0f;                            // A frekvencia tengely alja
+constexpr float MAX_FREQ_AM_HZ = 6000.0f;                        // A frekvencia tengely teteje AM-en...
+constexpr float MAX_FREQ_FM_HZ = 15000.0f;                       // ... és FM-en
+constexpr float LABEL_STEP_AM_HZ = 1000.0f;                      // Skála osztás AM-en...
+constexpr float LABEL_STEP_FM_HZ = 2000.0f;                      // ... és FM-en
+constexpr float NOISE_THRESHOLD = 0.003f;                        // Ez alatti magnitúdó nullázva (mint a spektrum komponensben)
+constexpr float MANUAL_INPUT_SCALE = 8.0f;                       // Kézi erősítésnél a magnitúdó szorzója (a komponens waterfall skálája)
+constexpr float AUTO_TARGET_LEVEL = 200.0f;                      // Auto erősítésnél a simított keret maximum erre a szintre kerül
+constexpr float AUTO_PEAK_SMOOTHING = 0.05f;                     // A keret maximum exponenciális simítása (~20 keret)
+constexpr float AUTO_MIN_PEAK = 0.01f;                           // A simított maximum alsó korlátja (csendben ne erősítsük fel a zajt)
+} // namespace ScreenWaterfallConstants
+
+/**
+ * @brief Teljes képernyős audio waterfall képernyő hardveres görgetéssel
+ * @details Fekvő (rotation 1, MV) tájolásban a vezérlő natív sorai a képernyő X tengelye mentén futnak,
+ *          ezért a függőleges görgetés vízszintesen mozgatja a képet: az idő balról jobbra halad,
+ *          a frekvencia alulról felfelé nő. Keretenként egyetlen 1 x COLUMN_HEIGHT oszlop íródik a következő
+ *          memória sorba, majd a görgetési mutató (VSP) úgy lép, hogy ez az oszlop kerüljön a jobb szélre.
+ *          Így a teljes kép újrarajzolása helyett keretenként ~320 képpont megy ki az SPI-n.
+ *          A bal oldali rögzített sáv (TFA) nem görög, ide kerül a frekvencia skála.
+ *          Kezelés:
+ *          - Rotary klikk: vissza az előző képernyőre
+ *          - Érintés: a kép törlése
+ */
+class ScreenWaterfall : public UIScreen {
+  public:
+    ScreenWaterfall();
+    virtual ~ScreenWaterfall() = default;
+
+    // UIScreen interface implementáció
+    void activate() override;
+    void deactivate() override;
+    void drawContent() override;
+    void handleOwnLoop() override;
+    bool handleTouch(const TouchEvent &event) override;
+    bool handleRotary(const RotaryEvent &event) override;
+
+  private:
+    TftScrollColumnWriter columnWriter_;                             // Az oszlopok kiírása és a görgetés léptetése
+    float maxFreqHz_;                                                // A frekvencia tengely teteje (AM/FM)
+    float smoothedPeak_;                                             // Auto erősítés: a simított keret maximum
+    BinPixelMap binMap_;                                             // Sor (alulról) -> FFT bin tábla, a sorok a binjeik maximumát mutatják
+    uint16_t columnBuffer_[ScreenWaterfallConstants::COLUMN_HEIGHT]; // Az új oszlop RGB565 képpontjai (felülről lefelé)
+
+    void drawFrequencyScale();
+    void drawColumn(const float *magnitudeData);
+};
@@ -0,0 +1,54 @@
+/**
+ * @file ScreenWefax.h
+ * @brief WEFAX (HF időjárási fax) kép képernyő
+ * @details A core1-en futó WefaxDecoder sorait soronként, egyetlen sor pufferrel rajzolja ki
+ */
+#pragma once
+
+#include "UIScreen.h"
+#include "WefaxDecoder.h"
+
+namespace ScreenWefaxConstants {
+constexpr uint16_t STATUS_BAR_HEIGHT = 16;                           // Felső állapotsor magassága
+constexpr uint16_t IMAGE_Y = STATUS_BAR_HEIGHT;                      // A kép területének teteje
+constexpr uint16_t STATUS_REFRESH_MS = 500;                          // Az állapotsor frissítési periódusa
+constexpr int16_t SLANT_STEP_PPM = 10;                               // Ferdeség korrekció lépésköze (rotary)
+constexpr uint16_t CURSOR_COLOR = TFT_RED;                           // A következő sor helyét jelző vonal színe
+constexpr uint8_t MAX_ROWS_PER_LOOP = WefaxConstants::ROW_RING_SIZE; // Egy loop hívásban legfeljebb ennyi sort rajzolunk
+} // namespace ScreenWefaxConstants
+
+/**
+ * @brief WEFAX kép képernyő
+ * @details Teljes képernyős szürkeárnyalatos kép, felül állapotsorral.
+ *          A sorok a kép területén felülről lefelé íródnak, alul körbefordulnak.
+ *          Kezelés:
+ *          - Rotary forgatás: ferdeség korrekció (ppm), dupla klikk: nullázás
+ *          - Rotary klikk: vissza az előző képernyőre
+ *          - Érintés: kép kézi indítása / leállítása (start hang nélkül)
+ */
+class ScreenWefax : public UIScreen {
+  public:
+    ScreenWefax();
+    virtual ~ScreenWefax() = default;
+
+    // UIScreen interface implementáció
+    void activate() override;
+    void deactivate() override;
+    void drawContent() override;
+    void handleOwnLoop() override;
+    bool handleTouch(const TouchEvent &event) override;
+    bool handleRotary(const RotaryEvent &event) override;
+
+  private:
+    WefaxDecoder *decoder_;
+    uint32_t lastImageCounter_; // A képszámláló utolsó látott értéke (új képnél törlünk)
+    uint16_t cursorY_;          // A következő kirajzolandó sor Y koordinátája
+    uint32_t lastStatusMs_;
+    uint8_t rowBuffer_[WefaxConstants::IMAGE_WIDTH];  // A dekóderből kivett szürke sor
+    uint16_t lineBuffer_[WefaxConstants::IMAGE_WIDTH]; // ... RGB565-re alakítva (az egyetlen kép puffer)
+
+    void clearImage();
+    void drawRow();
+    void drawStatusBar();
+    void changeSlant(int16_t ppm);
+};
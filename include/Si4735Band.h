@@ -48,6 +48,11 @@ class Si4735Band : public Si4735Runtime, public Band {
      */
     void setAfBandWidth();
 
+    /**
+     * @brief A seek RSSI/SNR küszöbeinek beállítása a chipen a konfig szerint (csak FM sávon)
+     */
+    void setSeekThresholds();
+
     /**
      * @brief A hangolás a memória állomásra
      * @param bandIndex A band indexe (FM, MW, SW, LW)
@@ -62,4 +67,12 @@ class Si4735Band : public Si4735Runtime, public Band {
      * @param rotaryValue A rotary encoder értéke (növelés/csökkentés)
      */
     uint16_t stepFrequency(int16_t rotaryValue);
+
+    /**
+     * @brief CW automatikus nullázó hangolás (auto zero-beat)
+     * @details A BFO finomhangolással úgy hangol át, hogy a mért CW hang a beállított CW offsetre essen.
+     * @param measuredToneHz A mért (AFC által követett) hangfrekvencia Hz-ben
+     * @return true ha történt áthangolás
+     */
+    bool cwZeroBeat(float measuredToneHz);
 };
@@ -4,6 +4,16 @@
 #include "Si4735Band.h"
 #include "utils.h"
 
+/**
+ * @brief Egy, a chip RDS FIFO-jából kivett csoport azonosító adatai
+ */
+struct RdsFifoGroup {
+    uint16_t pi;       // PI kód (0: a csoport A blokkja nem volt érvényes)
+    uint8_t pty;       // Program típus (0-31)
+    char ps[9];        // 0A csoportnál a PS puffer aktuális tartalma (a hiányzó szegmensektől rövidebb), egyébként üres
+    uint8_t remaining; // A FIFO-ban maradt csoportok száma
+};
+
 /**
  * @brief Si4735Rds osztály - RDS funkcionalitás kezelése
  * @details Ez az osztály tartalmazza az összes RDS-hez kapcsolódó funkcionalitást
@@ -56,6 +66,15 @@ class Si4735Rds : public Si4735Band {
      */
     bool getRdsDateTime(uint16_t &year, uint16_t &month, uint16_t &day, uint16_t &hour, uint16_t &minute);
 
+    /**
+     * @brief Egy RDS csoport kivétele a chip RDS FIFO-jából
+     * @details Állomás azonosításhoz (pl. sávfelmérés): a csoportok sorban, kihagyás nélkül feldolgozhatók,
+     *          a PS szegmenseket a könyvtár a saját pufferébe illeszti
+     * @param group A kivett csoport adatai
+     * @return false, ha nincs RDS szinkron vagy a FIFO üres
+     */
+    bool readRdsFifoGroup(RdsFifoGroup &group);
+
     /**
      * @brief Ellenőrzi, hogy elérhető-e RDS adat
      * @return true ha van érvényes RDS vétel
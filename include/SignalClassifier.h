@@ -0,0 +1,172 @@
+#pragma once
+
+#include <Arduino.h>
+
+namespace SignalClassifierConstants {
+constexpr uint8_t ENVELOPE_BLOCKS = 16;       // Az FFT keret időtartománya ennyi részblokkra bontva (RMS burkoló, az AudioProcessor tölti)
+constexpr float MIN_FREQ_HZ = 150.0f;         // Ez alatti binek kimaradnak (DC, mélyvágás)
+constexpr uint8_t FLOOR_BLOCK_BINS = 8;       // Zajszint becslés: ennyi bin átlaga egy blokk...
+constexpr uint8_t MAX_FLOOR_BLOCKS = 128;     // ... legfeljebb ennyi blokk, ezek alsó negyede a zajszint
+constexpr float SIGNAL_PRESENT_RATIO = 5.0f;  // A legerősebb bin a zajszint ennyiszerese felett (~14 dB): van jel
+constexpr float PEAK_RATIO = 4.0f;            // Csúcs: lokális maximum a zajszint ennyiszerese felett...
+constexpr float PEAK_RELATIVE = 0.1f;         // ... és a legerősebb csúcs -20 dB-én belül
+constexpr uint8_t MAX_PEAKS = 8;              // Ennyi legerősebb csúcsot tartunk nyilván keretenként
+constexpr float EXCESS_RATIO = 3.0f;          // A foglalt sávszélességbe csak a zajszint háromszorosa feletti rész számít (a zaj binek kimaradnak)
+constexpr float OCCUPIED_FRACTION = 0.9f;     // Foglalt sávszélesség: a zaj küszöb feletti teljesítmény 90%-a
+constexpr uint8_t NARROW_MIN_BINS = 4;        // Keskeny jel legalább ennyi bin (a Hamming ablak főnyalábja)
+constexpr float NARROW_BW_HZ = 150.0f;        // Keskeny jel (vivő, CW, PSK) foglalt sávszélessége legfeljebb
+constexpr float VOICE_MIN_BW_HZ = 400.0f;     // Beszéd foglalt sávszélessége legalább
+constexpr float STABLE_TOLERANCE_HZ = 30.0f;  // Stabil csúcs: keretek között legfeljebb ennyit (de legalább 1 bint) mozdul
+constexpr float RTTY_MIN_SHIFT_HZ = 100.0f;   // RTTY mark/space távolság alsó...
+constexpr float RTTY_MAX_SHIFT_HZ = 1000.0f;  // ... és felső határa
+constexpr float RTTY_TONE_RELATIVE = 0.25f;   // A második RTTY hang a legerősebb csúcs -12 dB-én belül
+constexpr float RTTY_MIN_PAIR_STABLE = 0.3f;  // A hangpár legalább a keretek ennyi részében ismétlődik
+constexpr float RTTY_MAX_PEAKS = 6.0f;        // RTTY-nál legfeljebb ennyi erős csúcs (átlag, a billentyűzés oldalsávjaival)
+constexpr float NOISE_FLATNESS = 0.38f;       // Ennél laposabb széles spektrum zaj (Hamming ablakos fehér zajnál ~0.43)
+constexpr float NOISE_MAX_ON = 0.2f;          // Ha az időrések kevesebb mint 20%-ában van jel: zaj
+constexpr float ENVELOPE_DIP_LEVEL = 0.5f;    // Burkoló beesés: a keret maximumának fele alatti részblokk
+constexpr float PSK_MIN_DIP = 0.05f;          // PSK: a fázisváltások miatt a részblokkok legalább 5%-a beesés (tiszta vivőnél ~0)
+constexpr uint8_t SIDEBAND_GUARD_BINS = 2;    // A vivő ±ennyi binje (de legalább ±SIDEBAND_GUARD_HZ) nem számít oldalsávnak
+constexpr float SIDEBAND_GUARD_HZ = 50.0f;    // ... a PSK fázisváltások oldalsávjai ezen belül maradnak
+constexpr float AM_SIDEBAND_SHARE = 0.01f;    // AM: a vivőn kívüli (oldalsáv) teljesítmény legalább ennyi
+constexpr float AM_MIN_PEAKS = 1.5f;          // AM: a vivő mellett az oldalsávokban is vannak erős csúcsok (átlag)
+constexpr float AM_CARRIER_SHARE = 0.3f;      // AM: a vivő részesedése a sáv teljesítményéből széles jelnél
+constexpr float AM_MIN_CARRIER_STABLE = 0.8f; // AM: a vivő legalább a keretek ennyi részében helyben marad
+constexpr float SMOOTHING = 0.15f;            // A keret jellemzők exponenciális simítása (~7 keret)
+constexpr uint8_t KEYING_SLOT_MS = 50;        // A jelenlét előzmény egy időrése (a keretek ütemezésétől független)
+constexpr uint8_t KEYING_HISTORY = 20;        // A jelenlét előzmény hossza időrésben (~1 s) a billentyűzés statisztikához
+constexpr float KEYED_MAX_ON = 0.9f;          // Billentyűzött jel: az időrések legfeljebb 90%-ában van jelen...
+constexpr uint8_t KEYED_MIN_TRANSITIONS = 2;  // ... és legalább ennyi be/ki váltás az előzményben
+constexpr uint8_t HYSTERESIS_FRAMES = 3;      // Ennyi egymást követő egyező döntés után vált az osztály
+constexpr uint8_t CONFIDENCE_FRAMES = 8;      // A megbízhatóság ennyi utolsó nyers döntésből (2 hatványa!)
+constexpr uint16_t RESULT_STALE_MS = 1000;    // Ennél régebbi eredményt a core0 érvénytelennek tekint
+} // namespace SignalClassifierConstants
+
+/**
+ * @brief A felismert jeltípus
+ */
+enum class SignalClass : uint8_t {
+    None,     // Nincs érvényes eredmény (FFT ki, core1 szünetel, FM mód)
+    Noise,    // Csak zaj
+    Carrier,  // Billentyűzetlen vivő
+    CW,       // Be/ki billentyűzött keskeny jel
+    RTTY,     // Két stabil hang (FSK)
+    PSK,      // Keskeny, fázisváltásoknál beeső burkolójú jel
+    SSBVoice, // Széles, ingadozó spektrumú beszéd vivő nélkül
+    AMVoice   // Széles beszéd vivővel (vagy AM demodulációval)
+};
+
+/**
+ * @brief Könnyűsúlyú jeltípus osztályozó a core1-en
+ *
+ * Minden FFT keret után fut a kész magnitúdó spektrumon és a keret RMS burkolóján:
+ * - Zajszint: a bin blokk-átlagok alsó negyede
+ * - Foglalt sávszélesség (a zajszint feletti teljesítmény 90%-a), spektrális laposság (gyors log2)
+ * - Csúcsok száma, a legerősebb csúcs és a hangpár stabilitása az előző kerethez képest
+ * - Billentyűzés: a jel jelenlétének be/ki váltásai ~1 s-on át (időrésekben, nem keretekben), a burkoló mélysége a kereten belül
+ *
+ * A jellemzők simítása után egy döntési fa adja a nyers osztályt, ami csak HYSTERESIS_FRAMES egyező
+ * keret után kerül ki. A core0 a volatile eredményt olvassa, a visszaállítást csak kérheti.
+ */
+class SignalClassifier {
+  public:
+    SignalClassifier();
+
+    /**
+     * @brief Egy FFT keret osztályozása (core1)
+     * @param magnitude A magnitúdó spektrum (fftSize elem, az első fele értékes)
+     * @param fftSize Az FFT mérete
+     * @param binWidthHz Egy bin szélessége Hz-ben
+     * @param envelope A keret RMS burkolója (ENVELOPE_BLOCKS elem)
+     */
+    void processFrame(const float *magnitude, uint16_t fftSize, float binWidthHz, const float *envelope);
+
+    /**
+     * @brief Az előzmények törlése kérése hangolás után (core0-ról, a core1 hajtja végre)
+     */
+    void requestReset() { resetRequested_ = true; }
+
+    /**
+     * @brief AM demoduláció jelzése (core0): a demodulált AM hangban nincs vivő csúcs
+     */
+    void setAmDemodulation(bool isAm) { amDemodulation_ = isAm; }
+
+    /**
+     * @brief Az aktuális jeltípus (core0-ról hívható)
+     * @return A jeltípus, vagy SignalClass::None ha az eredmény elavult
+     */
+    SignalClass getSignalClass() const;
+
+    /**
+     * @brief A döntés megbízhatósága: az utolsó keretek egyező nyers döntéseinek aránya (0..100)
+     */
+    uint8_t getConfidence() const { return confidence_; }
+
+    /**
+     * @brief Az utolsó visszaállítás óta feldolgozott keretek száma (a gyűjtési idő ellenőrzéséhez)
+     */
+    uint16_t getFramesSinceReset() const { return framesSinceReset_; }
+
+    /**
+     * @brief A futásidő statisztika kiolvasása és nullázása
+     * @param outMaxMicros A leghosszabb osztályozás (us) az előző lekérdezés óta
+     * @param outFrameMicros Egy FFT keret időtartama (us), ez a futásidő felső korlátja
+     */
+    void takeCostStats(uint32_t &outMaxMicros, uint32_t &outFrameMicros);
+
+    /**
+     * @brief Rövid (legfeljebb 5 karakteres) címke a jeltípushoz
+     */
+    static const char *getLabel(SignalClass signalClass);
+
+    /**
+     * @brief A jeltípus megjelenítési színe (RGB565)
+     */
+    static uint16_t getColor(SignalClass signalClass);
+
+  private:
+    // --- Keret jellemzők simítva ---
+    float bandwidthHz_;
+    float flatness_;
+    float peakCount_;
+    float topStable_;        // A legerősebb csúcs helyben maradt (arány)
+    float pairStable_;       // A hangpár mindkét tagja helyben maradt (arány)
+    float envDip_;           // A kereten belüli burkoló beesések aránya
+    float carrierShare_;     // A legerősebb bin részesedése a sáv teljesítményéből
+    float sidebandShare_;    // A vivőn kívüli zaj küszöb feletti teljesítmény aránya
+    float pairShiftHz_;      // A hangpár távolsága Hz-ben
+    uint16_t presentFrames_; // Jelenléttel feldolgozott keretek (az első a simítást inicializálja)
+
+    // --- Előző keret ---
+    int16_t prevTopBin_;
+    int16_t lastPairLo_; // Az utoljára látott hangpár
+    int16_t lastPairHi_;
+    uint32_t presenceHistory_; // Bitenként az időrések jelenléte (legújabb a 0. bit)
+    uint32_t slotStartMicros_; // Az aktuális (0.) időrés kezdete
+    uint8_t historySlots_;     // Az előzmény kitöltött időrései (legfeljebb KEYING_HISTORY)
+    uint32_t lastFrameMicros_; // Az utoljára feldolgozott keret ideje (az átfedő keretek kihagyásához)
+
+    // --- Döntés és hiszterézis ---
+    SignalClass candidate_;
+    uint8_t candidateCount_;
+    SignalClass rawHistory_[SignalClassifierConstants::CONFIDENCE_FRAMES];
+    uint8_t rawHistoryPos_;
+
+    float floorBlocks_[SignalClassifierConstants::MAX_FLOOR_BLOCKS];
+
+    // --- Core0 <-> Core1 ---
+    volatile SignalClass signalClass_;
+    volatile uint8_t confidence_;
+    volatile uint32_t lastUpdateMs_;
+    volatile uint16_t framesSinceReset_;
+    volatile uint32_t maxCostMicros_;
+    volatile uint32_t frameMicros_;
+    volatile bool resetRequested_;
+    volatile bool amDemodulation_;
+
+    void reset();
+    float estimateNoiseFloor(const float *magnitude, uint16_t lo, uint16_t hi);
+    void updatePresenceHistory(bool present, uint32_t nowMicros);
+    SignalClass decide(float binWidthHz) const;
+    void publish(SignalClass raw);
+};
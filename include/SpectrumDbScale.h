@@ -0,0 +1,93 @@
+#pragma once
+
+#include <Arduino.h>
+
+namespace DbScaleConstants {
+constexpr float UNITS_PER_DB = 2.0f;                     // 0.5 dB felbontás, a 255 egység 0 dBFS, a 0 egység -127.5 dBFS
+constexpr float UNITS_PER_LOG2 = 6.0206f * UNITS_PER_DB; // 20 * log10(2) dB kétszeres magnitúdónként
+constexpr float MAX_UNITS = 255.0f;                      // 0 dBFS
+constexpr float FULL_SCALE_AMPLITUDE = 2048.0f;          // A DC mentesített 12 bites ADC minta csúcsértéke
+constexpr float WINDOW_COHERENT_GAIN = 0.54f;            // Hamming ablak: a teljes kivezérlésű szinusz binje A * N/2 * 0.54
+constexpr uint8_t FLOOR_PERCENTILE = 20;                 // Zajszint: a keret egységeinek alsó 20%-a (a jelek nem húzzák fel)
+constexpr uint8_t FLOOR_BUCKET_SHIFT = 2;                // A percentilis hisztogram vödrei 4 egységesek (2 dB)
+constexpr float FLOOR_SMOOTHING = 0.05f;                 // A zajszint exponenciális simítása (~20 keret), ettől nem "lélegzik" a kép
+constexpr float FLOOR_MARGIN_DB = 6.0f;                  // Az ablak alja ennyivel a zajszint alatt: a háttér sötét, de nem fekete
+constexpr int8_t GRID_STEP_DB = 10;                      // dB rács lépésköze
+constexpr int GRID_MIN_SPACING_PX = 10;                  // Ennél sűrűbb rácsvonalaknál elmaradnak a feliratok
+constexpr uint16_t GRID_COLOR = 0x2945;                  // Sötétszürke rácsvonal (RGB565)
+constexpr uint16_t GRID_LABEL_COLOR = 0x7BEF;            // Rács felirat színe (TFT_DARKGREY)
+} // namespace DbScaleConstants
+
+/**
+ * @brief Logaritmikus (dBFS) spektrum skála zajszint követéssel
+ *
+ * - A magnitúdók 0.5 dB-es uint8 egységekbe kerülnek gyors log2 közelítéssel (255: teljes kivezérlésű szinusz)
+ * - A zajszint a keret egységeinek alsó percentilise (2 dB-es hisztogram, rendezés nélkül), időben simítva
+ * - A megjelenített ablak a zajszint alatt kezdődik és config.data.spectrumDbRange széles,
+ *   így a háttér stabil, a gyenge jelek a zaj felett kiemelkednek
+ *
+ * A keret elején beginFrame(), az egységek után updateNoiseFloor(), utána toLevel() a kijelző szintekhez.
+ */
+class SpectrumDbScale {
+  public:
+    SpectrumDbScale();
+
+    /**
+     * @brief A zajszint becslés törlése (mód vagy leképezés váltáskor)
+     */
+    void reset() { noiseFloorUnits_ = -1.0f; }
+
+    /**
+     * @brief Keret kezdete: az egység eltolás az FFT mérethez és a bemeneti erősítéshez
+     * @param fftSize Az FFT mérete
+     * @param inputGain Az FFT bemenetére alkalmazott erősítés (core1 auto/kézi gain), ezzel a skála visszaoszt
+     */
+    void beginFrame(uint16_t fftSize, float inputGain = 1.0f);
+
+    /**
+     * @brief Magnitúdó -> dB egység (0: -127.5 dBFS vagy az alatt, 255: 0 dBFS)
+     */
+    uint8_t toUnits(float magnitude) const;
+
+    /**
+     * @brief dB egység -> magnitúdó (lineáris skálájú megjelenítéshez)
+     */
+    float toMagnitude(uint8_t units) const;
+
+    /**
+     * @brief A zajszint és az ablak frissítése a keret egységeiből
+     * @param units A keret kijelző egységeinek dB értéke
+     * @param count Az egységek száma
+     */
+    void updateNoiseFloor(const uint8_t *units, uint16_t count);
+
+    /**
+     * @brief dB egység -> szint az ablakon belül (0: az ablak alja vagy alatta, maxLevel: a teteje vagy felette)
+     */
+    int toLevel(uint8_t units, int maxLevel) const;
+
+    /**
+     * @brief A dB rács vonalai az aktuális ablakban (GRID_STEP_DB egész többszörösei dBFS-ben)
+     * @param maxLevel Az ablak teteje szintben (pl. a grafikon magassága - 1)
+     * @param outLevels A vonalak szintje (alulról)
+     * @param outDbfs A vonalak dBFS értéke
+     * @param maxLines A kimeneti tömbök mérete
+     * @return A vonalak száma
+     */
+    uint8_t getGridLines(int maxLevel, int16_t *outLevels, int16_t *outDbfs, uint8_t maxLines) const;
+
+    /**
+     * @brief A simított zajszint dBFS-ben (a becslés előtt -127.5)
+     */
+    float getNoiseFloorDbfs() const;
+
+  private:
+    float offsetUnits_;     // log2(magnitúdó) -> egység eltolás az aktuális FFT mérethez
+    float unitScale_;       // Egység -> magnitúdó szorzó
+    float noiseFloorUnits_; // Simított zajszint egységben (< 0: még nincs becslés)
+    float windowLow_;       // A megjelenített ablak alja egységben (a zajszint alatt)
+    float windowRange_;     // A megjelenített ablak szélessége egységben
+
+    static float magnitudeTable_[256]; // Egység -> relatív magnitúdó (2^(egység / UNITS_PER_LOG2)), minden példány közös táblája
+    static bool magnitudeTableReady_;
+};
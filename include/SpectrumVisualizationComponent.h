@@ -1,11 +1,14 @@
 #pragma once
 
 #include <TFT_eSPI.h>
+#include <functional>
 #include <vector>
 
 #include "AudioProcessor.h"
 #include "Band.h"
+#include "BinPixelMap.h"
 #include "ConfigData.h"
+#include "SpectrumDbScale.h"
 #include "UIComponent.h"
 
 /**
@@ -13,6 +16,16 @@
  */
 enum class RadioMode { AM = 0, FM = 1 };
 
+/**
+ * @brief Spektrum nyomvonal bitek (config.data.spectrumTraces)
+ */
+namespace SpectrumTraceFlags {
+constexpr uint8_t AVERAGE = 0x01; // Exponenciális átlag
+constexpr uint8_t PEAK = 0x02;    // Csúcstartás lecsengéssel
+constexpr uint8_t MIN = 0x04;     // Minimum tartás (zajszint), ugyanazzal a sebességgel enged
+constexpr uint8_t ALL = AVERAGE | PEAK | MIN;
+} // namespace SpectrumTraceFlags
+
 /**
  * @brief Spektrum vizualizáció komponens a radio-2 projekt alapján
  */
@@ -21,7 +34,7 @@ class SpectrumVisualizationComponent : public UIComponent {
     /**
      * @brief Megjelenítési módok
      */
-    enum class DisplayMode { Off = 0, SpectrumLowRes = 1, SpectrumHighRes = 2, Oscilloscope = 3, Envelope = 4, Waterfall = 5, CWWaterfall = 6, RTTYWaterfall = 7 };
+    enum class DisplayMode { Off = 0, SpectrumLowRes = 1, SpectrumHighRes = 2, Oscilloscope = 3, Envelope = 4, Waterfall = 5, CWWaterfall = 6, RTTYWaterfall = 7, PSKWaterfall = 8, CWSkimmer = 9, NAVTEXWaterfall = 10 };
 
     /**
      * @brief Hangolási segéd típusok (CW/RTTY)
@@ -30,6 +43,9 @@ class SpectrumVisualizationComponent : public UIComponent {
         OFF_DECODER, // A fő dekóder ki van kapcsolva
         CW_TUNING,
         RTTY_TUNING,
+        PSK_TUNING,
+        CW_SKIMMER_TUNING,
+        NAVTEX_TUNING,
         // Később itt lehetnek más dekóder típusok is
     };
 
@@ -90,6 +106,14 @@ class SpectrumVisualizationComponent : public UIComponent {
      */
     bool isModeAvailable(DisplayMode mode) const;
 
+    /**
+     * @brief Dekóder/hangolássegéd mód-e (ezek csak AM-en érhetők el)
+     * @param mode A vizsgálandó megjelenítési mód
+     */
+    static bool isTuningAidMode(DisplayMode mode) {
+        return mode == DisplayMode::CWWaterfall || mode == DisplayMode::RTTYWaterfall || mode == DisplayMode::PSKWaterfall || mode == DisplayMode::CWSkimmer || mode == DisplayMode::NAVTEXWaterfall;
+    }
+
     /**
      * @brief Beállítja, hogy a keret rajzolása szükséges-e
      * @param drawn true ha a keretet rajzolni kell, false ha nem
@@ -111,6 +135,18 @@ class SpectrumVisualizationComponent : public UIComponent {
      */
     inline DisplayMode getCurrentMode() { return currentMode_; }
 
+    /**
+     * @brief A CW AFC által követett hangfrekvencia beállítása a hangolássegéd jelöléséhez
+     * @param frequencyHz A követett frekvencia Hz-ben (0: nincs zárás, nem rajzolunk jelölést)
+     */
+    inline void setCwLockedFrequencyHz(float frequencyHz) { cwLockedFrequencyHz_ = frequencyHz; }
+
+    /**
+     * @brief A CW hangolássegéd rövid érintésére hívott művelet (pl. auto zero-beat) beállítása
+     * @details Ha be van állítva, CW módban a hosszú érintés vált módot.
+     */
+    inline void setCwZeroBeatCallback(std::function<void()> callback) { cwZeroBeatCallback_ = callback; }
+
   private:
     RadioMode radioMode_;
     DisplayMode currentMode_;
@@ -121,6 +157,12 @@ class SpectrumVisualizationComponent : public UIComponent {
     bool needBorderDrawn;       // flag, ami jelzi, ha a keretet újra kell rajzolni
     uint32_t modeIndicatorHideTime_;
     uint32_t lastTouchTime_;
+    bool tapTouchPending_; // PSK/CW módban a lenyomás a felengedésig függőben van (rövid: mód specifikus művelet, hosszú: módváltás)
+
+    // CW AFC megjelenítés és auto zero-beat
+    float cwLockedFrequencyHz_;               // Az AFC által követett CW hang (0: nincs zárás)
+    std::function<void()> cwZeroBeatCallback_; // CW hangolássegéd rövid érintésére hívódik
+
     uint32_t lastFrameTime_; // FPS limitáláshoz
     uint16_t maxDisplayFrequencyHz_;
     float envelopeLastSmoothedValue_;
@@ -141,6 +183,7 @@ class SpectrumVisualizationComponent : public UIComponent {
     // Sprite handling
     TFT_eSprite *sprite_;
     bool spriteCreated_;
+    DisplayMode spriteMode_; // A mód, amelyhez a sprite készült (azonos mód és méret esetén nem készül újra)
     int indicatorFontHeight_;
 
     // Peak detection buffer (24 bands max)
@@ -152,8 +195,39 @@ class SpectrumVisualizationComponent : public UIComponent {
     uint16_t currentTuningAidMinFreqHz_;
     uint16_t currentTuningAidMaxFreqHz_;
 
-    // Waterfall buffer - egyszerűsített 2D vektor
-    std::vector<std::vector<uint8_t>> wabuf;
+    // Envelope gyűrűpuffer: egyetlen foglalás, wabufLines_ sor egyenként wabufLineLength_ bájttal.
+    // Új sor a fej léptetésével kerül be, az előzmény soha nem mozdul (egy sor = egy időoszlop)
+    std::vector<uint8_t> wabuf;
+    uint16_t wabufLines_;
+    uint16_t wabufLineLength_;
+    uint16_t wabufHead_; // A legújabb sor indexe
+
+    // Indexelt (8 bites) sprite (Waterfall, hangolási segéd): a képpont a színtábla indexe, az előzmény maga a sprite
+    uint16_t indexLut_[256];  // Kijelző bájtsorrendű RGB565 színtábla a kirakáshoz
+    uint8_t indexLutPalette_; // A tábla palettája (0xFF: még nincs felépítve)
+
+    // dB skála (config.data.spectrumLogScale): 0.5 dB/egység, a 255 egység 0 dBFS
+    std::vector<uint8_t> dbSlots_; // A keret kijelző egységeinek dB értéke, foglalás csak módváltáskor
+    SpectrumDbScale dbScale_;      // dBFS egységek, zajszint követés, ablak leképezés és rács
+
+    // Spektrum nyomvonalak (SpectrumHighRes): képpontonként dB egységben, foglalás csak módváltáskor
+    std::vector<uint8_t> tracePeak_;
+    std::vector<uint8_t> traceMin_;
+    std::vector<uint16_t> traceAvg_; // 8.8 fixpont: a felső bájt a dB egység, az alsó a tört rész (hosszú időállandónál se akadjon el)
+    bool tracesPrimed_;              // false: a következő keret minden nyomvonalat a pillanatnyi értékre állít
+    uint32_t lastTraceMs_;
+    uint32_t traceDecayRemainder_; // A lecsengés egységnél kisebb maradéka (ezred egység)
+
+    /**
+     * @brief Egy keret nyomvonal frissítési lépései (a keretek közötti időből)
+     */
+    struct TraceFrameStep {
+        uint16_t avgAlphaQ8; // Az átlag súlya 1/256 egységben (1..256)
+        uint8_t decayUnits;  // A csúcs ennyit csökken, a minimum ennyit nő
+        bool prime;          // Az első keret: minden nyomvonal a pillanatnyi érték
+    };
+
+    BinPixelMap binMap_; // Kijelző egység -> FFT bin leképező tábla
 
     /**
      * @brief Sprite kezelő függvények (radio-2 alapján)
@@ -177,7 +251,6 @@ class SpectrumVisualizationComponent : public UIComponent {
     /**
      * @brief Spectrum bar függvények (radio-2 alapján)
      */
-    uint8_t getBandVal(int fft_bin_index, int min_bin_low_res, int num_bins_low_res_range, int total_bands);
     void drawSpectrumBar(int band_idx, double magnitude, int actual_start_x_on_screen, int peak_max_height_for_mode, int current_bar_width_pixels);
 
     /**
@@ -185,15 +258,46 @@ class SpectrumVisualizationComponent : public UIComponent {
      */
     void setTuningAidType(TuningAidType type);
     void renderCwOrRttyTuningAid();
+    uint16_t tuningAidFrequencyAt(uint16_t touchX) const;
+    void selectPskCarrierAt(uint16_t touchX);
+    void selectNavtexCenterAt(uint16_t touchX);
 
     /**
      * @brief Segéd függvények
      */
-    uint16_t valueToWaterfallColor(float val, float min_val, float max_val, byte colorProfileIndex);
     int getGraphHeight() const;
     int getIndicatorHeight() const;
     int getEffectiveHeight() const;
 
+    /**
+     * @brief Waterfall gyűrűpuffer kezelés
+     */
+    void resizeWaterfallBuffer(DisplayMode mode);
+    void clearWaterfallBuffer();
+    uint8_t *pushWaterfallLine();
+    const uint8_t *getWaterfallLine(uint16_t age) const;
+
+    /**
+     * @brief Indexelt (8 bites) sprite kezelés
+     */
+    static bool usesIndexedSprite(DisplayMode mode);
+    void updateIndexLut();
+    uint16_t spriteColor(uint16_t color) const;
+    void queueSpritePush();
+
+    /**
+     * @brief Spektrum nyomvonalak (átlag, csúcstartás, minimum tartás)
+     */
+    void resizeTraces(DisplayMode mode);
+    TraceFrameStep beginTraceFrame();
+    void updateTraceSlot(uint16_t slot, uint8_t traceDb, const TraceFrameStep &step);
+    void drawTraceOverlays(uint16_t slot, int graphH, float adaptiveScale, uint8_t traceMask, int16_t (&prevY)[3]);
+
+    /**
+     * @brief dB skála: a keret kijelző egységeinek dBFS értéke és a zajszint frissítése
+     */
+    void computeDbSlots(const float *magnitudeData, uint16_t slots, uint16_t fftSize, float inputGain);
+
     /**
      * @brief Core1 audio adatok kezelése
      */
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "SignalClassifier.h"
 #include "UIComponent.h"
 
 /**
@@ -16,9 +17,11 @@ class StatusLine : public UIComponent {
         uint16_t width;
         uint16_t color;
     };
-    bool stationInMemory; // Memória állomás jelző
+    bool stationInMemory;         // Memória állomás jelző
+    SignalClass shownSignalClass; // A kirajzolt jeltípus (csak változáskor rajzolunk újra)
+    bool signalClassShown;        // Ki van-e már rajzolva a jeltípus
 
-#define STATUS_LINE_BOXES 10
+#define STATUS_LINE_BOXES 11
     StatusBox statusBoxes[STATUS_LINE_BOXES];
 
     // Privát rajzoló metódusok
@@ -81,4 +84,5 @@ class StatusLine : public UIComponent {
     void updateTemperature();
     void updateVoltage();
     void updateStationInMemory(bool isInMemo);
+    void updateSignalClass();
 };
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <TFT_eSPI.h>
+
+namespace TftDmaConstants {
+constexpr uint32_t STATS_INTERVAL_MS = 10 * 1000;        // A visszanyert főciklus idő statisztika kiírási periódusa
+constexpr uint16_t STRIP_ROWS = 4;                       // Indexelt sprite: egy sáv legalább ennyi sor a legszélesebb sprite-nál is
+constexpr size_t STRIP_PIXELS = STRIP_ROWS * TFT_HEIGHT; // Egy sáv puffer mérete (fekvő tájolásban a TFT_HEIGHT a kijelző szélessége)
+} // namespace TftDmaConstants
+
+/**
+ * @brief Sprite kirakás DMA-val
+ *
+ * A spektrum/waterfall sprite kirakása blokkoló pushSprite() helyett a TFT_eSPI DMA útján történik:
+ * - A komponens a renderelés végén csak előjegyzi a kirakást (queueSprite)
+ * - A főciklus a képernyő loop után indítja el (startPending): a 16 bites sprite közvetlenül a saját
+ *   memóriájából megy ki (nincs másolat), az SPI átvitel a háttérben fut
+ * - Amíg az átvitel fut (isTransferring), a főciklus csak SPI-t nem használó munkát végez; a képernyő logika,
+ *   az érintés olvasás és így a sprite következő rajzolása is csak a waitIdle() után jön
+ *
+ * Ha a DMA nem inicializálható, a kirakás blokkoló pushSprite()-tal történik.
+ *
+ * Indexelt (8 bites) sprite: a képpont egy 256 elemes színtábla indexe (pl. waterfall intenzitás), a kirakáskor
+ * a tábla alapján bővül RGB565-re. A TFT_eSPI 8 bites sprite-ja RGB332, ezért azt a pushSprite() nem így rakná ki.
+ * A bővítés soronkénti sávokban, két kis sáv pufferbe történik (teljes képkocka méretű puffer nincs): amíg az egyik sáv
+ * DMA-val kimegy, a másikba bővül a következő. A következő sáv indítását az isTransferring()/waitIdle() hívás végzi.
+ */
+class TftDmaManager {
+  public:
+    /**
+     * @brief A DMA csatorna inicializálása (a tft.init() után)
+     */
+    static void init();
+
+    /**
+     * @brief Sprite kirakásának előjegyzése (a főciklus startPending() hívása indítja)
+     * @param sprite A kirakandó 16 bites vagy indexelt 8 bites sprite
+     * @param x A kirakás X koordinátája
+     * @param y A kirakás Y koordinátája
+     * @param indexLut 8 bites sprite esetén a 256 elemes színtábla (kijelző bájtsorrendű RGB565), egyébként nullptr
+     */
+    static void queueSprite(TFT_eSprite *sprite, int32_t x, int32_t y, const uint16_t *indexLut = nullptr);
+
+    /**
+     * @brief Az előjegyzett kirakás indítása (a főciklusban, minden képernyő rajzolás után)
+     */
+    static void startPending();
+
+    /**
+     * @brief Fut-e még az indított átvitel (nem blokkol)
+     * @details Indexelt sprite-nál a befejezett sáv után itt indul a következő (a főciklus minden körben hívja)
+     * @return true ha az SPI busz még foglalt
+     */
+    static bool isTransferring();
+
+    /**
+     * @brief Várakozás a futó átvitel végére és az SPI busz felszabadítása (minden más SPI használat előtt)
+     */
+    static void waitIdle();
+
+    /**
+     * @brief A sprite-ra vonatkozó előjegyzés törlése (a sprite megszüntetése előtt)
+     */
+    static void cancel(TFT_eSprite *sprite);
+
+  private:
+    static bool enabled_;
+    static bool busy_;
+    static TFT_eSprite *pendingSprite_;
+    static int32_t pendingX_;
+    static int32_t pendingY_;
+    static const uint16_t *pendingLut_; // Indexelt sprite színtáblája (nullptr: 16 bites sprite)
+
+    // --- Indexelt sprite sávos kirakása ---
+    static uint16_t stripBuffers_[2][TftDmaConstants::STRIP_PIXELS]; // Váltakozó sáv pufferek: az egyik megy ki, a másikba bővül a következő
+    static TFT_eSprite *stripSprite_;                                 // A sávonként kirakott sprite (nullptr: nincs hátralévő sáv)
+    static const uint16_t *stripLut_;                                 // ... színtáblája
+    static int32_t stripX_;                                           // ... kirakási helye
+    static int32_t stripY_;                                           // ...
+    static int32_t stripRow_;                                         // A következő (már bővített) sáv első sora
+    static int32_t stripRows_;                                        // Sorok száma sávonként
+    static uint8_t stripNext_;                                        // A következő sáv puffere
+
+    // --- Statisztika ---
+    static uint32_t startMicros_;
+    static uint32_t transferEstimateMicros_; // Az átvitel becsült ideje (a blokkoló pushSprite ennyit várna)
+    static uint32_t statFrames_;
+    static uint32_t statReclaimedMicros_;
+    static uint32_t statWaitMicros_;
+    static uint32_t lastStatsMs_;
+
+    static void expandStrip();
+    static bool pumpStrips();
+    static void expandIndexed(const uint8_t *src, uint16_t *dst, size_t pixels, const uint16_t *indexLut);
+    static void pushIndexedBlocking(TFT_eSprite *sprite, int32_t x, int32_t y, const uint16_t *indexLut);
+};
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <TFT_eSPI.h>
+
+/**
+ * @brief A kijelző vezérlő hardveres függőleges görgetése (ILI9488 VSCRDEF/VSCRSADD)
+ *
+ * A görgetés a natív sorokra vonatkozik (TFA + VSA + BFA = TFT_HEIGHT), ezek a rotation 1 (MV, tükrözés nélkül)
+ * tájolásban a képernyő X koordinátái: a rögzített terület (TFA) a bal szélen van, a görgetett terület a jobb szélig tart.
+ * A görgetett területre írt oszlop a memóriában marad, a VSP léptetése csak a megjelenítést tolja el.
+ */
+class TftHardwareScroll {
+  public:
+    /**
+     * @brief A görgetési terület beállítása, VSP a terület elejére
+     * @param fixedWidth A bal oldali rögzített sáv (TFA) szélessége, a görgetett terület utána a jobb szélig tart
+     */
+    static void setArea(uint16_t fixedWidth);
+
+    /**
+     * @brief A görgetés kikapcsolása: a teljes kijelző egy terület, VSP = 0 és normál megjelenítési mód
+     * @details Képernyő elhagyásakor kötelező, a többi képernyő görgetés nélkül rajzol
+     */
+    static void disable();
+
+    /**
+     * @brief A görgetési mutató beállítása
+     * @param vsp Az a memória sor, ami a görgetett terület bal szélén (a TFA után) jelenik meg
+     */
+    static void setStart(uint16_t vsp);
+};
+
+/**
+ * @brief Oszloponként görgetett kép írója a TftHardwareScroll területén
+ * @details Az új oszlop a következő memória sorba íródik, majd a VSP úgy lép, hogy ez az oszlop kerüljön a jobb szélre,
+ *          a legrégebbi pedig a görgetett terület bal szélére. A waterfall és az analizátor képernyő közös oszlop írója.
+ */
+class TftScrollColumnWriter {
+  public:
+    /**
+     * @brief Konstruktor
+     * @param fixedWidth A bal oldali rögzített sáv (TFA) szélessége, mint a TftHardwareScroll::setArea() paramétere
+     */
+    explicit TftScrollColumnWriter(uint16_t fixedWidth);
+
+    /**
+     * @brief A görgetett terület törlése, az írás a terület elejéről indul
+     * @details A fillRect a memóriába ír, a görgetés csak a megjelenítést tolja el, így a teljes terület törlődik.
+     */
+    void clear();
+
+    /**
+     * @brief Egy oszlop kiírása a következő memória sorba és a görgetési mutató léptetése
+     * @param y Az oszlop felső képpontja
+     * @param height Az oszlop magassága
+     * @param pixels Az oszlop natív bájtsorrendű RGB565 képpontjai, felülről lefelé
+     */
+    void pushColumn(int32_t y, uint16_t height, uint16_t *pixels);
+
+  private:
+    uint16_t fixedWidth_; // A rögzített sáv szélessége: a görgetett terület első memória sora
+    uint16_t writeRow_;   // A következő oszlop memória sora (fixedWidth_ .. TFT_HEIGHT-1)
+};
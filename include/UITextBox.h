@@ -5,9 +5,29 @@
 
 /**
  * @brief Egyszerű szövegdoboz komponens a dekódolt szöveg megjelenítésére.
+ *
+ * Két működési mód:
+ * - Normál: setText() után a teljes szöveg újratördelve, egyben rajzolódik ki
+ * - Stream (csak hozzáfűzés): appendText() után csak az új karakterek rajzolódnak ki a kurzornál,
+ *   betelt doboznál a sprite egyetlen blokkmozgatással egy sorral feljebb görget.
+ *   A megőrzött szöveg egy fix méretű sor-gyűrű, így a rajzolás költsége nem nő a szöveg hosszával.
+ *   A sor-gyűrű csak stream módban foglal memóriát.
  */
 class UITextBox : public UIComponent {
+  public:
+    static constexpr uint8_t STREAM_MAX_LINES = 16;     // A sor-gyűrű mérete (a látható soroknál nem kell több)
+    static constexpr uint8_t STREAM_MAX_COLUMNS = 80;   // Egy sor maximális hossza karakterben
+    static constexpr uint8_t STREAM_PENDING_SIZE = 128; // Kirajzolásra váró karakterek puffere (2 hatványa!)
+
   private:
+    /**
+     * @brief A stream mód pufferei (csak stream módban foglalva, ~1.4kB)
+     */
+    struct StreamBuffer {
+        char lines[STREAM_MAX_LINES][STREAM_MAX_COLUMNS + 1]; // Sor-gyűrű, nullával lezárt sorok
+        char pending[STREAM_PENDING_SIZE];                     // Hozzáfűzött, de még ki nem rajzolt karakterek
+    };
+
     String text;
     uint16_t textColor;
     uint16_t bgColor;
@@ -16,17 +36,56 @@ class UITextBox : public UIComponent {
     TFT_eSprite _sprite;
     bool _spriteCreated;
 
+    // --- Stream mód ---
+    bool streamMode_;
+    bool fullRedrawPending_;  // A teljes tartalmat újra kell rajzolni (nem elég a hozzáfűzés)
+    StreamBuffer *pStream_;   // Sor-gyűrű és kirajzolásra váró puffer (nullptr, ha nincs stream mód)
+    uint8_t streamFirstLine_; // A legfelső látható sor indexe a gyűrűben
+    uint8_t streamLineCount_; // A használt (látható) sorok száma
+    uint8_t streamColumn_;    // Kurzor oszlop az utolsó sorban
+    uint8_t streamRows_;      // A dobozba férő sorok száma
+    uint8_t streamColumns_;   // A dobozba férő oszlopok száma
+    uint8_t pendingHead_;
+    uint8_t pendingTail_;
+
+    void updateStreamGeometry();
+    void streamClear();
+    void streamPutChar(char c, bool render);
+    bool streamNewLine(bool render);
+    void streamRenderFull();
+    void streamPushRect(int16_t x, int16_t y, int16_t w, int16_t h);
+    char *streamCurrentLine() { return pStream_->lines[(streamFirstLine_ + streamLineCount_ - 1) % STREAM_MAX_LINES]; }
+    int16_t streamCharWidth() const { return 6 * textSize; }
+    int16_t streamLineHeight() const { return 8 * textSize; }
+
   public:
     UITextBox(const Rect &bounds, const String &initialText);
     virtual ~UITextBox();
 
+    UITextBox(const UITextBox &) = delete;
+    UITextBox &operator=(const UITextBox &) = delete;
+
     void setText(const String &newText);
     String getText() const;
 
+    /**
+     * @brief Stream (csak hozzáfűzés) mód be/kikapcsolása, a tartalom törlődik
+     * @details Bekapcsoláskor lefoglalja, kikapcsoláskor felszabadítja a sor-gyűrűt
+     */
+    void setStreamMode(bool enabled);
+    bool isStreamMode() const { return streamMode_; }
+
+    /**
+     * @brief Szöveg hozzáfűzése stream módban (a kirajzolás a következő draw()-ban, csak az új karakterekre)
+     */
+    void appendText(const char *newText);
+    void appendChar(char c);
+
     void setTextColor(uint16_t fg, uint16_t bg);
     void setTextSize(uint8_t size);
     void setTextDatum(uint8_t datum);
 
     virtual void setBounds(const Rect &newBounds) override;
+    virtual void markForRedraw(bool markChildren = false) override;
     virtual void draw() override;
 };
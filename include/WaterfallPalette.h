@@ -0,0 +1,36 @@
+#pragma once
+
+#include <stdint.h>
+
+/**
+ * @brief A választható waterfall színpaletták (a config.data.waterfallPalette értékei)
+ */
+enum class WaterfallPaletteType : uint8_t {
+    Classic = 0,  // Fekete -> kék -> narancs -> sárga -> fehér (a korábbi "Cold" profil)
+    Grayscale,    // Fekete -> fehér
+    HighContrast, // Fekete -> kék -> cián -> zöld -> sárga -> piros -> fehér
+    NightRed,     // Fekete -> piros, éjszakai használatra
+    Count
+};
+
+/**
+ * @brief 256 elemes RGB565 waterfall paletták
+ *
+ * A táblák fordítási időben készülnek a színátmenet pontokból és a flash-ben maradnak,
+ * így egy képpont színe egyetlen tábla olvasás (palette[value], value: 0..255).
+ */
+namespace WaterfallPalette {
+
+/**
+ * @brief A paletta táblája
+ * @param paletteIndex WaterfallPaletteType érték (érvénytelen értéknél a Classic)
+ * @return 256 elemes RGB565 tábla
+ */
+const uint16_t *get(uint8_t paletteIndex);
+
+/**
+ * @brief A paletta rövid neve a beállítások menühöz
+ */
+const char *getName(uint8_t paletteIndex);
+
+} // namespace WaterfallPalette
@@ -0,0 +1,181 @@
+#pragma once
+
+#include "AudioSampleDecoder.h"
+
+namespace WefaxConstants {
+constexpr float CARRIER_HZ = 1900.0f;            // FM segédvivő középfrekvenciája (hangfrekvenciás, USB vételnél)
+constexpr float DEVIATION_HZ = 400.0f;           // Löket: 1500 Hz = fekete, 2300 Hz = fehér
+constexpr uint16_t TARGET_DECIMATED_RATE = 4000; // Decimálás utáni mintavételi frekvencia (Hz)
+constexpr uint8_t LOWPASS_TAPS = 7;              // Decimálás utáni FIR aluláteresztő hossza
+constexpr float LOWPASS_CUTOFF_HZ = 1000.0f;     // ... és vágási frekvenciája
+constexpr uint16_t NCO_TABLE_SIZE = 256;         // NCO szinusz tábla mérete (2 hatványa!)
+constexpr uint8_t NCO_TABLE_BITS = 8;            // log2(NCO_TABLE_SIZE)
+constexpr int16_t NCO_AMPLITUDE = 4096;          // Q12 fixpontos szinusz amplitúdó
+constexpr uint8_t LINES_PER_MINUTE = 120;        // Sorfrekvencia (LPM)
+constexpr uint16_t IOC = 576;                    // Index of Cooperation: egy sor IOC * PI képpont
+constexpr uint16_t IMAGE_WIDTH = 480;            // A kimeneti sor szélessége képpontban (a kijelző szélessége)
+constexpr uint16_t START_TONE_HZ = 300;          // APT start hang (IOC 576)
+constexpr uint16_t STOP_TONE_HZ = 450;           // APT stop hang
+constexpr uint16_t TONE_WINDOW_MS = 500;         // A start/stop hang detektor mérési ablaka
+constexpr uint8_t TONE_DETECT_WINDOWS = 3;       // Ennyi egymást követő ablakban kell a hangnak lennie
+constexpr float TONE_POWER_RATIO = 0.2f;         // A hang teljesítménye / a teljes variancia (tiszta négyszögnél 0.81)
+constexpr uint8_t PHASING_MIN_LINES = 4;         // Legalább ennyi fázisozó sor után kezdődhet a kép
+constexpr uint8_t PHASING_ALIGN_LINES = 8;       // Ennyi fázisozó soronként igazítjuk a sorkezdetet
+constexpr uint8_t PHASING_TIMEOUT_LINES = 80;    // Ennyi sor után fázisozás nélkül is elindul a kép
+constexpr int16_t MAX_SLANT_PPM = 5000;          // A ferdeség (mintavételi óra hiba) korrekció határa
+constexpr uint8_t ROW_RING_SIZE = 4;             // A core0 felé átadott sorok gyűrűje (2 hatványa!)
+} // namespace WefaxConstants
+
+/**
+ * @brief WEFAX (HF időjárási fax) dekóder a core1-en
+ *
+ * Feldolgozási lánc:
+ * - Fixpontos NCO keverő az 1900 Hz-es segédvivőre, integráló-ürítő decimálás ~4 kHz-re, FIR aluláteresztő
+ * - FM diszkriminátor (szomszédos komplex minták fáziskülönbsége): 1500 Hz fekete, 2300 Hz fehér
+ * - APT start (300 Hz) és stop (450 Hz) hang felismerése a diszkriminátor kimenetének korrelációjával
+ * - Fázisozás: a sorkezdet a fázisozó sorok 5%-os fehér impulzusához igazodik
+ * - 120 LPM sorórajel állítható ferdeség korrekcióval, a sor IMAGE_WIDTH képpontra átlagolva
+ * - IOC 576 méretarány: a sorokat függőlegesen is átlagolja (~3.8 sor / kimeneti sor)
+ *
+ * A kész szürkeárnyalatos sorok egy egy író (core1) / egy olvasó (core0) sor-gyűrűbe kerülnek,
+ * így a megjelenítésnek elég egyetlen sor puffer, nincs szükség teljes kép pufferre.
+ */
+class WefaxDecoder : public AudioSampleDecoder {
+  public:
+    enum class State : uint8_t {
+        Idle,    // Start hangra vár
+        Phasing, // Start hang után, a fázisozó sorokat keresi
+        Image    // Képsorokat ad ki
+    };
+
+    WefaxDecoder();
+
+    // AudioSampleDecoder interface (core1)
+    void reset(uint16_t samplingFrequency) override;
+    void processSample(int16_t sample) override;
+    const char *getName() const override { return "WEFAX"; }
+
+    /**
+     * @brief A ferdeség korrekció beállítása (core0-ról hívható, a következő sortól érvényes)
+     * @param ppm A mintavételi óra relatív hibája ppm-ben (pozitív: a sor hosszabb)
+     */
+    void setSlantPpm(int16_t ppm);
+    int16_t getSlantPpm() const { return requestedSlantPpm_; }
+
+    /**
+     * @brief Kép kézi indítása start hang nélkül (core0-ról kérhető, a core1 hajtja végre)
+     */
+    void requestStart() { startRequested_ = true; }
+
+    /**
+     * @brief A kép kézi leállítása (core0-ról kérhető, a core1 hajtja végre)
+     */
+    void requestStop() { stopRequested_ = true; }
+
+    State getState() const { return state_; }
+
+    /**
+     * @brief Képszámláló: minden új kép kezdetén nő (a UI ekkor törli a képet)
+     */
+    uint32_t getImageCounter() const { return imageCounter_; }
+
+    /**
+     * @brief Az aktuális képből eddig kiadott sorok száma
+     */
+    uint16_t getRowCount() const { return rowCount_; }
+
+    /**
+     * @brief Egy kész sor kivétele a sor-gyűrűből (core0-ról hívható)
+     * @param dst Legalább IMAGE_WIDTH bájtos cél puffer (0: fekete, 255: fehér)
+     * @return true ha volt kész sor
+     */
+    bool popRow(uint8_t *dst);
+
+  private:
+    // --- NCO ---
+    static int16_t sinTable_[WefaxConstants::NCO_TABLE_SIZE];
+    static bool sinTableReady_;
+    uint32_t ncoPhase_;
+    uint32_t ncoIncrement_;
+    uint16_t samplingFrequency_;
+
+    // --- Decimálás és szűrés ---
+    int32_t accI_;
+    int32_t accQ_;
+    uint16_t decimationFactor_;
+    uint16_t decimationCount_;
+    float decimationScale_;
+    float decimatedRate_;
+    float lowpassTaps_[WefaxConstants::LOWPASS_TAPS];
+    float lowpassI_[WefaxConstants::LOWPASS_TAPS];
+    float lowpassQ_[WefaxConstants::LOWPASS_TAPS];
+    uint8_t lowpassPos_;
+
+    // --- FM diszkriminátor ---
+    float prevI_;
+    float prevQ_;
+    float greyScale_; // Fázisléptetés (rad) -> szürke szint szorzó
+
+    // --- Start/stop hang detektor (a diszkriminátor kimenetének korrelációja a két hanggal) ---
+    float toneRotI_[2]; // e^(j*2*pi*f/fs) forgató (0: start, 1: stop hang)
+    float toneRotQ_[2];
+    float tonePhaseI_[2];
+    float tonePhaseQ_[2];
+    float toneAccI_[2];
+    float toneAccQ_[2];
+    float toneSum_;   // A kimenet összege és ...
+    float toneSumSq_; // ... négyzetösszege az ablakban (variancia)
+    uint16_t toneWindowPos_;
+    uint16_t toneWindowLength_;
+    uint8_t startHits_;
+    uint8_t stopHits_;
+
+    // --- Sorórajel és képpont átlagolás ---
+    float samplesPerLine_;
+    float pixelScale_; // Képpont / decimált minta
+    float linePos_;    // Pozíció a soron belül decimált mintában
+    int16_t pixelX_;
+    uint16_t pixelSum_;
+    uint8_t pixelCount_;
+    bool skipLine_; // A sorkezdet igazítása utáni csonka sort eldobjuk
+    uint8_t lineBuf_[WefaxConstants::IMAGE_WIDTH];
+
+    // --- Fázisozás ---
+    static constexpr uint8_t PHASING_BINS = 60; // 8 képpontos rekeszek (a fehér impulzus ~3 rekesz)
+    uint8_t phasingHist_[PHASING_BINS];
+    uint8_t phasingLines_;   // Fázisozó sorok az utolsó igazítás óta
+    uint8_t phasingTotal_;   // Összes fázisozó sor
+    uint8_t phasingElapsed_; // A Phasing állapotban eltelt sorok
+
+    // --- Függőleges átlagolás (IOC méretarány) ---
+    uint16_t rowSum_[WefaxConstants::IMAGE_WIDTH];
+    uint8_t rowLines_;
+    float rowPhase_;
+    float linesPerRow_;
+
+    // --- Sor-gyűrű (core1 írja, core0 olvassa) ---
+    uint8_t rowRing_[WefaxConstants::ROW_RING_SIZE][WefaxConstants::IMAGE_WIDTH];
+    volatile uint8_t rowHead_;
+    volatile uint8_t rowTail_;
+
+    // --- Core0 <-> Core1 ---
+    volatile State state_;
+    volatile uint32_t imageCounter_;
+    volatile uint16_t rowCount_;
+    volatile int16_t requestedSlantPpm_;
+    volatile bool slantChanged_;
+    volatile bool startRequested_;
+    volatile bool stopRequested_;
+
+    void updateLineTiming();
+    void processDecimated(float i, float q);
+    void detectTones(float deviation);
+    void finishPixel();
+    void finishLine();
+    void beginImage(State state);
+    void endImage();
+    bool isPhasingLine();
+    void alignToPhasing();
+    void accumulateRow();
+    void flushRow();
+};
@@ -23,6 +23,10 @@
 
 #define SCREEN_NAME_MEMORY "ScreenMemory"
 #define SCREEN_NAME_SCAN "ScreenScan"
+#define SCREEN_NAME_WEFAX "ScreenWefax"
+#define SCREEN_NAME_NAVTEX "ScreenNavtex"
+#define SCREEN_NAME_WATERFALL "ScreenWaterfall"
+#define SCREEN_NAME_ANALYZER "ScreenAnalyzer"
 
 #define SCREEN_NAME_TEST "TestScreen"
 #define SCREEN_NAME_EMPTY "EmptyScreen"
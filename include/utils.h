@@ -191,4 +191,18 @@ template <typename T> uint16_t calcCRC16(const T &obj) {
     return calcCRC16(reinterpret_cast<const uint8_t *>(&obj), sizeof(T));
 }
 
+//------- Gyors matematika ----
+/**
+ * @brief Gyors log2 közelítés (~0.005 hiba) a kitevő bitekből és egy másodfokú mantissza polinomból, az FPU nélküli RP2040 miatt
+ */
+inline float fastLog2(float x) {
+    union {
+        float f;
+        uint32_t i;
+    } v = {x};
+    const float exponent = static_cast<float>(static_cast<int32_t>((v.i >> 23) & 0xFF) - 127);
+    v.i = (v.i & 0x007FFFFF) | 0x3F800000; // Mantissza [1, 2) tartományban
+    return exponent + (-0.34484843f * v.f + 2.02466578f) * v.f - 1.67487759f;
+}
+
 } // namespace Utils
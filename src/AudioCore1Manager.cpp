@@ -8,6 +8,11 @@ AudioProcessor *AudioCore1Manager::pAudioProcessor_ = nullptr;
 bool AudioCore1Manager::initialized_ = false;
 float *AudioCore1Manager::currentGainConfigRef_ = nullptr;
 bool AudioCore1Manager::collectOsci_ = false;
+Psk31Decoder *AudioCore1Manager::pPsk31Decoder_ = nullptr;
+CwSkimmer *AudioCore1Manager::pCwSkimmer_ = nullptr;
+NavtexDecoder *AudioCore1Manager::pNavtexDecoder_ = nullptr;
+WefaxDecoder *AudioCore1Manager::pWefaxDecoder_ = nullptr;
+SignalClassifier *AudioCore1Manager::pSignalClassifier_ = nullptr;
 
 /**
  * @brief Core1 audio manager inicializálása
@@ -56,6 +61,14 @@ bool AudioCore1Manager::init(float &gainConfigAmRef, float &gainConfigFmRef, int
     // Kezdetben AM módra állítjuk
     currentGainConfigRef_ = &gainConfigAmRef;
 
+    // A jeltípus osztályozót a core1 indítása előtt hozzuk létre (a core1 használja, a core0 csak olvassa)
+    if (!pSignalClassifier_) {
+        pSignalClassifier_ = new (std::nothrow) SignalClassifier();
+        if (!pSignalClassifier_) {
+            DEBUG("AudioCore1Manager: SignalClassifier allokálás sikertelen!\n");
+        }
+    }
+
     DEBUG("AudioCore1Manager: Core1 indítása audio feldolgozáshoz...\n");
 
     // Core1 indítása
@@ -187,11 +200,36 @@ void AudioCore1Manager::core1AudioLoop() {
                 uint32_t t0 = micros();
                 pAudioProcessor_->process(collectOsci_);
 
+                // Jeltípus osztályozás a kész spektrumon és burkolón
+                if (pSignalClassifier_) {
+                    pSignalClassifier_->processFrame(pAudioProcessor_->getMagnitudeData(), pAudioProcessor_->getFftSize(), pAudioProcessor_->getBinWidthHz(), pAudioProcessor_->getEnvelopeData());
+                }
+
                 // Csak 5 másodpercenként írjuk ki a futásidőt
                 static uint32_t lastDebugPrint = 0;
                 uint32_t nowDebug = millis();
                 if (nowDebug - lastDebugPrint >= 5000) {
                     DEBUG("AudioCore1Manager: pAudioProcessor_->process(%s) futásidő: %s\n", collectOsci_ ? "true" : "false", Utils::elapsedUSecStr(t0, micros()).c_str());
+
+                    // Minta-alapú dekóder CPU terhelése az elmúlt időszakban
+                    AudioSampleDecoder *decoder = pAudioProcessor_->getSampleDecoder();
+                    if (decoder) {
+                        uint32_t busyMicros, sampleCount, overruns;
+                        pAudioProcessor_->takeDecoderLoadStats(busyMicros, sampleCount, overruns);
+                        uint32_t periodMicros = (nowDebug - lastDebugPrint) * 1000;
+                        float loadPercent = periodMicros > 0 ? (busyMicros * 100.0f) / periodMicros : 0.0f;
+                        float usPerSample = sampleCount > 0 ? static_cast<float>(busyMicros) / sampleCount : 0.0f;
+                        DEBUG("AudioCore1Manager: %s dekóder terhelés: %s%%, %s us/minta, túlcsordulás: %lu\n", decoder->getName(), Utils::floatToString(loadPercent).c_str(), Utils::floatToString(usPerSample).c_str(),
+                              overruns);
+                    }
+
+                    // Az osztályozás futásideje egy FFT keret idején belül kell maradjon
+                    if (pSignalClassifier_) {
+                        uint32_t maxCostMicros, frameMicros;
+                        pSignalClassifier_->takeCostStats(maxCostMicros, frameMicros);
+                        DEBUG("AudioCore1Manager: Jeltípus: %s (%u%%), osztályozás max. %lu us / FFT keret %lu us\n", SignalClassifier::getLabel(pSignalClassifier_->getSignalClass()), pSignalClassifier_->getConfidence(), maxCostMicros,
+                              frameMicros);
+                    }
                     lastDebugPrint = nowDebug;
                 }
 
@@ -202,14 +240,14 @@ void AudioCore1Manager::core1AudioLoop() {
                         uint16_t fftSize = pAudioProcessor_->getFftSize();
                         memcpy(pSharedData_->spectrumBuffer, magnitudeData, fftSize * sizeof(float));
                         pSharedData_->binWidthHz = pAudioProcessor_->getBinWidthHz();
-                        pSharedData_->currentAutoGain = pAudioProcessor_->getCurrentAutoGain();
+                        pSharedData_->currentAutoGain = pAudioProcessor_->getAppliedGain();
                         pSharedData_->spectrumDataReady = true;
 
                         // 2. A "nem-fogyasztó" cache a dekóderhez
                         memcpy(pSharedData_->latestSpectrumBuffer, magnitudeData, fftSize * sizeof(float));
                         pSharedData_->latestFftSize = fftSize;
                         pSharedData_->latestBinWidthHz = pAudioProcessor_->getBinWidthHz();
-                        pSharedData_->latestCurrentAutoGain = pAudioProcessor_->getCurrentAutoGain();
+                        pSharedData_->latestCurrentAutoGain = pAudioProcessor_->getAppliedGain();
                         pSharedData_->latestSpectrumDataAvailable = true;
 
                         if (!pSharedData_->configChanged) {
@@ -315,6 +353,80 @@ bool AudioCore1Manager::setFftSize(uint16_t newSize) {
     return false;
 }
 
+/**
+ * @brief Minta-alapú dekóder aktiválása a core1-en (core0-ból hívható)
+ * @param decoder A dekóder, vagy nullptr a kikapcsoláshoz
+ * @return true ha sikeres, false egyébként
+ */
+bool AudioCore1Manager::setSampleDecoder(AudioSampleDecoder *decoder) {
+    if (!initialized_ || !pSharedData_) {
+        return false;
+    }
+
+    // A dekóder váltás nem veszhet el (pl. képernyőváltáskor), ezért itt blokkolva várunk
+    mutex_enter_blocking(&pSharedData_->dataMutex);
+    pSharedData_->sampleDecoder = decoder;
+    pSharedData_->configChanged = true;
+    mutex_exit(&pSharedData_->dataMutex);
+    return true;
+}
+
+/**
+ * @brief A PSK31 dekóder példány lekérése, első híváskor létrehozása
+ * @return A dekóder pointere, vagy nullptr ha a foglalás sikertelen
+ */
+Psk31Decoder *AudioCore1Manager::getPsk31Decoder() {
+    if (!pPsk31Decoder_) {
+        pPsk31Decoder_ = new (std::nothrow) Psk31Decoder();
+        if (!pPsk31Decoder_) {
+            DEBUG("AudioCore1Manager: Psk31Decoder allokálás sikertelen!\n");
+        }
+    }
+    return pPsk31Decoder_;
+}
+
+/**
+ * @brief A CW skimmer példány lekérése, első híváskor létrehozása
+ * @return A skimmer pointere, vagy nullptr ha a foglalás sikertelen
+ */
+CwSkimmer *AudioCore1Manager::getCwSkimmer() {
+    if (!pCwSkimmer_) {
+        pCwSkimmer_ = new (std::nothrow) CwSkimmer();
+        if (!pCwSkimmer_) {
+            DEBUG("AudioCore1Manager: CwSkimmer allokálás sikertelen!\n");
+        }
+    }
+    return pCwSkimmer_;
+}
+
+/**
+ * @brief A NAVTEX dekóder példány lekérése, első híváskor létrehozása
+ * @return A dekóder pointere, vagy nullptr ha a foglalás sikertelen
+ */
+NavtexDecoder *AudioCore1Manager::getNavtexDecoder() {
+    if (!pNavtexDecoder_) {
+        pNavtexDecoder_ = new (std::nothrow) NavtexDecoder();
+        if (!pNavtexDecoder_) {
+            DEBUG("AudioCore1Manager: NavtexDecoder allokálás sikertelen!\n");
+        }
+    }
+    return pNavtexDecoder_;
+}
+
+/**
+ * @brief A WEFAX dekóder példány lekérése, első híváskor létrehozása
+ * @return A dekóder pointere, vagy nullptr ha a foglalás sikertelen
+ */
+WefaxDecoder *AudioCore1Manager::getWefaxDecoder() {
+    if (!pWefaxDecoder_) {
+        pWefaxDecoder_ = new (std::nothrow) WefaxDecoder();
+        if (!pWefaxDecoder_) {
+            DEBUG("AudioCore1Manager: WefaxDecoder allokálás sikertelen!\n");
+        }
+    }
+    return pWefaxDecoder_;
+}
+
 /**
  * @brief Audio konfiguráció frissítése
  */
@@ -338,6 +450,11 @@ void AudioCore1Manager::updateAudioConfig() {
         pAudioProcessor_->setSamplingFrequency(pSharedData_->samplingFrequency);
     }
 
+    // Minta-alapú dekóder váltása ha szükséges (a mintavételezési frekvencia után, hogy a dekóder már az újat kapja)
+    if (pAudioProcessor_->getSampleDecoder() != pSharedData_->sampleDecoder) {
+        pAudioProcessor_->setSampleDecoder(pSharedData_->sampleDecoder);
+    }
+
     pSharedData_->configChanged = false;
 }
 
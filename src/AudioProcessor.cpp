@@ -1,4 +1,6 @@
 #include <cmath> // std::abs, std::round
+#include <hardware/adc.h>
+#include <hardware/dma.h>
 
 #include "AudioProcessor.h"
 #include "defines.h"
@@ -6,6 +8,9 @@
 
 constexpr uint8_t NOISE_REDUCTION_ANALOG_SAMPLES_COUNT = 2; // Minta átlagolás zajcsökkentéshez
 
+// A folyamatos mintavételezés gyűrűs puffere (a DMA ring wrap miatt a méretére igazítva)
+static uint16_t captureRing[AudioProcessorConstants::CAPTURE_RING_SAMPLES] __attribute__((aligned(1u << AudioProcessorConstants::CAPTURE_RING_BITS)));
+
 /**
  * @brief AudioProcessor konstruktor - inicializálja az audio feldolgozó objektumot
  * @param gainConfigRef Referencia a gain konfigurációs értékre
@@ -23,7 +28,16 @@ AudioProcessor::AudioProcessor(float &gainConfigRef, uint8_t audioPin, uint16_t
       currentFftSize_(0),                                //
       vReal(nullptr),                                    //
       vImag(nullptr),                                    //
-      RvReal(nullptr) {
+      RvReal(nullptr),                                   //
+      sampleDecoder_(nullptr),                           //
+      dmaChannel_(-1),                                   //
+      continuousCapture_(false),                         //
+      captureReadIdx_(0),                                //
+      lastFeedMicros_(0),                                //
+      decoderBusyMicros_(0),                             //
+      decoderSampleCount_(0),                            //
+      decoderOverruns_(0),                               //
+      decoderLoadPercent_(0) {
 
     // FFT méret érvényesítése és beállítása
     if (!validateFftSize(fftSize)) {
@@ -47,6 +61,7 @@ AudioProcessor::AudioProcessor(float &gainConfigRef, uint8_t audioPin, uint16_t
 
     // Oszcilloszkóp minták inicializálása középpontra (ADC nyers érték)
     std::fill(osciSamples, osciSamples + AudioProcessorConstants::OSCI_SAMPLE_MAX_INTERNAL_WIDTH, 2048);
+    std::fill(envelope_, envelope_ + SignalClassifierConstants::ENVELOPE_BLOCKS, 0.0f);
 
     // Alacsony frekvenciás vágás binjének újraszámítása
     attenuation_cutoff_bin_ = static_cast<uint16_t>(AudioProcessorConstants::LOW_FREQ_ATTENUATION_THRESHOLD_HZ / binWidthHz_);
@@ -55,7 +70,10 @@ AudioProcessor::AudioProcessor(float &gainConfigRef, uint8_t audioPin, uint16_t
 /**
  * @brief AudioProcessor destruktor - felszabadítja az allokált memóriát
  */
-AudioProcessor::~AudioProcessor() { deallocateFftArrays(); }
+AudioProcessor::~AudioProcessor() {
+    stopContinuousCapture();
+    deallocateFftArrays();
+}
 
 /**
  * @brief Bin szélesség Hz-ben
@@ -147,6 +165,13 @@ bool AudioProcessor::setSamplingFrequency(uint16_t newFs) {
     targetSamplingFrequency_ = newFs;
     calculateBinWidthHz(); // Frissítjük a bin szélességet az új mintavételezési frekvenciával
 
+    // Folyamatos mintavételezésnél az ADC órajelét és a dekódert is át kell állítani
+    if (continuousCapture_) {
+        stopContinuousCapture();
+        sampleDecoder_->reset(targetSamplingFrequency_);
+        startContinuousCapture();
+    }
+
     DEBUG("AudioProcessor: Mintavételezési frekvencia beállítva %d Hz-re\n", (int)targetSamplingFrequency_);
 
     return true;
@@ -204,6 +229,151 @@ bool AudioProcessor::setFftSize(uint16_t newSize) {
     return true;
 }
 
+/**
+ * @brief Minta-alapú dekóder beállítása
+ * @param decoder Az új dekóder, vagy nullptr a kikapcsoláshoz
+ */
+void AudioProcessor::setSampleDecoder(AudioSampleDecoder *decoder) {
+
+    if (decoder == sampleDecoder_) {
+        return;
+    }
+
+    stopContinuousCapture();
+    sampleDecoder_ = decoder;
+
+    if (sampleDecoder_ != nullptr) {
+        sampleDecoder_->reset(targetSamplingFrequency_);
+        if (!startContinuousCapture()) {
+            DEBUG("AudioProcessor: Folyamatos mintavételezés indítása sikertelen, dekóder kikapcsolva\n");
+            sampleDecoder_ = nullptr;
+            return;
+        }
+        DEBUG("AudioProcessor: %s dekóder aktiválva\n", sampleDecoder_->getName());
+    }
+}
+
+/**
+ * @brief Folyamatos ADC mintavételezés indítása (ADC FIFO + DMA a gyűrűs pufferbe)
+ * @return true ha sikeres
+ */
+bool AudioProcessor::startContinuousCapture() {
+
+    if (continuousCapture_) {
+        return true;
+    }
+
+    if (dmaChannel_ < 0) {
+        dmaChannel_ = dma_claim_unused_channel(false);
+        if (dmaChannel_ < 0) {
+            DEBUG("AudioProcessor: Nincs szabad DMA csatorna\n");
+            return false;
+        }
+    }
+
+    // Az ADC-t az Arduino core már inicializálhatta (analogRead), ilyenkor nem nyúlunk hozzá
+    if ((adc_hw->cs & ADC_CS_EN_BITS) == 0) {
+        adc_init();
+    }
+    adc_gpio_init(audioInputPin);
+    adc_select_input(audioInputPin - 26); // GPIO26 = ADC0
+    adc_fifo_setup(true,  // FIFO engedélyezése
+                   true,  // DMA kérés (DREQ) engedélyezése
+                   1,     // DREQ már 1 minta esetén
+                   false, // Hibabit nélkül
+                   false  // 12 bites minták (nincs 8 bitre léptetés)
+    );
+    adc_set_clkdiv(static_cast<float>(AudioProcessorConstants::ADC_CLOCK_HZ) / targetSamplingFrequency_ - 1.0f);
+    adc_fifo_drain();
+
+    dma_channel_config cfg = dma_channel_get_default_config(dmaChannel_);
+    channel_config_set_transfer_data_size(&cfg, DMA_SIZE_16);
+    channel_config_set_read_increment(&cfg, false);
+    channel_config_set_write_increment(&cfg, true);
+    channel_config_set_dreq(&cfg, DREQ_ADC);
+    channel_config_set_ring(&cfg, true, AudioProcessorConstants::CAPTURE_RING_BITS); // Az írási cím körbefordul a pufferen
+    dma_channel_configure(dmaChannel_, &cfg, captureRing, &adc_hw->fifo, 0xFFFFFFFF, true);
+
+    captureReadIdx_ = 0;
+    lastFeedMicros_ = micros();
+    continuousCapture_ = true;
+    adc_run(true);
+
+    DEBUG("AudioProcessor: Folyamatos mintavételezés elindítva (DMA ch%d, %d Hz)\n", dmaChannel_, targetSamplingFrequency_);
+    return true;
+}
+
+/**
+ * @brief Folyamatos ADC mintavételezés leállítása, az ADC visszaállítása egyedi konverziós módba
+ */
+void AudioProcessor::stopContinuousCapture() {
+
+    if (!continuousCapture_) {
+        return;
+    }
+
+    adc_run(false);
+    dma_channel_abort(dmaChannel_);
+    adc_fifo_drain();
+    adc_fifo_setup(false, false, 0, false, false);
+    adc_set_clkdiv(0); // Az analogRead()-nek szabadon futó órajel kell
+    continuousCapture_ = false;
+}
+
+/**
+ * @brief A DMA aktuális írási pozíciója a gyűrűs pufferben
+ * @return Mintaindex (0 ... CAPTURE_RING_SAMPLES-1)
+ */
+uint16_t AudioProcessor::getCaptureWriteIndex() const {
+    uint32_t writeAddr = dma_channel_hw_addr(dmaChannel_)->write_addr;
+    return ((writeAddr - reinterpret_cast<uint32_t>(captureRing)) / sizeof(uint16_t)) & (AudioProcessorConstants::CAPTURE_RING_SAMPLES - 1);
+}
+
+/**
+ * @brief A legutóbbi etetés óta beérkezett minták átadása a dekódernek
+ * @param writeIdx A DMA aktuális írási pozíciója
+ */
+void AudioProcessor::feedSampleDecoder(uint16_t writeIdx) {
+
+    uint32_t startMicros = micros();
+
+    // Ha a legutóbbi etetés óta több idő telt el, mint amennyit a puffer tárolni tud, minták vesztek el
+    uint32_t ringDurationMicros = (static_cast<uint32_t>(AudioProcessorConstants::CAPTURE_RING_SAMPLES) * ONE_SECOND_IN_MICROS) / targetSamplingFrequency_;
+    uint32_t feedPeriodMicros = startMicros - lastFeedMicros_;
+    bool overrun = feedPeriodMicros >= ringDurationMicros;
+    if (overrun) {
+        decoderOverruns_++;
+        captureReadIdx_ = (writeIdx + 1) & (AudioProcessorConstants::CAPTURE_RING_SAMPLES - 1); // A legrégebbi még érvényes minta
+    }
+    lastFeedMicros_ = startMicros;
+
+    uint16_t count = 0;
+    while (captureReadIdx_ != writeIdx) {
+        sampleDecoder_->processSample(static_cast<int16_t>(captureRing[captureReadIdx_] & 0x0FFF) - 2048);
+        captureReadIdx_ = (captureReadIdx_ + 1) & (AudioProcessorConstants::CAPTURE_RING_SAMPLES - 1);
+        count++;
+    }
+
+    uint32_t busyMicros = micros() - startMicros;
+    decoderSampleCount_ += count;
+    decoderBusyMicros_ += busyMicros;
+
+    // Pillanatnyi terhelés a dekóder saját terheléskorlátozásához (túlcsordulás = túlterhelés)
+    decoderLoadPercent_ = (overrun || feedPeriodMicros == 0) ? 100 : static_cast<uint8_t>(std::min<uint32_t>(100, busyMicros * 100 / feedPeriodMicros));
+}
+
+/**
+ * @brief A dekóder CPU terhelési statisztikájának kiolvasása és nullázása
+ */
+void AudioProcessor::takeDecoderLoadStats(uint32_t &outBusyMicros, uint32_t &outSampleCount, uint32_t &outOverruns) {
+    outBusyMicros = decoderBusyMicros_;
+    outSampleCount = decoderSampleCount_;
+    outOverruns = decoderOverruns_;
+    decoderBusyMicros_ = 0;
+    decoderSampleCount_ = 0;
+    decoderOverruns_ = 0;
+}
+
 /**
  * @brief Fő audio feldolgozó függvény - mintavételezés, FFT számítás és spektrum analízis
  * @param collectOsciSamples true ha oszcilloszkóp mintákat is gyűjteni kell
@@ -217,6 +387,17 @@ void AudioProcessor::process(bool collectOsciSamples) {
     const bool isManualGain = activeFftGainConfigRef > 0.0f;
     const bool isAutoGain = activeFftGainConfigRef == 0.0f;
 
+    // Folyamatos mintavételezésnél először a dekóder kapja meg a beérkezett mintákat
+    uint16_t captureWriteIdx = 0;
+    if (continuousCapture_) {
+        // Ha a DMA számláló valaha lefutna, újraindítjuk
+        if (!dma_channel_is_busy(dmaChannel_)) {
+            dma_channel_set_trans_count(dmaChannel_, 0xFFFFFFFF, true);
+        }
+        captureWriteIdx = getCaptureWriteIndex();
+        feedSampleDecoder(captureWriteIdx);
+    }
+
     // Ha az FFT ki van kapcsolva (-1.0f), akkor töröljük a puffereket és visszatérünk
     if (activeFftGainConfigRef == -1.0f) {
         memset(RvReal, 0, currentFftSize_ * sizeof(float)); // Magnitúdó buffer törlése
@@ -230,19 +411,32 @@ void AudioProcessor::process(bool collectOsciSamples) {
 
     // 1. Mintavételezés és középre igazítás, opcionális oszcilloszkóp mintagyűjtés
     // A teljes mintavételezési ciklus idejét is mérhetnénk, de az egyes minták időzítése fontosabb.
+    // Folyamatos mintavételezésnél nincs várakozás: a gyűrűs puffer utolsó FFT-nyi mintáját használjuk.
+    uint16_t ringIdx = (captureWriteIdx - currentFftSize_) & (AudioProcessorConstants::CAPTURE_RING_SAMPLES - 1);
     uint32_t nextSampleTime = micros();
+
+    // Burkoló részblokkok a jeltípus osztályozóhoz: a DC mentes minták összege és négyzetösszege
+    const uint16_t envBlockLength = currentFftSize_ / SignalClassifierConstants::ENVELOPE_BLOCKS;
+    float envSum[SignalClassifierConstants::ENVELOPE_BLOCKS] = {};
+    float envSumSq[SignalClassifierConstants::ENVELOPE_BLOCKS] = {};
     for (uint16_t i = 0; i < currentFftSize_; i++) {
-        // Pontos időzítés a mintavételezési frekvencia betartásához
-        while (micros() < nextSampleTime) {
-            // busy wait a CPU magon, ez itt elfogadható, mert a Core1 dedikált
-        }
-        nextSampleTime += sampleIntervalMicros_;
+        float averaged_sample;
+        if (continuousCapture_) {
+            averaged_sample = static_cast<float>(captureRing[ringIdx] & 0x0FFF);
+            ringIdx = (ringIdx + 1) & (AudioProcessorConstants::CAPTURE_RING_SAMPLES - 1);
+        } else {
+            // Pontos időzítés a mintavételezési frekvencia betartásához
+            while (micros() < nextSampleTime) {
+                // busy wait a CPU magon, ez itt elfogadható, mert a Core1 dedikált
+            }
+            nextSampleTime += sampleIntervalMicros_;
 
-        uint32_t sum = 0;
-        for (uint8_t j = 0; j < NOISE_REDUCTION_ANALOG_SAMPLES_COUNT; j++) {
-            sum += analogRead(audioInputPin);
+            uint32_t sum = 0;
+            for (uint8_t j = 0; j < NOISE_REDUCTION_ANALOG_SAMPLES_COUNT; j++) {
+                sum += analogRead(audioInputPin);
+            }
+            averaged_sample = sum / (float)NOISE_REDUCTION_ANALOG_SAMPLES_COUNT;
         }
-        float averaged_sample = sum / (float)NOISE_REDUCTION_ANALOG_SAMPLES_COUNT;
 
         // Oszcilloszkóp minta gyűjtése ha szükséges (decimation factor 2 hatványa: bitmaszk)
         if (collectOsciSamples) {
@@ -256,6 +450,9 @@ void AudioProcessor::process(bool collectOsciSamples) {
 
         // DC-offset eltávolítása és manuális erősítés alkalmazása egy lépésben
         float sample = averaged_sample - 2048.0f;
+        const uint8_t envBlock = i / envBlockLength;
+        envSum[envBlock] += sample;
+        envSumSq[envBlock] += sample * sample;
         if (isManualGain) {
             vReal[i] = sample * activeFftGainConfigRef;
         } else {
@@ -276,6 +473,17 @@ void AudioProcessor::process(bool collectOsciSamples) {
     // Oszcilloszkóp mintaszám csak a ciklus végén
     osciSampleCount = osci_sample_idx;
 
+    // Részblokkonkénti RMS a keret átlagára vonatkoztatva (a névleges 2048-tól eltérő DC sem torzít)
+    float frameSum = 0.0f;
+    for (uint8_t b = 0; b < SignalClassifierConstants::ENVELOPE_BLOCKS; b++) {
+        frameSum += envSum[b];
+    }
+    const float frameMean = frameSum / currentFftSize_;
+    for (uint8_t b = 0; b < SignalClassifierConstants::ENVELOPE_BLOCKS; b++) {
+        const float power = (envSumSq[b] - 2.0f * frameMean * envSum[b]) / envBlockLength + frameMean * frameMean;
+        envelope_[b] = sqrtf(std::max(power, 0.0f));
+    }
+
     // 2. Automatikus erősítés alkalmazása (ha aktív)
     if (isAutoGain) {
 
@@ -316,4 +524,9 @@ void AudioProcessor::process(bool collectOsciSamples) {
     for (uint16_t i = 0; i < attenuation_cutoff_bin_ && i < (currentFftSize_ / 2); ++i) {
         RvReal[i] /= AudioProcessorConstants::LOW_FREQ_ATTENUATION_FACTOR;
     }
+
+    // 5. A spektrum alapú jelkeresést végző dekóderek is megkapják az eredményt
+    if (continuousCapture_) {
+        sampleDecoder_->processSpectrum(RvReal, currentFftSize_, binWidthHz_, decoderLoadPercent_);
+    }
 }
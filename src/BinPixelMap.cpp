@@ -0,0 +1,43 @@
+#include "BinPixelMap.h"
+#include <cmath>
+
+/**
+ * @brief Konstruktor: üres tábla, az első update() felépíti
+ */
+BinPixelMap::BinPixelMap()
+    : slots_(0),                           //
+      fftSize_(0),                         //
+      binWidthHz_(0.0f),                   //
+      minFreqHz_(0.0f),                    //
+      maxFreqHz_(0.0f),                    //
+      minBinLimit_(0),                     //
+      aggregation_(BinAggregation::Max) {}
+
+/**
+ * @brief A tábla frissítése (csak ha a paraméterek változtak)
+ */
+void BinPixelMap::update(uint16_t slots, float minFreqHz, float maxFreqHz, uint16_t minBinLimit, uint16_t fftSize, float binWidthHz, BinAggregation aggregation) {
+    if (slots_ == slots && fftSize_ == fftSize && binWidthHz_ == binWidthHz && minFreqHz_ == minFreqHz && maxFreqHz_ == maxFreqHz && minBinLimit_ == minBinLimit &&
+        aggregation_ == aggregation) {
+        return;
+    }
+    slots_ = slots;
+    fftSize_ = fftSize;
+    binWidthHz_ = binWidthHz;
+    minFreqHz_ = minFreqHz;
+    maxFreqHz_ = maxFreqHz;
+    minBinLimit_ = minBinLimit;
+    aggregation_ = aggregation;
+
+    const int lastUsableBin = fftSize / 2 - 1;
+    const int minBin = std::min(lastUsableBin, std::max(static_cast<int>(minBinLimit), static_cast<int>(std::round(minFreqHz / binWidthHz))));
+    const int maxBin = std::max(minBin, std::min(lastUsableBin, static_cast<int>(std::round(maxFreqHz / binWidthHz))));
+    const uint32_t numBins = maxBin - minBin + 1;
+
+    // Az i. egység első binje: ceil(i * numBins / slots), így egy bin pontosan egy egységhez tartozik
+    firstBin_.resize(slots + 1);
+    for (uint32_t i = 0; i < slots; i++) {
+        firstBin_[i] = std::min(maxBin, minBin + static_cast<int>((i * numBins + slots - 1) / slots));
+    }
+    firstBin_[slots] = maxBin + 1;
+}
@@ -24,6 +24,10 @@ const Config_t DEFAULT_CONFIG = {
     .currentSquelch = 0,     // Squelch szint (0...50)
     .squelchUsesRSSI = true, // A squlech RSSI alapú legyen?
 
+    // Seek küszöbök
+    .seekRssiThresholdFM = 2, // 2 dBuV
+    .seekSnrThresholdFM = 2,  // 2 dB
+
     // FM RDS
     .rdsEnabled = true,
 
@@ -53,14 +57,29 @@ const Config_t DEFAULT_CONFIG = {
     .miniAudioFftConfigRtty = 0.0f,     // RTTY-hez alapértelmezetten Auto Gain
 
     // CW és RTTY beállítások
-    .cwReceiverOffsetHz = 900,   // x Hz CW offset
-    .rttyMarkFrequencyHz = 2125, // RTTY Mark frequency
-    .rttyShiftHz = 170,          // RTTY Shift
+    .cwReceiverOffsetHz = 900,       // x Hz CW offset
+    .rttyMarkFrequencyHz = 2125,     // RTTY Mark frequency
+    .rttyShiftHz = 170,              // RTTY Shift
+    .pskCarrierFrequencyHz = 1000,   // PSK31 vivő frekvencia
+    .navtexCenterFrequencyHz = 1000, // NAVTEX középfrekvencia (pl. 517 kHz USB -> 518 kHz NAVTEX)
+    .wefaxSlantPpm = 0,              // WEFAX ferdeség korrekció
 
     // Audio processing alapértelmezett beállítások
     .audioModeAM = 1, // AudioComponentType::SPECTRUM_LOW_RES
     .audioModeFM = 1, // AudioComponentType::SPECTRUM_LOW_RES
                       // .audioFftGain = 1.0f, // Alapértelmezett FFT erősítés
+
+    // Waterfall megjelenítés
+    .waterfallPalette = 0, // WaterfallPaletteType::Classic
+
+    // Spektrum nyomvonalak
+    .spectrumTraces = 0,          // Nincs nyomvonal
+    .traceAverageMs = 1000,       // 1 s átlagolás
+    .tracePeakDecayDbPerSec = 10, // 10 dB/s lecsengés
+
+    // Spektrum amplitúdó skála
+    .spectrumLogScale = true, // dBFS skála
+    .spectrumDbRange = 50,    // 50 dB tartomány
 };
 
 // Globális konfiguráció példány
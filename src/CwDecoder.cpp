@@ -1,9 +1,40 @@
 #include "CwDecoder.h"
+#include "Band.h"
 #include "Config.h"
 #include "defines.h"
 #include "utils.h"
 #include <cmath>
 
+// AFC paraméterek
+namespace CwAfcConstants {
+constexpr float SEARCH_MIN_HALF_SPAN_HZ = 300.0f; // Befogás: legalább a CW offset +-300 Hz-es környezete (a hangolássegéd teljes szélessége)
+constexpr float SEARCH_MIN_FREQ_HZ = 150.0f;      // Befogás: ez alatt nem keresünk (DC, brumm)
+constexpr float TRACK_HALF_SPAN_HZ = 100.0f;      // Zárt állapot: keresési ablak a követett frekvencia körül
+constexpr float TRACK_TOLERANCE_HZ = 60.0f;       // Zárt állapot: ennél távolabbi csúcs nem a követett hang
+constexpr float CANDIDATE_TOLERANCE_HZ = 25.0f;   // A jelölt ennyit mozoghat két észlelés között
+constexpr float CANDIDATE_ALPHA = 0.3f;           // A jelölt frekvencia simítása
+constexpr float TRACK_ALPHA = 0.02f;              // Lassú frekvenciakövetés zárt állapotban
+constexpr uint8_t ACQUIRE_MIN_HITS = 10;          // Ennyi megerősítés kell a záráshoz
+constexpr unsigned long ACQUIRE_MIN_MS = 1000;    // ... és legalább ennyi ideig tartó jelenlét
+constexpr unsigned long LOST_TIMEOUT_MS = 5000;   // Ennyi ideig nem látott hang után újra keresünk
+constexpr float NARROW_SIDE_MIN_HZ = 50.0f;       // Keskenysávúság: a csúcs ennyire lévő oldalsávjai...
+constexpr float NARROW_SIDE_MAX_HZ = 80.0f;       // ... eddig a távolságig átlagolva
+constexpr float NARROW_PEAK_FACTOR = 3.0f;        // ... legalább ennyiszer gyengébbek a csúcsnál
+} // namespace CwAfcConstants
+
+/**
+ * @brief Befogáskor a keresési ablak fél szélessége: az aktuális CW/SSB szűrő sávszélességének fele
+ * @details Így a szűrő áteresztő sávjában bárhol lévő hang befogható, nem csak a hangolássegéd szélességén belül
+ */
+static float acquisitionHalfSpanHz() {
+    for (const BandWidth &bandWidth : Band::bandWidthSSB) {
+        if (bandWidth.index == config.data.bwIdxSSB) {
+            return std::max(CwAfcConstants::SEARCH_MIN_HALF_SPAN_HZ, static_cast<float>(atof(bandWidth.label)) * 1000.0f / 2.0f);
+        }
+    }
+    return CwAfcConstants::SEARCH_MIN_HALF_SPAN_HZ;
+}
+
 CwDecoder::CwDecoder() { clear(); }
 
 /**
@@ -27,21 +58,42 @@ void CwDecoder::clear() {
     sampleCount = 0;
     freqInRange_ = false;
     memset(sampleBuf, 0, sizeof(sampleBuf));
+    resetAfc();
+}
+
+/**
+ * AFC alaphelyzetbe állítása, új befogás indul (pl. áthangolás után)
+ */
+void CwDecoder::resetAfc() {
+    afcLocked_ = false;
+    afcFrequencyHz_ = 0.0f;
+    afcCandidateHz_ = 0.0f;
+    afcHits_ = 0;
+    afcCandidateSinceMs_ = 0;
+    afcLastSeenMs_ = 0;
 }
 
 /**
  * dekódolt szöveg visszaadása
  */
-String CwDecoder::getDecodedText() { return decodedText; }
+bool CwDecoder::takeDecodedText(String &out) {
+    if (decodedText.length() == 0) {
+        return false;
+    }
+    out = decodedText;
+    decodedText = "";
+    return true;
+}
 
 void CwDecoder::detectTone(const float *fftData, uint16_t fftSize, float binWidth) {
 
-    // Lekérjük CW a középfrekvenciát a konfigurációból
-    uint16_t centerFreqHz = config.data.cwReceiverOffsetHz;
+    // Lekérjük CW a középfrekvenciát a konfigurációból, AFC zárás esetén a követett frekvenciát használjuk
+    float centerFreqHz = afcLocked_ ? afcFrequencyHz_ : config.data.cwReceiverOffsetHz;
 
-    constexpr uint16_t SEARCH_WINDOW_HZ = 200; // +-200 Hz keresési ablak a bin-ek körül
-    uint16_t startFreqHz = (centerFreqHz > SEARCH_WINDOW_HZ) ? (centerFreqHz - SEARCH_WINDOW_HZ) : 0;
-    uint16_t endFreqHz = centerFreqHz + SEARCH_WINDOW_HZ;
+    // Keresési ablak: AFC befogáskor a szűrő teljes áteresztő sávja, zárt AFC-nél szűkebb
+    float searchWindowHz = afcLocked_ ? CwAfcConstants::TRACK_HALF_SPAN_HZ : acquisitionHalfSpanHz();
+    uint16_t startFreqHz = static_cast<uint16_t>(std::max(centerFreqHz - searchWindowHz, CwAfcConstants::SEARCH_MIN_FREQ_HZ));
+    uint16_t endFreqHz = static_cast<uint16_t>(centerFreqHz + searchWindowHz);
 
     // Keresés a megadott frekvencia ablakban
     int startBin = static_cast<int>(startFreqHz / binWidth);
@@ -62,6 +114,17 @@ void CwDecoder::detectTone(const float *fftData, uint16_t fftSize, float binWidt
     peakMagnitude_ = maxMagnitude;                                    // Legnagyobb amplitúdó érték
     peakFrequencyHz_ = (peakBin != -1) ? (peakBin * binWidth) : 0.0f; // Detektált csúcsfrekvencia
 
+    // Parabolikus interpoláció a szomszédos binekkel: bin alatti pontosság az AFC-hez
+    if (peakBin > 0 && peakBin < (int)fftSize / 2 - 1) {
+        float left = fftData[peakBin - 1];
+        float right = fftData[peakBin + 1];
+        float denom = left - 2.0f * maxMagnitude + right;
+        if (denom < 0.0f) {
+            float delta = constrain(0.5f * (left - right) / denom, -0.5f, 0.5f);
+            peakFrequencyHz_ = (peakBin + delta) * binWidth;
+        }
+    }
+
     // --- Noise level számítása: ablak összes binjének átlaga, csúcs bin kihagyásával ---
     float noiseSum = 0.0f;
     int noiseCount = 0;
@@ -109,11 +172,33 @@ void CwDecoder::detectTone(const float *fftData, uint16_t fftSize, float binWidt
     constexpr float FREQ_TOLERANCE_HZ = 120.0f;        // tolerancia a frekvencia eltérésre (közepes)
     constexpr float NOISE_THRESHOLD_MULTIPLIER = 2.0f; // legalább 2x a zaj szintjéhez képest a jel (stabilabb)
     // Hiszterézis visszaállítása
-    freqInRange_ = std::abs(peakFrequencyHz_ - centerFreqHz) <= FREQ_TOLERANCE_HZ;
+    float freqToleranceHz = afcLocked_ ? CwAfcConstants::TRACK_TOLERANCE_HZ : FREQ_TOLERANCE_HZ;
+    freqInRange_ = std::abs(peakFrequencyHz_ - centerFreqHz) <= freqToleranceHz;
     bool peakIsStrong = peakMagnitude_ > measuredNoise * NOISE_THRESHOLD_MULTIPLIER;
     bool aboveOnThreshold = peakMagnitude_ > (noiseLevel_ * NOISE_FLOOR_FACTOR_ON);
     bool aboveOffThreshold = peakMagnitude_ > (noiseLevel_ * NOISE_FLOOR_FACTOR_OFF);
 
+    // AFC: csak keskenysávú (vivő jellegű) csúcsot fogadunk el, a széles zajpúpokat nem
+    bool peakIsNarrow = false;
+    if (peakBin != -1 && binWidth > 0.0f) {
+        int sideMinBins = std::max(1, static_cast<int>(std::lround(CwAfcConstants::NARROW_SIDE_MIN_HZ / binWidth)));
+        int sideMaxBins = std::max(sideMinBins, static_cast<int>(std::lround(CwAfcConstants::NARROW_SIDE_MAX_HZ / binWidth)));
+        float sideSum = 0.0f;
+        int sideCount = 0;
+        for (int d = sideMinBins; d <= sideMaxBins; ++d) {
+            if (peakBin - d >= 0) {
+                sideSum += fftData[peakBin - d];
+                ++sideCount;
+            }
+            if (peakBin + d < (int)fftSize / 2) {
+                sideSum += fftData[peakBin + d];
+                ++sideCount;
+            }
+        }
+        peakIsNarrow = sideCount > 0 && peakMagnitude_ > CwAfcConstants::NARROW_PEAK_FACTOR * (sideSum / sideCount);
+    }
+    updateAfc(peakIsStrong && aboveOnThreshold && peakIsNarrow);
+
     // DEBUG minden kritikus értékre
     // DEBUG("[CW] peakFreq: %s Hz, peakMag: %s, noise: %s, th_on: %s, th_off: %s, freqInRange: %d, peakIsStrong: %d\n", Utils::floatToString(peakFrequencyHz_).c_str(), Utils::floatToString(peakMagnitude_).c_str(),
     //       Utils::floatToString(noiseLevel_).c_str(), Utils::floatToString(noiseLevel_ * NOISE_FLOOR_FACTOR_ON).c_str(), Utils::floatToString(noiseLevel_ * NOISE_FLOOR_FACTOR_OFF).c_str(), freqInRange, peakIsStrong);
@@ -127,6 +212,52 @@ void CwDecoder::detectTone(const float *fftData, uint16_t fftSize, float binWidt
     }
 }
 
+/**
+ * AFC állapotgép: befogás (a legerősebb, tartósan jelenlévő keskenysávú csúcs) és lassú követés
+ * @param peakIsValid Az aktuális csúcs elég erős és keskenysávú-e
+ */
+void CwDecoder::updateAfc(bool peakIsValid) {
+
+    unsigned long now = millis();
+
+    if (!afcLocked_) {
+        // Befogás: a jelöltnek tartósan, közel azonos frekvencián kell megjelennie
+        // (a billentyűzés szünetei nem számítanak, csak az ütköző csúcsok gyengítik)
+        if (!peakIsValid) {
+            return;
+        }
+        if (afcHits_ > 0 && std::abs(peakFrequencyHz_ - afcCandidateHz_) <= CwAfcConstants::CANDIDATE_TOLERANCE_HZ) {
+            afcCandidateHz_ += CwAfcConstants::CANDIDATE_ALPHA * (peakFrequencyHz_ - afcCandidateHz_);
+            if (afcHits_ < UINT8_MAX) {
+                afcHits_++;
+            }
+        } else if (afcHits_ > 0) {
+            afcHits_--;
+        } else {
+            afcCandidateHz_ = peakFrequencyHz_;
+            afcCandidateSinceMs_ = now;
+            afcHits_ = 1;
+        }
+
+        if (afcHits_ >= CwAfcConstants::ACQUIRE_MIN_HITS && now - afcCandidateSinceMs_ >= CwAfcConstants::ACQUIRE_MIN_MS) {
+            afcLocked_ = true;
+            afcFrequencyHz_ = afcCandidateHz_;
+            afcLastSeenMs_ = now;
+            DEBUG("[CW] AFC zárás: %s Hz\n", Utils::floatToString(afcFrequencyHz_).c_str());
+        }
+        return;
+    }
+
+    // Követés: csak a zárt frekvencia közelében lévő hangot követjük, lassan
+    if (peakIsValid && freqInRange_) {
+        afcFrequencyHz_ += CwAfcConstants::TRACK_ALPHA * (peakFrequencyHz_ - afcFrequencyHz_);
+        afcLastSeenMs_ = now;
+    } else if (now - afcLastSeenMs_ > CwAfcConstants::LOST_TIMEOUT_MS) {
+        DEBUG("[CW] AFC zárás elveszett (%s Hz), újra keresés\n", Utils::floatToString(afcFrequencyHz_).c_str());
+        resetAfc();
+    }
+}
+
 /**
  * Fő jelfeldolgozó függvény: FFT adatokból morze jelek detektálása és állapotgép futtatása
  * @param fftData FFT amplitúdó tömb
@@ -294,6 +425,10 @@ char CwDecoder::decodeMorse(const String &morse) {
 void CwDecoder::pushSymbol(char symbol) { currentSymbol += symbol; }
 
 void CwDecoder::pushChar(char c) {
+    constexpr uint16_t PENDING_TEXT_MAX_LENGTH = 128; // Ha senki nem veszi át, a legrégebbi karakterek elvesznek
+    if (decodedText.length() >= PENDING_TEXT_MAX_LENGTH) {
+        decodedText.remove(0, 1);
+    }
     if (c == ' ') {
         decodedText += ' ';
     } else if (c != '?' && c != '\0') {
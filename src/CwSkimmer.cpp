@@ -0,0 +1,459 @@
+#include "CwSkimmer.h"
+#include "AudioProcessor.h"
+#include "defines.h"
+#include <cmath>
+
+namespace {
+
+// Burkoló és billentyű detektálás (blokkonként)
+constexpr float NOISE_FALL_ALPHA = 0.1f;   // A zajszint gyorsan követi a csökkenést...
+constexpr float NOISE_RISE_ALPHA = 0.002f; // ... és lassan a növekedést (a hosszú vonások ne emeljék meg)
+constexpr float PEAK_DECAY_ALPHA = 0.002f; // A csúcsszint lassú visszaengedése a zajszint felé
+constexpr float MIN_SNR = 3.0f;            // Csúcs / zaj arány, ez alatt a csatorna "csendes"
+constexpr float KEY_ON_LEVEL = 0.6f;       // Bekapcsolási küszöb a zaj és a csúcs között (hiszterézis)
+constexpr float KEY_OFF_LEVEL = 0.4f;      // Kikapcsolási küszöb
+
+// Időzítés (pont hosszban kifejezve)
+constexpr float DASH_THRESHOLD = 2.0f;     // Ennél hosszabb hang vonás
+constexpr float CHAR_GAP_THRESHOLD = 2.0f; // Ennél hosszabb szünet karakterhatár
+constexpr float WORD_GAP_THRESHOLD = 5.0f; // Ennél hosszabb szünet szóköz
+constexpr float DOT_ALPHA = 0.1f;          // Pont hossz adaptáció
+constexpr float MIN_DOT_MS = 20.0f;        // ~60 WPM
+constexpr float MAX_DOT_MS = 200.0f;       // ~6 WPM
+constexpr float INITIAL_DOT_MS = 60.0f;    // ~20 WPM
+constexpr uint8_t MAX_SYMBOL_ELEMENTS = 6; // A morze tábla mérete miatt
+
+constexpr float FREQUENCY_TRACK_ALPHA = 0.2f; // A csatorna frekvencia követése a spektrum csúcsaihoz
+
+/**
+ * Morze kódok (a tábla indexe: vezető 1-es bit, utána pont=0, vonás=1)
+ */
+struct MorseEntry {
+    const char *code;
+    char c;
+};
+const MorseEntry MORSE_CODES[] = {
+    {".-", 'A'},     {"-...", 'B'},   {"-.-.", 'C'},   {"-..", 'D'},    {".", 'E'},      {"..-.", 'F'},   {"--.", 'G'},    {"....", 'H'},    {"..", 'I'},     {".---", 'J'},
+    {"-.-", 'K'},    {".-..", 'L'},   {"--", 'M'},     {"-.", 'N'},     {"---", 'O'},    {".--.", 'P'},   {"--.-", 'Q'},   {".-.", 'R'},     {"...", 'S'},    {"-", 'T'},
+    {"..-", 'U'},    {"...-", 'V'},   {".--", 'W'},    {"-..-", 'X'},   {"-.--", 'Y'},   {"--..", 'Z'},   {"-----", '0'},  {".----", '1'},   {"..---", '2'},  {"...--", '3'},
+    {"....-", '4'},  {".....", '5'},  {"-....", '6'},  {"--...", '7'},  {"---..", '8'},  {"----.", '9'},  {".-.-.-", '.'}, {"--..--", ','},  {"..--..", '?'}, {"-..-.", '/'},
+    {"-...-", '='},  {".-.-.", '+'},  {"-....-", '-'}, {"---...", ':'}, {"-.--.", '('},  {"-.--.-", ')'}, {".----.", '\''}, {".--.-.", '@'},
+};
+} // namespace
+
+int16_t CwSkimmer::sinTable_[CwSkimmer::NCO_TABLE_SIZE];
+char CwSkimmer::morseTable_[128];
+bool CwSkimmer::tablesReady_ = false;
+
+/**
+ * @brief Konstruktor
+ */
+CwSkimmer::CwSkimmer() : activeCount_(0), channelLimit_(CwSkimmerConstants::MAX_CHANNELS), lowLoadSpectra_(0), changeCounter_(0) {
+    initTables();
+    reset(AudioProcessorConstants::DEFAULT_AM_SAMPLING_FREQUENCY);
+}
+
+/**
+ * @brief Az NCO szinusz tábla (Q12) és a morze tábla egyszeri feltöltése
+ */
+void CwSkimmer::initTables() {
+    if (tablesReady_) {
+        return;
+    }
+    for (uint16_t i = 0; i < NCO_TABLE_SIZE; i++) {
+        sinTable_[i] = static_cast<int16_t>(std::lround(4096.0f * sinf(TWO_PI * i / NCO_TABLE_SIZE)));
+    }
+    memset(morseTable_, 0, sizeof(morseTable_));
+    for (const MorseEntry &entry : MORSE_CODES) {
+        uint8_t code = 1;
+        for (const char *p = entry.code; *p; ++p) {
+            code = (code << 1) | (*p == '-' ? 1 : 0);
+        }
+        morseTable_[code] = entry.c;
+    }
+    tablesReady_ = true;
+}
+
+/**
+ * @brief Alaphelyzet: minden csatorna felszabadítása, a blokkhossz újraszámítása
+ * @param samplingFrequency Az aktuális mintavételezési frekvencia Hz-ben
+ */
+void CwSkimmer::reset(uint16_t samplingFrequency) {
+
+    samplingFrequency_ = samplingFrequency > 0 ? samplingFrequency : AudioProcessorConstants::DEFAULT_AM_SAMPLING_FREQUENCY;
+    blockSamples_ = std::max(1, static_cast<int>(samplingFrequency_) * CwSkimmerConstants::BLOCK_MS / 1000);
+    blockMs_ = static_cast<float>(blockSamples_) * 1000.0f / samplingFrequency_;
+    blockCount_ = 0;
+
+    for (Channel &ch : channels_) {
+        ch.active = false;
+        ch.confirmed = false;
+    }
+    activeCount_ = 0;
+    channelLimit_ = CwSkimmerConstants::MAX_CHANNELS;
+    lowLoadSpectra_ = 0;
+    changeCounter_++;
+
+    DEBUG("CwSkimmer::reset() -> Fs: %u Hz, blokk: %u minta, csatornák: %u\n", samplingFrequency_, blockSamples_, CwSkimmerConstants::MAX_CHANNELS);
+}
+
+/**
+ * @brief Egy audio minta feldolgozása: minden aktív csatorna NCO keverése és blokk integrálása
+ */
+void CwSkimmer::processSample(int16_t sample) {
+
+    if (activeCount_ == 0) {
+        return;
+    }
+
+    int32_t s = sample;
+    for (uint8_t k = 0; k < activeCount_; k++) {
+        Channel &ch = channels_[activeSlots_[k]];
+        ch.ncoPhase += ch.ncoIncrement;
+        uint8_t idx = ch.ncoPhase >> 24;
+        ch.accI += s * sinTable_[static_cast<uint8_t>(idx + NCO_TABLE_SIZE / 4)];
+        ch.accQ += s * sinTable_[idx];
+    }
+
+    if (++blockCount_ >= blockSamples_) {
+        blockCount_ = 0;
+        for (uint8_t k = 0; k < activeCount_; k++) {
+            processBlock(channels_[activeSlots_[k]]);
+        }
+    }
+}
+
+/**
+ * @brief Blokk vége: burkoló, billentyű állapot és időzítés egy csatornára
+ */
+void CwSkimmer::processBlock(Channel &ch) {
+
+    // 10 ms-os ablak: az aktuális és az előző blokk összege (5 ms-os lépésközzel)
+    float i = static_cast<float>(ch.accI) + static_cast<float>(ch.prevI);
+    float q = static_cast<float>(ch.accQ) + static_cast<float>(ch.prevQ);
+    ch.prevI = ch.accI;
+    ch.prevQ = ch.accQ;
+    ch.accI = 0;
+    ch.accQ = 0;
+    float mag = sqrtf(i * i + q * q) / (2.0f * blockSamples_ * 4096.0f);
+
+    // Zaj- és csúcsszint követés (az első blokk inicializál)
+    if (ch.peakLevel <= 0.0f) {
+        ch.peakLevel = mag;
+        ch.noiseLevel = mag * 0.25f;
+    }
+    ch.noiseLevel += (mag < ch.noiseLevel ? NOISE_FALL_ALPHA : NOISE_RISE_ALPHA) * (mag - ch.noiseLevel);
+    if (mag > ch.peakLevel) {
+        ch.peakLevel = mag;
+    } else {
+        ch.peakLevel += PEAK_DECAY_ALPHA * (ch.noiseLevel - ch.peakLevel);
+    }
+
+    // Hiszterézises billentyű detektálás
+    float span = ch.peakLevel - ch.noiseLevel;
+    bool signalPresent = ch.peakLevel > ch.noiseLevel * MIN_SNR;
+    bool keyDown = signalPresent && mag > ch.noiseLevel + span * (ch.keyDown ? KEY_OFF_LEVEL : KEY_ON_LEVEL);
+
+    if (keyDown == ch.keyDown) {
+        if (ch.runBlocks < UINT16_MAX) {
+            ch.runBlocks++;
+        }
+        // Tartó szünet: karakter és szóhatár
+        if (!keyDown) {
+            if (ch.charPending && ch.runBlocks >= CHAR_GAP_THRESHOLD * ch.dotBlocks) {
+                finishCharacter(ch);
+            }
+            if (ch.spacePending && ch.runBlocks >= WORD_GAP_THRESHOLD * ch.dotBlocks) {
+                pushChannelChar(ch, ' ');
+                ch.spacePending = false;
+            }
+        }
+        return;
+    }
+
+    // Él: hang vége -> pont vagy vonás
+    if (ch.keyDown) {
+        float duration = ch.runBlocks;
+        bool isDash = duration > DASH_THRESHOLD * ch.dotBlocks;
+        ch.dotBlocks += DOT_ALPHA * ((isDash ? duration / 3.0f : duration) - ch.dotBlocks);
+        ch.dotBlocks = constrain(ch.dotBlocks, MIN_DOT_MS / blockMs_, MAX_DOT_MS / blockMs_);
+
+        // Túl hosszú elemsor: a karakter érvénytelen (0), a végéig így marad
+        if (ch.symbolCode != 0) {
+            ch.symbolCode = (ch.symbolCode >= (1 << MAX_SYMBOL_ELEMENTS)) ? 0 : static_cast<uint8_t>((ch.symbolCode << 1) | (isDash ? 1 : 0));
+        }
+        ch.charPending = true;
+    }
+
+    ch.keyDown = keyDown;
+    ch.runBlocks = 1;
+}
+
+/**
+ * @brief A gyűjtött elemsor dekódolása és kiírása
+ */
+void CwSkimmer::finishCharacter(Channel &ch) {
+    char c = morseTable_[ch.symbolCode & 0x7F];
+    if (c != '\0') {
+        pushChannelChar(ch, c);
+    }
+    ch.symbolCode = 1;
+    ch.charPending = false;
+    ch.spacePending = true;
+}
+
+/**
+ * @brief Karakter a csatorna gyűrűs szövegpufferébe (a legrégebbi felülíródik)
+ */
+void CwSkimmer::pushChannelChar(Channel &ch, char c) {
+    // Szóköz csak szöveg után
+    if (c == ' ' && (ch.textCount == 0 || ch.text[(ch.textHead + CwSkimmerConstants::CHANNEL_TEXT_LENGTH - 1) % CwSkimmerConstants::CHANNEL_TEXT_LENGTH] == ' ')) {
+        return;
+    }
+    ch.text[ch.textHead] = c;
+    ch.textHead = (ch.textHead + 1) % CwSkimmerConstants::CHANNEL_TEXT_LENGTH;
+    if (ch.textCount < CwSkimmerConstants::CHANNEL_TEXT_LENGTH) {
+        ch.textCount++;
+    }
+    if (ch.confirmed) {
+        changeCounter_++;
+    }
+}
+
+/**
+ * @brief Spektrum alapú vivőkeresés és csatorna kiosztás (core1, minden FFT után)
+ */
+void CwSkimmer::processSpectrum(const float *magnitudeData, uint16_t fftSize, float binWidthHz, uint8_t loadPercent) {
+
+    uint32_t now = millis();
+    adaptChannelLimit(loadPercent);
+
+    if (magnitudeData == nullptr || binWidthHz <= 0.0f) {
+        return;
+    }
+
+    int startBin = std::max(2, static_cast<int>(std::ceil(CwSkimmerConstants::MIN_FREQUENCY_HZ / binWidthHz)));
+    int endBin = std::min(static_cast<int>(fftSize / 2) - 2, static_cast<int>(CwSkimmerConstants::MAX_FREQUENCY_HZ / binWidthHz));
+    if (endBin <= startBin) {
+        return;
+    }
+
+    // Zajszint: átlag, majd a kiugró binek nélküli átlag (a vivők ne emeljék meg)
+    float sum = 0.0f;
+    for (int i = startBin; i <= endBin; i++) {
+        sum += magnitudeData[i];
+    }
+    float mean = sum / (endBin - startBin + 1);
+    float floorSum = 0.0f;
+    int floorCount = 0;
+    for (int i = startBin; i <= endBin; i++) {
+        if (magnitudeData[i] < 2.0f * mean) {
+            floorSum += magnitudeData[i];
+            floorCount++;
+        }
+    }
+    float noiseFloor = floorCount > 0 ? floorSum / floorCount : mean;
+    float detectLevel = noiseFloor * CwSkimmerConstants::DETECT_FACTOR;
+
+    // Lokális maximumok, erősség szerint csökkenő sorrendben (fix méretű tömb)
+    struct Candidate {
+        float frequencyHz;
+        float magnitude;
+    };
+    Candidate candidates[CwSkimmerConstants::MAX_CANDIDATES];
+    uint8_t candidateCount = 0;
+    for (int i = startBin; i <= endBin; i++) {
+        float m = magnitudeData[i];
+        if (m <= detectLevel || m <= magnitudeData[i - 1] || m < magnitudeData[i + 1]) {
+            continue;
+        }
+        if (candidateCount == CwSkimmerConstants::MAX_CANDIDATES && m <= candidates[candidateCount - 1].magnitude) {
+            continue;
+        }
+
+        // Parabolikus interpoláció a bin alatti pontossághoz
+        float left = magnitudeData[i - 1];
+        float right = magnitudeData[i + 1];
+        float denom = left - 2.0f * m + right;
+        float delta = denom < 0.0f ? constrain(0.5f * (left - right) / denom, -0.5f, 0.5f) : 0.0f;
+
+        uint8_t pos = candidateCount < CwSkimmerConstants::MAX_CANDIDATES ? candidateCount++ : candidateCount - 1;
+        while (pos > 0 && candidates[pos - 1].magnitude < m) {
+            candidates[pos] = candidates[pos - 1];
+            pos--;
+        }
+        candidates[pos] = {(i + delta) * binWidthHz, m};
+    }
+
+    // Csúcsok hozzárendelése a meglévő csatornákhoz, vagy új csatorna nyitása
+    for (uint8_t c = 0; c < candidateCount; c++) {
+        float f = candidates[c].frequencyHz;
+        int8_t matchSlot = -1;
+        bool tooClose = false;
+        for (uint8_t slot = 0; slot < CwSkimmerConstants::MAX_CHANNELS; slot++) {
+            if (!channels_[slot].active) {
+                continue;
+            }
+            float distance = std::abs(f - channels_[slot].frequencyHz);
+            if (distance <= CwSkimmerConstants::CHANNEL_MATCH_HZ) {
+                matchSlot = slot;
+                break;
+            }
+            if (distance < CwSkimmerConstants::MIN_CHANNEL_SPACING_HZ) {
+                tooClose = true;
+            }
+        }
+
+        if (matchSlot >= 0) {
+            Channel &ch = channels_[matchSlot];
+            ch.lastSeenMs = now;
+            ch.frequencyHz = ch.frequencyHz + FREQUENCY_TRACK_ALPHA * (f - ch.frequencyHz);
+            ch.ncoIncrement = static_cast<uint32_t>(ch.frequencyHz / samplingFrequency_ * 4294967296.0f);
+            if (ch.hits < UINT8_MAX) {
+                ch.hits++;
+            }
+            if (!ch.confirmed && ch.hits >= CwSkimmerConstants::CONFIRM_HITS) {
+                ch.confirmed = true;
+                changeCounter_++;
+            }
+        } else if (!tooClose && activeCount_ < channelLimit_) {
+            for (uint8_t slot = 0; slot < CwSkimmerConstants::MAX_CHANNELS; slot++) {
+                if (!channels_[slot].active) {
+                    assignChannel(slot, f, now);
+                    break;
+                }
+            }
+        }
+    }
+
+    // Régóta nem látott csatornák felszabadítása
+    for (uint8_t slot = 0; slot < CwSkimmerConstants::MAX_CHANNELS; slot++) {
+        const Channel &ch = channels_[slot];
+        if (!ch.active) {
+            continue;
+        }
+        uint32_t timeout = ch.confirmed ? CwSkimmerConstants::IDLE_TIMEOUT_MS : CwSkimmerConstants::UNCONFIRMED_TIMEOUT_MS;
+        if (now - ch.lastSeenMs > timeout) {
+            releaseChannel(slot);
+        }
+    }
+}
+
+/**
+ * @brief Az aktív csatornák számának korlátozása a mintafeldolgozás terhelése alapján
+ * @details Túlterheléskor azonnal elengedjük a leggyengébb csatornát, bővíteni csak tartósan alacsony terhelésnél lehet
+ */
+void CwSkimmer::adaptChannelLimit(uint8_t loadPercent) {
+
+    if (loadPercent > CwSkimmerConstants::LOAD_HIGH_PERCENT && activeCount_ > 0) {
+        lowLoadSpectra_ = 0;
+        uint8_t newLimit = std::max(1, std::min<int>(channelLimit_, activeCount_) - 1);
+        if (newLimit != channelLimit_) {
+            channelLimit_ = newLimit;
+            DEBUG("CwSkimmer: terhelés %u%%, csatorna limit: %u\n", loadPercent, channelLimit_);
+        }
+
+        // A limit feletti csatornák közül a meg nem erősített, majd a leggyengébb megy el
+        while (activeCount_ > channelLimit_) {
+            uint8_t weakestSlot = activeSlots_[0];
+            for (uint8_t k = 1; k < activeCount_; k++) {
+                const Channel &candidate = channels_[activeSlots_[k]];
+                const Channel &weakest = channels_[weakestSlot];
+                if ((weakest.confirmed && !candidate.confirmed) || (weakest.confirmed == candidate.confirmed && candidate.peakLevel < weakest.peakLevel)) {
+                    weakestSlot = activeSlots_[k];
+                }
+            }
+            releaseChannel(weakestSlot);
+        }
+        return;
+    }
+
+    if (loadPercent < CwSkimmerConstants::LOAD_LOW_PERCENT && channelLimit_ < CwSkimmerConstants::MAX_CHANNELS) {
+        if (++lowLoadSpectra_ >= CwSkimmerConstants::LOAD_RECOVER_SPECTRA) {
+            lowLoadSpectra_ = 0;
+            channelLimit_ = channelLimit_ + 1;
+            DEBUG("CwSkimmer: terhelés %u%%, csatorna limit: %u\n", loadPercent, channelLimit_);
+        }
+    } else {
+        lowLoadSpectra_ = 0;
+    }
+}
+
+/**
+ * @brief Szabad slot kiosztása egy új vivőhöz
+ */
+void CwSkimmer::assignChannel(uint8_t slot, float frequencyHz, uint32_t now) {
+    Channel &ch = channels_[slot];
+    ch.frequencyHz = frequencyHz;
+    ch.ncoPhase = 0;
+    ch.ncoIncrement = static_cast<uint32_t>(frequencyHz / samplingFrequency_ * 4294967296.0f);
+    ch.accI = ch.accQ = 0;
+    ch.prevI = ch.prevQ = 0;
+    ch.noiseLevel = 0.0f;
+    ch.peakLevel = 0.0f;
+    ch.keyDown = false;
+    ch.runBlocks = 0;
+    ch.dotBlocks = INITIAL_DOT_MS / blockMs_;
+    ch.symbolCode = 1;
+    ch.charPending = false;
+    ch.spacePending = false;
+    ch.hits = 1;
+    ch.lastSeenMs = now;
+    ch.textHead = 0;
+    ch.textCount = 0;
+    ch.confirmed = false;
+    ch.active = true;
+    rebuildActiveList();
+}
+
+/**
+ * @brief Csatorna felszabadítása
+ */
+void CwSkimmer::releaseChannel(uint8_t slot) {
+    Channel &ch = channels_[slot];
+    if (ch.confirmed) {
+        changeCounter_++;
+    }
+    ch.active = false;
+    ch.confirmed = false;
+    rebuildActiveList();
+}
+
+/**
+ * @brief Az aktív slotok tömör listájának újraépítése (a mintánkénti ciklus csak ezeken fut)
+ */
+void CwSkimmer::rebuildActiveList() {
+    activeCount_ = 0;
+    for (uint8_t slot = 0; slot < CwSkimmerConstants::MAX_CHANNELS; slot++) {
+        if (channels_[slot].active) {
+            activeSlots_[activeCount_++] = slot;
+        }
+    }
+}
+
+/**
+ * @brief Egy pool slot állapotának másolása (core0)
+ * @details A core1 közben írhatja a szöveget, legrosszabb esetben egy karakter hiányzik vagy kétszer látszik
+ */
+bool CwSkimmer::getChannelInfo(uint8_t slot, ChannelInfo &info) const {
+
+    if (slot >= CwSkimmerConstants::MAX_CHANNELS) {
+        return false;
+    }
+    const Channel &ch = channels_[slot];
+    if (!ch.active || !ch.confirmed) {
+        return false;
+    }
+
+    info.frequencyHz = static_cast<uint16_t>(std::lround(ch.frequencyHz));
+    info.wpm = ch.dotBlocks > 0.0f ? static_cast<uint8_t>(std::lround(1200.0f / (ch.dotBlocks * blockMs_))) : 0;
+    info.keyDown = ch.keyDown;
+
+    uint8_t count = ch.textCount;
+    uint8_t start = (ch.textHead + CwSkimmerConstants::CHANNEL_TEXT_LENGTH - count) % CwSkimmerConstants::CHANNEL_TEXT_LENGTH;
+    for (uint8_t k = 0; k < count; k++) {
+        info.text[k] = ch.text[(start + k) % CwSkimmerConstants::CHANNEL_TEXT_LENGTH];
+    }
+    info.text[count] = '\0';
+    return true;
+}
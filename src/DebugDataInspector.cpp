@@ -50,6 +50,8 @@ void DebugDataInspector::printConfigData(const Config_t &configData) {
     DEBUG("  ssIdxFM: %u\n", configData.ssIdxFM);
     DEBUG("  currentSquelch: %u\n", configData.currentSquelch);
     DEBUG("  squelchUsesRSSI: %s\n", configData.squelchUsesRSSI ? "true" : "false");
+    DEBUG("  seekRssiThresholdFM: %u\n", configData.seekRssiThresholdFM);
+    DEBUG("  seekSnrThresholdFM: %u\n", configData.seekSnrThresholdFM);
     DEBUG("  rdsEnabled: %s\n", configData.rdsEnabled ? "true" : "false");
     DEBUG("  currVolume: %u\n", configData.currVolume);
     DEBUG("  agcGain: %u\n", configData.agcGain);
@@ -91,6 +93,15 @@ void DebugDataInspector::printConfigData(const Config_t &configData) {
     DEBUG("  cwReceiverOffsetHz: %u\n", configData.cwReceiverOffsetHz);
     DEBUG("  rttyMarkFrequencyHz: %u\n", configData.rttyMarkFrequencyHz);
     DEBUG("  rttyShiftHz: %u\n", configData.rttyShiftHz);
+    DEBUG("  pskCarrierFrequencyHz: %u\n", configData.pskCarrierFrequencyHz);
+    DEBUG("  navtexCenterFrequencyHz: %u\n", configData.navtexCenterFrequencyHz);
+    DEBUG("  wefaxSlantPpm: %d\n", configData.wefaxSlantPpm);
+    DEBUG("  waterfallPalette: %u\n", configData.waterfallPalette);
+    DEBUG("  spectrumTraces: 0x%02X\n", configData.spectrumTraces);
+    DEBUG("  traceAverageMs: %u\n", configData.traceAverageMs);
+    DEBUG("  tracePeakDecayDbPerSec: %u\n", configData.tracePeakDecayDbPerSec);
+    DEBUG("  spectrumLogScale: %s\n", configData.spectrumLogScale ? "true" : "false");
+    DEBUG("  spectrumDbRange: %u\n", configData.spectrumDbRange);
     DEBUG("====================\n");
 #endif
 }
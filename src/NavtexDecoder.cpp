@@ -0,0 +1,511 @@
+#include "NavtexDecoder.h"
+#include "AudioProcessor.h"
+#include "defines.h"
+#include <cmath>
+#include <hardware/sync.h>
+
+namespace {
+
+constexpr float TIMING_GAIN = 0.05f;     // Bit óra korrekció a nullátmenet hibájának arányában
+constexpr float MIN_ENERGY = 1.0e-12f;   // Osztás védelem
+constexpr int8_t MAX_PARITY_VOTE = 8;    // A DX/RX rés paritás szavazat korlátja
+constexpr uint8_t FEC_DELAY_SLOTS = 5;   // Az RX (ismétlő) karakter ennyi réssel a DX után jön
+constexpr char ERROR_CHAR = '*';         // Javíthatatlan karakter jelölése (a NAVTEX vevők szokása szerint)
+constexpr uint8_t UNKNOWN_SERIAL = 0xFF; // Olvashatatlan fejléc sorszám
+
+// CCIR-476 vezérlő kódok (B = 1, az elsőként vett bit a legmagasabb helyiértékű)
+constexpr uint8_t CODE_LTRS = 0x5A;
+constexpr uint8_t CODE_FIGS = 0x36;
+constexpr uint8_t CODE_CR = 0x78;
+constexpr uint8_t CODE_LF = 0x6C;
+constexpr uint8_t CODE_ALPHA = 0x0F; // Fázisozó jel 1 (DX résben)
+constexpr uint8_t CODE_BETA = 0x33;
+constexpr uint8_t CODE_REP = 0x66; // Fázisozó jel 2 (RX résben)
+constexpr uint8_t CODE_CHAR32 = 0x6A;
+
+/**
+ * CCIR-476 karakter tábla: kód, betű, szám/jel váltás
+ */
+struct Ccir476Entry {
+    uint8_t code;
+    char letter;
+    char figure;
+};
+
+const Ccir476Entry CCIR476_TABLE[] = {
+    {0x47, 'A', '-'},  {0x72, 'B', '?'}, {0x1D, 'C', ':'}, {0x53, 'D', '$'}, {0x56, 'E', '3'}, {0x1B, 'F', '!'}, {0x35, 'G', '&'},
+    {0x69, 'H', '#'},  {0x4D, 'I', '8'}, {0x17, 'J', '\''}, {0x1E, 'K', '('}, {0x65, 'L', ')'}, {0x39, 'M', '.'}, {0x59, 'N', ','},
+    {0x71, 'O', '9'},  {0x2D, 'P', '0'}, {0x2E, 'Q', '1'}, {0x55, 'R', '4'}, {0x4B, 'S', '\''}, {0x74, 'T', '5'}, {0x4E, 'U', '7'},
+    {0x3C, 'V', '='},  {0x27, 'W', '2'}, {0x3A, 'X', '/'}, {0x2B, 'Y', '6'}, {0x63, 'Z', '+'}, {0x5C, ' ', ' '},
+};
+} // namespace
+
+int16_t NavtexDecoder::sinTable_[NavtexConstants::NCO_TABLE_SIZE];
+bool NavtexDecoder::sinTableReady_ = false;
+
+/**
+ * @brief Konstruktor
+ */
+NavtexDecoder::NavtexDecoder()
+    : storeHead_(0),                                                    //
+      storeCount_(0),                                                   //
+      storeSequence_(0),                                                //
+      clearRequested_(false),                                           //
+      requestedCenterHz_(NavtexConstants::DEFAULT_CENTER_FREQUENCY_HZ), //
+      centerChanged_(false) {
+
+    // NCO szinusz tábla (Q12) egyszeri feltöltése
+    if (!sinTableReady_) {
+        for (uint16_t i = 0; i < NavtexConstants::NCO_TABLE_SIZE; i++) {
+            sinTable_[i] = static_cast<int16_t>(std::lround(NavtexConstants::NCO_AMPLITUDE * sinf(TWO_PI * i / NavtexConstants::NCO_TABLE_SIZE)));
+        }
+        sinTableReady_ = true;
+    }
+
+    reset(AudioProcessorConstants::DEFAULT_AM_SAMPLING_FREQUENCY);
+}
+
+/**
+ * @brief Dekóder alaphelyzetbe állítása (a tárolt üzenetek megmaradnak)
+ * @param samplingFrequency Az aktuális mintavételezési frekvencia Hz-ben
+ */
+void NavtexDecoder::reset(uint16_t samplingFrequency) {
+
+    samplingFrequency_ = samplingFrequency > 0 ? samplingFrequency : AudioProcessorConstants::DEFAULT_AM_SAMPLING_FREQUENCY;
+
+    // Decimálás ~2 kHz-re (integráló-ürítő), így egy bit ~20 decimált minta
+    decimationFactor_ = std::max(1, static_cast<int>(std::lround(static_cast<float>(samplingFrequency_) / NavtexConstants::TARGET_DECIMATED_RATE)));
+    float decimatedRate = static_cast<float>(samplingFrequency_) / decimationFactor_;
+    decimationScale_ = 1.0f / (static_cast<float>(decimationFactor_) * 2048.0f * NavtexConstants::NCO_AMPLITUDE);
+    decimationCount_ = 0;
+    accI_ = 0;
+    accQ_ = 0;
+
+    // Mark/space szűrők: a két hang a középfrekvenciától +/- shift/2 távolságra
+    samplesPerBit_ = decimatedRate / NavtexConstants::BAUD_RATE;
+    filterLength_ = constrain(static_cast<int>(std::lround(samplesPerBit_)), 4, NavtexConstants::MAX_BIT_SAMPLES);
+    float w = TWO_PI * (NavtexConstants::SHIFT_HZ / 2.0f) / decimatedRate;
+    toneRotI_ = cosf(w);
+    toneRotQ_ = sinf(w);
+    tonePhaseI_ = 1.0f;
+    tonePhaseQ_ = 0.0f;
+    memset(markBufI_, 0, sizeof(markBufI_));
+    memset(markBufQ_, 0, sizeof(markBufQ_));
+    memset(spaceBufI_, 0, sizeof(spaceBufI_));
+    memset(spaceBufQ_, 0, sizeof(spaceBufQ_));
+    markSumI_ = markSumQ_ = spaceSumI_ = spaceSumQ_ = 0.0f;
+    filterPos_ = 0;
+
+    bitClock_ = 0.0f;
+    prevDecision_ = 0.0f;
+    messageState_ = MessageState::Idle;
+    memset(lastChars_, 0, sizeof(lastChars_));
+    resetSync();
+
+    ncoPhase_ = 0;
+    centerChanged_ = false;
+    updateNcoIncrement();
+
+    DEBUG("NavtexDecoder::reset() -> Fs: %u Hz, decimálás: %u, Fs dec: %d Hz, minta/bit: %u\n", samplingFrequency_, decimationFactor_, static_cast<int>(decimatedRate), filterLength_);
+}
+
+/**
+ * @brief A mark/space középfrekvencia beállítása (core0-ról hívható)
+ * @param frequencyHz A két hang közötti középfrekvencia Hz-ben
+ */
+void NavtexDecoder::setCenterFrequency(float frequencyHz) {
+    requestedCenterHz_ = constrain(frequencyHz, NavtexConstants::MIN_CENTER_FREQUENCY_HZ, NavtexConstants::MAX_CENTER_FREQUENCY_HZ);
+    centerChanged_ = true; // A core1 a következő decimált mintánál veszi át
+}
+
+/**
+ * @brief Az NCO lépésköz újraszámítása a középfrekvenciából
+ */
+void NavtexDecoder::updateNcoIncrement() { ncoIncrement_ = static_cast<uint32_t>(requestedCenterHz_ / samplingFrequency_ * 4294967296.0f); }
+
+/**
+ * @brief Bit/karakter szinkron elvetése (új jel keresése)
+ */
+void NavtexDecoder::resetSync() {
+    bitShift_ = 0;
+    bitCount_ = 0;
+    memset(validRun_, 0, sizeof(validRun_));
+    memset(invertedRun_, 0, sizeof(invertedRun_));
+    charSynced_ = false;
+    inverted_ = false;
+    errorRun_ = 0;
+    memset(slotCodes_, 0, sizeof(slotCodes_));
+    slotIndex_ = 0;
+    rxParityVote_ = 0;
+    figureShift_ = false;
+}
+
+/**
+ * @brief Egy audio minta feldolgozása: NCO keverés és decimálás (fixpontos, teljes mintavételi frekvencián)
+ * @param sample DC-mentes ADC minta
+ */
+void NavtexDecoder::processSample(int16_t sample) {
+
+    const uint8_t idx = ncoPhase_ >> (32 - NavtexConstants::NCO_TABLE_BITS);
+    const int32_t s = sinTable_[idx];
+    const int32_t c = sinTable_[(idx + NavtexConstants::NCO_TABLE_SIZE / 4) & (NavtexConstants::NCO_TABLE_SIZE - 1)];
+    ncoPhase_ += ncoIncrement_;
+
+    // Keverés alapsávba: x * e^(-j*phi), a mark +85 Hz-re, a space -85 Hz-re kerül
+    accI_ += sample * c;
+    accQ_ -= sample * s;
+
+    if (++decimationCount_ >= decimationFactor_) {
+        processDecimated(accI_ * decimationScale_, accQ_ * decimationScale_);
+        accI_ = 0;
+        accQ_ = 0;
+        decimationCount_ = 0;
+    }
+}
+
+/**
+ * @brief Decimált komplex minta feldolgozása: mark/space szűrés, diszkriminátor és bit szinkron
+ */
+void NavtexDecoder::processDecimated(float i, float q) {
+
+    // Új középfrekvencia a core0-ról?
+    if (centerChanged_) {
+        centerChanged_ = false;
+        updateNcoIncrement();
+        resetSync();
+    }
+
+    // Tároló törlése a core0 kérésére (a tárat csak a core1 írja)
+    if (clearRequested_) {
+        clearRequested_ = false;
+        storeSequence_ = storeSequence_ + 1;
+        __dmb();
+        storeHead_ = 0;
+        storeCount_ = 0;
+        __dmb();
+        storeSequence_ = storeSequence_ + 1;
+    }
+
+    // 1. Keverés a két hangra: mark = z * e^(-j*w*n), space = z * e^(+j*w*n)
+    const float pc = tonePhaseI_;
+    const float ps = tonePhaseQ_;
+    const float mi = i * pc + q * ps;
+    const float mq = q * pc - i * ps;
+    const float si = i * pc - q * ps;
+    const float sq = q * pc + i * ps;
+    tonePhaseI_ = pc * toneRotI_ - ps * toneRotQ_;
+    tonePhaseQ_ = pc * toneRotQ_ + ps * toneRotI_;
+
+    // 2. Egy bit hosszú mozgó összeg (illesztett szűrő a négyszög bitekhez)
+    markSumI_ += mi - markBufI_[filterPos_];
+    markSumQ_ += mq - markBufQ_[filterPos_];
+    spaceSumI_ += si - spaceBufI_[filterPos_];
+    spaceSumQ_ += sq - spaceBufQ_[filterPos_];
+    markBufI_[filterPos_] = mi;
+    markBufQ_[filterPos_] = mq;
+    spaceBufI_[filterPos_] = si;
+    spaceBufQ_[filterPos_] = sq;
+
+    if (++filterPos_ >= filterLength_) {
+        filterPos_ = 0;
+
+        // Kerekítési hibák felhalmozódása ellen: összegek újraszámolása, forgató normálása
+        markSumI_ = markSumQ_ = spaceSumI_ = spaceSumQ_ = 0.0f;
+        for (uint8_t k = 0; k < filterLength_; k++) {
+            markSumI_ += markBufI_[k];
+            markSumQ_ += markBufQ_[k];
+            spaceSumI_ += spaceBufI_[k];
+            spaceSumQ_ += spaceBufQ_[k];
+        }
+        float mag = sqrtf(tonePhaseI_ * tonePhaseI_ + tonePhaseQ_ * tonePhaseQ_);
+        if (mag > MIN_ENERGY) {
+            tonePhaseI_ /= mag;
+            tonePhaseQ_ /= mag;
+        }
+    }
+
+    // 3. Normált energia diszkriminátor: +1 mark (B), -1 space (Y)
+    const float markEnergy = markSumI_ * markSumI_ + markSumQ_ * markSumQ_;
+    const float spaceEnergy = spaceSumI_ * spaceSumI_ + spaceSumQ_ * spaceSumQ_;
+    const float decision = (markEnergy - spaceEnergy) / (markEnergy + spaceEnergy + MIN_ENERGY);
+
+    // 4. Bit szinkron: a szűrt jel nullátmenete a bitközépen (fél bittel a bithatár után) várható
+    bitClock_ += 1.0f;
+    if ((decision > 0.0f) != (prevDecision_ > 0.0f)) {
+        float error = bitClock_ - samplesPerBit_ * 0.5f;
+        bitClock_ -= TIMING_GAIN * error;
+    }
+    prevDecision_ = decision;
+
+    // A mintavétel a bit végén, ahol a mozgó összeg a teljes bitet tartalmazza
+    if (bitClock_ >= samplesPerBit_) {
+        bitClock_ -= samplesPerBit_;
+        processBit(decision > 0.0f ? 1 : 0);
+    }
+}
+
+/**
+ * @brief Egy vett bit feldolgozása: karakter szinkron keresés vagy karakter összerakás
+ */
+void NavtexDecoder::processBit(uint8_t bit) {
+
+    bitShift_ = ((bitShift_ << 1) | bit) & 0x7F;
+
+    if (charSynced_) {
+        if (++bitCount_ >= 7) {
+            bitCount_ = 0;
+            processSlot(inverted_ ? (bitShift_ ^ 0x7F) : bitShift_);
+        }
+        return;
+    }
+
+    // Szinkron keresés: mind a 7 bitfázisban pontozzuk az érvényes kódokat (érvényes +1, hibás -2, így
+    // zajban - ahol a kódok ~27%-a véletlenül érvényes - a pontszám nem nő, gyenge jelnél viszont igen).
+    // Fordított polaritásnál (pl. LSB vétel) a 4B/3Y kódokból 3B/4Y lesz, így a polaritás is kiderül.
+    const uint8_t phase = bitCount_;
+    bitCount_ = (bitCount_ + 1) % 7;
+    const uint8_t weight = __builtin_popcount(bitShift_);
+    validRun_[phase] = (weight == 4) ? validRun_[phase] + 1 : std::max(0, validRun_[phase] - 2);
+    invertedRun_[phase] = (weight == 3) ? invertedRun_[phase] + 1 : std::max(0, invertedRun_[phase] - 2);
+
+    if (validRun_[phase] >= NavtexConstants::SYNC_VALID_CHARS || invertedRun_[phase] >= NavtexConstants::SYNC_VALID_CHARS) {
+        bool inverted = invertedRun_[phase] >= NavtexConstants::SYNC_VALID_CHARS;
+        resetSync();
+        charSynced_ = true;
+        inverted_ = inverted;
+        DEBUG("NavtexDecoder: karakter szinkron%s\n", inverted ? " (fordított polaritás)" : "");
+    }
+}
+
+/**
+ * @brief Egy karakter időrés feldolgozása: DX/RX rés azonosítás és FEC döntés
+ * @param code A vett 7 bites CCIR-476 kód
+ */
+void NavtexDecoder::processSlot(uint8_t code) {
+
+    slotIndex_++;
+    slotCodes_[slotIndex_ & 7] = code;
+    const bool valid = isValidCode(code);
+
+    // Szinkron vesztés: tartósan hibás karakterek
+    errorRun_ = valid ? 0 : errorRun_ + 1;
+    if (errorRun_ >= NavtexConstants::SYNC_LOSS_ERRORS) {
+        DEBUG("NavtexDecoder: szinkron elveszett\n");
+        resetSync();
+        return;
+    }
+
+    // DX/RX rés azonosítás: az alpha a DX, a rep az RX résben jön, forgalom közben az RX az 5 réssel korábbi DX ismétlése
+    const uint8_t slotParity = slotIndex_ & 1;
+    const uint8_t dxCode = slotCodes_[(slotIndex_ - FEC_DELAY_SLOTS) & 7];
+    int8_t vote = 0;
+    if (code == CODE_ALPHA) {
+        vote = slotParity ? -1 : 1; // Ez DX rés, tehát a másik paritás az RX
+    } else if (code == CODE_REP || (valid && code == dxCode)) {
+        vote = slotParity ? 1 : -1;
+    }
+    rxParityVote_ = constrain(rxParityVote_ + vote, -MAX_PARITY_VOTE, MAX_PARITY_VOTE);
+
+    if (rxParityVote_ == 0 || slotParity != (rxParityVote_ > 0 ? 1 : 0)) {
+        return; // DX rés (vagy még ismeretlen): az RX ismétlésnél döntünk
+    }
+
+    // FEC: elsődlegesen a DX, ha az hibás, az RX karakter
+    if (isValidCode(dxCode)) {
+        decodeCharacter(dxCode);
+    } else if (valid) {
+        decodeCharacter(code);
+    } else {
+        decodeCharacter(0);
+    }
+}
+
+/**
+ * @brief Egy CCIR-476 kód karakterré alakítása (betű/szám váltás kezelésével)
+ * @param code A kód, 0 ha javíthatatlan
+ */
+void NavtexDecoder::decodeCharacter(uint8_t code) {
+
+    switch (code) {
+        case 0:
+            emitChar(ERROR_CHAR);
+            return;
+        case CODE_LTRS:
+            figureShift_ = false;
+            return;
+        case CODE_FIGS:
+            figureShift_ = true;
+            return;
+        case CODE_LF:
+            emitChar('\n');
+            return;
+        case CODE_CR:
+        case CODE_ALPHA:
+        case CODE_BETA:
+        case CODE_REP:
+        case CODE_CHAR32:
+            return; // Fázisozó és vezérlő jelek: nincs kiírás
+        default:
+            break;
+    }
+
+    for (const Ccir476Entry &entry : CCIR476_TABLE) {
+        if (entry.code == code) {
+            emitChar(figureShift_ ? entry.figure : entry.letter);
+            return;
+        }
+    }
+}
+
+/**
+ * @brief Egy dekódolt karakter kiadása: élő szöveg és üzenet keretezés (ZCZC B1B2B3B4 ... NNNN)
+ */
+void NavtexDecoder::emitChar(char c) {
+
+    pushDecodedChar(c);
+
+    memmove(lastChars_, lastChars_ + 1, sizeof(lastChars_) - 1);
+    lastChars_[sizeof(lastChars_) - 1] = c;
+
+    if (memcmp(lastChars_, "ZCZC", 4) == 0) {
+        startMessage();
+        return;
+    }
+
+    switch (messageState_) {
+        case MessageState::Idle:
+            break;
+
+        case MessageState::Header:
+            if (c == ' ') {
+                break;
+            }
+            if (c != '\n') {
+                header_[headerLength_++] = c;
+            }
+            if (c == '\n' || headerLength_ >= sizeof(header_)) {
+                // B1: állomás, B2: téma, B3B4: sorszám (hibás fejlécnél '?' és ismeretlen sorszám)
+                current_.station = (headerLength_ > 0 && isupper(header_[0])) ? header_[0] : '?';
+                current_.subject = (headerLength_ > 1 && isupper(header_[1])) ? header_[1] : '?';
+                current_.serial = (headerLength_ > 3 && isdigit(header_[2]) && isdigit(header_[3])) ? (header_[2] - '0') * 10 + (header_[3] - '0') : UNKNOWN_SERIAL;
+                messageState_ = MessageState::Body;
+            }
+            break;
+
+        case MessageState::Body:
+            if (memcmp(lastChars_, "NNNN", 4) == 0) {
+                current_.length -= std::min<uint16_t>(current_.length, 3); // Az előző 3 'N' már a szövegben van
+                finishMessage();
+                break;
+            }
+            if (c == ERROR_CHAR) {
+                current_.errorCount++;
+            }
+            if ((c == '\n' && current_.length == 0) || current_.length >= NavtexConstants::MESSAGE_TEXT_LENGTH) {
+                break; // A fejléc utáni sorvége, illetve a túl hosszú üzenet vége nem kerül tárolásra
+            }
+            current_.text[current_.length++] = c;
+            break;
+    }
+}
+
+/**
+ * @brief Új üzenet kezdete (ZCZC), a félbemaradt előző üzenet eldobódik
+ */
+void NavtexDecoder::startMessage() {
+    messageState_ = MessageState::Header;
+    headerLength_ = 0;
+    current_.station = '?';
+    current_.subject = '?';
+    current_.serial = UNKNOWN_SERIAL;
+    current_.errorCount = 0;
+    current_.length = 0;
+}
+
+/**
+ * @brief Az üzenet lezárása (NNNN) és mentése a tárba
+ */
+void NavtexDecoder::finishMessage() {
+    while (current_.length > 0 && (current_.text[current_.length - 1] == '\n' || current_.text[current_.length - 1] == ' ')) {
+        current_.length--;
+    }
+    current_.text[current_.length] = '\0';
+    current_.receivedMs = millis();
+    messageState_ = MessageState::Idle;
+    storeMessage(current_);
+}
+
+/**
+ * @brief Üzenet mentése a gyűrűs tárba, duplikáció szűréssel
+ * @details Az azonos azonosítójú (B1B2B3B4) üzenet csak akkor íródik felül, ha az új kevesebb hibát tartalmaz.
+ * A 00 sorszámú és az olvashatatlan fejlécű üzenetek mindig új üzenetnek számítanak.
+ */
+void NavtexDecoder::storeMessage(const Message &msg) {
+
+    uint8_t slot = storeHead_;
+    bool isNew = true;
+
+    if (msg.serial != 0 && msg.serial != UNKNOWN_SERIAL && msg.station != '?' && msg.subject != '?') {
+        for (uint8_t n = 0; n < storeCount_; n++) {
+            uint8_t s = (storeHead_ + NavtexConstants::MESSAGE_STORE_SIZE - 1 - n) % NavtexConstants::MESSAGE_STORE_SIZE;
+            const Message &stored = store_[s];
+            if (stored.station == msg.station && stored.subject == msg.subject && stored.serial == msg.serial) {
+                if (msg.errorCount >= stored.errorCount) {
+                    DEBUG("NavtexDecoder: ismételt üzenet (%c%c%02u), eldobva\n", msg.station, msg.subject, msg.serial);
+                    return;
+                }
+                slot = s; // Jobb minőségű ismétlés: a régi helyére kerül
+                isNew = false;
+                break;
+            }
+        }
+    }
+
+    // Szekvencia zár: páratlan számláló alatt a core0 nem fogad el másolatot
+    storeSequence_ = storeSequence_ + 1;
+    __dmb();
+    memcpy(&store_[slot], &msg, sizeof(Message));
+    if (isNew) {
+        storeHead_ = (storeHead_ + 1) % NavtexConstants::MESSAGE_STORE_SIZE;
+        if (storeCount_ < NavtexConstants::MESSAGE_STORE_SIZE) {
+            storeCount_ = storeCount_ + 1;
+        }
+    }
+    __dmb();
+    storeSequence_ = storeSequence_ + 1;
+
+    DEBUG("NavtexDecoder: üzenet mentve: %c%c%02u, %u karakter, %u hiba\n", msg.station, msg.subject, msg.serial, msg.length, msg.errorCount);
+}
+
+/**
+ * @brief Egy tárolt üzenet másolatának lekérése (core0-ról hívható)
+ * @param index 0: a legújabb üzenet
+ * @param out Kimeneti másolat
+ * @return true ha sikerült konzisztens másolatot készíteni
+ */
+bool NavtexDecoder::getMessage(uint8_t index, Message &out) const {
+
+    constexpr uint8_t MAX_READ_ATTEMPTS = 3;
+    for (uint8_t attempt = 0; attempt < MAX_READ_ATTEMPTS; attempt++) {
+        uint32_t sequence = storeSequence_;
+        if (sequence & 1) {
+            continue; // A core1 éppen ír
+        }
+        __dmb();
+        if (index >= storeCount_) {
+            return false;
+        }
+        uint8_t slot = (storeHead_ + NavtexConstants::MESSAGE_STORE_SIZE - 1 - index) % NavtexConstants::MESSAGE_STORE_SIZE;
+        memcpy(&out, &store_[slot], sizeof(Message));
+        __dmb();
+        if (sequence == storeSequence_) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Érvényes CCIR-476 kód-e (pontosan 4 B és 3 Y bit)
+ */
+bool NavtexDecoder::isValidCode(uint8_t code) { return __builtin_popcount(code & 0x7F) == 4; }
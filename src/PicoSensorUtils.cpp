@@ -1,3 +1,5 @@
+#include <hardware/adc.h>
+
 #include "PicoSensorUtils.h"
 
 namespace PicoSensorUtils {
@@ -15,6 +17,12 @@ namespace PicoSensorUtils {
  */
 void init() { analogReadResolution(AD_RESOLUTION); }
 
+/**
+ * @brief Az ADC-t épp a core1 folyamatos (DMA) mintavételezése használja-e
+ * @details Ilyenkor az analogRead() összekeverné a bemeneteket, ezért a cache-elt értéket adjuk vissza
+ */
+static bool isAdcFreeRunning() { return (adc_hw->cs & ADC_CS_START_MANY_BITS) != 0; }
+
 /**
  * ADC olvasás és VBUS feszültség kiszámítása KÜLSŐ osztóval
  * @return A VBUS mért feszültsége Voltban.
@@ -26,6 +34,9 @@ float readVBusExternal() {
     if (sensorCache.vBusExtValid && (currentTime - sensorCache.vBusExtLastRead < PICO_SENSORS_CACHE_TIMEOUT_MS)) {
         return sensorCache.vBusExtValue;
     }
+    if (isAdcFreeRunning()) {
+        return sensorCache.vBusExtValue;
+    }
 
     // Cache lejárt vagy nem érvényes, új mérés
     float voltageOut = (analogRead(PIN_VBUS_EXTERNAL_MEASURE_INPUT) * V_REFERENCE) / CONVERSION_FACTOR;
@@ -49,6 +60,9 @@ float readCoreTemperature() {
     if (sensorCache.temperatureValid && (currentTime - sensorCache.temperatureLastRead < PICO_SENSORS_CACHE_TIMEOUT_MS)) {
         return sensorCache.temperatureValue;
     }
+    if (isAdcFreeRunning()) {
+        return sensorCache.temperatureValue;
+    }
     float temperature = analogReadTemp(); // A4
     sensorCache.temperatureValue = temperature;
     sensorCache.temperatureLastRead = currentTime;
@@ -0,0 +1,307 @@
+#include "Psk31Decoder.h"
+#include "AudioProcessor.h"
+#include "defines.h"
+#include <cmath>
+
+namespace {
+
+// Hurok paraméterek
+constexpr float COSTAS_PHASE_GAIN = 0.1f;   // Costas fázis korrekció (szimbólumonként)
+constexpr float COSTAS_FREQ_GAIN = 0.02f;   // Costas frekvencia integrátor (szimbólumonként)
+constexpr float FLL_GAIN = 0.01f;           // Négyzetre emelős AFC erősítés (decimált mintánként)
+constexpr float TIMING_GAIN = 0.1f;         // Gardner hibából számolt korrekció (szimbólumhossz arányában)
+constexpr float MAX_TIMING_STEP = 0.5f;     // Max. szimbólum óra korrekció szimbólumonként (minta)
+constexpr float POWER_SMOOTHING = 0.02f;    // Teljesítmény becslők simítása
+constexpr float QUALITY_SMOOTHING = 0.05f;  // Jelminőség simítása
+constexpr float SNR_GATE_LOW = 0.08f;       // Szűrt / szűretlen teljesítmény arány, ez alatt nincs AFC (tiszta zajban ~0.05)
+constexpr float SNR_GATE_HIGH = 0.25f;      // E felett teljes AFC erősítés (az idle jel ~0.25)
+constexpr float MIN_POWER = 1.0e-12f;       // Osztás védelem
+constexpr float PHASE_TO_NCO = 4294967296.0f / TWO_PI; // Radián -> 32 bites NCO fázis
+
+/**
+ * PSK31 varicode tábla (ASCII 0...127), a kódok a két lezáró '0' bit nélkül
+ */
+const uint16_t VARICODE_TABLE[128] = {
+    0b1010101011, 0b1011011011, 0b1011101101, 0b1101110111, 0b1011101011, 0b1101011111, 0b1011101111, 0b1011111101, // 0-7
+    0b1011111111, 0b11101111,   0b11101,      0b1101101111, 0b1011011101, 0b11111,      0b1101110101, 0b1110101011, // 8-15
+    0b1011110111, 0b1011110101, 0b1110101101, 0b1110101111, 0b1101011011, 0b1101101011, 0b1101101101, 0b1101010111, // 16-23
+    0b1101111011, 0b1101111101, 0b1110110111, 0b1101010101, 0b1101011101, 0b1110111011, 0b1011111011, 0b1101111111, // 24-31
+    0b1,          0b111111111,  0b101011111,  0b111110101,  0b111011011,  0b1011010101, 0b1010111011, 0b101111111,  // ' ' ! " # $ % & '
+    0b11111011,   0b11110111,   0b101101111,  0b111011111,  0b1110101,    0b110101,     0b1010111,    0b110101111,  // ( ) * + , - . /
+    0b10110111,   0b10111101,   0b11101101,   0b11111111,   0b101110111,  0b101011011,  0b101101011,  0b110101101,  // 0-7
+    0b110101011,  0b110110111,  0b11110101,   0b110111101,  0b111101101,  0b1010101,    0b111010111,  0b1010101111, // 8 9 : ; < = > ?
+    0b1010111101, 0b1111101,    0b11101011,   0b10101101,   0b10110101,   0b1110111,    0b11011011,   0b11111101,   // @ A-G
+    0b101010101,  0b1111111,    0b111111101,  0b101111101,  0b11010111,   0b10111011,   0b11011101,   0b10101011,   // H-O
+    0b11010101,   0b111011101,  0b10101111,   0b1101111,    0b1101101,    0b101010111,  0b110110101,  0b101011101,  // P-W
+    0b101110101,  0b101111011,  0b1010101101, 0b111110111,  0b111101111,  0b111111011,  0b1010111111, 0b101101101,  // X Y Z [ \ ] ^ _
+    0b1011011111, 0b1011,       0b1011111,    0b101111,     0b101101,     0b11,         0b111101,     0b1011011,    // ` a-g
+    0b101011,     0b1101,       0b111101011,  0b10111111,   0b11011,      0b111011,     0b1111,       0b111,        // h-o
+    0b111111,     0b110111111,  0b10101,      0b10111,      0b101,        0b110111,     0b1111011,    0b1101011,    // p-w
+    0b11011111,   0b1011101,    0b111010101,  0b1010110111, 0b110111011,  0b1010110101, 0b1011010111, 0b1110110101, // x y z { | } ~ DEL
+};
+} // namespace
+
+int16_t Psk31Decoder::sinTable_[Psk31Constants::NCO_TABLE_SIZE];
+bool Psk31Decoder::sinTableReady_ = false;
+
+/**
+ * @brief Konstruktor
+ */
+Psk31Decoder::Psk31Decoder()
+    : requestedCarrierHz_(Psk31Constants::DEFAULT_CARRIER_FREQUENCY_HZ), //
+      carrierChanged_(false),                                            //
+      trackedFrequencyHz_(Psk31Constants::DEFAULT_CARRIER_FREQUENCY_HZ), //
+      signalQualityPercent_(0) {
+
+    // NCO szinusz tábla (Q12) egyszeri feltöltése
+    if (!sinTableReady_) {
+        for (uint16_t i = 0; i < Psk31Constants::NCO_TABLE_SIZE; i++) {
+            sinTable_[i] = static_cast<int16_t>(std::lround(Psk31Constants::NCO_AMPLITUDE * sinf(TWO_PI * i / Psk31Constants::NCO_TABLE_SIZE)));
+        }
+        sinTableReady_ = true;
+    }
+
+    reset(AudioProcessorConstants::DEFAULT_AM_SAMPLING_FREQUENCY);
+}
+
+/**
+ * @brief Dekóder alaphelyzetbe állítása, a decimálás és az illesztett szűrő újraszámítása
+ * @param samplingFrequency Az aktuális mintavételezési frekvencia Hz-ben
+ */
+void Psk31Decoder::reset(uint16_t samplingFrequency) {
+
+    samplingFrequency_ = samplingFrequency > 0 ? samplingFrequency : AudioProcessorConstants::DEFAULT_AM_SAMPLING_FREQUENCY;
+
+    // Decimálás ~500 Hz-re (integráló-ürítő)
+    decimationFactor_ = std::max(1, static_cast<int>(std::lround(static_cast<float>(samplingFrequency_) / Psk31Constants::TARGET_DECIMATED_RATE)));
+    decimatedRate_ = static_cast<float>(samplingFrequency_) / decimationFactor_;
+    decimationScale_ = 1.0f / (static_cast<float>(decimationFactor_) * 2048.0f * Psk31Constants::NCO_AMPLITUDE);
+    decimationCount_ = 0;
+    accI_ = 0;
+    accQ_ = 0;
+
+    // Illesztett szűrő: 2 szimbólum hosszú Hann ablak (a PSK31 koszinuszos burkolójához illesztve)
+    samplesPerSymbol_ = decimatedRate_ / Psk31Constants::SYMBOL_RATE;
+    mfLength_ = constrain(static_cast<int>(std::lround(2.0f * samplesPerSymbol_)), 4, Psk31Constants::MAX_MATCHED_FILTER_TAPS);
+    float tapSum = 0.0f;
+    for (uint8_t k = 0; k < mfLength_; k++) {
+        float s = sinf(PI * (k + 0.5f) / mfLength_);
+        mfTaps_[k] = s * s;
+        tapSum += mfTaps_[k];
+    }
+    for (uint8_t k = 0; k < mfLength_; k++) {
+        mfTaps_[k] /= tapSum;
+    }
+    memset(mfBufI_, 0, sizeof(mfBufI_));
+    memset(mfBufQ_, 0, sizeof(mfBufQ_));
+    mfPos_ = 0;
+
+    // Hurkok és szinkron
+    afcHz_ = 0.0f;
+    prevI_ = prevQ_ = 0.0f;
+    inputPower_ = filteredPower_ = 0.0f;
+    snrGate_ = 0.0f;
+    symbolClock_ = 0.0f;
+    midSampleTaken_ = false;
+    midI_ = midQ_ = 0.0f;
+    prevSymI_ = prevSymQ_ = 0.0f;
+    varicodeShiftReg_ = 0;
+    quality_ = 0.0f;
+    signalQualityPercent_ = 0;
+
+    ncoPhase_ = 0;
+    carrierChanged_ = false;
+    updateNcoIncrement();
+
+    DEBUG("Psk31Decoder::reset() -> Fs: %u Hz, decimálás: %u, Fs dec: %d Hz, minta/szimbólum: %d, MF hossz: %u\n", samplingFrequency_, decimationFactor_, static_cast<int>(decimatedRate_),
+          static_cast<int>(samplesPerSymbol_), mfLength_);
+}
+
+/**
+ * @brief A vivő (hangfrekvenciás offset) beállítása (core0-ról hívható)
+ * @param frequencyHz A vivő frekvenciája Hz-ben
+ */
+void Psk31Decoder::setCarrierFrequency(float frequencyHz) {
+    requestedCarrierHz_ = constrain(frequencyHz, Psk31Constants::MIN_CARRIER_FREQUENCY_HZ, Psk31Constants::MAX_CARRIER_FREQUENCY_HZ);
+    trackedFrequencyHz_ = requestedCarrierHz_;
+    carrierChanged_ = true; // A core1 a következő decimált mintánál veszi át
+}
+
+/**
+ * @brief Az NCO lépésköz újraszámítása a kiválasztott vivő és az AFC alapján
+ */
+void Psk31Decoder::updateNcoIncrement() {
+    float frequencyHz = requestedCarrierHz_ + afcHz_;
+    ncoIncrement_ = static_cast<uint32_t>(frequencyHz / samplingFrequency_ * 4294967296.0f);
+    trackedFrequencyHz_ = frequencyHz;
+}
+
+/**
+ * @brief Egy audio minta feldolgozása: NCO keverés és decimálás (fixpontos, teljes mintavételi frekvencián)
+ * @param sample DC-mentes ADC minta
+ */
+void Psk31Decoder::processSample(int16_t sample) {
+
+    const uint8_t idx = ncoPhase_ >> (32 - Psk31Constants::NCO_TABLE_BITS);
+    const int32_t s = sinTable_[idx];
+    const int32_t c = sinTable_[(idx + Psk31Constants::NCO_TABLE_SIZE / 4) & (Psk31Constants::NCO_TABLE_SIZE - 1)];
+    ncoPhase_ += ncoIncrement_;
+
+    // Keverés alapsávba: x * e^(-j*phi)
+    accI_ += sample * c;
+    accQ_ -= sample * s;
+
+    if (++decimationCount_ >= decimationFactor_) {
+        processDecimated(accI_ * decimationScale_, accQ_ * decimationScale_);
+        accI_ = 0;
+        accQ_ = 0;
+        decimationCount_ = 0;
+    }
+}
+
+/**
+ * @brief Decimált komplex minta feldolgozása: illesztett szűrő, AFC és szimbólum szinkron
+ */
+void Psk31Decoder::processDecimated(float i, float q) {
+
+    // Új vivő a core0-ról?
+    if (carrierChanged_) {
+        carrierChanged_ = false;
+        afcHz_ = 0.0f;
+        quality_ = 0.0f;
+        varicodeShiftReg_ = 0;
+        updateNcoIncrement();
+    }
+
+    // 1. Illesztett szűrő (szimmetrikus együtthatók, így a bejárás iránya mindegy)
+    mfBufI_[mfPos_] = i;
+    mfBufQ_[mfPos_] = q;
+    float fi = 0.0f;
+    float fq = 0.0f;
+    uint8_t k = mfPos_;
+    for (uint8_t t = 0; t < mfLength_; t++) {
+        fi += mfTaps_[t] * mfBufI_[k];
+        fq += mfTaps_[t] * mfBufQ_[k];
+        k = (k == 0) ? mfLength_ - 1 : k - 1;
+    }
+    mfPos_ = (mfPos_ + 1 >= mfLength_) ? 0 : mfPos_ + 1;
+
+    // 2. Jel/zaj becslés: szűrt és szűretlen teljesítmény aránya (zajban ~0.1, jelen ~1)
+    const float mag = fi * fi + fq * fq;
+    inputPower_ += POWER_SMOOTHING * ((i * i + q * q) - inputPower_);
+    filteredPower_ += POWER_SMOOTHING * (mag - filteredPower_);
+    snrGate_ = 0.0f;
+    if (inputPower_ > MIN_POWER) {
+        snrGate_ = constrain((filteredPower_ / inputPower_ - SNR_GATE_LOW) / (SNR_GATE_HIGH - SNR_GATE_LOW), 0.0f, 1.0f);
+    }
+
+    // 3. Négyzetre emelős AFC (FLL): a z^2 eltünteti a BPSK modulációt, a forgása 2*delta_f
+    //    A simított teljesítménnyel normálunk (nem a pillanatnyival), így a fázisfordulások
+    //    nullátmeneteinél lévő kis amplitúdójú, bizonytalan fázisú minták alig számítanak
+    const float powerNorm = filteredPower_ * filteredPower_;
+    if (snrGate_ > 0.0f && powerNorm > MIN_POWER * MIN_POWER) {
+        const float wI = fi * fi - fq * fq;
+        const float wQ = 2.0f * fi * fq;
+        const float pwI = prevI_ * prevI_ - prevQ_ * prevQ_;
+        const float pwQ = 2.0f * prevI_ * prevQ_;
+        const float cross = constrain((wQ * pwI - wI * pwQ) / powerNorm, -1.0f, 1.0f); // ~sin(2 * delta_phi) * |z|^4 / P^2
+        afcHz_ += FLL_GAIN * snrGate_ * (1.0f - constrain(quality_, 0.0f, 1.0f)) * cross * decimatedRate_ / (2.0f * TWO_PI);
+        afcHz_ = constrain(afcHz_, -Psk31Constants::AFC_RANGE_HZ, Psk31Constants::AFC_RANGE_HZ);
+        updateNcoIncrement();
+    }
+    prevI_ = fi;
+    prevQ_ = fq;
+
+    // 4. Gardner szimbólum szinkron
+    symbolClock_ += 1.0f;
+    if (!midSampleTaken_ && symbolClock_ >= samplesPerSymbol_ * 0.5f) {
+        midI_ = fi;
+        midQ_ = fq;
+        midSampleTaken_ = true;
+    }
+
+    if (symbolClock_ >= samplesPerSymbol_) {
+        symbolClock_ -= samplesPerSymbol_;
+        midSampleTaken_ = false;
+
+        // Késői mintavétel esetén a hiba pozitív -> előrébb hozzuk a következő döntést
+        const float norm = mag + prevSymI_ * prevSymI_ + prevSymQ_ * prevSymQ_;
+        if (norm > MIN_POWER) {
+            const float timingError = ((fi - prevSymI_) * midI_ + (fq - prevSymQ_) * midQ_) / norm;
+            symbolClock_ += constrain(TIMING_GAIN * timingError * samplesPerSymbol_, -MAX_TIMING_STEP, MAX_TIMING_STEP);
+        }
+
+        processSymbol(fi, fq);
+    }
+}
+
+/**
+ * @brief Szimbólum döntés: Costas hurok, differenciális demoduláció és jelminőség
+ */
+void Psk31Decoder::processSymbol(float i, float q) {
+
+    // Costas hurok: BPSK fázishiba ~0.5*sin(2*phi), független a modulációtól (zajban nem mozdítjuk)
+    const float mag = i * i + q * q;
+    if (snrGate_ > 0.0f && mag > MIN_POWER) {
+        const float phaseError = snrGate_ * (i * q) / mag;
+        ncoPhase_ += static_cast<int32_t>(COSTAS_PHASE_GAIN * phaseError * PHASE_TO_NCO);
+        afcHz_ += COSTAS_FREQ_GAIN * phaseError * Psk31Constants::SYMBOL_RATE / TWO_PI;
+        afcHz_ = constrain(afcHz_, -Psk31Constants::AFC_RANGE_HZ, Psk31Constants::AFC_RANGE_HZ);
+        updateNcoIncrement();
+    }
+
+    // Differenciális döntés: nincs fázisfordulás -> '1', fázisfordulás -> '0'
+    const float dRe = i * prevSymI_ + q * prevSymQ_;
+    const float dIm = q * prevSymI_ - i * prevSymQ_;
+    const float dMag = dRe * dRe + dIm * dIm;
+    if (dMag > MIN_POWER) {
+        // cos(2*dphi): tiszta jelnél ~1, zajnál ~0 átlagosan
+        quality_ += QUALITY_SMOOTHING * ((dRe * dRe - dIm * dIm) / dMag - quality_);
+    }
+    prevSymI_ = i;
+    prevSymQ_ = q;
+
+    signalQualityPercent_ = static_cast<uint8_t>(constrain(quality_ * 100.0f, 0.0f, 100.0f));
+
+    decodeBit(dRe >= 0.0f ? 1 : 0);
+}
+
+/**
+ * @brief Varicode bit feldolgozása, két egymást követő '0' bit zárja a karaktert
+ */
+void Psk31Decoder::decodeBit(uint8_t bit) {
+
+    varicodeShiftReg_ = (varicodeShiftReg_ << 1) | bit;
+
+    if ((varicodeShiftReg_ & 0x03) == 0) {
+        uint16_t code = varicodeShiftReg_ >> 2;
+        varicodeShiftReg_ = 0;
+
+        // Squelch: zajban nem szemetelünk
+        if (code != 0 && quality_ >= Psk31Constants::SQUELCH_THRESHOLD) {
+            char c = varicodeToAscii(code);
+            if (c != 0) {
+                pushDecodedChar(c);
+            }
+        }
+    } else {
+        // A leghosszabb varicode 10 bites, a túl hosszú sorozat úgyis érvénytelen lesz
+        varicodeShiftReg_ &= 0x1FFF;
+    }
+}
+
+/**
+ * @brief Varicode -> ASCII konverzió
+ * @return A karakter, vagy 0 ha érvénytelen / nem megjeleníthető
+ */
+char Psk31Decoder::varicodeToAscii(uint16_t code) {
+    for (uint8_t ch = 0; ch < 128; ch++) {
+        if (VARICODE_TABLE[ch] == code) {
+            if (ch == '\n') {
+                return '\n';
+            }
+            return (ch >= ' ' && ch < 127) ? static_cast<char>(ch) : 0; // CR és vezérlőkarakterek eldobva
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,129 @@
+#include "ScanHistory.h"
+#include <algorithm>
+
+using namespace ScanHistoryConstants;
+
+/**
+ * @brief Konstruktor
+ */
+ScanHistory::ScanHistory()
+    : startFreq_(0),   //
+      endFreq_(0),     //
+      head_(ROWS - 1), //
+      count_(0) {
+    reset(0, 0);
+}
+
+/**
+ * @brief A történet és a statisztika törlése, az oszlopok frekvencia tartományának beállítása
+ */
+void ScanHistory::reset(uint32_t startFreq, uint32_t endFreq) {
+    startFreq_ = startFreq;
+    endFreq_ = endFreq;
+    head_ = ROWS - 1;
+    count_ = 0;
+    memset(rowSweeps_, 0, sizeof(rowSweeps_));
+    memset(statMax_, 0, sizeof(statMax_));
+    memset(statSum_, 0, sizeof(statSum_));
+    memset(statSweeps_, 0, sizeof(statSweeps_));
+    memset(statActive_, 0, sizeof(statActive_));
+}
+
+/**
+ * @brief Egy sweep hozzáadása (tele puffernél előbb két régebbi sor összevonódik)
+ */
+void ScanHistory::addSweep(const uint8_t *columns) {
+    if (count_ >= ROWS) {
+        decimate();
+    }
+    head_ = (head_ + 1) % ROWS;
+    memcpy(rows_[head_], columns, COLUMNS);
+    rowSweeps_[head_] = 1;
+    count_++;
+
+    updateStats(columns);
+}
+
+/**
+ * @brief Egy sor felszabadítása két szomszédos sor összevonásával
+ * @details Csak a régebbi fele vonódik össze, az újabb fele mindig sweep-enként megmarad. Ott a legkevesebb
+ *          sweep-et együtt tartalmazó szomszédos pár kerül sorra (egyenlőségnél a régebbi), ha az eredmény nem hosszabb
+ *          a nála régebbi sornál: így a sorok időtartama a kor felé haladva nem csökken (2, 4, 8... sweep).
+ *          Az összevont sor a régebbi helyére kerül, az újabb sorok egy hellyel hátrébb csúsznak.
+ */
+void ScanHistory::decimate() {
+    uint8_t pairAge = count_ - 2; // A pár újabb sorának kora
+    uint32_t pairSweeps = UINT32_MAX;
+    for (uint8_t age = count_ / 2; age + 1 < count_; age++) {
+        uint32_t sweeps = getRowSweeps(age) + getRowSweeps(age + 1);
+        bool ordered = age + 2 >= count_ || sweeps <= getRowSweeps(age + 2); // Az összevont sor ne legyen hosszabb a nála régebbinél
+        if (ordered && sweeps <= pairSweeps) {
+            pairSweeps = sweeps;
+            pairAge = age;
+        }
+    }
+
+    // Oszloponként a maximum, a nem mért oszlop nem számít
+    uint8_t *older = rows_[rowIndex(pairAge + 1)];
+    const uint8_t *newer = rows_[rowIndex(pairAge)];
+    for (uint16_t c = 0; c < COLUMNS; c++) {
+        if (older[c] == NO_DATA || (newer[c] != NO_DATA && newer[c] > older[c])) {
+            older[c] = newer[c];
+        }
+    }
+    rowSweeps_[rowIndex(pairAge + 1)] = std::min<uint32_t>(pairSweeps, UINT16_MAX);
+
+    // Az újabb sorok hátrébb csúsznak, a legújabb hely felszabadul
+    for (uint8_t age = pairAge; age > 0; age--) {
+        memcpy(rows_[rowIndex(age)], rows_[rowIndex(age - 1)], COLUMNS);
+        rowSweeps_[rowIndex(age)] = rowSweeps_[rowIndex(age - 1)];
+    }
+    head_ = (head_ + ROWS - 1) % ROWS;
+    count_--;
+}
+
+/**
+ * @brief Az oszloponkénti statisztika frissítése egy sweep-pel
+ * @details Aktív az oszlop, ha legalább ACTIVE_MARGIN_DB-vel a sweep mért oszlopainak mediánja (a sáv zajszintje) felett van
+ */
+void ScanHistory::updateStats(const uint8_t *columns) {
+    uint8_t measured[COLUMNS];
+    uint16_t measuredCount = 0;
+    for (uint16_t c = 0; c < COLUMNS; c++) {
+        if (columns[c] != NO_DATA) {
+            measured[measuredCount++] = columns[c];
+        }
+    }
+    if (measuredCount == 0) {
+        return;
+    }
+    std::nth_element(measured, measured + measuredCount / 2, measured + measuredCount);
+    const uint16_t activeLevel = measured[measuredCount / 2] + ACTIVE_MARGIN_DB;
+
+    for (uint16_t c = 0; c < COLUMNS; c++) {
+        if (columns[c] == NO_DATA || statSweeps_[c] == UINT16_MAX) {
+            continue;
+        }
+        statMax_[c] = std::max(statMax_[c], columns[c]);
+        statSum_[c] += columns[c];
+        statSweeps_[c]++;
+        if (columns[c] >= activeLevel) {
+            statActive_[c]++;
+        }
+    }
+}
+
+/**
+ * @brief Egy frekvencia oszlop statisztikája
+ */
+ScanHistoryStats ScanHistory::getStats(uint16_t column) const {
+    ScanHistoryStats stats = {};
+    if (column >= COLUMNS || statSweeps_[column] == 0) {
+        return stats;
+    }
+    stats.rssiMax = statMax_[column];
+    stats.rssiMean = (statSum_[column] + statSweeps_[column] / 2) / statSweeps_[column];
+    stats.activePercent = (statActive_[column] * 100u + statSweeps_[column] / 2) / statSweeps_[column];
+    stats.sweeps = statSweeps_[column];
+    return stats;
+}
@@ -0,0 +1,111 @@
+#include "ScanModel.h"
+#include "defines.h"
+
+using namespace ScanModelConstants;
+
+ScanModel *ScanModel::pInstance_ = nullptr;
+
+/**
+ * @brief A közös példány (az első hívásnál jön létre)
+ * @details A nézet pontjai (~2.8 kB) csak a pásztázás első használatakor foglalódnak le, a piramis és a történet a reset()-kor
+ */
+ScanModel &ScanModel::get() {
+    if (!pInstance_) {
+        pInstance_ = new ScanModel();
+    }
+    return *pInstance_;
+}
+
+/**
+ * @brief A piramis és a sweep történet felszabadítása, ha a tárolt adat már nem kell
+ */
+void ScanModel::releaseIfUnused(uint8_t currentBandIndex) {
+    if (!pInstance_ || !pInstance_->pPyramid_) {
+        return;
+    }
+    if (pInstance_->view_.bandIndex != currentBandIndex) {
+        DEBUG("ScanModel: sávváltás, piramis és történet felszabadítva\n");
+        pInstance_->release();
+    } else if (rp2040.getFreeHeap() < RELEASE_FREE_HEAP) {
+        DEBUG("ScanModel: kevés a szabad heap (%u B), piramis és történet felszabadítva\n", static_cast<unsigned>(rp2040.getFreeHeap()));
+        pInstance_->release();
+    }
+}
+
+/**
+ * @brief Konstruktor
+ * @details Piramis és történet nélkül indul, az első reset() foglalja le őket
+ */
+ScanModel::ScanModel() : pPyramid_(nullptr), pHistory_(nullptr), view_{}, valid_(false) {
+    memset(rssi_, 0, sizeof(rssi_));
+    memset(snr_, 0, sizeof(snr_));
+    memset(state_, 0, sizeof(state_));
+    memset(signalClass_, 0, sizeof(signalClass_));
+}
+
+/**
+ * @brief A piramis és a sweep történet felszabadítása, a tárolt adat érvénytelenné válik
+ */
+void ScanModel::release() {
+    delete pPyramid_;
+    pPyramid_ = nullptr;
+    delete pHistory_;
+    pHistory_ = nullptr;
+    valid_ = false;
+}
+
+/**
+ * @brief Az összes adat törlése és a lefedett sáv beállítása
+ * @details A nézet a teljes sáv lesz 1.0x zoommal, mért adat nélkül
+ */
+void ScanModel::reset(uint8_t bandIndex, uint32_t bandStartFreq, uint32_t bandEndFreq) {
+    memset(rssi_, 0, sizeof(rssi_));
+    memset(snr_, 0, sizeof(snr_));
+    memset(state_, 0, sizeof(state_)); // ScanPointState::None
+    memset(signalClass_, 0, sizeof(signalClass_));
+    mark_.reset();
+    refine_.reset();
+    if (!pPyramid_) {
+        pPyramid_ = new ScanPyramid();
+    }
+    if (!pHistory_) {
+        pHistory_ = new ScanHistory();
+    }
+    pPyramid_->reset(bandStartFreq, bandEndFreq);
+    pHistory_->reset(bandStartFreq, bandEndFreq);
+
+    view_ = {};
+    view_.bandIndex = bandIndex;
+    view_.startFreq = bandStartFreq;
+    view_.endFreq = bandEndFreq;
+    view_.zoomLevel = 1.0f;
+    view_.cursorFreq = bandStartFreq;
+    valid_ = true;
+}
+
+/**
+ * @brief Egy pont törlése (nincs adat, nincs jelzés)
+ */
+void ScanModel::clearPoint(uint16_t pos) {
+    rssi_[pos] = 0;
+    snr_[pos] = 0;
+    setState(pos, ScanPointState::None);
+    setSignalClass(pos, 0);
+    mark_[pos] = false;
+}
+
+/**
+ * @brief Egy pont adatának eredete (2 bit)
+ */
+void ScanModel::setState(uint16_t pos, ScanPointState state) {
+    uint8_t shift = (pos & 3) * 2;
+    state_[pos >> 2] = (state_[pos >> 2] & ~(0x03 << shift)) | ((static_cast<uint8_t>(state) & 0x03) << shift);
+}
+
+/**
+ * @brief Egy pont jeltípusa (4 bit)
+ */
+void ScanModel::setSignalClass(uint16_t pos, uint8_t signalClass) {
+    uint8_t shift = (pos & 1) * 4;
+    signalClass_[pos >> 1] = (signalClass_[pos >> 1] & ~(0x0F << shift)) | ((signalClass & 0x0F) << shift);
+}
@@ -0,0 +1,123 @@
+#include "ScanPyramid.h"
+#include <algorithm>
+
+using namespace ScanPyramidConstants;
+
+/**
+ * @brief Konstruktor
+ */
+ScanPyramid::ScanPyramid()
+    : bandStartFreq_(0), //
+      bandSpan_(1) {
+    reset(0, 1);
+}
+
+/**
+ * @brief Az összes adat törlése és a lefedett sáv beállítása
+ */
+void ScanPyramid::reset(uint32_t bandStartFreq, uint32_t bandEndFreq) {
+    bandStartFreq_ = bandStartFreq;
+    bandSpan_ = bandEndFreq > bandStartFreq ? bandEndFreq - bandStartFreq : 1;
+    memset(cells_, 0, sizeof(cells_)); // count = 0, state = None
+}
+
+/**
+ * @brief Frekvencia -> alap cella index (a sávon kívül a szélső cella)
+ */
+uint16_t ScanPyramid::freqToBaseCell(uint32_t freq) const {
+    if (freq <= bandStartFreq_) {
+        return 0;
+    }
+    uint32_t index = (freq - bandStartFreq_) * BASE_CELLS / bandSpan_;
+    return index < BASE_CELLS ? index : BASE_CELLS - 1;
+}
+
+/**
+ * @brief Egy cella hozzáadása az összesítéshez
+ * @details Az átlag a mért alap cellák számával súlyozott, a jeltípus a nagyobb SNR-ű oldalé
+ */
+void ScanPyramid::merge(ScanCell &target, const ScanCell &source) {
+    if (source.count == 0) {
+        return;
+    }
+    if (target.count == 0) {
+        target = source;
+        return;
+    }
+    uint16_t count = target.count + source.count;
+    target.rssiMean = (target.rssiMean * target.count + source.rssiMean * source.count + count / 2) / count;
+    target.rssiMin = std::min(target.rssiMin, source.rssiMin);
+    target.rssiMax = std::max(target.rssiMax, source.rssiMax);
+    if (source.snrMax > target.snrMax) {
+        target.snrMax = source.snrMax;
+        target.signalClass = source.signalClass;
+    }
+    target.state = std::min(target.state, source.state);
+    target.count = std::min<uint16_t>(count, 0xFF);
+}
+
+/**
+ * @brief Egy alap cella felmenőinek újraösszesítése (szintenként egy cella a két gyerekéből)
+ */
+void ScanPyramid::propagate(uint16_t baseIndex) {
+    uint16_t index = baseIndex;
+    for (uint8_t level = 1; level < LEVELS; level++) {
+        const ScanCell *children = &cells_[levelOffset(level - 1) + (index & ~1)];
+        index >>= 1;
+        ScanCell &parent = cells_[levelOffset(level) + index];
+        parent = children[0];
+        merge(parent, children[1]);
+    }
+}
+
+/**
+ * @brief Egy mérés eltárolása
+ */
+void ScanPyramid::store(uint32_t freq, uint8_t rssi, uint8_t snr, ScanPointState state) {
+    uint16_t index = freqToBaseCell(freq);
+    ScanCell &cell = cells_[index];
+    uint8_t signalClass = cell.count > 0 ? cell.signalClass : 0; // A jeltípust csak a következő osztályozás írja felül
+    cell = {rssi, rssi, rssi, snr, 1, signalClass, state};
+    propagate(index);
+}
+
+/**
+ * @brief A jeltípus eltárolása egy már mért alap cellához
+ */
+void ScanPyramid::setSignalClass(uint32_t freq, uint8_t signalClass) {
+    uint16_t index = freqToBaseCell(freq);
+    if (cells_[index].count == 0) {
+        return;
+    }
+    cells_[index].signalClass = signalClass;
+    propagate(index);
+}
+
+/**
+ * @brief A [fromFreq, toFreq) tartomány összesítése
+ * @details Az a legdurvább szint, amelynek cellája még nem szélesebb a tartománynál: egy nézet pontra 1-3 cella
+ */
+ScanCell ScanPyramid::query(uint32_t fromFreq, uint32_t toFreq) const {
+    uint16_t first = freqToBaseCell(fromFreq);
+    uint16_t last = toFreq > fromFreq ? freqToBaseCell(toFreq - 1) : first;
+
+    uint8_t level = 0;
+    while (level + 1 < LEVELS && (2u << level) <= static_cast<uint16_t>(last - first + 1)) {
+        level++;
+    }
+
+    // Az átlag itt pontos összegből számolódik (a páronkénti kerekítés sok cellánál elvándorolna)
+    ScanCell result = {};
+    uint32_t rssiSum = 0;
+    uint16_t count = 0;
+    const ScanCell *cells = &cells_[levelOffset(level)];
+    for (uint16_t i = first >> level; i <= (last >> level); i++) {
+        merge(result, cells[i]);
+        rssiSum += cells[i].rssiMean * cells[i].count;
+        count += cells[i].count;
+    }
+    if (count > 0) {
+        result.rssiMean = (rssiSum + count / 2) / count;
+    }
+    return result;
+}
@@ -3,6 +3,7 @@
 #include "MultiButtonDialog.h"
 
 #include <RPi_Pico_TimerInterrupt.h>
+#include <algorithm>
 extern RPI_PICO_Timer audioDecoderTimer;
 constexpr int AUDIO_DECODER_TIMER_INTERVAL = 10; // Audio dekóder időzítő intervallum (másodpercben)
 
@@ -13,11 +14,8 @@ ScreenAM *ScreenAM::that = nullptr;
  * @brief  Hardware timer interrupt service routine az audio dekóder számára
  */
 bool audioDecoderTimerHardwareInterruptHandler(struct repeating_timer *t) {
+    // Csak jelzünk, a dekóder a handleOwnLoop()-ban fut (String műveletek nem valók megszakításba)
     ScreenAM::audioDecoderRun = true;
-
-    // Audio dekóder feldolgozása
-    ScreenAM::processAudioDecoder();
-
     return true;
 }
 
@@ -46,7 +44,7 @@ void ScreenAM::processAudioDecoder() {
 
             // Ha a CW dekóder mód aktív
             if (currentMode == SpectrumVisualizationComponent::DisplayMode::CWWaterfall) {
-                // ScreenAM::that->cwDecoder->processFftData(magnitudeData, fftSize, binWidth);
+                ScreenAM::that->cwDecoder->processFftData(magnitudeData, fftSize, binWidth);
             }
         }
     }
@@ -60,16 +58,18 @@ void ScreenAM::processAudioDecoder() {
  * @brief AM képernyő specifikus vízszintes gomb azonosítók
  * @details Alsó vízszintes gombsor - AM specifikus funkcionalitás
  *
- * **ID tartomány**: 70-74 (nem ütközik a közös 50-52 és FM 60-61 tartománnyal)
+ * **ID tartomány**: 70-76 (nem ütközik a közös 50-52 és FM 60-62 tartománnyal)
  * **Funkció**: AM specifikus rádió funkciók
  * **Gomb típus**: Pushable (egyszeri nyomás → funkció végrehajtása)
  */
 namespace ScreenAMHorizontalButtonIDs {
-static constexpr uint8_t BFO_BUTTON = 70;    ///< Beat Frequency Oscillator
-static constexpr uint8_t AFBW_BUTTON = 71;   ///< Audio Filter Bandwidth
-static constexpr uint8_t ANTCAP_BUTTON = 72; ///< Antenna Capacitor
-static constexpr uint8_t DEMOD_BUTTON = 73;  ///< Demodulation
-static constexpr uint8_t STEP_BUTTON = 74;   ///< Frequency Step
+static constexpr uint8_t BFO_BUTTON = 70;      ///< Beat Frequency Oscillator
+static constexpr uint8_t AFBW_BUTTON = 71;     ///< Audio Filter Bandwidth
+static constexpr uint8_t ANTCAP_BUTTON = 72;   ///< Antenna Capacitor
+static constexpr uint8_t DEMOD_BUTTON = 73;    ///< Demodulation
+static constexpr uint8_t STEP_BUTTON = 74;     ///< Frequency Step
+static constexpr uint8_t VIEWS_BUTTON = 75;    ///< Full-screen views (WEFAX, waterfall, analyzer, NAVTEX)
+static constexpr uint8_t ZEROBEAT_BUTTON = 76; ///< CW auto zero-beat
 } // namespace ScreenAMHorizontalButtonIDs
 
 // =====================================================================
@@ -324,6 +324,12 @@ void ScreenAM::handleOwnLoop() {
     // ===================================================================
     updateSMeter(false /* AM mód */);
 
+    // Az időzítő jelzésére a dekóder futtatása
+    if (audioDecoderRun) {
+        audioDecoderRun = false;
+        processAudioDecoder();
+    }
+
     // Spektrum és dekóder frissítés
     if (spectrumComp && cwDecoder && decodedTextBox) {
         SpectrumVisualizationComponent::DisplayMode currentMode = spectrumComp->getCurrentMode();
@@ -332,22 +338,69 @@ void ScreenAM::handleOwnLoop() {
         if (currentMode != lastSpectrumMode_) {
             if (currentMode == SpectrumVisualizationComponent::DisplayMode::CWWaterfall) {
                 cwDecoder->clear();
+                decodedTextBox->setStreamMode(true);
+            } else if (currentMode == SpectrumVisualizationComponent::DisplayMode::PSKWaterfall) {
+                if (Psk31Decoder *pskDecoder = AudioCore1Manager::getPsk31Decoder()) {
+                    pskDecoder->flushDecodedText();
+                }
+                decodedTextBox->setStreamMode(true);
+            } else if (currentMode == SpectrumVisualizationComponent::DisplayMode::NAVTEXWaterfall) {
+                if (NavtexDecoder *navtexDecoder = AudioCore1Manager::getNavtexDecoder()) {
+                    navtexDecoder->flushDecodedText();
+                }
+                decodedTextBox->setStreamMode(true);
+            } else if (currentMode == SpectrumVisualizationComponent::DisplayMode::CWSkimmer) {
+                skimmerChangeCounter_ = 0;
+                decodedTextBox->setStreamMode(false); // A csatornalista teljes újrarajzolással frissül
                 decodedTextBox->setText("");
             }
             lastSpectrumMode_ = currentMode;
         }
 
+        // Ha a PSK31 dekóder mód aktív: a core1-en dekódolt karakterek hozzáfűzése
+        if (currentMode == SpectrumVisualizationComponent::DisplayMode::PSKWaterfall) {
+            if (Psk31Decoder *pskDecoder = AudioCore1Manager::getPsk31Decoder()) {
+                char c;
+                while (pskDecoder->popDecodedChar(c)) {
+                    decodedTextBox->appendChar(c); // Csak az új karakterek rajzolódnak ki
+                }
+            }
+        }
+
+        // Ha a NAVTEX dekóder mód aktív: az élő szöveg hozzáfűzése (a teljes üzenetek a dekóder tárában)
+        if (currentMode == SpectrumVisualizationComponent::DisplayMode::NAVTEXWaterfall) {
+            if (NavtexDecoder *navtexDecoder = AudioCore1Manager::getNavtexDecoder()) {
+                char c;
+                while (navtexDecoder->popDecodedChar(c)) {
+                    decodedTextBox->appendChar(c);
+                }
+            }
+        }
+
+        // Ha a CW skimmer mód aktív: a csatornák listája
+        if (currentMode == SpectrumVisualizationComponent::DisplayMode::CWSkimmer) {
+            updateCwSkimmerList();
+        }
+
         // Ha a CW dekóder mód aktív
         if (currentMode == SpectrumVisualizationComponent::DisplayMode::CWWaterfall) {
 
-            // A Dekódolt szöveg (vagy debug állapot) lekérése és megjelenítése
-            if (cwDecoder) {
-                String newText = cwDecoder->getDecodedText();
-                if (newText != decodedTextBox->getText()) {
-                    decodedTextBox->setText(newText);
-                }
+            // Az AFC által követett hang átadása a hangolássegédnek
+            spectrumComp->setCwLockedFrequencyHz(cwDecoder->getLockedFrequencyHz());
+
+            // Az új dekódolt szöveg hozzáfűzése a szövegdobozhoz
+            String newText;
+            if (cwDecoder->takeDecodedText(newText)) {
+                decodedTextBox->appendText(newText.c_str());
             }
         }
+
+        // A ZBeat gomb csak zárt AFC mellett aktív
+        bool zeroBeatReady = currentMode == SpectrumVisualizationComponent::DisplayMode::CWWaterfall && ::pSi4735Manager->isCurrentDemodCW() && cwDecoder->isAfcLocked();
+        if (zeroBeatReady != cwZeroBeatReady_) {
+            cwZeroBeatReady_ = zeroBeatReady;
+            updateZeroBeatButtonState();
+        }
     }
 }
 
@@ -427,6 +480,9 @@ void ScreenAM::layoutComponents() {
     // CW Dekóder példányosítása
     cwDecoder = std::make_shared<CwDecoder>();
 
+    // CW hangolássegéd rövid érintése: auto zero-beat az AFC által követett hangra
+    spectrumComp->setCwZeroBeatCallback([this]() { handleCwZeroBeat(); });
+
     // Dekódolt szöveg doboz létrehozása
     Rect textBoxBounds(2, 165, 405, 75); // Pozíció
     decodedTextBox = std::make_shared<UITextBox>(textBoxBounds, "");
@@ -435,6 +491,75 @@ void ScreenAM::layoutComponents() {
     addChild(decodedTextBox);
 }
 
+/**
+ * @brief ZBeat gomb eseménykezelő - CW auto zero-beat
+ */
+void ScreenAM::handleZeroBeatButton(const UIButton::ButtonEvent &event) {
+    if (event.state == UIButton::EventButtonState::Clicked) {
+        handleCwZeroBeat();
+    }
+}
+
+/**
+ * @brief CW auto zero-beat: a BFO-val a követett hangot a beállított CW offsetre hangolja
+ * @details A ZBeat gombra és a CW hangolássegéd rövid érintésére hívódik
+ */
+void ScreenAM::handleCwZeroBeat() {
+
+    if (!cwDecoder || !cwDecoder->isAfcLocked()) {
+        DEBUG("ScreenAM::handleCwZeroBeat() - Nincs AFC zárás, nincs mire hangolni\n");
+        return;
+    }
+
+    if (::pSi4735Manager->cwZeroBeat(cwDecoder->getLockedFrequencyHz())) {
+        // Az új hangolás után a hang a CW offseten lesz, az AFC onnan fog újra befogni
+        cwDecoder->resetAfc();
+        if (freqDisplayComp) {
+            freqDisplayComp->setFrequency(::pSi4735Manager->getSi4735().getCurrentFrequency(), true);
+        }
+    }
+}
+
+/**
+ * @brief A CW skimmer csatornáinak listája a szövegdobozba
+ * @details Csak változás esetén és ritkítva frissít, mert a teljes szövegdoboz újrarajzolódik
+ */
+void ScreenAM::updateCwSkimmerList() {
+
+    constexpr uint32_t SKIMMER_LIST_UPDATE_INTERVAL_MS = 250;
+
+    CwSkimmer *skimmer = AudioCore1Manager::getCwSkimmer();
+    if (!skimmer || !decodedTextBox) {
+        return;
+    }
+    uint32_t changeCounter = skimmer->getChangeCounter();
+    if (changeCounter == skimmerChangeCounter_ || millis() - skimmerListUpdateMs_ < SKIMMER_LIST_UPDATE_INTERVAL_MS) {
+        return;
+    }
+    skimmerChangeCounter_ = changeCounter;
+    skimmerListUpdateMs_ = millis();
+
+    // Soronként egy csatorna, frekvencia szerint növekvő sorrendben
+    CwSkimmer::ChannelInfo infos[CwSkimmerConstants::MAX_CHANNELS];
+    uint8_t count = 0;
+    for (uint8_t slot = 0; slot < CwSkimmerConstants::MAX_CHANNELS; slot++) {
+        if (skimmer->getChannelInfo(slot, infos[count])) {
+            count++;
+        }
+    }
+    std::sort(infos, infos + count, [](const CwSkimmer::ChannelInfo &a, const CwSkimmer::ChannelInfo &b) { return a.frequencyHz < b.frequencyHz; });
+
+    String list;
+    char header[16];
+    for (uint8_t i = 0; i < count; i++) {
+        snprintf(header, sizeof(header), "%4u %2uw ", infos[i].frequencyHz, infos[i].wpm);
+        list += header;
+        list += infos[i].text;
+        list += '\n';
+    }
+    decodedTextBox->setText(list);
+}
+
 /**
  * @brief AM specifikus gombok hozzáadása a közös gombokhoz
  * @param buttonConfigs A már meglévő gomb konfigurációk vektora
@@ -458,6 +583,13 @@ void ScreenAM::addSpecificHorizontalButtons(std::vector<UIHorizontalButtonBar::B
 
     // 5. Step - Frequency Step
     buttonConfigs.push_back({ScreenAMHorizontalButtonIDs::STEP_BUTTON, "Step", UIButton::ButtonType::Pushable, UIButton::ButtonState::Off, [this](const UIButton::ButtonEvent &event) { handleStepButton(event); }});
+
+    // 6. Views - A teljes képernyős nézetek (WEFAX, waterfall, analizátor, NAVTEX) egy választó dialógusból,
+    //    így a gombsor két sorban marad és nem takarja a dekódolt szöveg dobozt
+    buttonConfigs.push_back({ScreenAMHorizontalButtonIDs::VIEWS_BUTTON, "Views", UIButton::ButtonType::Pushable, UIButton::ButtonState::Off, [this](const UIButton::ButtonEvent &event) { handleViewsButton(event); }});
+
+    // 7. ZBeat - CW auto zero-beat (a hangolássegéd rövid érintése ugyanezt teszi)
+    buttonConfigs.push_back({ScreenAMHorizontalButtonIDs::ZEROBEAT_BUTTON, "ZBeat", UIButton::ButtonType::Pushable, UIButton::ButtonState::Disabled, [this](const UIButton::ButtonEvent &event) { handleZeroBeatButton(event); }});
 }
 
 // =====================================================================
@@ -489,6 +621,7 @@ void ScreenAM::updateHorizontalButtonStates() {
     horizontalButtonBar->setButtonState(ScreenAMHorizontalButtonIDs::AFBW_BUTTON, UIButton::ButtonState::Off);
     horizontalButtonBar->setButtonState(ScreenAMHorizontalButtonIDs::ANTCAP_BUTTON, UIButton::ButtonState::Off);
     horizontalButtonBar->setButtonState(ScreenAMHorizontalButtonIDs::DEMOD_BUTTON, UIButton::ButtonState::Off);
+    updateZeroBeatButtonState();
 
     // ===================================================================
     // Step gomb speciális logika: használjuk a dedikált metódust
@@ -543,6 +676,18 @@ void ScreenAM::updateBFOButtonState() {
     horizontalButtonBar->setButtonState(ScreenAMHorizontalButtonIDs::BFO_BUTTON, bfoButtonState);
 }
 
+/**
+ * @brief ZBeat gomb állapotának frissítése
+ * @details Csak CW dekóder módban, zárt AFC mellett engedélyezett (különben nincs mire hangolni)
+ */
+void ScreenAM::updateZeroBeatButtonState() {
+    if (!horizontalButtonBar) {
+        return; // Biztonsági ellenőrzés
+    }
+
+    horizontalButtonBar->setButtonState(ScreenAMHorizontalButtonIDs::ZEROBEAT_BUTTON, cwZeroBeatReady_ ? UIButton::ButtonState::Off : UIButton::ButtonState::Disabled);
+}
+
 // =====================================================================
 // AM specifikus gomb eseménykezelők
 // =====================================================================
@@ -807,6 +952,38 @@ void ScreenAM::handleStepButton(const UIButton::ButtonEvent &event) {
     this->showDialog(stepDialog);
 }
 
+/**
+ * @brief Views gomb eseménykezelő - a teljes képernyős nézetek választó dialógusa
+ * @param event Gomb esemény (Clicked)
+ * @details A WEFAX és a NAVTEX képernyő a saját dekóderét maga kapcsolja be a core1-en, a waterfall és az analizátor
+ *          a saját FFT méretét állítja be. Visszalépéskor az AM képernyő újra létrejön és a spektrum módjának megfelelő
+ *          FFT méretet és dekódert állítja vissza.
+ */
+void ScreenAM::handleViewsButton(const UIButton::ButtonEvent &event) {
+    if (event.state != UIButton::EventButtonState::Clicked) {
+        return;
+    }
+
+    static const char *labels[] = {"WEFAX", "Waterfall", "Analyzer", "NAVTEX"};
+    static const char *screenNames[] = {SCREEN_NAME_WEFAX, SCREEN_NAME_WATERFALL, SCREEN_NAME_ANALYZER, SCREEN_NAME_NAVTEX};
+
+    auto viewsDialog = std::make_shared<MultiButtonDialog>(
+        this,                                                                         // Képernyő referencia
+        "Views", "",                                                                  // Dialógus címe és üzenete
+        labels, ARRAY_ITEM_COUNT(labels),                                             // Gombok feliratai és számuk
+        [this](int buttonIndex, const char *buttonLabel, MultiButtonDialog *dialog) { // Gomb kattintás kezelése
+            // Eseménykezelés közben a ScreenManager halasztva vált, a dialógus még biztonságosan bezárul
+            getScreenManager()->switchToScreen(screenNames[buttonIndex]);
+        },
+        true,                  // Automatikusan bezárja-e a dialógust gomb kattintáskor
+        -1,                    // Nincs alapértelmezett gomb
+        false,                 // Az alapértelmezett gomb nincs letiltva
+        Rect(-1, -1, 320, 100) // Dialógus mérete (ha -1, akkor automatikusan a képernyő közepére igazítja)
+    );
+
+    this->showDialog(viewsDialog);
+}
+
 /**
  * @brief Frissíti a FreqDisplay szélességét az aktuális band típus alapján
  * @details Dinamikusan állítja be a frekvencia kijelző szélességét
@@ -0,0 +1,390 @@
+/**
+ * @file ScreenAnalyzer.cpp
+ * @brief Teljes képernyős audio spektrum analizátor képernyő implementáció
+ */
+
+#include "ScreenAnalyzer.h"
+#include "AudioCore1Manager.h"
+#include "Config.h"
+#include "ScreenManager.h"
+#include "Si4735Manager.h"
+#include "TftHardwareScroll.h"
+#include "WaterfallPalette.h"
+#include "defines.h"
+#include "utils.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+/**
+ * @brief Konstruktor
+ */
+ScreenAnalyzer::ScreenAnalyzer()
+    : UIScreen(SCREEN_NAME_ANALYZER),                      //
+      columnWriter_(ScreenAnalyzerConstants::FIXED_WIDTH), //
+      maxFreqHz_(ScreenAnalyzerConstants::MAX_FREQ_AM_HZ), //
+      startHz_(ScreenAnalyzerConstants::MIN_FREQ_HZ),      //
+      zoomLevel_(0),                                       //
+      cursorRow_(ScreenAnalyzerConstants::AXIS_ROWS / 2),  //
+      touchStartY_(0),                                     //
+      touchHoldY_(0),                                      //
+      lastHoldPollMs_(0),                                  //
+      touchActive_(false),                                 //
+      lastReadoutMs_(0),                                   //
+      binMap_() {
+    memset(rowUnits_, 0, sizeof(rowUnits_));
+    invalidateBars();
+}
+
+/**
+ * @brief Képernyő aktiválása: teljes tartomány, FFT méret beállítása, a dekóderek leválasztása
+ */
+void ScreenAnalyzer::activate() {
+    UIScreen::activate();
+
+    const bool isFm = ::pSi4735Manager && ::pSi4735Manager->isCurrentDemodFM();
+    maxFreqHz_ = isFm ? ScreenAnalyzerConstants::MAX_FREQ_FM_HZ : ScreenAnalyzerConstants::MAX_FREQ_AM_HZ;
+    setView(ScreenAnalyzerConstants::MIN_FREQ_HZ, 0);
+    cursorRow_ = ScreenAnalyzerConstants::AXIS_ROWS / 2;
+    touchActive_ = false;
+    dbScale_.reset();
+
+    // Ha a spektrum ki volt kapcsolva (Off mód), a mintavételezés szünetel: az analizátorhoz el kell indítani
+    if (AudioCore1Manager::isCore1Paused()) {
+        AudioCore1Manager::resumeCore1Audio();
+    }
+    AudioCore1Manager::setSampleDecoder(nullptr);
+    AudioCore1Manager::setFftSize(ScreenAnalyzerConstants::INITIAL_FFT_SIZE);
+}
+
+/**
+ * @brief Képernyő deaktiválása: a görgetés kikapcsolása, a kijelző normál módba
+ * @details A visszatérő képernyő újra létrejön, a saját FFT méretét és dekóderét maga állítja be
+ */
+void ScreenAnalyzer::deactivate() {
+    TftHardwareScroll::disable();
+    UIScreen::deactivate();
+}
+
+/**
+ * @brief Teljes képernyő kirajzolása: görgetési terület, elválasztó, frekvencia skála, üres waterfall
+ */
+void ScreenAnalyzer::drawContent() {
+    using namespace ScreenAnalyzerConstants;
+
+    tft.fillScreen(TFT_BLACK);
+    TftHardwareScroll::setArea(FIXED_WIDTH);
+    tft.drawFastVLine(FIXED_WIDTH - 1, READOUT_HEIGHT, AXIS_ROWS, TFT_DARKGREY);
+    invalidateBars();
+    redrawView();
+}
+
+/**
+ * @brief A látott tartomány a teljes tartomány 2^zoomLevel-ed része
+ */
+float ScreenAnalyzer::getSpanHz() const { return (maxFreqHz_ - ScreenAnalyzerConstants::MIN_FREQ_HZ) / (1 << zoomLevel_); }
+
+/**
+ * @brief Képernyő Y koordináta -> tengely sor (0: alul)
+ */
+uint16_t ScreenAnalyzer::yToRow(uint16_t y) const {
+    const int row = TFT_WIDTH - 1 - static_cast<int>(y);
+    return constrain(row, 0, ScreenAnalyzerConstants::AXIS_ROWS - 1);
+}
+
+/**
+ * @brief A látott tartomány beállítása (a teljes tartományon belülre szorítva)
+ * @param startHz A látott tartomány alja
+ * @param zoomLevel Nagyítás (0 .. MAX_ZOOM_LEVEL)
+ */
+void ScreenAnalyzer::setView(float startHz, uint8_t zoomLevel) {
+    zoomLevel_ = std::min(zoomLevel, ScreenAnalyzerConstants::MAX_ZOOM_LEVEL);
+    startHz_ = constrain(startHz, ScreenAnalyzerConstants::MIN_FREQ_HZ, maxFreqHz_ - getSpanHz());
+}
+
+/**
+ * @brief Nagyítás a kurzor frekvenciája körül: a kurzor frekvenciája a helyén marad (ha a tartomány széle engedi)
+ */
+void ScreenAnalyzer::zoomTo(uint8_t zoomLevel) {
+    zoomLevel = std::min(zoomLevel, ScreenAnalyzerConstants::MAX_ZOOM_LEVEL);
+    if (zoomLevel == zoomLevel_) {
+        return;
+    }
+
+    const float cursorHz = rowToHz(cursorRow_);
+    const float newHzPerRow = (maxFreqHz_ - ScreenAnalyzerConstants::MIN_FREQ_HZ) / (1 << zoomLevel) / ScreenAnalyzerConstants::AXIS_ROWS;
+    setView(cursorHz - (cursorRow_ + 0.5f) * newHzPerRow, zoomLevel);
+
+    // A tartomány szélén a kurzor a frekvenciáját követi
+    const int row = static_cast<int>((cursorHz - startHz_) / getHzPerRow());
+    cursorRow_ = constrain(row, 0, ScreenAnalyzerConstants::AXIS_ROWS - 1);
+    redrawView();
+}
+
+/**
+ * @brief Tartomány váltás után: a régi leképezésű waterfall törlése, skála és kiírás újrarajzolása
+ */
+void ScreenAnalyzer::redrawView() {
+    columnWriter_.clear();
+    drawFrequencyScale();
+    lastReadoutMs_ = 0;
+}
+
+/**
+ * @brief Minden sor sávja teljes újrarajzolást kér (a képernyő törlése után)
+ */
+void ScreenAnalyzer::invalidateBars() { memset(barLevel_, ScreenAnalyzerConstants::BAR_INVALID, sizeof(barLevel_)); }
+
+/**
+ * @brief A látott tartományhoz illő FFT méret
+ * @param samplingHz A mintavételi frekvencia
+ * @return A legkisebb méret, amelynél legalább minden második sorra jut egy bin, de legfeljebb az,
+ *         amelynek mintái 1/MIN_FPS s alatt összegyűlnek (felette a bin összevonás/ismétlés nagyít)
+ */
+uint16_t ScreenAnalyzer::selectFftSize(float samplingHz) const {
+    using namespace ScreenAnalyzerConstants;
+
+    uint16_t maxSize = MIN_FFT_SIZE;
+    while (maxSize < AudioProcessorConstants::MAX_FFT_SAMPLES && samplingHz / (maxSize * 2) >= MIN_FPS) {
+        maxSize <<= 1;
+    }
+
+    const float targetBinHz = 2.0f * getHzPerRow();
+    uint16_t size = MIN_FFT_SIZE;
+    while (size < maxSize && samplingHz / size > targetBinHz) {
+        size <<= 1;
+    }
+    return size;
+}
+
+/**
+ * @brief Főciklus: új FFT keretenként spektrum és egy waterfall oszlop
+ */
+void ScreenAnalyzer::handleOwnLoop() {
+    if (touchActive_) {
+        trackTouchHold();
+    }
+
+    const float *magnitudeData = nullptr;
+    uint16_t fftSize = 0;
+    float binWidthHz = 0.0f;
+    float autoGain = 1.0f;
+
+    if (!AudioCore1Manager::getSpectrumData(&magnitudeData, &fftSize, &binWidthHz, &autoGain) || !magnitudeData || binWidthHz == 0.0f) {
+        return;
+    }
+
+    // FFT méret a látott tartományhoz (foglalt mutex esetén a következő keret újra próbálja)
+    const uint16_t wantedFftSize = selectFftSize(binWidthHz * fftSize);
+    if (wantedFftSize != fftSize) {
+        AudioCore1Manager::setFftSize(wantedFftSize);
+    }
+
+    // A tábla csak a látott tartomány vagy az FFT paraméterek változásakor épül újra
+    binMap_.update(ScreenAnalyzerConstants::AXIS_ROWS, startHz_, startHz_ + getSpanHz(), 1, fftSize, binWidthHz, BinAggregation::Max);
+    drawFrame(magnitudeData, fftSize, autoGain);
+
+    if (millis() - lastReadoutMs_ >= ScreenAnalyzerConstants::READOUT_INTERVAL_MS) {
+        drawReadout();
+        lastReadoutMs_ = millis();
+    }
+}
+
+/**
+ * @brief A frekvencia skála és a kurzor jel kirajzolása
+ * @details A lépésköz a legkisebb, amelynél a feliratok legalább LABEL_MIN_SPACING_PX távolságra vannak
+ */
+void ScreenAnalyzer::drawFrequencyScale() {
+    using namespace ScreenAnalyzerConstants;
+    static constexpr uint16_t STEPS_HZ[] = {100, 200, 500, 1000, 2000, 5000};
+
+    tft.fillRect(0, READOUT_HEIGHT, LABEL_WIDTH, AXIS_ROWS, TFT_BLACK);
+
+    tft.setFreeFont();
+    tft.setTextSize(1);
+    tft.setTextColor(TFT_SILVER, TFT_BLACK);
+    tft.setTextDatum(MR_DATUM);
+
+    const float hzPerRow = getHzPerRow();
+    uint16_t stepHz = STEPS_HZ[ARRAY_ITEM_COUNT(STEPS_HZ) - 1];
+    for (uint16_t step : STEPS_HZ) {
+        if (step / hzPerRow >= LABEL_MIN_SPACING_PX) {
+            stepHz = step;
+            break;
+        }
+    }
+
+    const float endHz = startHz_ + getSpanHz();
+    char buf[8];
+    for (float freqHz = std::ceil(startHz_ / stepHz) * stepHz; freqHz < endHz; freqHz += stepHz) {
+        const int16_t y = rowToY(static_cast<uint16_t>((freqHz - startHz_) / hzPerRow));
+        if (y < READOUT_HEIGHT + 4 || y > TFT_WIDTH - 5) {
+            continue; // A felirat ne lógjon ki a tengelyről
+        }
+        tft.drawFastHLine(LABEL_WIDTH - 5, y, 4, TFT_DARKGREY);
+        if (stepHz >= 1000) {
+            snprintf(buf, sizeof(buf), "%uk", static_cast<unsigned>(freqHz / 1000.0f));
+        } else {
+            snprintf(buf, sizeof(buf), "%sk", Utils::floatToString(freqHz / 1000.0f, 1).c_str());
+        }
+        tft.drawString(buf, LABEL_WIDTH - 7, y);
+    }
+
+    const int16_t cursorY = rowToY(cursorRow_);
+    tft.fillTriangle(LABEL_WIDTH - 5, cursorY - 3, LABEL_WIDTH - 1, cursorY, LABEL_WIDTH - 5, cursorY + 3, CURSOR_BAR_COLOR);
+}
+
+/**
+ * @brief A kurzor kiírás: frekvencia, szint dBFS-ben, zajszint és nagyítás
+ */
+void ScreenAnalyzer::drawReadout() {
+    using namespace ScreenAnalyzerConstants;
+
+    const float levelDbfs = (rowUnits_[cursorRow_] - DbScaleConstants::MAX_UNITS) / DbScaleConstants::UNITS_PER_DB;
+    char buf[40];
+    snprintf(buf, sizeof(buf), "%skHz %sdB NF%s x%u", Utils::floatToString(rowToHz(cursorRow_) / 1000.0f, 2).c_str(), Utils::floatToString(levelDbfs, 1).c_str(),
+             Utils::floatToString(dbScale_.getNoiseFloorDbfs(), 0).c_str(), 1u << zoomLevel_);
+
+    tft.setFreeFont();
+    tft.setTextSize(1);
+    tft.setTextColor(TFT_WHITE, TFT_BLACK);
+    tft.setTextDatum(ML_DATUM);
+    tft.setTextPadding(FIXED_WIDTH - 4);
+    tft.drawString(buf, 2, READOUT_HEIGHT / 2);
+    tft.setTextPadding(0);
+}
+
+/**
+ * @brief Egy keret kirajzolása: soronként dB egység, zajszint, spektrum sávok részlegesen, waterfall oszlop
+ */
+void ScreenAnalyzer::drawFrame(const float *magnitudeData, uint16_t fftSize, float inputGain) {
+    using namespace ScreenAnalyzerConstants;
+
+    // A core1 auto/kézi erősítését a skála visszaosztja: a kurzor dBFS értéke az ADC bemenetre vonatkozik
+    dbScale_.beginFrame(fftSize, inputGain);
+    for (uint16_t r = 0; r < AXIS_ROWS; r++) {
+        rowUnits_[r] = dbScale_.toUnits(binMap_.aggregate(magnitudeData, r));
+    }
+    dbScale_.updateNoiseFloor(rowUnits_, AXIS_ROWS);
+
+    // Spektrum: egyetlen SPI tranzakcióban a változott szakaszok
+    const uint16_t *palette = WaterfallPalette::get(config.data.waterfallPalette);
+    tft.startWrite();
+    for (uint16_t r = 0; r < AXIS_ROWS; r++) {
+        drawSpectrumRow(r, static_cast<uint8_t>(dbScale_.toLevel(rowUnits_[r], SPECTRUM_WIDTH)));
+        columnBuffer_[AXIS_ROWS - 1 - r] = palette[dbScale_.toLevel(rowUnits_[r], 255)];
+    }
+    tft.endWrite();
+
+    // Waterfall: a readout sáv alatti részre
+    columnWriter_.pushColumn(READOUT_HEIGHT, AXIS_ROWS, columnBuffer_);
+}
+
+/**
+ * @brief Egy spektrum sor frissítése: csak az előző és az új sávhossz közötti szakasz
+ * @details A kurzor sora minden keretben teljesen rajzolódik (sáv + vonal), utána érvénytelen marad,
+ *          így a kurzor elmozdulása után a régi sor fekete háttérrel újrarajzolódik.
+ */
+void ScreenAnalyzer::drawSpectrumRow(uint16_t row, uint8_t level) {
+    using namespace ScreenAnalyzerConstants;
+
+    const int16_t y = rowToY(row);
+    const uint8_t previous = barLevel_[row];
+
+    if (row == cursorRow_) {
+        tft.drawFastHLine(LABEL_WIDTH, y, level, CURSOR_BAR_COLOR);
+        tft.drawFastHLine(LABEL_WIDTH + level, y, SPECTRUM_WIDTH - level, CURSOR_LINE_COLOR);
+        barLevel_[row] = BAR_INVALID;
+        return;
+    }
+
+    if (previous == BAR_INVALID) {
+        tft.drawFastHLine(LABEL_WIDTH, y, level, BAR_COLOR);
+        tft.drawFastHLine(LABEL_WIDTH + level, y, SPECTRUM_WIDTH - level, TFT_BLACK);
+    } else if (level > previous) {
+        tft.drawFastHLine(LABEL_WIDTH + previous, y, level - previous, BAR_COLOR);
+    } else if (level < previous) {
+        tft.drawFastHLine(LABEL_WIDTH + level, y, previous - level, TFT_BLACK);
+    }
+    barLevel_[row] = level;
+}
+
+/**
+ * @brief Érintés: húzás a tartomány görgetése, koppintás a kurzor áthelyezése
+ * @details A main loop csak lenyomás és felengedés eseményt küld (a felengedés az utolsó érintett ponttal),
+ *          ezért a görgetés a felengedéskor, a teljes elmozdulással történik.
+ */
+bool ScreenAnalyzer::handleTouch(const TouchEvent &event) {
+    using namespace ScreenAnalyzerConstants;
+
+    if (event.pressed) {
+        touchStartY_ = event.y;
+        touchHoldY_ = event.y;
+        lastHoldPollMs_ = millis();
+        touchActive_ = true;
+        return true;
+    }
+    if (!touchActive_) {
+        return true;
+    }
+    touchActive_ = false;
+
+    // A felengedés esemény a lenyomás pontját hozza, a húzás vége a nyomva tartás alatt olvasott utolsó pont
+    const int dy = static_cast<int>(touchHoldY_) - touchStartY_;
+    if (abs(dy) > DRAG_THRESHOLD_PX) {
+        // A tartalom követi az ujjat: lefelé húzva a magasabb frekvenciák jönnek be felülről
+        setView(startHz_ + dy * getHzPerRow(), zoomLevel_);
+        redrawView();
+    } else if (event.y >= READOUT_HEIGHT) {
+        cursorRow_ = yToRow(event.y);
+        drawFrequencyScale();
+        lastReadoutMs_ = 0;
+    }
+    return true;
+}
+
+/**
+ * @brief Nyomva tartás alatt az érintési pont követése (a húzás végpontjához)
+ * @details A főciklus csak lenyomás és felengedés eseményt küld, a felengedés a lenyomás pontjával érkezik
+ *          (a gombok kattintása így a remegő felengedési pont miatt nem vész el). A húzáshoz ezért a képernyő maga
+ *          olvassa az érintést; a handleOwnLoop() a DMA átvitel után fut, az SPI busz szabad.
+ */
+void ScreenAnalyzer::trackTouchHold() {
+    if (millis() - lastHoldPollMs_ < ScreenAnalyzerConstants::TOUCH_HOLD_POLL_MS) {
+        return;
+    }
+    lastHoldPollMs_ = millis();
+
+    uint16_t x;
+    uint16_t y;
+    if (tft.getTouch(&x, &y) && x <= tft.width() && y <= tft.height()) {
+        touchHoldY_ = y;
+    }
+}
+
+/**
+ * @brief Rotary: forgatás nagyít/kicsinyít, klikk vissza az előző képernyőre, dupla klikk a teljes tartomány
+ */
+bool ScreenAnalyzer::handleRotary(const RotaryEvent &event) {
+    if (event.buttonState == RotaryEvent::ButtonState::Clicked) {
+        if (getScreenManager()) {
+            getScreenManager()->goBack();
+        }
+        return true;
+    }
+    if (event.buttonState == RotaryEvent::ButtonState::DoubleClicked) {
+        zoomTo(0);
+        return true;
+    }
+
+    if (event.direction == RotaryEvent::Direction::Up) {
+        zoomTo(zoomLevel_ + 1);
+        return true;
+    }
+    if (event.direction == RotaryEvent::Direction::Down && zoomLevel_ > 0) {
+        zoomTo(zoomLevel_ - 1);
+        return true;
+    }
+    return UIScreen::handleRotary(event);
+}
@@ -6,6 +6,7 @@
 namespace ScreenFMHorizontalButtonIDs {
 static constexpr uint8_t SEEK_DOWN_BUTTON = 60; ///< Seek lefelé (pushable) - FM specifikus
 static constexpr uint8_t SEEK_UP_BUTTON = 61;   ///< Seek felfelé (pushable) - FM specifikus
+static constexpr uint8_t ANLZ_BUTTON = 62;      ///< Teljes képernyős spektrum analizátor (pushable)
 } // namespace ScreenFMHorizontalButtonIDs
 
 // ===================================================================
@@ -124,9 +125,16 @@ void ScreenFM::layoutComponents() {
  * - Rotary klikket figyelmen kívül hagyja (más funkciókhoz)
  * - Frekvencia léptetés és mentés a band táblába
  * - Frekvencia kijelző azonnali frissítése
+ * - Futó seek alatt forgatás és klikk is megszakítja a seek-et
  */
 bool ScreenFM::handleRotary(const RotaryEvent &event) {
 
+    // Futó seek megszakítása (a rádió az elért frekvencián marad)
+    if (isSeeking()) {
+        cancelSeek();
+        return true;
+    }
+
     // Biztonsági ellenőrzés: csak aktív dialógus nélkül és nem klikk eseménykor
     if (!isDialogActive() && event.buttonState != RotaryEvent::ButtonState::Clicked) {
 
@@ -155,6 +163,22 @@ bool ScreenFM::handleRotary(const RotaryEvent &event) {
     return UIScreen::handleRotary(event);
 }
 
+/**
+ * @brief Érintés eseménykezelés
+ * @param event Érintés esemény
+ * @return true ha sikeresen kezelte az eseményt, false egyébként
+ *
+ * @details Futó seek alatt az első érintés csak megszakítja a seek-et (a gombok nem kapják meg),
+ * egyébként a szülő osztály kezeli
+ */
+bool ScreenFM::handleTouch(const TouchEvent &event) {
+    if (isSeeking() && event.pressed) {
+        cancelSeek();
+        return true;
+    }
+    return UIScreen::handleTouch(event);
+}
+
 // ===================================================================
 // Loop ciklus - Optimalizált teljesítmény
 // ===================================================================
@@ -164,6 +188,7 @@ bool ScreenFM::handleRotary(const RotaryEvent &event) {
  * @details Event-driven architektúra: NINCS folyamatos gombállapot pollozás!
  *
  * Csak az alábbi komponenseket frissíti minden ciklusban:
+ * - Futó seek követése - STC és közbenső frekvencia lekérdezés várakozás nélkül
  * - S-Meter (jelerősség) - valós idejű adat
  *
  * Gombállapotok frissítése CSAK:
@@ -172,15 +197,20 @@ bool ScreenFM::handleRotary(const RotaryEvent &event) {
  */
 void ScreenFM::handleOwnLoop() {
 
+    // ===================================================================
+    // Futó seek követése (a frekvencia kijelző menet közben frissül)
+    // ===================================================================
+    handleSeek();
+
     // ===================================================================
     // S-Meter (jelerősség) időzített frissítése - Közös RadioScreen implementáció
     // ===================================================================
     updateSMeter(true /* FM mód */);
 
     // ===================================================================
-    // RDS adatok valós idejű frissítése
+    // RDS adatok valós idejű frissítése (seek közben a közbenső frekvenciák RDS-e érdektelen)
     // ===================================================================
-    if (rdsComponent) {
+    if (rdsComponent && !isSeeking()) {
         static uint32_t lastRdsCall = 0;
         uint32_t currentTime = millis();
 
@@ -309,6 +339,15 @@ void ScreenFM::addSpecificHorizontalButtons(std::vector<UIHorizontalButtonBar::B
                              [this](const UIButton::ButtonEvent &event) { //
                                  handleSeekUpButton(event);
                              }});
+
+    // 3. ANLZ - Teljes képernyős spektrum analizátor
+    buttonConfigs.push_back({ScreenFMHorizontalButtonIDs::ANLZ_BUTTON,    //
+                             "Anlz",                                      //
+                             UIButton::ButtonType::Pushable,              //
+                             UIButton::ButtonState::Off,                  //
+                             [this](const UIButton::ButtonEvent &event) { //
+                                 handleAnalyzerButton(event);
+                             }});
 }
 
 /**
@@ -352,17 +391,13 @@ void ScreenFM::updateHorizontalButtonStates() {
  * @param event Gomb esemény (Clicked)
  *
  * @details Pushable gomb: Automatikus állomáskeresés lefelé
- * A seek során valós időben frissíti a frekvencia kijelzőt
+ * A seek nem blokkol: a handleOwnLoop() követi, a frekvencia kijelző menet közben frissül
  */
 void ScreenFM::handleSeekDownButton(const UIButton::ButtonEvent &event) {
     if (event.state == UIButton::EventButtonState::Clicked) {
         // RDS cache törlése seek indítása előtt
         clearRDSCache(); // Seek lefelé a RadioScreen metódusával
         seekStationDown();
-
-        // Seek befejezése után: RDS és memória státusz frissítése
-        clearRDSCache();
-        checkAndUpdateMemoryStatus();
     }
 }
 
@@ -371,17 +406,32 @@ void ScreenFM::handleSeekDownButton(const UIButton::ButtonEvent &event) {
  * @param event Gomb esemény (Clicked)
  *
  * @details Pushable gomb: Automatikus állomáskeresés felfelé
- * A seek során valós időben frissíti a frekvencia kijelzőt
+ * A seek nem blokkol: a handleOwnLoop() követi, a frekvencia kijelző menet közben frissül
  */
 void ScreenFM::handleSeekUpButton(const UIButton::ButtonEvent &event) {
     if (event.state == UIButton::EventButtonState::Clicked) {
         // RDS cache törlése seek indítása előtt
         clearRDSCache(); // Seek felfelé a RadioScreen metódusával
         seekStationUp();
+    }
+}
 
-        // Seek befejezése után: RDS és memória státusz frissítése
-        clearRDSCache();
-        checkAndUpdateMemoryStatus();
+/**
+ * @brief Seek befejezése után: RDS és memória státusz frissítése
+ */
+void ScreenFM::onSeekFinished() {
+    clearRDSCache();
+    checkAndUpdateMemoryStatus();
+}
+
+/**
+ * @brief ANLZ gomb eseménykezelő - teljes képernyős spektrum analizátor
+ * @param event Gomb esemény (Clicked)
+ * @details Visszalépéskor az FM képernyő újra létrejön és a spektrum módjának megfelelő FFT méretet állítja vissza
+ */
+void ScreenFM::handleAnalyzerButton(const UIButton::ButtonEvent &event) {
+    if (event.state == UIButton::EventButtonState::Clicked) {
+        getScreenManager()->switchToScreen(SCREEN_NAME_ANALYZER);
     }
 }
 
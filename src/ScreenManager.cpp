@@ -1,9 +1,11 @@
 #include "ScreenManager.h"
 
 #include "ScreenAM.h"
+#include "ScreenAnalyzer.h"
 #include "ScreenEmpty.h"
 #include "ScreenFM.h"
 #include "ScreenMemory.h"
+#include "ScreenNavtex.h"
 #include "ScreenScan.h"
 #include "ScreenScreenSaver.h"
 #include "ScreenSetup.h"
@@ -11,6 +13,8 @@
 #include "ScreenSetupSi4735.h"
 #include "ScreenSetupSystem.h"
 #include "ScreenTest.h"
+#include "ScreenWaterfall.h"
+#include "ScreenWefax.h"
 
 /**
  * @brief Képernyőkezelő osztály konstruktor
@@ -21,6 +25,10 @@ void ScreenManager::registerDefaultScreenFactories() {
     registerScreenFactory(SCREEN_NAME_SCREENSAVER, []() { return std::make_shared<ScreenScreenSaver>(); });
     registerScreenFactory(SCREEN_NAME_MEMORY, []() { return std::make_shared<ScreenMemory>(); });
     registerScreenFactory(SCREEN_NAME_SCAN, []() { return std::make_shared<ScreenScan>(); });
+    registerScreenFactory(SCREEN_NAME_WEFAX, []() { return std::make_shared<ScreenWefax>(); });
+    registerScreenFactory(SCREEN_NAME_NAVTEX, []() { return std::make_shared<ScreenNavtex>(); });
+    registerScreenFactory(SCREEN_NAME_WATERFALL, []() { return std::make_shared<ScreenWaterfall>(); });
+    registerScreenFactory(SCREEN_NAME_ANALYZER, []() { return std::make_shared<ScreenAnalyzer>(); });
 
     // Setup képernyők regisztrálása
     registerScreenFactory(SCREEN_NAME_SETUP, []() { return std::make_shared<ScreenSetup>(); });
@@ -0,0 +1,327 @@
+/**
+ * @file ScreenNavtex.cpp
+ * @brief A NAVTEX dekóder tárolt üzeneteinek listája és megjelenítése
+ */
+
+#include "ScreenNavtex.h"
+#include "AudioCore1Manager.h"
+#include "MessageDialog.h"
+#include "ScreenManager.h"
+#include "defines.h"
+
+// ===================================================================
+// Vízszintes gombsor azonosítók - Képernyő-specifikus navigáció
+// ===================================================================
+namespace ScreenNavtexHorizontalButtonIDs {
+static constexpr uint8_t CLEAR_BUTTON = 40;
+static constexpr uint8_t BACK_BUTTON = 41;
+} // namespace ScreenNavtexHorizontalButtonIDs
+
+/**
+ * @brief Konstruktor
+ */
+ScreenNavtex::ScreenNavtex() : UIScreen(SCREEN_NAME_NAVTEX), decoder_(nullptr), selected_{}, selectedIndex_(-1), storeSequence_(0), lastPollMs_(0), lastSynced_(false) { layoutComponents(); }
+
+/**
+ * @brief A lista és a gombok elhelyezése (a szöveg terület a lista jobb oldalán)
+ */
+void ScreenNavtex::layoutComponents() {
+    using namespace ScreenNavtexConstants;
+    using namespace ScreenNavtexHorizontalButtonIDs;
+
+    const int16_t buttonY = ::SCREEN_H - UIButton::DEFAULT_BUTTON_HEIGHT - MARGIN;
+    Rect listBounds(MARGIN, TITLE_HEIGHT, LIST_WIDTH, buttonY - MARGIN - TITLE_HEIGHT);
+    messageList = std::make_shared<UIScrollableListComponent>(listBounds, this, UIScrollableListComponent::DEFAULT_VISIBLE_ITEMS, LIST_ITEM_HEIGHT);
+    addChild(messageList);
+
+    constexpr uint16_t buttonWidth = 90;
+    std::vector<UIHorizontalButtonBar::ButtonConfig> buttonConfigs = {
+        {CLEAR_BUTTON, "Clear", UIButton::ButtonType::Pushable, UIButton::ButtonState::Off, [this](const UIButton::ButtonEvent &event) {
+             if (event.state == UIButton::EventButtonState::Clicked) {
+                 showClearConfirmDialog();
+             }
+         }}};
+    horizontalButtonBar = std::make_shared<UIHorizontalButtonBar>(Rect(MARGIN, buttonY, buttonWidth, UIButton::DEFAULT_BUTTON_HEIGHT), buttonConfigs, buttonWidth, UIButton::DEFAULT_BUTTON_HEIGHT);
+    addChild(horizontalButtonBar);
+
+    // Back gomb külön, jobbra igazítva
+    constexpr uint16_t backButtonWidth = 60;
+    Rect backButtonRect(::SCREEN_W - backButtonWidth - MARGIN, buttonY, backButtonWidth, UIButton::DEFAULT_BUTTON_HEIGHT);
+    backButton = std::make_shared<UIButton>(BACK_BUTTON, backButtonRect, "Back", UIButton::ButtonType::Pushable, UIButton::ButtonState::Off, [this](const UIButton::ButtonEvent &event) {
+        if (event.state == UIButton::EventButtonState::Clicked && getScreenManager()) {
+            getScreenManager()->goBack();
+        }
+    });
+    addChild(backButton);
+}
+
+/**
+ * @brief Képernyő aktiválása: a NAVTEX dekóder a képernyőn is fut (az új üzenetek megjelennek)
+ */
+void ScreenNavtex::activate() {
+    decoder_ = AudioCore1Manager::getNavtexDecoder();
+    if (decoder_) {
+        // Ha a spektrum ki volt kapcsolva (Off mód), a mintavételezés szünetel: a dekóderhez el kell indítani
+        if (AudioCore1Manager::isCore1Paused()) {
+            AudioCore1Manager::resumeCore1Audio();
+        }
+        AudioCore1Manager::setSampleDecoder(decoder_);
+    }
+
+    loadHeaders();
+    selectedIndex_ = -1;
+    if (!headers_.empty() && decoder_->getMessage(0, selected_)) {
+        selectedIndex_ = 0; // A legújabb üzenet látszik
+    }
+    UIScreen::activate();
+}
+
+/**
+ * @brief Képernyő deaktiválása: a dekóder leválasztása (a visszatérő képernyő állítja be a sajátját)
+ */
+void ScreenNavtex::deactivate() {
+    AudioCore1Manager::setSampleDecoder(nullptr);
+    decoder_ = nullptr;
+    UIScreen::deactivate();
+}
+
+/**
+ * @brief A tár üzeneteinek fejlécei (a legújabb elöl)
+ */
+void ScreenNavtex::loadHeaders() {
+    headers_.clear();
+    if (!decoder_) {
+        return;
+    }
+    storeSequence_ = decoder_->getStoreSequence();
+
+    for (uint8_t i = 0; i < decoder_->getMessageCount(); i++) {
+        if (!decoder_->getMessage(i, selected_)) {
+            break;
+        }
+        headers_.push_back({selected_.station, selected_.subject, selected_.serial, selected_.errorCount, selected_.receivedMs});
+    }
+}
+
+/**
+ * @brief Teljes képernyő: cím és a kiválasztott üzenet (a lista és a gombok gyerek komponensek)
+ */
+void ScreenNavtex::drawContent() {
+    drawTitle();
+    drawMessage();
+}
+
+/**
+ * @brief Cím a tárolt üzenetek számával és a szinkron állapottal
+ */
+void ScreenNavtex::drawTitle() {
+    tft.fillRect(0, 0, ::SCREEN_W, ScreenNavtexConstants::TITLE_HEIGHT - 1, TFT_COLOR_BACKGROUND);
+    tft.setFreeFont(&FreeSansBold12pt7b);
+    tft.setTextSize(1);
+    tft.setTextColor(TFT_YELLOW, TFT_COLOR_BACKGROUND);
+    tft.setTextDatum(TC_DATUM);
+    String title = "NAVTEX messages (" + String(headers_.size()) + "/" + String(NavtexConstants::MESSAGE_STORE_SIZE) + ")";
+    tft.drawString(title, ::SCREEN_W / 2, 5);
+
+    drawSyncIndicator();
+}
+
+/**
+ * @brief A dekóder karakter szinkron jelzője a cím jobb oldalán
+ */
+void ScreenNavtex::drawSyncIndicator() {
+    lastSynced_ = decoder_ && decoder_->isSynchronized();
+    tft.setFreeFont();
+    tft.setTextSize(1);
+    tft.setTextDatum(TR_DATUM);
+    tft.setTextColor(lastSynced_ ? TFT_GREEN : TFT_DARKGREY, TFT_COLOR_BACKGROUND);
+    tft.drawString("SYNC", ::SCREEN_W - ScreenNavtexConstants::MARGIN, 10);
+}
+
+/**
+ * @brief A kiválasztott üzenet fejléce és szövege a lista jobb oldalán (karakterenkénti tördeléssel)
+ */
+void ScreenNavtex::drawMessage() {
+    using namespace ScreenNavtexConstants;
+
+    const int16_t areaX = MARGIN + LIST_WIDTH + MARGIN;
+    const int16_t areaY = TITLE_HEIGHT;
+    const int16_t areaW = ::SCREEN_W - areaX - MARGIN;
+    const int16_t areaH = ::SCREEN_H - UIButton::DEFAULT_BUTTON_HEIGHT - 2 * MARGIN - TITLE_HEIGHT;
+    tft.fillRect(areaX, areaY, areaW, areaH, TFT_COLOR_BACKGROUND);
+    tft.drawRect(areaX, areaY, areaW, areaH, TFT_DARKGREY);
+
+    tft.setFreeFont();
+    tft.setTextSize(1);
+    tft.setTextDatum(TL_DATUM);
+
+    if (selectedIndex_ < 0) {
+        tft.setTextColor(TFT_SILVER, TFT_COLOR_BACKGROUND);
+        tft.drawString("No stored messages", areaX + MARGIN, areaY + MARGIN);
+        return;
+    }
+
+    // Fejléc: azonosító, tárgy, hibaszám
+    char header[64];
+    char serial[3] = {'?', '?', '\0'};
+    if (selected_.serial <= 99) {
+        snprintf(serial, sizeof(serial), "%02u", selected_.serial);
+    }
+    snprintf(header, sizeof(header), "%c%c%s  %s  err %u", selected_.station, selected_.subject, serial, getSubjectName(selected_.subject), selected_.errorCount);
+    tft.setTextColor(TFT_YELLOW, TFT_COLOR_BACKGROUND);
+    tft.drawString(header, areaX + MARGIN, areaY + MARGIN);
+
+    // Szöveg: soronként egy drawString, a sor végén vagy újsornál tördelve
+    const uint8_t columns = (areaW - 2 * MARGIN) / TEXT_CHAR_WIDTH;
+    const int16_t bottomY = areaY + areaH - MARGIN - TEXT_LINE_HEIGHT;
+    int16_t y = areaY + MARGIN + TEXT_LINE_HEIGHT + 4;
+    char line[81];
+    uint8_t length = 0;
+    tft.setTextColor(TFT_CYAN, TFT_COLOR_BACKGROUND);
+    for (uint16_t i = 0; i <= selected_.length && y <= bottomY; i++) {
+        char c = i < selected_.length ? selected_.text[i] : '\n';
+        if (c != '\n') {
+            line[length++] = c;
+        }
+        if (c == '\n' || length >= std::min<uint8_t>(columns, sizeof(line) - 1)) {
+            line[length] = '\0';
+            tft.drawString(line, areaX + MARGIN, y);
+            y += TEXT_LINE_HEIGHT;
+            length = 0;
+        }
+    }
+}
+
+/**
+ * @brief Főciklus: új vagy törölt üzenetnél a lista újratöltése, a legújabb üzenet megjelenítése
+ */
+void ScreenNavtex::handleOwnLoop() {
+    if (!decoder_ || isDialogActive() || millis() - lastPollMs_ < ScreenNavtexConstants::STORE_POLL_MS) {
+        return;
+    }
+    lastPollMs_ = millis();
+
+    if (decoder_->getStoreSequence() == storeSequence_) {
+        if (decoder_->isSynchronized() != lastSynced_) {
+            drawSyncIndicator();
+        }
+        return;
+    }
+
+    loadHeaders();
+    selectedIndex_ = -1;
+    if (!headers_.empty() && decoder_->getMessage(0, selected_)) {
+        selectedIndex_ = 0;
+    }
+    messageList->setDataSource(this); // A kijelölés a lista elejére (a legújabb üzenetre) kerül
+    drawTitle();
+    drawMessage();
+}
+
+/**
+ * @brief Rotary: a lista kijelölése és kiválasztása (dialógus alatt a dialógusé)
+ */
+bool ScreenNavtex::handleRotary(const RotaryEvent &event) {
+    if (isDialogActive()) {
+        return UIScreen::handleRotary(event);
+    }
+    return messageList->handleRotary(event);
+}
+
+/**
+ * @brief A tárolt üzenetek törlésének megerősítése
+ */
+void ScreenNavtex::showClearConfirmDialog() {
+    if (!decoder_ || headers_.empty()) {
+        return;
+    }
+    auto confirmDialog = std::make_shared<MessageDialog>(this, "NAVTEX", "Clear all stored messages?", MessageDialog::ButtonsType::YesNo, Rect(-1, -1, 250, 0));
+    confirmDialog->setDialogCallback([this](UIDialogBase *dialog, UIDialogBase::DialogResult result) {
+        if (result == UIDialogBase::DialogResult::Accepted && decoder_) {
+            decoder_->clearMessages(); // A core1 hajtja végre, a lista a következő ellenőrzéskor ürül
+        }
+    });
+    showDialog(confirmDialog);
+}
+
+// ===================================================================
+// IScrollableListDataSource
+// ===================================================================
+
+int ScreenNavtex::getItemCount() const { return headers_.size(); }
+
+/**
+ * @brief Lista elem címke: B1B2B3B4 (pl. "NA12")
+ */
+String ScreenNavtex::getItemLabelAt(int index) const {
+    if (index < 0 || index >= (int)headers_.size()) {
+        return "";
+    }
+    const MessageHeader &header = headers_[index];
+    char label[8];
+    if (header.serial <= 99) {
+        snprintf(label, sizeof(label), "%c%c%02u", header.station, header.subject, header.serial);
+    } else {
+        snprintf(label, sizeof(label), "%c%c??", header.station, header.subject);
+    }
+    return String(label);
+}
+
+/**
+ * @brief Lista elem érték: a vétel óta eltelt idő
+ */
+String ScreenNavtex::getItemValueAt(int index) const {
+    if (index < 0 || index >= (int)headers_.size()) {
+        return "";
+    }
+    uint32_t minutes = (millis() - headers_[index].receivedMs) / 60000;
+    if (minutes < 60) {
+        return String(minutes) + "m";
+    }
+    return String(minutes / 60) + "h";
+}
+
+/**
+ * @brief Elem kiválasztása: a szöveg másolata a megjelenítéshez
+ */
+bool ScreenNavtex::onItemClicked(int index) {
+    if (decoder_ && decoder_->getMessage(index, selected_)) {
+        selectedIndex_ = index;
+        drawMessage();
+    }
+    return false;
+}
+
+/**
+ * @brief A NAVTEX tárgy (B2) rövid neve
+ */
+const char *ScreenNavtex::getSubjectName(char subject) {
+    switch (subject) {
+        case 'A':
+            return "Nav warning";
+        case 'B':
+            return "Met warning";
+        case 'C':
+            return "Ice report";
+        case 'D':
+            return "SAR";
+        case 'E':
+            return "Met forecast";
+        case 'F':
+            return "Pilot";
+        case 'G':
+            return "AIS";
+        case 'H':
+            return "LORAN";
+        case 'J':
+            return "SATNAV";
+        case 'K':
+            return "Other navaid";
+        case 'L':
+            return "Nav warning";
+        case 'Z':
+            return "No messages";
+        default:
+            return "";
+    }
+}
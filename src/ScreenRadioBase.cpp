@@ -1,4 +1,5 @@
 #include "ScreenRadioBase.h"
+#include "AudioCore1Manager.h"
 #include "MultiButtonDialog.h"
 #include "Si4735Manager.h"
 #include "StationStore.h"
@@ -48,69 +49,121 @@ void ScreenRadioBase::activate() {
     }
 }
 
+/**
+ * @brief ScreenRadioBase deaktiválása - a futó seek megszakítása
+ * @details A képernyő elhagyásakor (pl. képernyővédő) a seek nem futhat tovább felügyelet nélkül
+ */
+void ScreenRadioBase::deactivate() {
+    cancelSeek();
+    UIScreen::deactivate();
+}
+
 // ===================================================================
-// Seek callback infrastruktúra
+// Seek (automatikus állomáskeresés) implementáció
 // ===================================================================
 
-/// Static pointer az aktuális ScreenRadioBase instance-ra (seek callback-hez)
-static ScreenRadioBase *g_currentSeekingScreenRadioBase = nullptr;
+// A seek állapotgép időzítései
+constexpr uint16_t SEEK_POLL_INTERVAL_MS = 20;   // A futó seek STC és frekvencia lekérdezésének periódusa
+constexpr uint16_t SEEK_TIMEOUT_MS = 8000;       // Ennyi idő után a seek megszakad (a könyvtár blokkoló seek-jének korlátja is ennyi)
+constexpr uint16_t SEEK_CANCEL_TIMEOUT_MS = 100; // Megszakításkor legfeljebb ennyit várunk a chip STC jelzésére
 
 /**
- * @brief Callback függvény a SI4735::seekStationProgress számára
- * @param frequency Aktuális frekvencia a seek során
- *
- * @details C-style callback, ami frissíti a frekvencia kijelzőt seek közben.
- * A g_currentSeekingScreenRadioBase static pointer-en keresztül éri el az instance-t.
+ * @brief Seek keresés indítása lefelé (nem blokkol)
  */
-void radioSeekProgressCallback(uint16_t frequency) {
-    if (g_currentSeekingScreenRadioBase && g_currentSeekingScreenRadioBase->freqDisplayComp) {
-        g_currentSeekingScreenRadioBase->freqDisplayComp->setFrequency(frequency);
-        g_currentSeekingScreenRadioBase->freqDisplayComp->draw(); // Azonnali frissítés a kijelzőn
+void ScreenRadioBase::seekStationDown() { startSeek(SEEK_DOWN); }
+
+/**
+ * @brief Seek keresés indítása felfelé (nem blokkol)
+ */
+void ScreenRadioBase::seekStationUp() { startSeek(SEEK_UP); }
+
+/**
+ * @brief Seek indítása a megadott irányban
+ * @details Egyetlen seek parancs WRAP = 1 beállítással: a chip a sáv végén körbefordul, és ha nem talál állomást,
+ * a kiindulási frekvencián áll meg. A befejezést a handleSeek() figyeli.
+ */
+void ScreenRadioBase::startSeek(uint8_t direction) {
+    if (!pSi4735Manager || seekActive || pSi4735Manager->isCurrentDemodSSBorCW()) {
+        return; // SSB/CW módban a chip nem tud seek-elni
     }
-}
 
-// ===================================================================
-// Seek (automatikus állomáskeresés) implementáció
-// ===================================================================
+    SI4735 &si4735 = pSi4735Manager->getSi4735();
+    pSi4735Manager->setSeekThresholds(); // A beállítások képernyőn módosított küszöbök is érvényesüljenek
+    si4735.getStatus(1, 0);              // Egy korábbi hangolás STC jelzésének törlése
+    si4735.seekStation(direction, 1);
+
+    seekActive = true;
+    seekStartTime = millis();
+    seekLastPollTime = seekStartTime;
+    seekLastFrequency = 0;
+    DEBUG("ScreenRadioBase: seek %s indítva\n", direction == SEEK_UP ? "up" : "down");
+}
 
 /**
- * @brief Seek keresés indítása lefelé valós idejű frekvencia frissítéssel
- * @details Beállítja a callback infrastruktúrát és indítja a seek-et
+ * @brief A futó seek keresés követése (nem blokkol)
  */
-void ScreenRadioBase::seekStationDown() {
-    if (pSi4735Manager) {
-        // Static pointer beállítása a callback számára
-        g_currentSeekingScreenRadioBase = this;
+void ScreenRadioBase::handleSeek() {
+    if (!seekActive || millis() - seekLastPollTime < SEEK_POLL_INTERVAL_MS) {
+        return;
+    }
+    seekLastPollTime = millis();
 
-        // Seek lefelé valós idejű frekvencia frissítéssel
-        pSi4735Manager->getSi4735().seekStationProgress(radioSeekProgressCallback, SEEK_DOWN);
+    if (seekLastPollTime - seekStartTime >= SEEK_TIMEOUT_MS) {
+        DEBUG("ScreenRadioBase: seek időtúllépés\n");
+        cancelSeek();
+        return;
+    }
 
-        // Static pointer nullázása
-        g_currentSeekingScreenRadioBase = nullptr;
+    // TUNE_STATUS: a seek közbenső frekvenciája és az STC bit
+    SI4735 &si4735 = pSi4735Manager->getSi4735();
+    uint16_t frequency = si4735.getFrequency();
+    if (si4735.getTuneCompleteTriggered()) {
+        finishSeek();
+        return;
+    }
 
-        // Seek befejezése után: konfiguráció és band tábla frissítése
-        saveCurrentFrequency();
+    // A kijelző a normál UI ciklusban rajzolódik újra, a főciklus közben is fut
+    if (frequency != seekLastFrequency && freqDisplayComp) {
+        freqDisplayComp->setFrequency(frequency);
+        seekLastFrequency = frequency;
     }
 }
 
 /**
- * @brief Seek keresés indítása felfelé valós idejű frekvencia frissítéssel
- * @details Beállítja a callback infrastruktúrát és indítja a seek-et
+ * @brief A futó seek keresés megszakítása
  */
-void ScreenRadioBase::seekStationUp() {
-    if (pSi4735Manager) {
-        // Static pointer beállítása a callback számára
-        g_currentSeekingScreenRadioBase = this;
-
-        // Seek felfelé valós idejű frekvencia frissítéssel
-        pSi4735Manager->getSi4735().seekStationProgress(radioSeekProgressCallback, SEEK_UP);
+void ScreenRadioBase::cancelSeek() {
+    if (!seekActive) {
+        return;
+    }
 
-        // Static pointer nullázása
-        g_currentSeekingScreenRadioBase = nullptr;
+    // CANCEL = 1: a chip az aktuális frekvencián megáll, és STC-t jelez
+    SI4735 &si4735 = pSi4735Manager->getSi4735();
+    si4735.getStatus(0, 1);
+    uint32_t start = millis();
+    while (!si4735.getTuneCompleteTriggered() && millis() - start < SEEK_CANCEL_TIMEOUT_MS) {
+        si4735.getStatus(0, 0);
+    }
+    finishSeek();
+}
 
-        // Seek befejezése után: konfiguráció és band tábla frissítése
-        saveCurrentFrequency();
+/**
+ * @brief A befejeződött seek lezárása
+ */
+void ScreenRadioBase::finishSeek() {
+    SI4735 &si4735 = pSi4735Manager->getSi4735();
+    uint16_t frequency = si4735.getFrequency(); // A végleges frekvencia (a könyvtár cache-ét is frissíti)
+    si4735.getStatus(1, 0);                     // STC nyugtázása
+    seekActive = false;
+
+    // Konfiguráció és band tábla frissítése
+    saveCurrentFrequency();
+    if (freqDisplayComp) {
+        freqDisplayComp->setFrequency(frequency);
     }
+    DEBUG("ScreenRadioBase: seek vége, frekvencia: %u\n", frequency);
+
+    onSeekFinished();
 }
 
 // ===================================================================
@@ -384,6 +437,15 @@ void ScreenRadioBase::updateSMeter(bool isFMMode) {
             // RSSI és SNR megjelenítése a megfelelő módban
             smeterComp->showRSSI(signalCache.rssi, signalCache.snr, isFMMode);
         }
+
+        // Jeltípus: az osztályozó megkapja a demodulációs módot, az eredmény az állapotsorra kerül
+        SignalClassifier *classifier = AudioCore1Manager::getSignalClassifier();
+        if (classifier) {
+            classifier->setAmDemodulation(!isFMMode && pSi4735Manager->isCurrentDemodAM());
+        }
+        if (statusLineComp) {
+            statusLineComp->updateSignalClass();
+        }
         lastSmeterUpdate = currentTime;
     }
 }
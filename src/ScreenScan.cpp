@@ -12,15 +12,66 @@
  */
 
 #include "ScreenScan.h"
+#include "AudioCore1Manager.h"
+#include "MessageDialog.h"
 #include "ScreenManager.h"
+#include "StationStore.h"
+#include "WaterfallPalette.h"
 #include "defines.h"
 #include "rtVars.h"
+#include <algorithm>
 
 // Az állomás detektálásához szükséges SNR (jel-zaj viszony) küszöbértéket.
 // Ez azt jelenti, hogy csak azoknál a mérési pontoknál lesz állomásnak jelölve a frekvencia, ahol az SNR érték legalább ennyi.
 // Ez a küszöbérték határozza meg, hogy mennyire legyen érzékeny az állomáskeresés.
 constexpr uint8_t MIN_STATION_SNR_VALUE = 8;
 
+// A jeltípus osztályozás megállás (pause) után: ennyi ideig kell egy frekvencián állni,
+// és ennyi FFT keretet kell az osztályozónak a hangolás óta feldolgoznia, mielőtt az eredményt eltároljuk.
+// (A pásztázás lépései ehhez túl rövidek.)
+constexpr uint16_t CLASSIFY_DWELL_MS = 1500;
+constexpr uint8_t CLASSIFY_MIN_FRAMES = 20;
+
+// Pásztázó motor: hangolás után az STC (seek/tune complete) bitet kérdezzük le, fix várakozás nincs.
+// Egy főciklus hívás legfeljebb SCAN_SLICE_MS ideig mér, így az érintés és a rotary pásztázás közben is azonnal reagál.
+constexpr uint16_t SCAN_SLICE_MS = 15;          // Egy főciklus hívásban ennyi ideig mérünk egymás után
+constexpr uint16_t STC_TIMEOUT_MS = 100;        // Ha a chip ennyi idő alatt sem jelez STC-t, akkor is mérünk
+constexpr uint16_t SCAN_INFO_INTERVAL_MS = 250; // Az info panel frissítése pásztázás közben
+constexpr uint16_t SWEEP_TARGET_MW_MS = 10000;  // MW sávon egy teljes sweep célideje (felette a sweep végén figyelmeztetés)
+// A célidő csak a durva-finom menettel (lent) érhető el, és a chip STC idejétől függ, amit semmilyen fix érték nem korlátoz:
+// a tényleges sweep időt a sweep végi DEBUG sor méri (lastSweepMs).
+
+// Durva-finom pásztázás: a legtöbb pont üres spektrum, ezért az első menet csak minden COARSE_STRIDE-adik pontot méri egyszer,
+// a finomító menet pedig teljes felbontással és átlagolással csak a helyi zajszint feletti durva pontok környezetét.
+// A kimaradt pontok a durva pontokból interpolálódnak. MW sávon a durva lépés (~5 kHz) kisebb egy AM állomás sávszélességénél, így állomás nem marad ki.
+constexpr uint8_t COARSE_STRIDE = 4;         // A durva menet lépésköze (adatpontban)
+constexpr uint8_t NOISE_FLOOR_WINDOW = 8;    // A helyi zajszint (medián) ablaka: ennyi durva pont mindkét oldalon
+constexpr uint8_t REFINE_RSSI_MARGIN_DB = 3; // Ennyivel a helyi zajszint felett finomítunk...
+constexpr uint8_t REFINE_MIN_SNR = 4;        // ... vagy ha az SNR legalább ennyi
+constexpr uint8_t REFINE_SAMPLES_FACTOR = 2; // Finomításkor a mérések száma countScanSignal-szorosa, a durva menet egyszer mér
+
+// Automatikus állomás tárolás: csúcskeresés, szomszédos csatorna elnyomás, SNR szerinti rangsor
+constexpr uint8_t AUTO_STORE_MAX_STATIONS = 20;      // Egy pásztázásból legfeljebb ennyi állomás kerül a memóriába
+constexpr uint16_t AUTO_STORE_RDS_TIMEOUT_MS = 2500; // FM: legfeljebb ennyi ideig azonosítunk egy jelöltet, utána ami addig megjött
+
+// FM sávfelmérés: jelöltenként a chip RDS FIFO-jának csoportjai sorban, kihagyás nélkül kerülnek feldolgozásra.
+// RDS nélküli jelöltről gyorsan, stabil PI és teljes PS után azonnal továbblépünk; ha a PI egy már azonosított
+// állomásé (annak egy másik frekvenciája), a PS-t sem várjuk meg.
+constexpr uint8_t SURVEY_MAX_CANDIDATES = 60;    // Legfeljebb ennyi csúcs kerül azonosításra
+constexpr uint16_t SURVEY_POLL_MS = 40;          // Az RDS FIFO kiolvasásának periódusa (~11 csoport/s, a FIFO nem telik meg)
+constexpr uint16_t SURVEY_SYNC_TIMEOUT_MS = 600; // Ha ennyi idő alatt nem jön RDS csoport, a jelölt RDS nélküli
+constexpr uint8_t SURVEY_PI_CONFIRM = 3;         // Stabil a PI, ha ennyi egymást követő csoportban azonos
+constexpr uint8_t SURVEY_PS_CONFIRM = 4;         // Teljes a PS, ha ennyi egymást követő 0A csoportban (minden szegmens) nem változott
+constexpr uint8_t SURVEY_ROW_HEIGHT = 11;        // Az eredménytábla sormagassága (pixel)
+
+// Memória pásztázás: az STC után egyetlen RSQ minta dönt, így az üres csatorna néhányszor 10 ms alatt kimarad.
+// Aktív csatornán a hang szól, és csak tartós jelvesztés után lépünk tovább (a rövid fading nem szakítja meg).
+constexpr uint16_t MEMORY_SCAN_POLL_MS = 250;    // Dwell: a jel mintavételezésének periódusa
+constexpr uint16_t MEMORY_SCAN_RESUME_MS = 2000; // Dwell: ennyi ideig tartó jelvesztés után folytatjuk a pásztázást
+
+// Hőtérkép (sweep történet)
+constexpr uint8_t HEATMAP_FULL_SCALE_DBUV = 64; // Ennyi dBuV a paletta teteje (a 0 dBuV az alja)
+
 // ===================================================================
 // Konstruktor és inicializálás
 // ===================================================================
@@ -31,13 +82,41 @@ constexpr uint8_t MIN_STATION_SNR_VALUE = 8;
  * @param si4735Manager Si4735 rádió chip kezelő
  *
  * Inicializálja az összes scan paraméter alapértelmezett értékével,
- * létrehozza a scan adattömböket és beállítja a UI komponenseket.
+ * a mérési adatokat a közös ScanModel-ben tartja, és beállítja a UI komponenseket.
  */
-ScreenScan::ScreenScan() : UIScreen(SCREEN_NAME_SCAN) { // Scan állapot inicializálása
+ScreenScan::ScreenScan() : UIScreen(SCREEN_NAME_SCAN), scanModel(ScanModel::get()) { // Scan állapot inicializálása
     scanState = ScanState::Idle;
     scanMode = ScanMode::Spectrum;
     scanPaused = true;
     lastScanTime = 0;
+    lastTuneTime = 0;
+    tunePending = false;
+    tuneStartTime = 0;
+    sweepStartTime = 0;
+    lastSweepMs = 0;
+    sweepMeasuredPoints = 0;
+    lastInfoTime = 0;
+    scanPass = ScanPass::Coarse;
+    heatmapView = false;
+    core1WasPaused = false;
+    autoStorePhase = AutoStorePhase::Off;
+    autoStoreIndex = 0;
+    autoStoreTuneTime = 0;
+    autoStorePollTime = 0;
+    surveyCurrent = {};
+    surveyPiCount = 0;
+    surveyPs[0] = '\0';
+    surveyPsCount = 0;
+    surveySynced = false;
+    surveyStartTime = 0;
+    surveyView = false;
+    surveyTableTop = 0;
+    memoryScanIndex = 0;
+    memoryScanPhase = MemoryScanPhase::Tune;
+    memoryScanTuneTime = 0;
+    memoryScanPollTime = 0;
+    memoryScanSignalTime = 0;
+    memoryScanStartBandIdx = 0;
 
     // Frekvencia beállítások inicializálása
     currentScanFreq = 0;
@@ -46,7 +125,6 @@ ScreenScan::ScreenScan() : UIScreen(SCREEN_NAME_SCAN) { // Scan állapot inicial
     scanStep = 1.0f;
     zoomLevel = 1.0f;
     currentScanPos = 0;
-    zoomGeneration = 0; // Zoom interpoláció generáció számláló
 
     // Sáv határok inicializálása
     scanBeginBand = -1;
@@ -65,15 +143,9 @@ ScreenScan::ScreenScan() : UIScreen(SCREEN_NAME_SCAN) { // Scan állapot inicial
 
     // UI cache inicializálása
     lastStatusText = "";
+    lastTypeText = "";
 
-    // Scan adattömbök inicializálása - minden érték üres állapotra
-    for (int i = 0; i < SCAN_RESOLUTION; i++) {
-        scanValueRSSI[i] = SCAN_AREA_Y + SCAN_AREA_HEIGHT; // Spektrum alján (nincs jel)
-        scanValueSNR[i] = 0;
-        scanMark[i] = false;
-        scanScaleLine[i] = 0;
-        scanDataValid[i] = false; // Nincs érvényes adat inicializáláskor
-    }
+    // A scan adatok a ScanModel-ben vannak: az activate() visszatölti őket, vagy új sávon törli
 
     // UI komponensek létrehozása
     layoutComponents();
@@ -95,9 +167,19 @@ void ScreenScan::activate() {
     initializeScan();
     calculateScanParameters();
 
-    // Csak akkor reseteljük a scant, ha még nincs érvényes adat
-    // Ez megőrzi a scan állapotot screensaver után
-    if (scanEmpty) {
+    // A könyvtár setFrequency() hívása alapból fix ideig vár a hangolás után, itt helyette az STC-t figyeljük
+    if (pSi4735Manager) {
+        pSi4735Manager->getSi4735().setMaxDelaySetFrequency(0);
+    }
+
+    // A megállított állomások jeltípusához a core1 spektrum feldolgozásnak futnia kell (kilépéskor az előző állapot visszaáll)
+    core1WasPaused = AudioCore1Manager::isCore1Paused();
+    if (core1WasPaused) {
+        AudioCore1Manager::resumeCore1Audio();
+    }
+
+    // A korábbi mérések és nézet visszatöltése (képernyőváltás és screensaver után), más sávon új scan indul
+    if (!restoreView()) {
         resetScan();
     }
 }
@@ -109,7 +191,16 @@ void ScreenScan::activate() {
  * Leállítja a scant és felszabadítja az erőforrásokat.
  */
 void ScreenScan::deactivate() {
+    autoStorePhase = AutoStorePhase::Off; // Félbehagyott automatikus tárolás eldobása
+    stopMemoryScan();                     // A rádió az utolsó memória csatornán marad
     stopScan();
+    saveView(); // A következő megnyitáskor innen folytatjuk
+    if (pSi4735Manager) {
+        pSi4735Manager->getSi4735().setMaxDelaySetFrequency(MAX_DELAY_AFTER_SET_FREQUENCY);
+    }
+    if (core1WasPaused) {
+        AudioCore1Manager::pauseCore1Audio();
+    }
     UIScreen::deactivate();
 }
 
@@ -126,15 +217,15 @@ void ScreenScan::layoutComponents() {
 /**
  * @brief Vízszintes gombsor létrehozása
  *
- * Létrehozza a Start/Pause, Zoom+, Zoom-, Reset és Back gombokat
+ * Létrehozza a Start/Pause, Zoom+, Zoom-, Reset, Store, Heat, Mem és Back gombokat
  * a képernyő alján megfelelő eseménykezelőkkel.
  */
 void ScreenScan::createHorizontalButtonBar() {
     constexpr int16_t margin = 5;
     uint16_t buttonHeight = UIButton::DEFAULT_BUTTON_HEIGHT;
     uint16_t buttonY = ::SCREEN_H - UIButton::DEFAULT_BUTTON_HEIGHT - margin;
-    uint16_t buttonWidth = 70;
-    uint16_t buttonSpacing = 5;
+    uint16_t buttonWidth = 55;
+    uint16_t buttonSpacing = 3;
 
     // Start/Pause gomb - scan indítása/megállítása
     uint16_t playPauseX = margin;
@@ -204,6 +295,57 @@ void ScreenScan::createHorizontalButtonBar() {
         });
     addChild(resetButton);
 
+    // Auto store gomb - a teljes sáv pásztázása és a legjobb állomások mentése a memóriába
+    uint16_t autoStoreX = resetX + buttonWidth + buttonSpacing;
+    Rect autoStoreRect(autoStoreX, buttonY, buttonWidth, buttonHeight);
+    autoStoreButton = std::make_shared<UIButton>( //
+        AUTO_STORE_BUTTON_ID,                     //
+        autoStoreRect,                            //
+        "Store",                                  //
+        UIButton::ButtonType::Pushable,           //
+        UIButton::ButtonState::Off,               //
+        [this](const UIButton::ButtonEvent &event) {
+            if (event.state == UIButton::EventButtonState::Clicked) {
+                startAutoStore();
+            }
+        });
+    addChild(autoStoreButton);
+
+    // Heat gomb - a spektrum helyén a sweep történet (idő x frekvencia hőtérkép)
+    uint16_t heatmapX = autoStoreX + buttonWidth + buttonSpacing;
+    Rect heatmapRect(heatmapX, buttonY, buttonWidth, buttonHeight);
+    heatmapButton = std::make_shared<UIButton>( //
+        HEATMAP_BUTTON_ID,                      //
+        heatmapRect,                            //
+        "Heat",                                 //
+        UIButton::ButtonType::Toggleable,       //
+        UIButton::ButtonState::Off,             //
+        [this](const UIButton::ButtonEvent &event) {
+            if (event.state == UIButton::EventButtonState::On || event.state == UIButton::EventButtonState::Off) {
+                setHeatmapView(event.state == UIButton::EventButtonState::On);
+            }
+        });
+    addChild(heatmapButton);
+
+    // Mem gomb - a tárolt állomások pásztázása (aktív csatornán megáll, jelvesztés után folytatja)
+    uint16_t memoryScanX = heatmapX + buttonWidth + buttonSpacing;
+    Rect memoryScanRect(memoryScanX, buttonY, buttonWidth, buttonHeight);
+    memoryScanButton = std::make_shared<UIButton>( //
+        MEMORY_SCAN_BUTTON_ID,                     //
+        memoryScanRect,                            //
+        "Mem",                                     //
+        UIButton::ButtonType::Toggleable,          //
+        UIButton::ButtonState::Off,                //
+        [this](const UIButton::ButtonEvent &event) {
+            if (event.state == UIButton::EventButtonState::On) {
+                startMemoryScan();
+            } else if (event.state == UIButton::EventButtonState::Off) {
+                stopMemoryScan();
+                markForRedraw(true); // Vissza a spektrum nézetre
+            }
+        });
+    addChild(memoryScanButton);
+
     // Back gomb - visszalépés a főmenübe (jobbra igazítva)
     uint16_t backButtonWidth = 60;
     uint16_t backButtonX = ::SCREEN_W - backButtonWidth - margin;
@@ -241,7 +383,9 @@ void ScreenScan::drawContent() {
     tft.setTextColor(TFT_WHITE, TFT_BLACK);
     tft.setTextSize(2);
     tft.setTextDatum(TC_DATUM);
-    tft.drawString("SPECTRUM ANALYZER", tft.width() / 2, 10);
+    if (scanMode != ScanMode::Memory) {
+        tft.drawString("SPECTRUM ANALYZER", tft.width() / 2, 10); // Memória pásztázáskor a cím helyén az aktuális csatorna
+    }
 
     // Spektrum terület kerete
     tft.drawRect(SCAN_AREA_X - 1, SCAN_AREA_Y - 1, SCAN_AREA_WIDTH + 2, SCAN_AREA_HEIGHT + 2, TFT_WHITE);
@@ -252,14 +396,15 @@ void ScreenScan::drawContent() {
     // Skála rajzolása
     drawScale();
 
-    // Frekvencia címkék
-    drawFrequencyLabels();
-
-    // Sáv határok jelölése
-    drawBandBoundaries();
+    // Frekvencia címkék és sáv határok jelölése (a memória csatornák nem frekvencia tengelyen vannak)
+    if (scanMode != ScanMode::Memory) {
+        drawFrequencyLabels();
+        drawBandBoundaries();
+    }
 
     // Statikus információs címkék egyszeri kirajzolása
     drawScanInfoStatic();
+    lastStatsText = ""; // Hőtérkép nézetben a statisztika, memória pásztázáskor az aktuális csatorna kerül a cím helyére
 
     // Változó információk kirajzolása
     drawScanInfo();
@@ -268,17 +413,20 @@ void ScreenScan::drawContent() {
 /**
  * @brief Főciklus kezelése
  *
- * 50ms-enként frissíti a scant ha aktív.
- * Ez biztosítja a folyamatos spektrum pásztázást.
+ * Aktív scan mellett minden hívásban egy időszeletnyi pontot mér (lásd updateScan()).
+ * Ez biztosítja a folyamatos, a chip által megengedett leggyorsabb spektrum pásztázást.
  */
 void ScreenScan::handleOwnLoop() {
-    if (scanState == ScanState::Scanning && !scanPaused) {
-        uint32_t currentTime = millis();
-        // 50ms késleltetés a mérések között
-        if (currentTime - lastScanTime > 50) {
-            updateScan();
-            lastScanTime = currentTime;
-        }
+    if (scanMode == ScanMode::Memory) {
+        updateMemoryScan();
+    } else if (autoStorePhase == AutoStorePhase::Survey) {
+        updateSurvey();
+    } else if (scanState == ScanState::Scanning && !scanPaused) {
+        updateScan();
+        lastScanTime = millis();
+    } else {
+        // Megállítva: az aktuális pozíció jeltípusának eltárolása, ha elég ideig álltunk rajta
+        annotateCurrentPosition();
     }
 }
 
@@ -299,6 +447,14 @@ void ScreenScan::handleOwnLoop() {
 bool ScreenScan::handleTouch(const TouchEvent &event) {
     // Spektrum terület érintésének ellenőrzése (prioritás!)
     if (event.pressed && event.x >= SCAN_AREA_X && event.x < SCAN_AREA_X + SCAN_AREA_WIDTH && event.y >= SCAN_AREA_Y && event.y < SCAN_AREA_Y + SCAN_AREA_HEIGHT) {
+        if (scanMode == ScanMode::Memory) {
+            return true; // Memória pásztázáskor nincs kurzor
+        }
+        if (surveyView) {
+            surveyView = false; // A felmérés táblája érintésre bezárul, a spektrum visszajön
+            drawSpectrum();
+            return true;
+        }
 
         // Relatív pozíció számítás a spektrum területen belül
         uint16_t relativePixelX = event.x - SCAN_AREA_X;
@@ -377,6 +533,36 @@ bool ScreenScan::handleTouch(const TouchEvent &event) {
  * - Click: zoom nagyítás
  */
 bool ScreenScan::handleRotary(const RotaryEvent &event) {
+    // Memória pásztázás: forgatásra a következő/előző csatorna (aktív csatornáról is), a klikk nem zoomol
+    if (scanMode == ScanMode::Memory) {
+        if (event.direction == RotaryEvent::Direction::Up || event.direction == RotaryEvent::Direction::Down) {
+            if (memoryScanPhase == MemoryScanPhase::Tune) {
+                waitTuneComplete(); // A következő hangolás ne a félbehagyott STC-jét lássa
+            }
+            pSi4735Manager->getSi4735().setAudioMute(true);
+            advanceMemoryChannel(event.direction == RotaryEvent::Direction::Up ? 1 : -1);
+            drawScanInfo();
+        }
+        return true;
+    }
+
+    // Felmérés tábla: forgatásra görgetés, klikkre bezárás
+    if (surveyView) {
+        const uint8_t visibleRows = SCAN_AREA_HEIGHT / SURVEY_ROW_HEIGHT - 1;
+        uint16_t maxTop = surveyResults.size() > visibleRows ? surveyResults.size() - visibleRows : 0;
+        if (event.buttonState == RotaryEvent::ButtonState::Clicked) {
+            surveyView = false;
+            drawSpectrum();
+        } else if (event.direction == RotaryEvent::Direction::Up && surveyTableTop < maxTop) {
+            surveyTableTop++;
+            drawSurveyTable();
+        } else if (event.direction == RotaryEvent::Direction::Down && surveyTableTop > 0) {
+            surveyTableTop--;
+            drawSurveyTable();
+        }
+        return true;
+    }
+
     // Rotary encoder klikk kezelése - zoom in funkció
     if (event.buttonState == RotaryEvent::ButtonState::Clicked) {
         zoomIn(); // Ugyanaz a funkció mint a Zoom+ gomb
@@ -419,6 +605,8 @@ bool ScreenScan::handleRotary(const RotaryEvent &event) {
 
                     // Információs panel frissítése
                     drawScanInfo();
+                } else if (zoomLevel > 1.0f) {
+                    panView(1); // A nézet jobb szélén: eltolás a piramisból, újramérés nélkül
                 }
             } else {
                 // Nincs scan adat - frekvencia léptetés
@@ -468,6 +656,8 @@ bool ScreenScan::handleRotary(const RotaryEvent &event) {
 
                     // Információs panel frissítése
                     drawScanInfo();
+                } else if (zoomLevel > 1.0f) {
+                    panView(-1); // A nézet bal szélén: eltolás a piramisból, újramérés nélkül
                 }
             } else {
                 // Nincs scan adat - frekvencia léptetés
@@ -533,12 +723,17 @@ void ScreenScan::calculateScanParameters() {
  */
 void ScreenScan::resetScan() {
     // Scan állapot teljes visszaállítása
+    if (tunePending && pSi4735Manager) {
+        waitTuneComplete();
+    }
+    tunePending = false;
     scanState = ScanState::Idle;
     scanPaused = true;
     scanEmpty = true;
     currentScanPos = 0;
-    zoomLevel = 1.0f;   // Zoom visszaállítása 1.0x-ra
-    zoomGeneration = 0; // Zoom generáció nullázása
+    scanPass = ScanPass::Coarse;
+    zoomLevel = 1.0f; // Zoom visszaállítása 1.0x-ra
+    surveyView = false;
 
     // Teljes sáv tartomány visszaállítása
     if (pSi4735Manager) {
@@ -547,22 +742,15 @@ void ScreenScan::resetScan() {
         scanEndFreq = currentBand.maximumFreq * 10;   // Teljes sáv vége
         currentScanFreq = scanStartFreq;
     }
+    scanModel.reset(config.data.currentBandIdx, scanStartFreq, scanEndFreq); // Pontok, piramis és sweep történet törlése
 
     // UI cache visszaállítása
     lastStatusText = "";
+    lastTypeText = "";
 
     // Scan paraméterek újraszámítása
     calculateScanParameters();
 
-    // Összes mért adat törlése
-    for (int i = 0; i < SCAN_RESOLUTION; i++) {
-        scanValueRSSI[i] = SCAN_AREA_Y + SCAN_AREA_HEIGHT; // Spektrum alján (nincs jel)
-        scanValueSNR[i] = 0;
-        scanMark[i] = false;
-        scanScaleLine[i] = 0;
-        scanDataValid[i] = false; // Nincs érvényes adat
-    }
-
     // Sáv határok újraszámítása
     scanBeginBand = -1;
     scanEndBand = SCAN_RESOLUTION;
@@ -591,13 +779,32 @@ void ScreenScan::resetScan() {
  * - Azonnal frissíti a státusz kijelzést
  */
 void ScreenScan::startScan() {
+    if (surveyView) {
+        surveyView = false; // A pásztázás a spektrumon látszik
+        drawSpectrum();
+    }
     scanPaused = false;
+    autoStorePhase = AutoStorePhase::Off; // Kézi indítás megszakítja a folyamatban lévő automatikus tárolást
     scanState = ScanState::Scanning;
     lastScanTime = millis();
+    tunePending = false;
+    sweepStartTime = 0; // Folytatott sweep ideje nem mérhető
+
+    // A kitöltő menet az első még nem mért ponttól, a durva menet a rácson folytatódik (a kurzor a megállítás alatt máshova kerülhetett)
+    if (scanPass == ScanPass::Fill) {
+        currentScanPos = firstScanPosition();
+        if (currentScanPos >= SCAN_RESOLUTION) {
+            scanPass = ScanPass::Coarse;
+            currentScanPos = 0;
+        }
+    } else if (scanPass == ScanPass::Coarse && currentScanPos % COARSE_STRIDE != 0) {
+        currentScanPos = std::min<uint16_t>((currentScanPos / COARSE_STRIDE + 1) * COARSE_STRIDE, SCAN_RESOLUTION - 1);
+    }
 
     // Audio némítás a scan közben (gyors frekvencia váltások miatt)
     if (pSi4735Manager) {
         pSi4735Manager->getSi4735().setAudioMute(true);
+        pollTuneComplete(); // Egy korábbi (más képernyőről kiadott) hangolás STC jelzésének törlése
     }
     if (playPauseButton) {
         playPauseButton->setLabel("Pause"); // Scan közben Pause gomb
@@ -618,6 +825,11 @@ void ScreenScan::startScan() {
  */
 void ScreenScan::pauseScan() {
     scanPaused = true;
+    autoStorePhase = AutoStorePhase::Off; // Megállításkor az automatikus tárolás is megszakad
+    if (tunePending && pSi4735Manager) {
+        waitTuneComplete(); // A félbehagyott hangolás befejezése, hogy a következő ne egy régi STC-t lásson
+    }
+    tunePending = false;
 
     // Hang visszakapcsolása pause módban, hogy hallhassuk az aktuális frekvenciát
     if (pSi4735Manager) {
@@ -640,6 +852,10 @@ void ScreenScan::pauseScan() {
 void ScreenScan::stopScan() {
     scanState = ScanState::Idle;
     scanPaused = true;
+    if (tunePending && pSi4735Manager) {
+        waitTuneComplete();
+    }
+    tunePending = false;
     if (playPauseButton) {
         playPauseButton->setLabel("Start"); // Stop után Start gomb
     }
@@ -649,280 +865,1122 @@ void ScreenScan::stopScan() {
 }
 
 /**
- * @brief Scan frissítése (egy lépés)
+ * @brief Scan frissítése (egy időszelet)
  *
- * Minden meghíváskor egy frekvencia pontot mér le:
- * - Beállítja a frekvenciát
- * - Mér RSSI és SNR értékeket
- * - Értékeli az állomás jelenlétét
- * - Frissíti a spektrum megjelenítést
- * - Léptet a következő pozícióra
+ * Legfeljebb SCAN_SLICE_MS ideig egymás után méri a pontokat:
+ * - Kiadja a hangolást (várakozás nélkül)
+ * - Az STC bit lekérdezésével megvárja, amíg a chip befejezi (legfeljebb STC_TIMEOUT_MS)
+ * - Mér RSSI és SNR értékeket (durva menetben egyszer, finomításkor átlagolva), értékeli az állomás jelenlétét
+ * - Egy képpont oszlopot csak akkor rajzol ki, ha a menet továbblépett róla
+ * - Léptet a menet következő pozíciójára, a durva menet végén interpolál és kijelöli a finomítandó pontokat,
+ *   a sweep végén kiírja a sweep idejét
  */
 void ScreenScan::updateScan() {
     if (!pSi4735Manager || scanPaused || currentScanPos >= SCAN_RESOLUTION) {
         return;
     }
 
-    // Aktuális frekvencia számítása
-    uint32_t scanFreq = positionToFreq(currentScanPos);
-    setFrequency(scanFreq);
+    uint32_t sliceStart = millis();
+    bool sweepCompleted = false;
+    do {
+        // Hangolás kiadása, ha még nincs folyamatban
+        if (!tunePending) {
+            if (currentScanPos == 0 && scanPass == ScanPass::Coarse) {
+                sweepStartTime = millis();
+                sweepMeasuredPoints = 0;
+            }
+            tuneTo(positionToFreq(currentScanPos));
+            tunePending = true;
+            tuneStartTime = millis();
+        }
+
+        // Az RSQ mérés csak a hangolás befejezése után érvényes
+        if (!pollTuneComplete() && millis() - tuneStartTime < STC_TIMEOUT_MS) {
+            continue;
+        }
+        tunePending = false;
+        sweepMeasuredPoints++;
+
+        // Jel mérése - optimalizált: egyszerre RSSI és SNR (a durva és a kitöltő menetben egyetlen méréssel)
+        bool singleShot = scanPass != ScanPass::Refine;
+        uint8_t rssi;
+        uint8_t snr;
+        measureSignal(rssi, snr, singleShot ? 1 : countScanSignal * REFINE_SAMPLES_FACTOR);
+        ScanPointState pointState = singleShot ? ScanPointState::Coarse : ScanPointState::Measured;
+        scanModel.setPoint(currentScanPos, rssi, snr, pointState);
+        scanModel.getPyramid().store(positionToFreq(currentScanPos), rssi, snr, pointState);
+
+        // Állomás jelzés SNR alapján - minden méréskor újra értékeljük
+        if (snr >= scanMarkSNR && currentScanPos > scanBeginBand && currentScanPos < scanEndBand) {
+            scanModel.setMarked(currentScanPos, true);
+        } else {
+            scanModel.setMarked(currentScanPos, false); // Töröljük a régi jelzést ha már nincs elég jel
+            scanModel.setSignalClass(currentScanPos, static_cast<uint8_t>(SignalClass::None));
+        }
 
-    // Jel mérése - optimalizált: egyszerre RSSI és SNR
-    int16_t rssiY;
-    uint8_t snr;
-    getSignalQuality(rssiY, snr);
-    scanValueRSSI[currentScanPos] = rssiY;
-    scanValueSNR[currentScanPos] = snr;
-    scanDataValid[currentScanPos] = true; // Megjelöljük, hogy érvényes adat van itt
-
-    // Állomás jelzés SNR alapján - minden méréskor újra értékeljük
-    if (scanValueSNR[currentScanPos] >= scanMarkSNR && currentScanPos > scanBeginBand && currentScanPos < scanEndBand) {
-        scanMark[currentScanPos] = true;
-    } else {
-        scanMark[currentScanPos] = false; // Töröljük a régi jelzést ha már nincs elég jel
+        // Pozíció léptetése a menet következő pontjára
+        uint16_t pixelPos = (currentScanPos * SCAN_AREA_WIDTH) / SCAN_RESOLUTION;
+        uint16_t nextPos = nextScanPosition(currentScanPos);
+
+        // A durva menet végén: interpoláció, a finomítandó pontok kijelölése, majd a teljes spektrum újrarajzolása
+        bool redrawAll = false;
+        if (nextPos >= SCAN_RESOLUTION && scanPass == ScanPass::Coarse) {
+            finishCoarsePass();
+            scanPass = ScanPass::Refine;
+            nextPos = firstScanPosition();
+            redrawAll = true;
+        }
+
+        // Ha végére értünk, újrakezdés
+        bool sweepDone = nextPos >= SCAN_RESOLUTION;
+        if (sweepDone) {
+            nextPos = 0;
+            scanPass = ScanPass::Coarse;
+            scanEmpty = false;
+            if (sweepStartTime != 0) {
+                lastSweepMs = millis() - sweepStartTime;
+                DEBUG("ScreenScan: %s sweep: %u/%u pont mérve, %lu ms (%lu us/pont)\n", pSi4735Manager->getCurrentBandName(), sweepMeasuredPoints, SCAN_RESOLUTION, lastSweepMs,
+                      lastSweepMs * 1000UL / std::max<uint16_t>(sweepMeasuredPoints, 1));
+                if (pSi4735Manager->getCurrentBandType() == MW_BAND_TYPE && lastSweepMs > SWEEP_TARGET_MW_MS) {
+                    DEBUG("ScreenScan: MW sweep a %u ms-os célidő felett\n", SWEEP_TARGET_MW_MS);
+                }
+                recordHistorySweep(); // Csak a sáv elejéről indult teljes sweep kerül a történetbe
+            }
+        }
+        currentScanPos = nextPos;
+
+        // Spektrum oszlop rajzolása, ha a menet továbblépett róla: a kész oszlop kurzor nélkül, a kurzor a következőre kerül
+        uint16_t nextPixelPos = (currentScanPos * SCAN_AREA_WIDTH) / SCAN_RESOLUTION;
+        if (redrawAll) {
+            drawSpectrum();
+        } else if (nextPixelPos != pixelPos) {
+            drawSpectrumLine(pixelPos);
+            drawSpectrumLine(nextPixelPos);
+        }
+
+        if (sweepDone) {
+            sweepCompleted = true;
+            break; // A sweep végén az info panel azonnal frissül
+        }
+    } while (millis() - sliceStart < SCAN_SLICE_MS);
+
+    // Automatikus tárolás: a teljes sáv megvan, jöhet a jelöltek kiválasztása
+    if (sweepCompleted && autoStorePhase == AutoStorePhase::Sweep) {
+        collectAutoStoreCandidates();
+        return;
+    }
+
+    // Hőtérkép nézetben a sweep végén egy új sor jelenik meg felül
+    if (sweepCompleted && heatmapView) {
+        drawHeatmap();
     }
 
-    // Spektrum vonal rajzolása (pixel pozícióra konvertálás)
-    uint16_t pixelPos = (currentScanPos * SCAN_AREA_WIDTH) / SCAN_RESOLUTION;
-    drawSpectrumLine(pixelPos);
+    // Információk frissítése (ritkítva, a mérés ne várjon a kijelzőre)
+    if (currentScanPos == 0 || millis() - lastInfoTime >= SCAN_INFO_INTERVAL_MS) {
+        drawScanInfo();
+        lastInfoTime = millis();
+    }
+}
 
-    // Előző pozíció kurzorának törlése (ha volt)
-    if (currentScanPos > 0) {
-        uint16_t prevPixelPos = ((currentScanPos - 1) * SCAN_AREA_WIDTH) / SCAN_RESOLUTION;
-        if (prevPixelPos != pixelPos) {
-            // Újrarajzoljuk az előző pozíciót kurzor nélkül
-            drawSpectrumLine(prevPixelPos);
+/**
+ * @brief Az aktuális menet következő mérendő pontja
+ * @param scanPos Az utoljára mért pont
+ * @return A következő pont, vagy SCAN_RESOLUTION, ha a menet véget ért
+ */
+uint16_t ScreenScan::nextScanPosition(uint16_t scanPos) const {
+    if (scanPass == ScanPass::Coarse) {
+        // Durva rács: minden COARSE_STRIDE-adik pont, a sáv utolsó pontja mindig rajta van
+        return scanPos >= SCAN_RESOLUTION - 1 ? SCAN_RESOLUTION : std::min<uint16_t>(scanPos + COARSE_STRIDE, SCAN_RESOLUTION - 1);
+    }
+    for (uint16_t pos = scanPos + 1; pos < SCAN_RESOLUTION; pos++) {
+        if (scanModel.isRefine(pos)) {
+            return pos;
         }
     }
+    return SCAN_RESOLUTION;
+}
 
-    // Pozíció léptetése
-    currentScanPos++;
+/**
+ * @brief Az aktuális menet első mérendő pontja
+ * @return A pont, vagy SCAN_RESOLUTION, ha a menetben nincs mérendő pont
+ */
+uint16_t ScreenScan::firstScanPosition() const {
+    if (scanPass == ScanPass::Coarse) {
+        return 0;
+    }
+    return scanModel.isRefine(0) ? 0 : nextScanPosition(0);
+}
 
-    // Ha végére értünk, újrakezdés
-    if (currentScanPos >= SCAN_RESOLUTION) {
-        currentScanPos = 0;
-        scanEmpty = false;
+/**
+ * @brief A helyi zajszint egy durva pont körül
+ * @details A szomszédos durva pontok RSSI mediánja: az ablakba eső egy-két állomás nem emeli meg
+ * @param coarseIndex A durva pont sorszáma (a pozíciója coarseIndex * COARSE_STRIDE)
+ * @param coarseCount A durva rács pontjainak száma
+ * @return A zajszint (dBuV)
+ */
+uint8_t ScreenScan::localNoiseFloor(uint16_t coarseIndex, uint16_t coarseCount) const {
+    uint8_t window[2 * NOISE_FLOOR_WINDOW + 1];
+    uint8_t count = 0;
+    uint16_t first = coarseIndex > NOISE_FLOOR_WINDOW ? coarseIndex - NOISE_FLOOR_WINDOW : 0;
+    uint16_t last = std::min<uint16_t>(coarseIndex + NOISE_FLOOR_WINDOW, coarseCount - 1);
+    for (uint16_t k = first; k <= last; k++) {
+        window[count++] = scanModel.getRssi(std::min<uint16_t>(k * COARSE_STRIDE, SCAN_RESOLUTION - 1));
     }
+    std::nth_element(window, window + count / 2, window + count);
+    return window[count / 2];
+}
 
-    // Információk frissítése
-    drawScanInfo();
+/**
+ * @brief A durva menet lezárása
+ * @details - A durva pontok közötti pontok lineáris interpolációja (ScanPointState::Interpolated, állomás jelzés nélkül)
+ *          - Finomításra kerül minden durva pont és a szomszédos durva pontig terjedő környezete,
+ *            ha az RSSI legalább REFINE_RSSI_MARGIN_DB-vel a helyi zajszint felett van, vagy az SNR legalább REFINE_MIN_SNR
+ */
+void ScreenScan::finishCoarsePass() {
+    const uint16_t coarseCount = (SCAN_RESOLUTION - 1 + COARSE_STRIDE - 1) / COARSE_STRIDE + 1;
+
+    scanModel.clearRefine();
+
+    for (uint16_t k = 0; k < coarseCount; k++) {
+        uint16_t pos = std::min<uint16_t>(k * COARSE_STRIDE, SCAN_RESOLUTION - 1);
+
+        // Interpoláció a következő durva pontig
+        if (k + 1 < coarseCount) {
+            uint16_t nextPos = std::min<uint16_t>((k + 1) * COARSE_STRIDE, SCAN_RESOLUTION - 1);
+            uint16_t span = nextPos - pos;
+            for (uint16_t i = pos + 1; i < nextPos; i++) {
+                uint16_t t = i - pos;
+                uint8_t rssi = scanModel.getRssi(pos) + (scanModel.getRssi(nextPos) - scanModel.getRssi(pos)) * t / span;
+                uint8_t snr = scanModel.getSnr(pos) + (scanModel.getSnr(nextPos) - scanModel.getSnr(pos)) * t / span;
+                scanModel.setPoint(i, rssi, snr, ScanPointState::Interpolated);
+                scanModel.setMarked(i, false);
+                scanModel.setSignalClass(i, static_cast<uint8_t>(SignalClass::None));
+            }
+        }
+
+        // Zajszint feletti durva pont: a környezete teljes felbontással újramérendő
+        bool aboveFloor = scanModel.getRssi(pos) >= localNoiseFloor(k, coarseCount) + REFINE_RSSI_MARGIN_DB;
+        if (aboveFloor || scanModel.getSnr(pos) >= REFINE_MIN_SNR) {
+            uint16_t first = pos >= COARSE_STRIDE ? pos - COARSE_STRIDE + 1 : 0;
+            uint16_t last = std::min<uint16_t>(pos + COARSE_STRIDE - 1, SCAN_RESOLUTION - 1);
+            for (uint16_t i = first; i <= last; i++) {
+                scanModel.setRefine(i, true);
+            }
+        }
+    }
 }
 
 // ===================================================================
-// Rajzolási funkciók
+// Automatikus állomás tárolás
 // ===================================================================
 
 /**
- * @brief Teljes spektrum kirajzolása
- *
- * Kirajzolja az összes spektrum vonalat pixel-enkénti felbontásban.
- * Minden pixel reprezentálja egy vagy több mérési pontot.
+ * @brief Automatikus állomás tárolás indítása
+ * @details Teljes sávos pásztázás 1.0x zoommal; a sweep végén a collectAutoStoreCandidates() választ a csúcsokból
  */
-void ScreenScan::drawSpectrum() {
-    // Spektrum terület törlése
-    tft.fillRect(SCAN_AREA_X, SCAN_AREA_Y, SCAN_AREA_WIDTH, SCAN_AREA_HEIGHT, TFT_COLOR_BACKGROUND);
-
-    // Minden pixel spektrum vonalának kirajzolása
-    for (int x = 0; x < SCAN_AREA_WIDTH; x++) {
-        drawSpectrumLine(x);
+void ScreenScan::startAutoStore() {
+    if (!pSi4735Manager) {
+        return;
     }
+    resetScan();
+    markForRedraw(true); // Üres spektrum, teljes sáv (a gombokkal együtt, a drawContent() törli a képernyőt)
+    autoStoreStations.clear();
+    startScan();
+    autoStorePhase = AutoStorePhase::Sweep;
 }
 
 /**
- * @brief Egy spektrum vonal kirajzolása
- * @param pixelX A vízszintes pixel pozíció (0-SCAN_AREA_WIDTH)
- *
- * Ez a függvény felelős egy vertikális spektrum vonal kirajzolásáért.
- * Több mérési pontot átlagol egy pixelre és különböző színekkel jeleníti meg:
- * - SNR alapú színkódolás (kék->narancs->piros)
- * - Skála vonalak (oliva háttér)
- * - Állomás jelzők (zöld pontok)
- * - Kurzor pozíció (piros vonal)
+ * @brief A jelöltek kiválasztása egy teljes sweep után
+ * @details - Jelölt: jelzett (scanMark), mért pont, ahol az SNR helyi maximum
+ *          - Rangsor: SNR szerint csökkenő, egyenlőségnél az erősebb RSSI előrébb
+ *          - A frekvencia a sáv csatornarácsára (defStep) kerekítve, a már elfogadott jelölttől legfeljebb
+ *            egy csatornányira eső csúcs elnyomva (a szomszédos csatornára átszűrődő erős adó nem lesz külön állomás)
+ *          - A memóriában már meglévő és a szabad helyeken felüli jelöltek kimaradnak
+ *          FM-en ezután az összes csúcs (legfeljebb SURVEY_MAX_CANDIDATES) RDS felmérése jön, a memória szerinti
+ *          szűrés a felmérés eredményén történik; egyébként rögtön a mentés.
  */
-void ScreenScan::drawSpectrumLine(uint16_t pixelX) {
-    if (pixelX >= SCAN_AREA_WIDTH)
-        return;
+void ScreenScan::collectAutoStoreCandidates() {
+    // A pásztázás leáll, a hang a névgyűjtés végéig némítva marad
+    scanPaused = true;
+    tunePending = false;
+    if (playPauseButton) {
+        playPauseButton->setLabel("Start");
+    }
 
-    uint16_t screenX = SCAN_AREA_X + pixelX;
+    // Csúcsok gyűjtése
+    std::vector<uint16_t> peaks;
+    for (uint16_t i = 0; i < SCAN_RESOLUTION; i++) {
+        if (!scanModel.isMarked(i) || scanModel.getState(i) < ScanPointState::Coarse) {
+            continue;
+        }
+        uint8_t snr = scanModel.getSnr(i);
+        if ((i > 0 && scanModel.getSnr(i - 1) > snr) || (i + 1 < SCAN_RESOLUTION && scanModel.getSnr(i + 1) >= snr)) {
+            continue; // Nem helyi maximum (platón az első pont marad)
+        }
+        peaks.push_back(i);
+    }
+    std::sort(peaks.begin(), peaks.end(), [this](uint16_t a, uint16_t b) {
+        if (scanModel.getSnr(a) != scanModel.getSnr(b)) {
+            return scanModel.getSnr(a) > scanModel.getSnr(b);
+        }
+        return scanModel.getRssi(a) > scanModel.getRssi(b);
+    });
 
-    // Mérési pontok tartományának meghatározása ehhez a pixelhez
-    uint16_t dataStart = (pixelX * SCAN_RESOLUTION) / SCAN_AREA_WIDTH;
-    uint16_t dataEnd = ((pixelX + 1) * SCAN_RESOLUTION) / SCAN_AREA_WIDTH;
+    bool isFM = pSi4735Manager->isCurrentBandFM();
+    BandTable &currentBand = pSi4735Manager->getCurrentBand();
+    uint16_t step = std::max<uint16_t>(currentBand.defStep, 1);
+    uint8_t freeSlots = isFM ? MAX_FM_STATIONS - fmStationStore.getStationCount() : MAX_AM_STATIONS - amStationStore.getStationCount();
+    uint8_t limit = isFM ? SURVEY_MAX_CANDIDATES : std::min<uint8_t>(AUTO_STORE_MAX_STATIONS, freeSlots);
+
+    autoStoreStations.clear();
+    for (uint16_t pos : peaks) {
+        if (autoStoreStations.size() >= limit) {
+            break;
+        }
 
-    // Átlagolási változók inicializálása
-    int16_t avgRSSI = 0;
-    uint8_t avgSNR = 0;
-    bool hasStation = false;
-    bool isMainScale = false;
-    uint32_t avgFreq = 0;
+        // Csatornarácsra kerekítés (chip egységben: FM 10 kHz, AM kHz)
+        uint16_t freq = ((positionToFreq(pos) / 10 + step / 2) / step) * step;
 
-    // Mérési pontok átlagolása ebben a pixelben
-    int validSamples = 0;
-    for (uint16_t i = dataStart; i < dataEnd && i < SCAN_RESOLUTION; i++) {
-        // Csak valós mért adatokat vesszük figyelembe
-        if (scanValueRSSI[i] < SCAN_AREA_Y + SCAN_AREA_HEIGHT) {
-            avgRSSI += scanValueRSSI[i];
-            avgSNR += scanValueSNR[i];
-            validSamples++;
+        // Szomszédos csatorna elnyomás
+        bool suppressed = false;
+        for (const StationData &station : autoStoreStations) {
+            if (abs(static_cast<int32_t>(station.frequency) - freq) <= step) {
+                suppressed = true;
+                break;
+            }
         }
-
-        // Állomás jelzés ellenőrzése
-        if (scanMark[i]) {
-            hasStation = true;
+        if (suppressed) {
+            continue;
         }
 
-        // Frekvencia számítás az adatponthoz
-        uint32_t freq = scanStartFreq + (uint32_t)(i * scanStep);
-        avgFreq += freq; // Skála vonalak ellenőrzése - dinamikus ritkítás zoom szint alapján
-        // MINDIG ellenőrizzük a skála vonalakat, függetlenül a mérési adatoktól
-        if (scanScaleLine[i] == 0) {
-            if (zoomLevel < 1.4f) {
-                // 1x zoom: minden 2 MHz-nél
-                if ((freq % 2000) < scanStep) {
-                    scanScaleLine[i] = 2;
-                    isMainScale = true;
-                }
-            } else if (zoomLevel < 2.5f) {
-                // 2x zoom: minden 1 MHz-nél
-                if ((freq % 1000) < scanStep) {
-                    scanScaleLine[i] = 2;
-                    isMainScale = true;
-                }
-            } else if (zoomLevel < 4.0f) {
-                // 3x zoom: minden 500 kHz-nél
-                if ((freq % 500) < scanStep) {
-                    scanScaleLine[i] = 2;
-                    isMainScale = true;
-                }
-            } else if (scanStep > 50) {
-                // Nagy zoom (4x+), de még nagy lépésköz: minden 200 kHz-nél
-                if ((freq % 200) < scanStep) {
-                    scanScaleLine[i] = 2;
-                    isMainScale = true;
-                }
-            } else {
-                // Nagyon nagy zoom: minden 100 kHz-nél
-                if ((freq % 100) < scanStep) {
-                    scanScaleLine[i] = 2;
-                    isMainScale = true;
-                }
-            }
+        if (!isFM && amStationStore.findStation(freq, config.data.currentBandIdx) >= 0) {
+            continue;
         }
-        if (scanScaleLine[i] == 2)
-            isMainScale = true;
-    }
 
-    // Átlagok kiszámítása
-    if (validSamples > 0) {
-        avgRSSI /= validSamples;
-        avgSNR /= validSamples;
-    } else {
-        avgRSSI = SCAN_AREA_Y + SCAN_AREA_HEIGHT; // Nincs jel
-        avgSNR = 0;
+        StationData station = {};
+        station.bandIndex = config.data.currentBandIdx;
+        station.frequency = freq;
+        station.modulation = currentBand.currDemod;
+        station.bandwidthIndex = 0;
+        String name = isFM ? String(freq / 100.0f, 1) + "MHz" : String(freq) + "kHz";
+        strncpy(station.name, name.c_str(), MAX_STATION_NAME_LEN);
+        station.name[MAX_STATION_NAME_LEN] = '\0';
+        autoStoreStations.push_back(station);
     }
-    avgFreq /= (dataEnd - dataStart); // Színek meghatározása alapértelmezett értékekkel
-    uint16_t lineColor = TFT_NAVY;
-    uint16_t bgColor = TFT_BLACK;
 
-    // Skála vonalak esetén oliva háttér
-    if (isMainScale) {
-        lineColor = TFT_BLACK;
-        bgColor = TFT_OLIVE;
-    }
+    DEBUG("ScreenScan: auto store: %u csúcs, %u jelölt\n", peaks.size(), autoStoreStations.size());
 
-    // SNR alapú színkódolás a jel erősségének megjelenítéséhez
-    if (avgSNR > 0) {
-        lineColor = TFT_NAVY;
-        if (avgSNR < 16) {
-            // Gyenge jel: kék árnyalatok
-            lineColor += (avgSNR * 2048);
-        } else {
-            lineColor = TFT_ORANGE;
-            if (avgSNR < 24) {
-                // Közepes jel: narancs árnyalatok
-                lineColor += ((avgSNR - 16) * 258);
-            } else {
-                // Erős jel: piros
-                lineColor = TFT_RED;
-            }
-        }
+    if (isFM && !autoStoreStations.empty()) {
+        autoStorePhase = AutoStorePhase::Survey;
+        autoStoreIndex = 0;
+        surveyResults.clear();
+        surveyStartTime = millis();
+        tuneSurveyCandidate();
+    } else {
+        finishAutoStore();
     }
+}
 
-    // Sáv határok ellenőrzése és jelölése
-    if (avgFreq > scanEndFreq || avgFreq < scanStartFreq) {
-        lineColor = TFT_DARKGREY;
-        if (avgFreq > scanEndFreq && scanEndBand == SCAN_RESOLUTION) {
-            scanEndBand = dataStart;
-        }
-        if (avgFreq < scanStartFreq && scanBeginBand < (int16_t)dataStart) {
-            scanBeginBand = dataStart;
-        }
+// ===================================================================
+// FM sávfelmérés (RDS azonosítás)
+// ===================================================================
+
+/**
+ * @brief Ráhangolás az aktuális jelöltre, a jel mérése és az RDS dekóder újraindítása
+ */
+void ScreenScan::tuneSurveyCandidate() {
+    const StationData &station = autoStoreStations[autoStoreIndex];
+    setFrequency(station.frequency * 10);
+    pSi4735Manager->getSi4735().RdsInit(); // Az előző jelölt PS szegmensei ne maradjanak a pufferben
+
+    surveyCurrent = {};
+    surveyCurrent.frequency = station.frequency;
+    measureSignal(surveyCurrent.rssi, surveyCurrent.snr, countScanSignal);
+    surveyPiCount = 0;
+    surveyPs[0] = '\0';
+    surveyPsCount = 0;
+    surveySynced = false;
+
+    // A FIFO-ban maradt (az előző frekvencián vett) csoportok eldobása
+    RdsFifoGroup group;
+    while (pSi4735Manager->readRdsFifoGroup(group) && group.remaining > 0) {
     }
 
-    // RSSI alapú spektrum háttér rajzolása
-    int16_t rssiY = avgRSSI;
-    if (rssiY >= SCAN_AREA_Y + SCAN_AREA_HEIGHT) {
-        // Nincs jel - használjuk a megfelelő háttérszínt (oliva vonalaknál TFT_OLIVE)
-        tft.drawLine(screenX, SCAN_AREA_Y, screenX, SCAN_AREA_Y + SCAN_AREA_HEIGHT, bgColor);
-    } else {
-        // Van mért jel, normál spektrum megjelenítés
-        if (rssiY < SCAN_AREA_Y + 10)
-            rssiY = SCAN_AREA_Y + 10;
+    autoStoreTuneTime = millis();
+    autoStorePollTime = autoStoreTuneTime;
+    drawScanInfo();
+}
 
-        tft.drawLine(screenX, rssiY + 1, screenX, SCAN_AREA_Y + SCAN_AREA_HEIGHT, lineColor);
-        tft.drawLine(screenX, SCAN_AREA_Y, screenX, rssiY - 1, bgColor);
+/**
+ * @brief Az aktuális jelölt RDS azonosítása (a handleOwnLoop()-ból, nem blokkol)
+ * @details SURVEY_POLL_MS-onként a FIFO összes csoportja feldolgozásra kerül:
+ *          - PI: SURVEY_PI_CONFIRM egymást követő azonos érték után stabil, a PTY ugyanebből a csoportból
+ *          - PS: a könyvtár pufferében összerakott név, ha SURVEY_PS_CONFIRM egymást követő 0A csoportban sem változott
+ *          Továbblépés: RDS csoport nélkül SURVEY_SYNC_TIMEOUT_MS után, stabil PI mellett teljes PS-sel (vagy ha a PI
+ *          már ismert állomásé) azonnal, egyébként AUTO_STORE_RDS_TIMEOUT_MS után.
+ */
+void ScreenScan::updateSurvey() {
+    if (millis() - autoStorePollTime < SURVEY_POLL_MS) {
+        return;
     }
+    autoStorePollTime = millis();
 
-    // RSSI görbe rajzolása (simított) - az előző pixellel való összekötéshez
-    if (rssiY < SCAN_AREA_Y + SCAN_AREA_HEIGHT && pixelX > 0) {
-        // Előző pixel átlagolt RSSI értékének számítása
-        uint16_t prevDataStart = ((pixelX - 1) * SCAN_RESOLUTION) / SCAN_AREA_WIDTH;
-        uint16_t prevDataEnd = (pixelX * SCAN_RESOLUTION) / SCAN_AREA_WIDTH;
+    RdsFifoGroup group;
+    while (pSi4735Manager->readRdsFifoGroup(group)) {
+        surveySynced = true;
 
-        int16_t prevAvgRSSI = SCAN_AREA_Y + SCAN_AREA_HEIGHT;
-        int prevValidSamples = 0;
-        for (uint16_t i = prevDataStart; i < prevDataEnd && i < SCAN_RESOLUTION; i++) {
-            if (scanValueRSSI[i] < SCAN_AREA_Y + SCAN_AREA_HEIGHT) {
-                prevAvgRSSI += scanValueRSSI[i];
-                prevValidSamples++;
+        if (group.pi != 0) {
+            if (group.pi == surveyCurrent.pi) {
+                surveyPiCount = std::min<uint8_t>(surveyPiCount + 1, SURVEY_PI_CONFIRM);
+                if (surveyPiCount >= SURVEY_PI_CONFIRM) {
+                    surveyCurrent.pty = group.pty;
+                }
+            } else {
+                surveyCurrent.pi = group.pi;
+                surveyPiCount = 1;
             }
         }
-        if (prevValidSamples > 0) {
-            prevAvgRSSI /= prevValidSamples;
+
+        if (group.ps[0] != '\0') {
+            bool complete = strlen(group.ps) == sizeof(group.ps) - 1;
+            surveyPsCount = complete && strcmp(group.ps, surveyPs) == 0 ? std::min<uint8_t>(surveyPsCount + 1, SURVEY_PS_CONFIRM) : 0;
+            strcpy(surveyPs, group.ps);
         }
 
-        // Simított vonal rajzolása az előző ponttal
-        if (prevAvgRSSI < SCAN_AREA_Y + SCAN_AREA_HEIGHT) {
-            if (prevAvgRSSI < SCAN_AREA_Y + 10)
-                prevAvgRSSI = SCAN_AREA_Y + 10;
-            tft.drawLine(screenX - 1, prevAvgRSSI, screenX, rssiY, TFT_SILVER);
-        } else {
-            tft.drawPixel(screenX, rssiY, TFT_SILVER);
+        if (group.remaining == 0) {
+            break;
         }
     }
 
-    // Skála vonalak rajzolása - UTOLJÁRA, hogy mindig látszanak
-    if (isMainScale) {
-        tft.drawLine(screenX, SCAN_AREA_Y, screenX, SCAN_AREA_Y + 15, TFT_OLIVE);
+    bool piStable = surveyPiCount >= SURVEY_PI_CONFIRM;
+    bool psComplete = surveyPsCount >= SURVEY_PS_CONFIRM;
+    if (piStable && psComplete) {
+        strcpy(surveyCurrent.ps, surveyPs);
+        Utils::trimSpaces(surveyCurrent.ps);
+    }
+    drawSurveyTitle(); // Csak változáskor rajzol
+
+    // A PI egy már azonosított állomás másik frekvenciája: a PS nem kell
+    bool knownPi = false;
+    if (piStable) {
+        for (const FmSurveyEntry &entry : surveyResults) {
+            if (entry.pi == surveyCurrent.pi && entry.ps[0] != '\0') {
+                knownPi = true;
+                break;
+            }
+        }
     }
 
-    // Aktuális kurzor pozíció jelzése (piros vonal)
-    uint16_t currentPixelPos = (currentScanPos * SCAN_AREA_WIDTH) / SCAN_RESOLUTION;
-    if (pixelX == currentPixelPos) {
-        tft.drawLine(screenX, SCAN_AREA_Y, screenX, SCAN_AREA_Y + SCAN_AREA_HEIGHT, TFT_RED);
+    uint32_t elapsed = millis() - autoStoreTuneTime;
+    bool done = (piStable && (psComplete || knownPi)) || (!surveySynced && elapsed >= SURVEY_SYNC_TIMEOUT_MS) || elapsed >= AUTO_STORE_RDS_TIMEOUT_MS;
+    if (!done) {
+        return;
     }
 
-    // Állomás jelzők (zöld pontok)
-    if (hasStation) {
-        tft.drawPixel(screenX, SCAN_AREA_Y + 5, TFT_GREEN);
-        tft.drawPixel(screenX, SCAN_AREA_Y + 10, TFT_GREEN);
+    finishSurveyCandidate();
+    if (++autoStoreIndex < autoStoreStations.size()) {
+        tuneSurveyCandidate();
+    } else {
+        finishSurvey();
     }
 }
 
 /**
- * @brief Frekvencia skála vonal rajzolása
- *
- * Kirajzolja a vízszintes skála vonalat a spektrum alatt.
+ * @brief Az aktuális jelölt felvétele az eredmények közé
+ * @details Stabil PI nélkül a jelölt a frekvenciájával önálló sor. Azonos PI-nél egy sor marad: az erősebb (RSSI,
+ *          egyenlőségnél SNR) frekvencia nyer, a PS és a PTY a már megjött értékkel egészül ki.
+ */
+void ScreenScan::finishSurveyCandidate() {
+    if (surveyPiCount < SURVEY_PI_CONFIRM) {
+        surveyCurrent.pi = 0;
+        surveyCurrent.pty = 0;
+        surveyCurrent.ps[0] = '\0';
+    }
+    DEBUG("ScreenScan: survey %u: PI %04X PS '%s' PTY %u (%lu ms)\n", surveyCurrent.frequency, surveyCurrent.pi, surveyCurrent.ps, surveyCurrent.pty, millis() - autoStoreTuneTime);
+
+    if (surveyCurrent.pi != 0) {
+        for (FmSurveyEntry &entry : surveyResults) {
+            if (entry.pi != surveyCurrent.pi) {
+                continue;
+            }
+            bool stronger = surveyCurrent.rssi != entry.rssi ? surveyCurrent.rssi > entry.rssi : surveyCurrent.snr > entry.snr;
+            if (stronger) {
+                entry.frequency = surveyCurrent.frequency;
+                entry.rssi = surveyCurrent.rssi;
+                entry.snr = surveyCurrent.snr;
+            }
+            if (entry.ps[0] == '\0' || (stronger && surveyCurrent.ps[0] != '\0')) {
+                strcpy(entry.ps, surveyCurrent.ps);
+            }
+            if (stronger) {
+                entry.pty = surveyCurrent.pty;
+            }
+            return;
+        }
+    }
+    surveyResults.push_back(surveyCurrent);
+}
+
+/**
+ * @brief A felmérés lezárása: a memóriában még nem szereplő állomások kiválasztása tárolásra
+ * @details A sorrend SNR szerint csökkenő, a név a PS (ha nincs, a frekvencia). Az eredménytábla
+ *          frekvencia szerint rendezve a spektrum helyére kerül.
+ */
+void ScreenScan::finishSurvey() {
+    std::sort(surveyResults.begin(), surveyResults.end(), [](const FmSurveyEntry &a, const FmSurveyEntry &b) { return a.frequency < b.frequency; });
+    DEBUG("ScreenScan: survey: %u jelölt, %u állomás, %lu ms\n", autoStoreStations.size(), surveyResults.size(), millis() - surveyStartTime);
+
+    std::vector<const FmSurveyEntry *> ranked;
+    for (const FmSurveyEntry &entry : surveyResults) {
+        ranked.push_back(&entry);
+    }
+    std::stable_sort(ranked.begin(), ranked.end(), [](const FmSurveyEntry *a, const FmSurveyEntry *b) { return a->snr > b->snr; });
+
+    BandTable &currentBand = pSi4735Manager->getCurrentBand();
+    uint8_t limit = std::min<uint8_t>(AUTO_STORE_MAX_STATIONS, MAX_FM_STATIONS - fmStationStore.getStationCount());
+
+    autoStoreStations.clear();
+    for (const FmSurveyEntry *entry : ranked) {
+        if (autoStoreStations.size() >= limit) {
+            break;
+        }
+        if (fmStationStore.findStation(entry->frequency, config.data.currentBandIdx) >= 0) {
+            continue;
+        }
+        StationData station = {};
+        station.bandIndex = config.data.currentBandIdx;
+        station.frequency = entry->frequency;
+        station.modulation = currentBand.currDemod;
+        station.bandwidthIndex = 0;
+        String name = entry->ps[0] != '\0' ? String(entry->ps) : String(entry->frequency / 100.0f, 1) + "MHz";
+        strncpy(station.name, name.c_str(), MAX_STATION_NAME_LEN);
+        station.name[MAX_STATION_NAME_LEN] = '\0';
+        autoStoreStations.push_back(station);
+    }
+
+    surveyView = true;
+    surveyTableTop = 0;
+    finishAutoStore();
+}
+
+/**
+ * @brief A jelöltek mentése egyetlen tárolással, majd a kurzor a legjobb állomásra
+ */
+void ScreenScan::finishAutoStore() {
+    uint8_t added = 0;
+    if (!autoStoreStations.empty()) {
+        added = pSi4735Manager->isCurrentBandFM() ? fmStationStore.addStations(autoStoreStations.data(), autoStoreStations.size())
+                                                  : amStationStore.addStations(autoStoreStations.data(), autoStoreStations.size());
+    }
+
+    // A pauseScan() visszakapcsolja a hangot
+    autoStorePhase = AutoStorePhase::Off;
+    pauseScan();
+
+    // Kurzor és hangolás a legjobb jelöltre
+    if (!autoStoreStations.empty()) {
+        uint16_t oldPixelPos = (currentScanPos * SCAN_AREA_WIDTH) / SCAN_RESOLUTION;
+        currentScanPos = freqToPosition(autoStoreStations.front().frequency * 10);
+        setFrequency(positionToFreq(currentScanPos));
+        drawSpectrumLine(oldPixelPos);
+        drawSpectrumLine((currentScanPos * SCAN_AREA_WIDTH) / SCAN_RESOLUTION);
+        drawScanInfo();
+    }
+    autoStoreStations.clear();
+
+    char message[48];
+    if (surveyView) {
+        uint8_t rdsCount = std::count_if(surveyResults.begin(), surveyResults.end(), [](const FmSurveyEntry &entry) { return entry.pi != 0; });
+        snprintf(message, sizeof(message), "%u found, %u RDS, %u stored", static_cast<unsigned>(surveyResults.size()), rdsCount, added);
+    } else {
+        snprintf(message, sizeof(message), "%u stations stored", added);
+    }
+    auto infoDialog = std::make_shared<MessageDialog>(this, surveyView ? "FM Survey" : "Auto Store", message, MessageDialog::ButtonsType::Ok, Rect(-1, -1, 250, 0));
+    showDialog(infoDialog);
+}
+
+/**
+ * @brief A felmérés eredménytáblája a spektrum helyén (frekvencia szerint, forgatással görgethető)
+ * @details Az RDS nélküli állomások sorai szürkék
+ */
+void ScreenScan::drawSurveyTable() {
+    constexpr uint16_t COL_FREQ = SCAN_AREA_X + 4;
+    constexpr uint16_t COL_RSSI = SCAN_AREA_X + 60;
+    constexpr uint16_t COL_SNR = SCAN_AREA_X + 100;
+    constexpr uint16_t COL_PI = SCAN_AREA_X + 135;
+    constexpr uint16_t COL_PS = SCAN_AREA_X + 180;
+    constexpr uint16_t COL_PTY = SCAN_AREA_X + 245;
+    const uint8_t visibleRows = SCAN_AREA_HEIGHT / SURVEY_ROW_HEIGHT - 1; // A fejléc egy sor
+
+    tft.fillRect(SCAN_AREA_X, SCAN_AREA_Y, SCAN_AREA_WIDTH, SCAN_AREA_HEIGHT, TFT_COLOR_BACKGROUND);
+    tft.setFreeFont();
+    tft.setTextSize(1);
+    tft.setTextDatum(TL_DATUM);
+
+    int16_t y = SCAN_AREA_Y + 3;
+    tft.setTextColor(TFT_YELLOW, TFT_COLOR_BACKGROUND);
+    tft.drawString("MHz", COL_FREQ, y);
+    tft.drawString("dBuV", COL_RSSI, y);
+    tft.drawString("SNR", COL_SNR, y);
+    tft.drawString("PI", COL_PI, y);
+    tft.drawString("PS", COL_PS, y);
+    tft.drawString("PTY", COL_PTY, y);
+    if (surveyResults.size() > visibleRows) {
+        String rangeText = String(surveyTableTop + 1) + "-" + String(std::min<uint16_t>(surveyTableTop + visibleRows, surveyResults.size())) + "/" + String(surveyResults.size());
+        tft.setTextDatum(TR_DATUM);
+        tft.drawString(rangeText, SCAN_AREA_X + SCAN_AREA_WIDTH - 4, y);
+        tft.setTextDatum(TL_DATUM);
+    }
+
+    for (uint8_t row = 0; row < visibleRows && surveyTableTop + row < surveyResults.size(); row++) {
+        const FmSurveyEntry &entry = surveyResults[surveyTableTop + row];
+        y += SURVEY_ROW_HEIGHT;
+        tft.setTextColor(entry.pi != 0 ? TFT_WHITE : TFT_DARKGREY, TFT_COLOR_BACKGROUND);
+        tft.drawString(String(entry.frequency / 100.0f, 2), COL_FREQ, y);
+        tft.drawString(String(entry.rssi), COL_RSSI, y);
+        tft.drawString(String(entry.snr), COL_SNR, y);
+        if (entry.pi == 0) {
+            continue;
+        }
+        char piText[5];
+        snprintf(piText, sizeof(piText), "%04X", entry.pi);
+        tft.drawString(piText, COL_PI, y);
+        tft.drawString(entry.ps, COL_PS, y);
+        tft.drawString(pSi4735Manager->convertPtyCodeToString(entry.pty), COL_PTY, y);
+    }
+}
+
+/**
+ * @brief Az éppen azonosított jelölt a cím helyén (csak változáskor)
+ */
+void ScreenScan::drawSurveyTitle() {
+    String titleText = String(surveyCurrent.frequency / 100.0f, 2) + " MHz";
+    if (surveyPiCount >= SURVEY_PI_CONFIRM) {
+        char piText[10];
+        snprintf(piText, sizeof(piText), "  PI %04X", surveyCurrent.pi);
+        titleText += piText;
+        if (surveyCurrent.ps[0] != '\0') {
+            titleText += "  " + String(surveyCurrent.ps);
+        }
+    } else if (surveySynced) {
+        titleText += "  RDS...";
+    }
+    if (titleText == lastStatsText) {
+        return;
+    }
+
+    tft.fillRect(0, 0, ::SCREEN_W, SCAN_AREA_Y - 1, TFT_BLACK); // A cím törlése
+    tft.setFreeFont();
+    tft.setTextColor(TFT_WHITE, TFT_BLACK);
+    tft.setTextSize(2);
+    tft.setTextDatum(TC_DATUM);
+    tft.drawString(titleText, tft.width() / 2, 10);
+    lastStatsText = titleText;
+}
+
+// ===================================================================
+// Memória pásztázás
+// ===================================================================
+
+/**
+ * @brief Memória pásztázás indítása (Mem gomb)
+ * @details A két állomástár csatornái egy listába kerülnek, a sávváltások szerint csoportosítva: előbb az FM, majd az AM,
+ *          végül az SSB/CW demodulációjú csatornák, a csoporton belül sáv, demoduláció, sávszélesség és frekvencia szerint.
+ *          Így a blokkoló sávváltás (bandSet()) csoportonként egyszer fut, az SSB patch pedig a teljes SSB/CW csoporthoz
+ *          egyszer töltődik be (az AM demoduláció törli a betöltött állapotot, ezért nem keveredhet közéjük).
+ */
+void ScreenScan::startMemoryScan() {
+    if (!pSi4735Manager) {
+        return;
+    }
+
+    surveyView = false;
+    memoryChannels.clear();
+    for (uint8_t i = 0; i < fmStationStore.getStationCount(); i++) {
+        memoryChannels.push_back({*fmStationStore.getStationByIndex(i), 0, 0, false});
+    }
+    for (uint8_t i = 0; i < amStationStore.getStationCount(); i++) {
+        memoryChannels.push_back({*amStationStore.getStationByIndex(i), 0, 0, false});
+    }
+    if (memoryChannels.empty()) {
+        memoryScanButton->setButtonState(UIButton::ButtonState::Off);
+        auto infoDialog = std::make_shared<MessageDialog>(this, "Memory Scan", "No stored stations", MessageDialog::ButtonsType::Ok, Rect(-1, -1, 250, 0));
+        showDialog(infoDialog);
+        return;
+    }
+
+    auto groupRank = [](uint8_t modulation) -> uint8_t { return modulation == FM_DEMOD_TYPE ? 0 : modulation == AM_DEMOD_TYPE ? 1 : 2; };
+    std::stable_sort(memoryChannels.begin(), memoryChannels.end(), [&groupRank](const MemoryScanChannel &a, const MemoryScanChannel &b) {
+        const StationData &sa = a.station;
+        const StationData &sb = b.station;
+        if (groupRank(sa.modulation) != groupRank(sb.modulation)) {
+            return groupRank(sa.modulation) < groupRank(sb.modulation);
+        }
+        if (sa.bandIndex != sb.bandIndex) {
+            return sa.bandIndex < sb.bandIndex;
+        }
+        if (sa.modulation != sb.modulation) {
+            return sa.modulation < sb.modulation;
+        }
+        if (sa.bandwidthIndex != sb.bandwidthIndex) {
+            return sa.bandwidthIndex < sb.bandwidthIndex;
+        }
+        return sa.frequency < sb.frequency;
+    });
+
+    DEBUG("ScreenScan: memory scan, %u csatorna\n", memoryChannels.size());
+
+    // A spektrum pásztázás (és az automatikus tárolás) leáll, a gombjai a memória pásztázás végéig tiltva
+    pauseScan();
+    scanMode = ScanMode::Memory;
+    memoryScanStartBandIdx = config.data.currentBandIdx;
+    memoryScanIndex = 0;
+    setSpectrumButtonsEnabled(false);
+    pSi4735Manager->getSi4735().setAudioMute(true);
+    pollTuneComplete(); // Egy korábbi hangolás STC jelzésének törlése
+    tuneMemoryChannel();
+    markForRedraw(true); // Csatorna sáv nézet a spektrum helyén
+}
+
+/**
+ * @brief Memória pásztázás leállítása
+ * @details A rádió az utolsó csatornán marad. Ha az más sávon van, mint ahol a pásztázás indult,
+ *          a spektrum adatai érvénytelenek, ezért az új sávra törlődnek.
+ */
+void ScreenScan::stopMemoryScan() {
+    if (scanMode != ScanMode::Memory) {
+        return;
+    }
+    if (memoryScanPhase == MemoryScanPhase::Tune && pSi4735Manager) {
+        waitTuneComplete();
+    }
+    scanMode = ScanMode::Spectrum;
+    memoryChannels.clear();
+    setSpectrumButtonsEnabled(true);
+    memoryScanButton->setButtonState(UIButton::ButtonState::Off);
+
+    if (config.data.currentBandIdx != memoryScanStartBandIdx) {
+        resetScan();
+    }
+    if (pSi4735Manager) {
+        pSi4735Manager->getSi4735().setAudioMute(false);
+    }
+}
+
+/**
+ * @brief A spektrum pásztázás gombjainak engedélyezése/tiltása (memória pásztázás alatt tiltva)
+ */
+void ScreenScan::setSpectrumButtonsEnabled(bool enabled) {
+    UIButton::ButtonState state = enabled ? UIButton::ButtonState::Off : UIButton::ButtonState::Disabled;
+    playPauseButton->setButtonState(state);
+    zoomInButton->setButtonState(state);
+    zoomOutButton->setButtonState(state);
+    resetButton->setButtonState(state);
+    autoStoreButton->setButtonState(state);
+    heatmapButton->setButtonState(enabled && heatmapView ? UIButton::ButtonState::On : state);
+}
+
+/**
+ * @brief Ráhangolás az aktuális csatornára (várakozás nélkül, a befejezést a updateMemoryScan() figyeli)
+ * @details Ugyanazon a sávon, demodulációval és sávszélességgel csak frekvencia hangolás történik,
+ *          egyébként a tuneMemoryStation() teljes sávváltása (a csoportosítás miatt ritkán)
+ */
+void ScreenScan::tuneMemoryChannel() {
+    const StationData &station = memoryChannels[memoryScanIndex].station;
+    SI4735 &si4735 = pSi4735Manager->getSi4735();
+
+    uint8_t bandwidthIndex = station.modulation == FM_DEMOD_TYPE   ? config.data.bwIdxFM
+                             : station.modulation == AM_DEMOD_TYPE ? config.data.bwIdxAM
+                                                                   : config.data.bwIdxSSB;
+    bool sameGroup = station.bandIndex == config.data.currentBandIdx && station.modulation == pSi4735Manager->getCurrentBand().currDemod &&
+                     station.bandwidthIndex == bandwidthIndex;
+    if (sameGroup) {
+        tuneTo(station.frequency * 10);
+    } else {
+        DEBUG("ScreenScan: memory scan sávváltás -> %s\n", pSi4735Manager->getBandByIdx(station.bandIndex).bandName);
+        pSi4735Manager->tuneMemoryStation(station.bandIndex, station.frequency, station.modulation, station.bandwidthIndex);
+        si4735.setAudioMute(true); // A sávváltás visszaállítja a hangerőt
+        currentScanFreq = station.frequency * 10;
+        lastTuneTime = millis();
+    }
+
+    // Leállításkor (vagy a képernyő elhagyásakor) a rádió ezen a csatornán marad
+    pSi4735Manager->getCurrentBand().currFreq = station.frequency;
+    if (pSi4735Manager->isCurrentBandFM()) {
+        pSi4735Manager->clearRdsCache();
+    }
+
+    memoryScanPhase = MemoryScanPhase::Tune;
+    memoryScanTuneTime = millis();
+}
+
+/**
+ * @brief Továbblépés a következő/előző csatornára (a lista végén körbe)
+ */
+void ScreenScan::advanceMemoryChannel(int8_t direction) {
+    uint8_t previous = memoryScanIndex;
+    memoryScanIndex = (memoryScanIndex + memoryChannels.size() + direction) % memoryChannels.size();
+    tuneMemoryChannel();
+    drawMemoryChannel(previous);
+    drawMemoryChannel(memoryScanIndex);
+}
+
+/**
+ * @brief Egyetlen RSQ minta az aktuális csatornán
+ * @return true ha a csatorna aktív (az SNR eléri az állomás jelzés küszöbét)
+ */
+bool ScreenScan::sampleMemoryChannel() {
+    MemoryScanChannel &channel = memoryChannels[memoryScanIndex];
+    measureSignal(channel.rssi, channel.snr, 1);
+    channel.measured = true;
+    return channel.snr >= scanMarkSNR;
+}
+
+/**
+ * @brief Memória pásztázás frissítése (a handleOwnLoop()-ból, nem blokkol)
+ * @details - Tune: legfeljebb SCAN_SLICE_MS ideig hangol és mintáz egymás után, amíg üres csatornákon halad;
+ *            aktív csatornán bekapcsolja a hangot és Dwell-be vált
+ *          - Dwell: MEMORY_SCAN_POLL_MS-onként mintáz, MEMORY_SCAN_RESUME_MS tartós jelvesztés után némít és továbblép
+ */
+void ScreenScan::updateMemoryScan() {
+    if (!pSi4735Manager || memoryChannels.empty()) {
+        return;
+    }
+
+    if (memoryScanPhase == MemoryScanPhase::Dwell) {
+        if (millis() - memoryScanPollTime < MEMORY_SCAN_POLL_MS) {
+            return;
+        }
+        memoryScanPollTime = millis();
+        if (sampleMemoryChannel()) {
+            memoryScanSignalTime = memoryScanPollTime;
+        } else if (memoryScanPollTime - memoryScanSignalTime >= MEMORY_SCAN_RESUME_MS) {
+            pSi4735Manager->getSi4735().setAudioMute(true);
+            advanceMemoryChannel(1);
+            drawScanInfo();
+            return;
+        }
+        drawMemoryChannel(memoryScanIndex);
+        drawScanInfo();
+        return;
+    }
+
+    uint32_t sliceStart = millis();
+    while (millis() - sliceStart < SCAN_SLICE_MS) {
+        if (!pollTuneComplete() && millis() - memoryScanTuneTime < STC_TIMEOUT_MS) {
+            continue;
+        }
+        if (sampleMemoryChannel()) {
+            memoryScanPhase = MemoryScanPhase::Dwell;
+            memoryScanPollTime = millis();
+            memoryScanSignalTime = memoryScanPollTime;
+            pSi4735Manager->getSi4735().setAudioMute(false);
+            drawMemoryChannel(memoryScanIndex);
+            drawScanInfo();
+            return;
+        }
+        advanceMemoryChannel(1);
+    }
+
+    if (millis() - lastInfoTime >= SCAN_INFO_INTERVAL_MS) {
+        lastInfoTime = millis();
+        drawScanInfo();
+    }
+}
+
+/**
+ * @brief A csatorna sávok kirajzolása a spektrum helyére
+ */
+void ScreenScan::drawMemoryScan() {
+    tft.fillRect(SCAN_AREA_X, SCAN_AREA_Y, SCAN_AREA_WIDTH, SCAN_AREA_HEIGHT, TFT_COLOR_BACKGROUND);
+    for (uint8_t i = 0; i < memoryChannels.size(); i++) {
+        drawMemoryChannel(i);
+    }
+}
+
+/**
+ * @brief Egy csatorna sávja: magassága az utolsó minta RSSI értéke, zöld ha aktív, az aktuális csatorna sárga, piros keretben
+ */
+void ScreenScan::drawMemoryChannel(uint8_t index) {
+    if (index >= memoryChannels.size()) {
+        return;
+    }
+    uint16_t x = SCAN_AREA_X + (index * SCAN_AREA_WIDTH) / memoryChannels.size();
+    uint16_t width = SCAN_AREA_X + ((index + 1) * SCAN_AREA_WIDTH) / memoryChannels.size() - x;
+    if (width > 2) {
+        width--; // 1 pixel rés a csatornák között
+    }
+    tft.fillRect(x, SCAN_AREA_Y, width, SCAN_AREA_HEIGHT, TFT_COLOR_BACKGROUND);
+
+    const MemoryScanChannel &channel = memoryChannels[index];
+    bool current = index == memoryScanIndex;
+    if (channel.measured) {
+        int16_t top = rssiToY(channel.rssi);
+        uint16_t color = current ? TFT_YELLOW : channel.snr >= scanMarkSNR ? TFT_GREEN : TFT_DARKGREY;
+        tft.fillRect(x, top, width, SCAN_AREA_Y + SCAN_AREA_HEIGHT - top, color);
+    }
+    if (current) {
+        tft.drawRect(x, SCAN_AREA_Y, width, SCAN_AREA_HEIGHT, TFT_RED);
+    }
+}
+
+/**
+ * @brief Az aktuális csatorna adatai a cím helyén (csak változáskor)
+ */
+void ScreenScan::drawMemoryScanTitle() {
+    if (memoryChannels.empty()) {
+        return;
+    }
+    const StationData &station = memoryChannels[memoryScanIndex].station;
+    String freqText = station.modulation == FM_DEMOD_TYPE ? String(station.frequency / 100.0f, 2) + " MHz" : String(station.frequency) + " kHz";
+    String titleText = String(station.name) + "  " + freqText + "  " + pSi4735Manager->getBandByIdx(station.bandIndex).bandName;
+    if (station.modulation < ARRAY_ITEM_COUNT(Band::bandModeDesc)) {
+        titleText += String(" ") + Band::bandModeDesc[station.modulation];
+    }
+    if (titleText == lastStatsText) {
+        return;
+    }
+
+    tft.fillRect(0, 0, ::SCREEN_W, SCAN_AREA_Y - 1, TFT_BLACK); // A cím törlése
+    tft.setFreeFont();
+    tft.setTextColor(TFT_WHITE, TFT_BLACK);
+    tft.setTextSize(2);
+    tft.setTextDatum(TC_DATUM);
+    tft.drawString(titleText, tft.width() / 2, 10);
+    lastStatsText = titleText;
+}
+
+// ===================================================================
+// Rajzolási funkciók
+// ===================================================================
+
+/**
+ * @brief Teljes spektrum kirajzolása
+ *
+ * Kirajzolja az összes spektrum vonalat pixel-enkénti felbontásban.
+ * Minden pixel reprezentálja egy vagy több mérési pontot.
+ */
+void ScreenScan::drawSpectrum() {
+    if (scanMode == ScanMode::Memory) {
+        drawMemoryScan();
+        return;
+    }
+    if (heatmapView) {
+        drawHeatmap();
+        return;
+    }
+    if (surveyView) {
+        drawSurveyTable();
+        return;
+    }
+
+    // Spektrum terület törlése
+    tft.fillRect(SCAN_AREA_X, SCAN_AREA_Y, SCAN_AREA_WIDTH, SCAN_AREA_HEIGHT, TFT_COLOR_BACKGROUND);
+
+    // Minden pixel spektrum vonalának kirajzolása
+    for (int x = 0; x < SCAN_AREA_WIDTH; x++) {
+        drawSpectrumLine(x);
+    }
+}
+
+/**
+ * @brief Egy spektrum vonal kirajzolása
+ * @param pixelX A vízszintes pixel pozíció (0-SCAN_AREA_WIDTH)
+ *
+ * Ez a függvény felelős egy vertikális spektrum vonal kirajzolásáért.
+ * Több mérési pontot átlagol egy pixelre és különböző színekkel jeleníti meg:
+ * - SNR alapú színkódolás (kék->narancs->piros)
+ * - Skála vonalak (oliva háttér)
+ * - Állomás jelzők (zöld pontok)
+ * - Kurzor pozíció (piros vonal)
+ */
+void ScreenScan::drawSpectrumLine(uint16_t pixelX) {
+    if (pixelX >= SCAN_AREA_WIDTH || scanMode == ScanMode::Memory || surveyView)
+        return;
+
+    // Hőtérkép nézetben pásztázás közben nincs oszloponkénti rajzolás (a sweep végén egyben frissül), megállítva a kurzor mozog
+    if (heatmapView) {
+        if (scanPaused) {
+            drawHeatmapColumn(pixelX);
+        }
+        return;
+    }
+
+    uint16_t screenX = SCAN_AREA_X + pixelX;
+
+    // Mérési pontok tartományának meghatározása ehhez a pixelhez
+    uint16_t dataStart = (pixelX * SCAN_RESOLUTION) / SCAN_AREA_WIDTH;
+    uint16_t dataEnd = ((pixelX + 1) * SCAN_RESOLUTION) / SCAN_AREA_WIDTH;
+
+    // Átlagolási változók inicializálása
+    uint16_t avgRSSI = 0;
+    uint8_t avgSNR = 0;
+    bool hasStation = false;
+    uint16_t stationColor = TFT_GREEN; // Osztályozott állomásnál a jeltípus színe
+    bool isMainScale = false;
+    uint32_t avgFreq = 0;
+
+    // Mérési pontok átlagolása ebben a pixelben
+    int validSamples = 0;
+    for (uint16_t i = dataStart; i < dataEnd && i < SCAN_RESOLUTION; i++) {
+        // Csak valós mért (vagy interpolált) adatokat vesszük figyelembe
+        if (scanModel.getState(i) != ScanPointState::None) {
+            avgRSSI += scanModel.getRssi(i);
+            avgSNR += scanModel.getSnr(i);
+            validSamples++;
+        }
+
+        // Állomás jelzés ellenőrzése
+        if (scanModel.isMarked(i)) {
+            hasStation = true;
+            uint8_t signalClass = scanModel.getSignalClass(i);
+            if (signalClass != static_cast<uint8_t>(SignalClass::None)) {
+                stationColor = SignalClassifier::getColor(static_cast<SignalClass>(signalClass));
+            }
+        }
+
+        // Frekvencia számítás az adatponthoz
+        uint32_t freq = scanStartFreq + (uint32_t)(i * scanStep);
+        avgFreq += freq;
+
+        // Skála vonalak ellenőrzése - MINDIG, függetlenül a mérési adatoktól
+        if (isScaleLine(freq)) {
+            isMainScale = true;
+        }
+    }
+
+    // Átlagok kiszámítása (a Y koordináta csak itt, rajzoláshoz számolódik)
+    int16_t avgRSSIY = SCAN_AREA_Y + SCAN_AREA_HEIGHT; // Nincs jel
+    if (validSamples > 0) {
+        avgRSSIY = rssiToY(avgRSSI / validSamples);
+        avgSNR /= validSamples;
+    } else {
+        avgSNR = 0;
+    }
+    avgFreq /= (dataEnd - dataStart); // Színek meghatározása alapértelmezett értékekkel
+    uint16_t lineColor = TFT_NAVY;
+    uint16_t bgColor = TFT_BLACK;
+
+    // Skála vonalak esetén oliva háttér
+    if (isMainScale) {
+        lineColor = TFT_BLACK;
+        bgColor = TFT_OLIVE;
+    }
+
+    // SNR alapú színkódolás a jel erősségének megjelenítéséhez
+    if (avgSNR > 0) {
+        lineColor = TFT_NAVY;
+        if (avgSNR < 16) {
+            // Gyenge jel: kék árnyalatok
+            lineColor += (avgSNR * 2048);
+        } else {
+            lineColor = TFT_ORANGE;
+            if (avgSNR < 24) {
+                // Közepes jel: narancs árnyalatok
+                lineColor += ((avgSNR - 16) * 258);
+            } else {
+                // Erős jel: piros
+                lineColor = TFT_RED;
+            }
+        }
+    }
+
+    // Sáv határok ellenőrzése és jelölése
+    if (avgFreq > scanEndFreq || avgFreq < scanStartFreq) {
+        lineColor = TFT_DARKGREY;
+        if (avgFreq > scanEndFreq && scanEndBand == SCAN_RESOLUTION) {
+            scanEndBand = dataStart;
+        }
+        if (avgFreq < scanStartFreq && scanBeginBand < (int16_t)dataStart) {
+            scanBeginBand = dataStart;
+        }
+    }
+
+    // RSSI alapú spektrum háttér rajzolása
+    int16_t rssiY = avgRSSIY;
+    if (rssiY >= SCAN_AREA_Y + SCAN_AREA_HEIGHT) {
+        // Nincs jel - használjuk a megfelelő háttérszínt (oliva vonalaknál TFT_OLIVE)
+        tft.drawLine(screenX, SCAN_AREA_Y, screenX, SCAN_AREA_Y + SCAN_AREA_HEIGHT, bgColor);
+    } else {
+        // Van mért jel, normál spektrum megjelenítés
+        if (rssiY < SCAN_AREA_Y + 10)
+            rssiY = SCAN_AREA_Y + 10;
+
+        tft.drawLine(screenX, rssiY + 1, screenX, SCAN_AREA_Y + SCAN_AREA_HEIGHT, lineColor);
+        tft.drawLine(screenX, SCAN_AREA_Y, screenX, rssiY - 1, bgColor);
+    }
+
+    // RSSI görbe rajzolása (simított) - az előző pixellel való összekötéshez
+    if (rssiY < SCAN_AREA_Y + SCAN_AREA_HEIGHT && pixelX > 0) {
+        // Előző pixel átlagolt RSSI értékének számítása
+        uint16_t prevDataStart = ((pixelX - 1) * SCAN_RESOLUTION) / SCAN_AREA_WIDTH;
+        uint16_t prevDataEnd = (pixelX * SCAN_RESOLUTION) / SCAN_AREA_WIDTH;
+
+        int16_t prevAvgRSSI = SCAN_AREA_Y + SCAN_AREA_HEIGHT;
+        uint16_t prevRSSISum = 0;
+        int prevValidSamples = 0;
+        for (uint16_t i = prevDataStart; i < prevDataEnd && i < SCAN_RESOLUTION; i++) {
+            if (scanModel.getState(i) != ScanPointState::None) {
+                prevRSSISum += scanModel.getRssi(i);
+                prevValidSamples++;
+            }
+        }
+        if (prevValidSamples > 0) {
+            prevAvgRSSI = rssiToY(prevRSSISum / prevValidSamples);
+        }
+
+        // Simított vonal rajzolása az előző ponttal
+        if (prevAvgRSSI < SCAN_AREA_Y + SCAN_AREA_HEIGHT) {
+            if (prevAvgRSSI < SCAN_AREA_Y + 10)
+                prevAvgRSSI = SCAN_AREA_Y + 10;
+            tft.drawLine(screenX - 1, prevAvgRSSI, screenX, rssiY, TFT_SILVER);
+        } else {
+            tft.drawPixel(screenX, rssiY, TFT_SILVER);
+        }
+    }
+
+    // Skála vonalak rajzolása - UTOLJÁRA, hogy mindig látszanak
+    if (isMainScale) {
+        tft.drawLine(screenX, SCAN_AREA_Y, screenX, SCAN_AREA_Y + 15, TFT_OLIVE);
+    }
+
+    // Aktuális kurzor pozíció jelzése (piros vonal)
+    uint16_t currentPixelPos = (currentScanPos * SCAN_AREA_WIDTH) / SCAN_RESOLUTION;
+    if (pixelX == currentPixelPos) {
+        tft.drawLine(screenX, SCAN_AREA_Y, screenX, SCAN_AREA_Y + SCAN_AREA_HEIGHT, TFT_RED);
+    }
+
+    // Állomás jelzők (zöld pontok, osztályozott állomásnál a jeltípus színével)
+    if (hasStation) {
+        tft.drawPixel(screenX, SCAN_AREA_Y + 5, stationColor);
+        tft.drawPixel(screenX, SCAN_AREA_Y + 10, stationColor);
+    }
+}
+
+/**
+ * @brief Esik-e skála vonal az adatpont frekvenciájára
+ * @details Dinamikus ritkítás a zoom szint alapján (a nézetből számolódik, pontonként nem tároljuk)
+ */
+bool ScreenScan::isScaleLine(uint32_t freq) const {
+    uint16_t spacing;
+    if (zoomLevel < 1.4f) {
+        spacing = 2000; // 1x zoom: minden 2 MHz-nél
+    } else if (zoomLevel < 2.5f) {
+        spacing = 1000; // 2x zoom: minden 1 MHz-nél
+    } else if (zoomLevel < 4.0f) {
+        spacing = 500; // 3x zoom: minden 500 kHz-nél
+    } else if (scanStep > 50) {
+        spacing = 200; // Nagy zoom (4x+), de még nagy lépésköz: minden 200 kHz-nél
+    } else {
+        spacing = 100; // Nagyon nagy zoom: minden 100 kHz-nél
+    }
+    return (freq % spacing) < scanStep;
+}
+
+/**
+ * @brief Frekvencia skála vonal rajzolása
+ *
+ * Kirajzolja a vízszintes skála vonalat a spektrum alatt.
  */
 void ScreenScan::drawScale() {
     // Skála vonal a spektrum alatt
@@ -1015,6 +2073,7 @@ void ScreenScan::drawScanInfoStatic() {
     tft.drawString("x", 70, INFO_AREA_Y + 15); // x egység fix helyen
 
     tft.drawString("Status: ", 170, INFO_AREA_Y);
+    tft.drawString("Type: ", 170, INFO_AREA_Y + 15);
 
     // Statikus címkék a jel információkhoz
     tft.drawString("RSSI: ", 330, INFO_AREA_Y);
@@ -1046,8 +2105,15 @@ void ScreenScan::drawScanInfo() {
 
     // Scan állapot - csak akkor írjuk ki, ha változott (villogás elkerülése)
     String statusText;
-    if (scanState == ScanState::Scanning && !scanPaused) {
-        statusText = "Scanning...";
+    if (scanMode == ScanMode::Memory) {
+        statusText = (memoryScanPhase == MemoryScanPhase::Dwell ? "Mem hold " : "Mem scan ") + String(memoryScanIndex + 1) + "/" + String(memoryChannels.size());
+    } else if (autoStorePhase == AutoStorePhase::Sweep) {
+        statusText = "Auto store...";
+    } else if (autoStorePhase == AutoStorePhase::Survey) {
+        statusText = "Survey " + String(autoStoreIndex + 1) + "/" + String(autoStoreStations.size());
+    } else if (scanState == ScanState::Scanning && !scanPaused) {
+        // Az utolsó teljes sweep ideje, ha már van
+        statusText = lastSweepMs > 0 ? "Scan " + String(lastSweepMs / 1000.0f, 1) + "s/sweep" : "Scanning...";
     } else if (scanPaused) {
         statusText = "Paused";
     } else {
@@ -1060,10 +2126,21 @@ void ScreenScan::drawScanInfo() {
         lastStatusText = statusText; // Cache frissítése
     }
 
+    // Az aktuális pozíció eltárolt jeltípusa - szintén csak változáskor
+    SignalClass signalClass = currentScanPos < SCAN_RESOLUTION ? static_cast<SignalClass>(scanModel.getSignalClass(currentScanPos)) : SignalClass::None;
+    String typeText = SignalClassifier::getLabel(signalClass);
+    if (typeText != lastTypeText) {
+        tft.setTextColor(SignalClassifier::getColor(signalClass), TFT_COLOR_BACKGROUND);
+        tft.fillRect(220, INFO_AREA_Y + 15, 110, FONT_HEIGHT, TFT_COLOR_BACKGROUND); // Régi érték törlése
+        tft.drawString(typeText, 220, INFO_AREA_Y + 15);
+        tft.setTextColor(TFT_WHITE, TFT_COLOR_BACKGROUND);
+        lastTypeText = typeText;
+    }
+
     // RSSI érték - csak az érték részét frissítjük
     int16_t rssi;
     uint8_t snr;
-    getSignalQuality(rssi, snr);
+    getSignalQuality(rssi, snr, countScanSignal);
     int16_t rssiValue = (SCAN_AREA_Y + SCAN_AREA_HEIGHT - rssi) / signalScale;
     String rssiText = String(rssiValue);
     tft.fillRect(365, INFO_AREA_Y, 15, FONT_HEIGHT, TFT_COLOR_BACKGROUND); // Régi érték törlése
@@ -1074,6 +2151,173 @@ void ScreenScan::drawScanInfo() {
     tft.setTextColor(TFT_ORANGE, TFT_COLOR_BACKGROUND);
     tft.fillRect(365, INFO_AREA_Y + 15, 15, FONT_HEIGHT, TFT_COLOR_BACKGROUND); // Régi érték törlése
     tft.drawString(snrText, 365, INFO_AREA_Y + 15);
+
+    if (scanMode == ScanMode::Memory) {
+        drawMemoryScanTitle();
+    } else if (autoStorePhase == AutoStorePhase::Survey) {
+        drawSurveyTitle();
+    } else if (heatmapView) {
+        drawHeatmapStats();
+    }
+}
+
+// ===================================================================
+// Sweep történet (hőtérkép)
+// ===================================================================
+
+/**
+ * @brief RSSI (dBuV) -> hőtérkép szín (a nem mért oszlop háttérszínű)
+ */
+static uint16_t heatmapColor(const uint16_t *palette, uint8_t rssi) {
+    if (rssi == ScanHistoryConstants::NO_DATA) {
+        return TFT_COLOR_BACKGROUND;
+    }
+    return palette[std::min<uint16_t>(rssi * 255 / HEATMAP_FULL_SCALE_DBUV, 255)];
+}
+
+/**
+ * @brief Váltás a spektrum és a hőtérkép nézet között
+ * @details A teljes képernyő újrarajzolódik: hőtérkép nézetben a cím helyén a kurzor oszlopának statisztikája látszik
+ */
+void ScreenScan::setHeatmapView(bool enabled) {
+    heatmapView = enabled;
+    surveyView = false;
+    markForRedraw(true);
+}
+
+/**
+ * @brief Egy teljes sweep rögzítése a történetben
+ * @details A történet oszlopai az aktuális nézetet fedik (zoomolva is a spektrum felbontásával), az értékük a piramis
+ *          oszlopnyi tartományának legnagyobb RSSI-je. Ha a nézet a legutóbbi rögzítés óta változott (zoom, eltolás),
+ *          a történet törlődik, mert a régi oszlopok más frekvenciákat fednek.
+ */
+void ScreenScan::recordHistorySweep() {
+    using namespace ScanHistoryConstants;
+
+    ScanHistory &history = scanModel.getHistory();
+    if (history.getStartFreq() != scanStartFreq || history.getEndFreq() != scanEndFreq) {
+        DEBUG("ScreenScan: új nézet, a sweep történet törölve\n");
+        history.reset(scanStartFreq, scanEndFreq);
+    }
+
+    uint32_t viewSpan = scanEndFreq - scanStartFreq;
+    uint8_t columns[COLUMNS];
+    for (uint16_t c = 0; c < COLUMNS; c++) {
+        uint32_t columnStart = scanStartFreq + c * viewSpan / COLUMNS;
+        uint32_t columnEnd = scanStartFreq + (c + 1) * viewSpan / COLUMNS;
+        ScanCell cell = scanModel.getPyramid().query(columnStart, columnEnd);
+        columns[c] = cell.count > 0 ? cell.rssiMax : NO_DATA;
+    }
+    history.addSweep(columns);
+}
+
+/**
+ * @brief Frekvencia -> a történet oszlopa (a történet rögzítéskori nézetén)
+ * @return ScanHistoryConstants::COLUMNS, ha a frekvencia a történet tartományán kívül esik
+ *         (nézetváltás után, a következő sweep végéig)
+ */
+uint16_t ScreenScan::freqToHistoryColumn(uint32_t freq) {
+    const ScanHistory &history = scanModel.getHistory();
+    uint32_t historyStart = history.getStartFreq();
+    uint32_t historySpan = history.getEndFreq() - historyStart;
+    if (freq < historyStart || freq > history.getEndFreq() || historySpan == 0) {
+        return ScanHistoryConstants::COLUMNS;
+    }
+    return std::min<uint32_t>((freq - historyStart) * ScanHistoryConstants::COLUMNS / historySpan, ScanHistoryConstants::COLUMNS - 1);
+}
+
+/**
+ * @brief A teljes hőtérkép kirajzolása a spektrum helyére
+ * @details Felül a legújabb sweep, soronként SCAN_AREA_HEIGHT / ROWS pixel; a frekvencia tengely a spektrum nézeté
+ *          (zoom, eltolás), így a kurzor, az érintés és a címkék ugyanazok. Pixel soronként egy pushImage.
+ */
+void ScreenScan::drawHeatmap() {
+    using namespace ScanHistoryConstants;
+    constexpr uint8_t ROW_HEIGHT = SCAN_AREA_HEIGHT / ROWS;
+
+    if (!pSi4735Manager) {
+        return;
+    }
+
+    // A nézet pixeleinek történet oszlopa (a pixel közepének frekvenciája alapján)
+    uint8_t pixelColumn[SCAN_AREA_WIDTH];
+    for (uint16_t x = 0; x < SCAN_AREA_WIDTH; x++) {
+        pixelColumn[x] = freqToHistoryColumn(positionToFreq(((2 * x + 1) * SCAN_RESOLUTION) / (2 * SCAN_AREA_WIDTH)));
+    }
+    int16_t cursorPixel = scanPaused ? (currentScanPos * SCAN_AREA_WIDTH) / SCAN_RESOLUTION : -1;
+
+    const uint16_t *palette = WaterfallPalette::get(config.data.waterfallPalette);
+    const ScanHistory &history = scanModel.getHistory();
+    uint16_t lineBuffer[SCAN_AREA_WIDTH];
+
+    // A sor puffer natív bájtsorrendű RGB565
+    const bool swapBytes = tft.getSwapBytes();
+    tft.setSwapBytes(true);
+    for (uint8_t row = 0; row < ROWS; row++) {
+        if (row < history.getRowCount()) {
+            const uint8_t *values = history.getRow(row);
+            for (uint16_t x = 0; x < SCAN_AREA_WIDTH; x++) {
+                lineBuffer[x] = pixelColumn[x] < COLUMNS ? heatmapColor(palette, values[pixelColumn[x]]) : TFT_COLOR_BACKGROUND;
+            }
+        } else {
+            std::fill(lineBuffer, lineBuffer + SCAN_AREA_WIDTH, TFT_COLOR_BACKGROUND);
+        }
+        if (cursorPixel >= 0) {
+            lineBuffer[cursorPixel] = TFT_RED;
+        }
+        for (uint8_t y = 0; y < ROW_HEIGHT; y++) {
+            tft.pushImage(SCAN_AREA_X, SCAN_AREA_Y + row * ROW_HEIGHT + y, SCAN_AREA_WIDTH, 1, lineBuffer);
+        }
+    }
+    tft.setSwapBytes(swapBytes);
+}
+
+/**
+ * @brief A hőtérkép egyetlen pixel oszlopa (kurzor mozgatáskor)
+ */
+void ScreenScan::drawHeatmapColumn(uint16_t pixelX) {
+    using namespace ScanHistoryConstants;
+    constexpr uint8_t ROW_HEIGHT = SCAN_AREA_HEIGHT / ROWS;
+
+    uint16_t screenX = SCAN_AREA_X + pixelX;
+    if (scanPaused && pixelX == (currentScanPos * SCAN_AREA_WIDTH) / SCAN_RESOLUTION) {
+        tft.drawFastVLine(screenX, SCAN_AREA_Y, ROWS * ROW_HEIGHT, TFT_RED);
+        return;
+    }
+
+    uint16_t column = freqToHistoryColumn(positionToFreq(((2 * pixelX + 1) * SCAN_RESOLUTION) / (2 * SCAN_AREA_WIDTH)));
+    const uint16_t *palette = WaterfallPalette::get(config.data.waterfallPalette);
+    const ScanHistory &history = scanModel.getHistory();
+    for (uint8_t row = 0; row < ROWS; row++) {
+        uint16_t color = row < history.getRowCount() && column < COLUMNS ? heatmapColor(palette, history.getRow(row)[column]) : TFT_COLOR_BACKGROUND;
+        tft.drawFastVLine(screenX, SCAN_AREA_Y + row * ROW_HEIGHT, ROW_HEIGHT, color);
+    }
+}
+
+/**
+ * @brief A kurzor oszlopának statisztikája a cím helyén (csak változáskor)
+ */
+void ScreenScan::drawHeatmapStats() {
+    uint16_t column = freqToHistoryColumn(positionToFreq(currentScanPos));
+    ScanHistoryStats stats = column < ScanHistoryConstants::COLUMNS ? scanModel.getHistory().getStats(column) : ScanHistoryStats{};
+    String statsText;
+    if (stats.sweeps == 0) {
+        statsText = "History: no sweeps at cursor";
+    } else {
+        statsText = "Max " + String(stats.rssiMax) + " / avg " + String(stats.rssiMean) + " dBuV, active " + String(stats.activePercent) + "% of " +
+                    String(stats.sweeps) + " sweeps";
+    }
+    if (statsText == lastStatsText) {
+        return;
+    }
+
+    tft.fillRect(0, 0, ::SCREEN_W, SCAN_AREA_Y - 1, TFT_BLACK); // A cím törlése
+    tft.setFreeFont();
+    tft.setTextColor(TFT_WHITE, TFT_BLACK);
+    tft.setTextSize(1);
+    tft.setTextDatum(TC_DATUM);
+    tft.drawString(statsText, tft.width() / 2, 15);
+    lastStatsText = statsText;
 }
 
 // ===================================================================
@@ -1081,46 +2325,135 @@ void ScreenScan::drawScanInfo() {
 // ===================================================================
 
 // Közös jel mérés - egyszerre RSSI és SNR
-void ScreenScan::getSignalQuality(int16_t &rssiY, uint8_t &snr) {
+void ScreenScan::getSignalQuality(int16_t &rssiY, uint8_t &snr, uint8_t samples) {
     if (!pSi4735Manager) {
         rssiY = SCAN_AREA_Y + SCAN_AREA_HEIGHT - 20;
         snr = 0;
         return;
     }
 
+    uint8_t rssi;
+    measureSignal(rssi, snr, samples);
+    rssiY = rssiToY(rssi);
+}
+
+/**
+ * @brief RSSI és SNR mérés a chip egységeiben (dBuV, dB), több minta átlagával
+ */
+void ScreenScan::measureSignal(uint8_t &rssi, uint8_t &snr, uint8_t samples) {
+    if (!pSi4735Manager) {
+        rssi = 0;
+        snr = 0;
+        return;
+    }
+
     // Együttes mérés a Si4735 chipről - hatékonyabb!
     int rssiSum = 0;
     int snrSum = 0;
 
-    for (int i = 0; i < countScanSignal; i++) {
+    for (int i = 0; i < samples; i++) {
         // Egyszerre mérjük mind az RSSI-t, mind az SNR-t
         SignalQualityData signalQuality = pSi4735Manager->getSignalQualityRealtime();
         rssiSum += signalQuality.rssi;
         snrSum += signalQuality.snr;
     }
 
-    // RSSI átlag és Y koordinátára konvertálás
-    int avgRssi = rssiSum / countScanSignal;
-    rssiY = SCAN_AREA_Y + SCAN_AREA_HEIGHT - (avgRssi * signalScale * 2);
+    rssi = rssiSum / samples;
+    snr = snrSum / samples;
+}
+
+/**
+ * @brief RSSI (dBuV) -> a spektrum vonal teteje (Y koordináta, a spektrum területen belülre korlátozva)
+ */
+int16_t ScreenScan::rssiToY(uint8_t rssi) const {
+    int16_t rssiY = SCAN_AREA_Y + SCAN_AREA_HEIGHT - (rssi * signalScale * 2);
 
     // RSSI korlátozás
     if (rssiY < SCAN_AREA_Y + 10)
         rssiY = SCAN_AREA_Y + 10;
     if (rssiY > SCAN_AREA_Y + SCAN_AREA_HEIGHT - 10)
-        rssiY = SCAN_AREA_Y + SCAN_AREA_HEIGHT - 10; // SNR átlag
-    snr = snrSum / countScanSignal;
+        rssiY = SCAN_AREA_Y + SCAN_AREA_HEIGHT - 10;
+    return rssiY;
 }
 
+/**
+ * @brief Frekvencia beállítása és a hangolás befejezésének megvárása (kurzor mozgatás)
+ */
 void ScreenScan::setFrequency(uint32_t freq) {
+    tuneTo(freq);
+    if (pSi4735Manager) {
+        waitTuneComplete();
+    }
+}
+
+/**
+ * @brief Hangolás kiadása várakozás nélkül
+ * @details A befejezést a pollTuneComplete() jelzi, addig az RSQ mérés nem érvényes.
+ */
+void ScreenScan::tuneTo(uint32_t freq) {
     currentScanFreq = freq;
     // Spektrum analizátor hangol át minden frekvenciára a méréshez!
     if (pSi4735Manager) {
         // frekvencia beállítás a Si4735 chipen
         pSi4735Manager->getSi4735().setFrequency(freq / 10); // Si4735 10kHz egységekben dolgozik
+    }
+
+    // Az osztályozó előzményei a régi frekvenciához tartoznak
+    lastTuneTime = millis();
+    if (SignalClassifier *classifier = AudioCore1Manager::getSignalClassifier()) {
+        classifier->requestReset();
+    }
+}
+
+/**
+ * @brief A hangolás befejezésének (STC) lekérdezése
+ * @details A TUNE_STATUS INTACK-kal hívódik, így a jelzett STC egyben törlődik is, a következő hangolás tiszta lappal indul
+ * @return true ha a chip befejezte a hangolást
+ */
+bool ScreenScan::pollTuneComplete() {
+    SI4735 &si4735 = pSi4735Manager->getSi4735();
+    si4735.getStatus(1, 0); // INTACK = 1, CANCEL = 0
+    return si4735.getTuneCompleteTriggered();
+}
+
+/**
+ * @brief Blokkoló várakozás a hangolás befejezésére (legfeljebb STC_TIMEOUT_MS)
+ */
+void ScreenScan::waitTuneComplete() {
+    uint32_t start = millis();
+    while (!pollTuneComplete() && millis() - start < STC_TIMEOUT_MS) {
+    }
+}
+
+/**
+ * @brief Az aktuális pozíció jeltípusának eltárolása megállított scan mellett
+ *
+ * A pásztázás lépései túl rövidek az audio alapú osztályozáshoz, ezért csak akkor tároljuk
+ * a core1 osztályozó eredményét, ha a rádió a kurzor frekvenciáján áll legalább CLASSIFY_DWELL_MS ideje.
+ * FM sávon nincs osztályozás (a demodulált műsor hangja nem jellemzi a jeltípust).
+ */
+void ScreenScan::annotateCurrentPosition() {
+    SignalClassifier *classifier = AudioCore1Manager::getSignalClassifier();
+    if (!classifier || !pSi4735Manager || pSi4735Manager->isCurrentBandFM() || currentScanPos >= SCAN_RESOLUTION) {
+        return;
+    }
+    // A pásztázás megállítása után a rádió még az előző pozícióra van hangolva: csak a kurzor frekvenciáján osztályozunk
+    if (lastTuneTime == 0 || currentScanFreq != positionToFreq(currentScanPos)) {
+        return;
+    }
+    if (millis() - lastTuneTime < CLASSIFY_DWELL_MS || classifier->getFramesSinceReset() < CLASSIFY_MIN_FRAMES) {
+        return;
+    }
 
-        // Kis várakozás a ráhangolódáshoz (stabilizálódás)
-        delay(5); // 5ms várakozás
+    SignalClass signalClass = classifier->getSignalClass();
+    if (signalClass == SignalClass::None || scanModel.getSignalClass(currentScanPos) == static_cast<uint8_t>(signalClass)) {
+        return;
     }
+    scanModel.setSignalClass(currentScanPos, static_cast<uint8_t>(signalClass));
+    scanModel.getPyramid().setSignalClass(positionToFreq(currentScanPos), static_cast<uint8_t>(signalClass));
+
+    drawSpectrumLine((currentScanPos * SCAN_AREA_WIDTH) / SCAN_RESOLUTION);
+    drawScanInfo();
 }
 
 // ===================================================================
@@ -1168,7 +2501,7 @@ void ScreenScan::zoomOut() {
 }
 
 void ScreenScan::handleZoom(float newZoomLevel) {
-    if (!pSi4735Manager)
+    if (!pSi4735Manager || autoStorePhase != AutoStorePhase::Off)
         return;
 
     // Érvényesség ellenőrzése
@@ -1241,144 +2574,148 @@ void ScreenScan::handleZoom(float newZoomLevel) {
         return;
     }
 
-    // Régi értékek mentése az adatok újrafelhasználásához
-    uint32_t oldScanStartFreq = scanStartFreq;
-    uint32_t oldScanEndFreq = scanEndFreq;
-    float oldScanStep = scanStep;
-
-    // Értékek frissítése
     zoomLevel = newZoomLevel;
-    scanStartFreq = newScanStart;
-    scanEndFreq = newScanEnd;
-
-    // Új scan paraméterek számítása
-    calculateScanParameters(); // INTELLIGENS ADATMEGŐRZÉS: Ellenőrizzük, hogy a régi adatok újrafelhasználhatók-e
-    bool canReuseData = false; // Csak zoom IN esetén (szűkítés) próbálunk adatokat megőrizni
-    // És csak akkor, ha az új tartomány teljesen a régi tartományon belül van
-    // PLUSZ: Limitáljuk az interpoláció mélységét - max 2 generáció
-    if (newScanStart >= oldScanStartFreq && newScanEnd <= oldScanEndFreq && !scanEmpty && zoomGeneration < 2) {
-        canReuseData = true;
-
-    } else if (zoomGeneration >= 2) {
-    }
-    if (canReuseData) {
-
-        // BIZTONSÁGOS MEGKÖZELÍTÉS: In-place adatmozgatás batch-enként
-        // Először létrehozunk egy "mapping" tömböt, ami megmondja, melyik régi index melyik új indexre kerül        // Határozunk fel egy kis buffer-t (csak 10 elem)
-        const int BUFFER_SIZE = 10;
-        uint8_t bufferRSSI[BUFFER_SIZE];
-        uint8_t bufferSNR[BUFFER_SIZE];
-        bool bufferMark[BUFFER_SIZE];
-        bool bufferValid[BUFFER_SIZE]; // Új buffer az érvényességi adatoknak
-
-        // Először jelöljük meg, mely pozíciók tartalmazzanak érvényes adatokat
-        // és végezzük el a másolást batch-enként
-
-        for (int targetStart = 0; targetStart < SCAN_RESOLUTION; targetStart += BUFFER_SIZE) {
-            int targetEnd = min(targetStart + BUFFER_SIZE, SCAN_RESOLUTION);
-
-            // Buffer feltöltése az új pozíciókra szánt adatokkal
-            for (int t = targetStart; t < targetEnd; t++) {
-                int bufferIndex = t - targetStart;
-                uint32_t targetFreq = scanStartFreq + (uint32_t)(t * scanStep); // Alapértelmezett értékek
-                bufferRSSI[bufferIndex] = SCAN_AREA_Y + SCAN_AREA_HEIGHT;
-                bufferSNR[bufferIndex] = 0;
-                bufferMark[bufferIndex] = false;
-                bufferValid[bufferIndex] = false; // Alapból nincs érvényes adat                // Keressük meg a régi pozíciót
-                if (targetFreq >= oldScanStartFreq && targetFreq <= oldScanEndFreq) {
-                    // Pontosabb mapping: nem csak kerekítünk, hanem ellenőrizzük a frekvencia távolságokat is
-                    float oldPosFloat = (float)(targetFreq - oldScanStartFreq) / oldScanStep;
-                    int oldPos = static_cast<int>(oldPosFloat + 0.5f); // Kerekítés
-
-                    // Dupla ellenőrzés: az oldPos pozíció frekvenciája közel van-e a target frekvenciához?
-                    if (oldPos >= 0 && oldPos < SCAN_RESOLUTION) {
-                        uint32_t oldPosFreq = oldScanStartFreq + (uint32_t)(oldPos * oldScanStep);
-                        uint32_t freqDiff = (targetFreq > oldPosFreq) ? (targetFreq - oldPosFreq) : (oldPosFreq - targetFreq);
-
-                        // Csak akkor másoljuk, ha a frekvencia különbség kisebb mint a régi lépésköz fele
-                        // Ez megakadályozza a "szellem adók" kialakulását
-                        if (freqDiff <= (oldScanStep / 2)) {
-                            bufferRSSI[bufferIndex] = scanValueRSSI[oldPos];
-                            bufferSNR[bufferIndex] = scanValueSNR[oldPos];
-                            bufferMark[bufferIndex] = scanMark[oldPos];
-                            bufferValid[bufferIndex] = scanDataValid[oldPos]; // Érvényességi adat másolása                            // Csak első néhány elemhez logolunk optimalizálás céljából
-                            if (t < 5) {
-                            }
-                        } else { // Túl nagy a frekvencia eltérés - szellem adó elkerülése
-                            if (t < 5) {
-                            }
-                        }
-                    }
-                }
-            } // Buffer tartalom visszamásolása
-            for (int t = targetStart; t < targetEnd; t++) {
-                int bufferIndex = t - targetStart;
-                scanValueRSSI[t] = bufferRSSI[bufferIndex];
-                scanValueSNR[t] = bufferSNR[bufferIndex];
-                scanMark[t] = bufferMark[bufferIndex];
-                scanDataValid[t] = bufferValid[bufferIndex]; // Érvényességi adat visszamásolása
-            }
-        }
-        scanEmpty = false;
-        zoomGeneration++; // Növeljük a generáció számot
-
-        // FONTOS: Az adatok megmaradtak, ezért NE rajzoljuk újra a teljes spektrumot!
-        // Csak a skála vonalakat és címkéket frissítjük
+    setViewRange(newScanStart, newScanEnd);
+}
 
-        // Közös inicializálás
-        currentScanPos = 0;
+/**
+ * @brief A nagyított nézet eltolása negyed nézetnyivel (a kurzor a nézet szélén túlra lépne)
+ * @param direction 1: felfelé, -1: lefelé a frekvenciában
+ */
+void ScreenScan::panView(int8_t direction) {
+    if (!pSi4735Manager || autoStorePhase != AutoStorePhase::Off) {
+        return;
+    }
+    BandTable &currentBand = pSi4735Manager->getCurrentBand();
+    uint32_t bandStartFreq = currentBand.minimumFreq * 10;
+    uint32_t bandEndFreq = currentBand.maximumFreq * 10;
+
+    uint32_t span = scanEndFreq - scanStartFreq;
+    uint32_t shift = span / 4;
+    uint32_t newScanStart;
+    if (direction > 0) {
+        newScanStart = std::min(scanStartFreq + shift, bandEndFreq - span);
+    } else {
+        newScanStart = scanStartFreq > bandStartFreq + shift ? scanStartFreq - shift : bandStartFreq;
+    }
+    if (newScanStart == scanStartFreq) {
+        return; // A sáv szélén vagyunk
+    }
+    setViewRange(newScanStart, newScanStart + span);
+}
 
-        // Skála vonalak újraszámítása (mindig szükséges zoom után)
-        for (int i = 0; i < SCAN_RESOLUTION; i++) {
-            scanScaleLine[i] = 0;
-        }
+/**
+ * @brief A megjelenített tartomány beállítása (a zoom és az eltolás közös része)
+ * @details Nincs újramérés: a nézet a piramisból töltődik és azonnal újrarajzolódik,
+ *          a pásztázás utána csak a soha nem mért pontokat méri (lásd scheduleGapFill())
+ */
+void ScreenScan::setViewRange(uint32_t startFreq, uint32_t endFreq) {
+    // Egy félbehagyott hangolás mérése már a régi tartományhoz tartozna
+    if (tunePending) {
+        waitTuneComplete();
+        tunePending = false;
+    }
 
-        // Sáv határok újraszámítása
-        scanBeginBand = -1;
-        scanEndBand = SCAN_RESOLUTION;
+    scanStartFreq = startFreq;
+    scanEndFreq = endFreq;
+    surveyView = false; // Zoom és eltolás után a spektrum látszik
+    calculateScanParameters();
 
-        // CSAK a meglévő adatok újrarajzolása - NE töröljük a spektrumot!
-        drawSpectrum(); // Ez a meglévő adatokat rajzolja ki
-        drawScale();
-        drawFrequencyLabels();
-        drawBandBoundaries();
-        drawScanInfo();
+    loadViewFromPyramid();
+    scheduleGapFill();
+    sweepStartTime = 0; // A félbeszakadt sweep ideje nem mérhető
 
-        return; // FONTOS: Kilépünk, ne fusson le a többi rajzolás!
+    // Kurzor: megállítva a hangolt frekvencián marad, pásztázás közben a menet első pontja
+    if (scanPaused) {
+        currentScanPos = freqToPosition(currentScanFreq);
+    } else {
+        currentScanPos = firstScanPosition();
     }
-    if (!canReuseData) {
-        // Ha nem lehet újrafelhasználni, törölni kell az adatokat
 
-        scanEmpty = true;
-        for (int i = 0; i < SCAN_RESOLUTION; i++) {
-            scanValueRSSI[i] = SCAN_AREA_Y + SCAN_AREA_HEIGHT; // Spektrum alján kezdjük (nincs látható jel)
-            scanValueSNR[i] = 0;
-            scanMark[i] = false;
-            scanDataValid[i] = false; // Nincs érvényes adat zoom out után
-        }
+    // Sáv határok újraszámítása
+    scanBeginBand = -1;
+    scanEndBand = SCAN_RESOLUTION;
 
-        // Zoom generáció nullázása - friss adatok
-        zoomGeneration = 0;
+    drawSpectrum();
+    drawScale();
+    drawFrequencyLabels();
+    drawBandBoundaries();
+    drawScanInfo();
+}
 
-        // Közös inicializálás
-        currentScanPos = 0;
+/**
+ * @brief Az aktuális nézet mentése a ScanModel-be (a pontok már ott vannak)
+ */
+void ScreenScan::saveView() {
+    ScanModelView view = scanModel.getView();
+    view.startFreq = scanStartFreq;
+    view.endFreq = scanEndFreq;
+    view.zoomLevel = zoomLevel;
+    view.cursorFreq = currentScanFreq;
+    view.cursorPos = currentScanPos;
+    view.hasData = !scanEmpty;
+    scanModel.setView(view);
+}
 
-        // Skála vonalak újraszámítása (mindig szükséges zoom után)
-        for (int i = 0; i < SCAN_RESOLUTION; i++) {
-            scanScaleLine[i] = 0;
-        }
+/**
+ * @brief A ScanModel-ben megmaradt nézet visszatöltése
+ * @details A pásztázás megállítva indul; a következő menetet a pontok alapján a scheduleGapFill() választja
+ * @return false, ha a tárolt adat nem az aktuális sávhoz tartozik (ilyenkor resetScan() kell)
+ */
+bool ScreenScan::restoreView() {
+    if (!pSi4735Manager || !scanModel.isValidFor(config.data.currentBandIdx)) {
+        return false;
+    }
 
-        // Sáv határok újraszámítása
-        scanBeginBand = -1;
-        scanEndBand = SCAN_RESOLUTION;
+    const ScanModelView &view = scanModel.getView();
+    scanStartFreq = view.startFreq;
+    scanEndFreq = view.endFreq;
+    zoomLevel = view.zoomLevel;
+    currentScanFreq = view.cursorFreq;
+    currentScanPos = view.cursorPos;
+    scanEmpty = !view.hasData;
+    calculateScanParameters();
+    scheduleGapFill();
 
-        // Spektrum és címkék frissítése (üres spektrum)
-        drawSpectrum();
-        drawScale();
-        drawFrequencyLabels();
-        drawBandBoundaries();
-        drawScanInfo();
+    DEBUG("ScreenScan: scan adatok visszatöltve (%lu - %lu)\n", scanStartFreq, scanEndFreq);
+    return true;
+}
+
+/**
+ * @brief A nézet pontjainak feltöltése a piramisból
+ * @details A pont a frekvencia tartományának legnagyobb RSSI és SNR értékét kapja, így kicsinyítéskor
+ *          a keskeny állomások sem tűnnek el; a mért adat nélküli pontok ScanPointState::None állapotúak
+ */
+void ScreenScan::loadViewFromPyramid() {
+    bool anyData = false;
+    for (uint16_t i = 0; i < SCAN_RESOLUTION; i++) {
+        ScanCell cell = scanModel.getPyramid().query(positionToFreq(i), positionToFreq(i + 1));
+        if (cell.count == 0) {
+            scanModel.clearPoint(i);
+            continue;
+        }
+        bool marked = cell.snrMax >= scanMarkSNR;
+        scanModel.setPoint(i, cell.rssiMax, cell.snrMax, cell.state);
+        scanModel.setMarked(i, marked);
+        scanModel.setSignalClass(i, marked ? cell.signalClass : static_cast<uint8_t>(SignalClass::None));
+        anyData = true;
+    }
+    scanEmpty = !anyData;
+}
+
+/**
+ * @brief A következő menet kiválasztása a nézet betöltése után
+ * @details Ha a nem mért pontok kevesebben vannak egy durva menetnél, csak ezeket méri egy kitöltő (Fill) menet,
+ *          egyébként (pl. először látott tartomány) a szokásos durva-finom sweep indul
+ */
+void ScreenScan::scheduleGapFill() {
+    uint16_t gaps = 0;
+    for (uint16_t i = 0; i < SCAN_RESOLUTION; i++) {
+        bool gap = scanModel.getState(i) == ScanPointState::None;
+        scanModel.setRefine(i, gap);
+        gaps += gap;
     }
+    scanPass = gaps > 0 && gaps <= SCAN_RESOLUTION / COARSE_STRIDE ? ScanPass::Fill : ScanPass::Coarse;
 }
 
 uint32_t ScreenScan::positionToFreq(uint16_t dataPos) {
@@ -1413,5 +2750,5 @@ bool ScreenScan::isDataValid(uint16_t scanPos) const {
     }
 
     // Ellenőrizzük, hogy a pozícióban van-e érvényes mérési adat
-    return scanDataValid[scanPos];
+    return scanModel.getState(scanPos) != ScanPointState::None;
 }
\ No newline at end of file
@@ -1,7 +1,9 @@
 #include "ScreenSetupAudioProc.h"
 #include "Config.h"
 #include "MultiButtonDialog.h"
+#include "SpectrumVisualizationComponent.h"
 #include "ValueChangeDialog.h"
+#include "WaterfallPalette.h"
 
 /**
  * @brief ScreenSetupAudioProc konstruktor
@@ -31,6 +33,12 @@ void ScreenSetupAudioProc::populateMenuItems() {
 
     settingItems.push_back(SettingItem("FFT Gain AM", decodeFFTGain(config.data.audioFftConfigAm), static_cast<int>(AudioProcItemAction::FFT_GAIN_AM)));
     settingItems.push_back(SettingItem("FFT Gain FM", decodeFFTGain(config.data.audioFftConfigFm), static_cast<int>(AudioProcItemAction::FFT_GAIN_FM)));
+    settingItems.push_back(SettingItem("Waterfall Palette", WaterfallPalette::getName(config.data.waterfallPalette), static_cast<int>(AudioProcItemAction::WATERFALL_PALETTE)));
+    settingItems.push_back(SettingItem("Spectrum Traces", decodeSpectrumTraces(config.data.spectrumTraces), static_cast<int>(AudioProcItemAction::SPECTRUM_TRACES)));
+    settingItems.push_back(SettingItem("Trace Average Time", String(config.data.traceAverageMs) + " ms", static_cast<int>(AudioProcItemAction::TRACE_AVERAGE_TIME)));
+    settingItems.push_back(SettingItem("Trace Peak Decay", String(config.data.tracePeakDecayDbPerSec) + " dB/s", static_cast<int>(AudioProcItemAction::TRACE_PEAK_DECAY)));
+    settingItems.push_back(SettingItem("Spectrum Scale", config.data.spectrumLogScale ? "dB" : "Linear", static_cast<int>(AudioProcItemAction::SPECTRUM_SCALE)));
+    settingItems.push_back(SettingItem("Spectrum dB Range", String(config.data.spectrumDbRange) + " dB", static_cast<int>(AudioProcItemAction::SPECTRUM_DB_RANGE)));
 
     // Lista komponens újrarajzolásának kérése, ha létezik
     if (menuList) {
@@ -65,6 +73,24 @@ void ScreenSetupAudioProc::handleItemAction(int index, int action) {
         case AudioProcItemAction::FFT_GAIN_FM:
             handleFFTGainDialog(index, false);
             break;
+        case AudioProcItemAction::WATERFALL_PALETTE:
+            handleWaterfallPaletteDialog(index);
+            break;
+        case AudioProcItemAction::SPECTRUM_TRACES:
+            handleSpectrumTracesDialog(index);
+            break;
+        case AudioProcItemAction::TRACE_AVERAGE_TIME:
+            handleTraceAverageTimeDialog(index);
+            break;
+        case AudioProcItemAction::TRACE_PEAK_DECAY:
+            handleTracePeakDecayDialog(index);
+            break;
+        case AudioProcItemAction::SPECTRUM_SCALE:
+            handleSpectrumScaleDialog(index);
+            break;
+        case AudioProcItemAction::SPECTRUM_DB_RANGE:
+            handleSpectrumDbRangeDialog(index);
+            break;
         case AudioProcItemAction::NONE:
         default:
             DEBUG("ScreenSetupAudioProc: Unknown action: %d\n", action);
@@ -243,3 +269,167 @@ void ScreenSetupAudioProc::handleFFTGainDialog(int index, bool isAM) {
         false, defaultSelection, false, Rect(-1, -1, 340, 120));
     this->showDialog(fftDialog);
 }
+
+/**
+ * @brief Waterfall színpaletta kiválasztása dialógussal
+ *
+ * @param index A menüpont indexe a lista frissítéséhez
+ */
+void ScreenSetupAudioProc::handleWaterfallPaletteDialog(int index) {
+    const char *options[static_cast<uint8_t>(WaterfallPaletteType::Count)];
+    for (uint8_t i = 0; i < ARRAY_ITEM_COUNT(options); i++) {
+        options[i] = WaterfallPalette::getName(i);
+    }
+
+    auto paletteDialog = std::make_shared<MultiButtonDialog>(
+        this, "Waterfall Palette", "Select waterfall colors:", options, ARRAY_ITEM_COUNT(options),
+        [this, index](int buttonIndex, const char *buttonLabel, MultiButtonDialog *dialog) {
+            config.data.waterfallPalette = static_cast<uint8_t>(buttonIndex);
+            settingItems[index].value = WaterfallPalette::getName(config.data.waterfallPalette);
+            updateListItem(index);
+            dialog->close(UIDialogBase::DialogResult::Accepted);
+        },
+        false, config.data.waterfallPalette, false, Rect(-1, -1, 340, 120));
+    this->showDialog(paletteDialog);
+}
+
+/**
+ * @brief Spektrum nyomvonal bitmaszk dekódolása olvasható szöveggé
+ *
+ * @param traceMask SpectrumTraceFlags bitek
+ * @return Rövid név, a név indexe maga a bitmaszk
+ */
+const char *ScreenSetupAudioProc::decodeSpectrumTraces(uint8_t traceMask) {
+    static const char *names[] = {"Off", "Avg", "Peak", "Avg+Peak", "Min", "Avg+Min", "Peak+Min", "All"};
+    return names[traceMask & SpectrumTraceFlags::ALL];
+}
+
+/**
+ * @brief Spektrum nyomvonalak kiválasztása dialógussal (a gomb indexe a bitmaszk)
+ *
+ * @param index A menüpont indexe a lista frissítéséhez
+ */
+void ScreenSetupAudioProc::handleSpectrumTracesDialog(int index) {
+    const char *options[SpectrumTraceFlags::ALL + 1];
+    for (uint8_t i = 0; i < ARRAY_ITEM_COUNT(options); i++) {
+        options[i] = decodeSpectrumTraces(i);
+    }
+
+    auto tracesDialog = std::make_shared<MultiButtonDialog>(
+        this, "Spectrum Traces", "HighRes spectrum overlays:", options, ARRAY_ITEM_COUNT(options),
+        [this, index](int buttonIndex, const char *buttonLabel, MultiButtonDialog *dialog) {
+            config.data.spectrumTraces = static_cast<uint8_t>(buttonIndex);
+            settingItems[index].value = decodeSpectrumTraces(config.data.spectrumTraces);
+            updateListItem(index);
+            dialog->close(UIDialogBase::DialogResult::Accepted);
+        },
+        false, config.data.spectrumTraces & SpectrumTraceFlags::ALL, false, Rect(-1, -1, 340, 160));
+    this->showDialog(tracesDialog);
+}
+
+/**
+ * @brief Az átlag nyomvonal időállandójának beállítása dialógussal
+ *
+ * @param index A menüpont indexe a lista frissítéséhez
+ */
+void ScreenSetupAudioProc::handleTraceAverageTimeDialog(int index) {
+    auto tempValuePtr = std::make_shared<int>(static_cast<int>(config.data.traceAverageMs));
+
+    auto averageDialog = std::make_shared<ValueChangeDialog>(
+        this, "Trace Average", "Average time constant (ms):", tempValuePtr.get(),
+        static_cast<int>(100),  // Min: 100ms
+        static_cast<int>(5000), // Max: 5s
+        static_cast<int>(100),  // Step: 100ms
+        [this, index](const std::variant<int, float, bool> &liveNewValue) {
+            if (std::holds_alternative<int>(liveNewValue)) {
+                config.data.traceAverageMs = static_cast<uint16_t>(std::get<int>(liveNewValue));
+            }
+        },
+        [this, index, tempValuePtr](UIDialogBase *sender, MessageDialog::DialogResult dialogResult) {
+            if (dialogResult == MessageDialog::DialogResult::Accepted) {
+                config.data.traceAverageMs = static_cast<uint16_t>(*tempValuePtr);
+                settingItems[index].value = String(config.data.traceAverageMs) + " ms";
+                updateListItem(index);
+            }
+        },
+        Rect(-1, -1, 280, 0));
+    this->showDialog(averageDialog);
+}
+
+/**
+ * @brief A csúcstartás lecsengésének beállítása dialógussal
+ *
+ * @param index A menüpont indexe a lista frissítéséhez
+ */
+void ScreenSetupAudioProc::handleTracePeakDecayDialog(int index) {
+    auto tempValuePtr = std::make_shared<int>(static_cast<int>(config.data.tracePeakDecayDbPerSec));
+
+    auto decayDialog = std::make_shared<ValueChangeDialog>(
+        this, "Peak Decay", "Peak hold decay (dB/s):", tempValuePtr.get(),
+        static_cast<int>(1),  // Min: 1 dB/s
+        static_cast<int>(60), // Max: 60 dB/s
+        static_cast<int>(1),  // Step: 1 dB/s
+        [this, index](const std::variant<int, float, bool> &liveNewValue) {
+            if (std::holds_alternative<int>(liveNewValue)) {
+                config.data.tracePeakDecayDbPerSec = static_cast<uint8_t>(std::get<int>(liveNewValue));
+            }
+        },
+        [this, index, tempValuePtr](UIDialogBase *sender, MessageDialog::DialogResult dialogResult) {
+            if (dialogResult == MessageDialog::DialogResult::Accepted) {
+                config.data.tracePeakDecayDbPerSec = static_cast<uint8_t>(*tempValuePtr);
+                settingItems[index].value = String(config.data.tracePeakDecayDbPerSec) + " dB/s";
+                updateListItem(index);
+            }
+        },
+        Rect(-1, -1, 280, 0));
+    this->showDialog(decayDialog);
+}
+
+/**
+ * @brief Spektrum amplitúdó skála kiválasztása dialógussal (lineáris vagy dBFS)
+ *
+ * @param index A menüpont indexe a lista frissítéséhez
+ */
+void ScreenSetupAudioProc::handleSpectrumScaleDialog(int index) {
+    static const char *options[] = {"Linear", "dB"};
+
+    auto scaleDialog = std::make_shared<MultiButtonDialog>(
+        this, "Spectrum Scale", "Spectrum amplitude scale:", options, ARRAY_ITEM_COUNT(options),
+        [this, index](int buttonIndex, const char *buttonLabel, MultiButtonDialog *dialog) {
+            config.data.spectrumLogScale = buttonIndex == 1;
+            settingItems[index].value = options[buttonIndex];
+            updateListItem(index);
+            dialog->close(UIDialogBase::DialogResult::Accepted);
+        },
+        false, config.data.spectrumLogScale ? 1 : 0, false, Rect(-1, -1, 340, 120));
+    this->showDialog(scaleDialog);
+}
+
+/**
+ * @brief A dB skála megjelenített tartományának beállítása dialógussal
+ *
+ * @param index A menüpont indexe a lista frissítéséhez
+ */
+void ScreenSetupAudioProc::handleSpectrumDbRangeDialog(int index) {
+    auto tempValuePtr = std::make_shared<int>(static_cast<int>(config.data.spectrumDbRange));
+
+    auto rangeDialog = std::make_shared<ValueChangeDialog>(
+        this, "Spectrum dB Range", "Displayed range (dB):", tempValuePtr.get(),
+        static_cast<int>(20),  // Min: 20 dB
+        static_cast<int>(100), // Max: 100 dB
+        static_cast<int>(5),   // Step: 5 dB
+        [this, index](const std::variant<int, float, bool> &liveNewValue) {
+            if (std::holds_alternative<int>(liveNewValue)) {
+                config.data.spectrumDbRange = static_cast<uint8_t>(std::get<int>(liveNewValue));
+            }
+        },
+        [this, index, tempValuePtr](UIDialogBase *sender, MessageDialog::DialogResult dialogResult) {
+            if (dialogResult == MessageDialog::DialogResult::Accepted) {
+                config.data.spectrumDbRange = static_cast<uint8_t>(*tempValuePtr);
+                settingItems[index].value = String(config.data.spectrumDbRange) + " dB";
+                updateListItem(index);
+            }
+        },
+        Rect(-1, -1, 280, 0));
+    this->showDialog(rangeDialog);
+}
@@ -29,6 +29,8 @@ void ScreenSetupSi4735::populateMenuItems() {
 
     // Si4735 specifikus beállítások hozzáadása
     settingItems.push_back(SettingItem("Squelch Basis", String(config.data.squelchUsesRSSI ? "RSSI" : "SNR"), static_cast<int>(Si4735ItemAction::SQUELCH_BASIS)));
+    settingItems.push_back(SettingItem("Seek RSSI FM", String(config.data.seekRssiThresholdFM) + " dBuV", static_cast<int>(Si4735ItemAction::SEEK_RSSI_FM)));
+    settingItems.push_back(SettingItem("Seek SNR FM", String(config.data.seekSnrThresholdFM) + " dB", static_cast<int>(Si4735ItemAction::SEEK_SNR_FM)));
 
     // Példa további Si4735 beállításokra (ha léteznek a config-ban)
     // settingItems.push_back(SettingItem("Volume Level",
@@ -60,6 +62,12 @@ void ScreenSetupSi4735::handleItemAction(int index, int action) {
         case Si4735ItemAction::SQUELCH_BASIS:
             handleSquelchBasisDialog(index);
             break;
+        case Si4735ItemAction::SEEK_RSSI_FM:
+            handleSeekThresholdDialog(index, "Seek RSSI FM", config.data.seekRssiThresholdFM, "dBuV");
+            break;
+        case Si4735ItemAction::SEEK_SNR_FM:
+            handleSeekThresholdDialog(index, "Seek SNR FM", config.data.seekSnrThresholdFM, "dB");
+            break;
         // case Si4735ItemAction::VOLUME_LEVEL:
         //     handleVolumeLevelDialog(index);
         //     break;
@@ -97,6 +105,36 @@ void ScreenSetupSi4735::handleSquelchBasisDialog(int index) {
     this->showDialog(basisDialog);
 }
 
+/**
+ * @brief Seek küszöb beállítása dialógussal
+ * @details A küszöb a következő seek indításakor kerül a chipre (Si4735Band::setSeekThresholds())
+ *
+ * @param index A menüpont indexe a lista frissítéséhez
+ * @param title A dialógus címe
+ * @param configValue A módosítandó konfig érték
+ * @param unit A kijelzett mértékegység
+ */
+void ScreenSetupSi4735::handleSeekThresholdDialog(int index, const char *title, uint8_t &configValue, const char *unit) {
+    auto tempValuePtr = std::make_shared<int>(static_cast<int>(configValue));
+
+    auto thresholdDialog = std::make_shared<ValueChangeDialog>(
+        this, title, "Seek threshold:", tempValuePtr.get(),
+        static_cast<int>(0),   // Min: 0
+        static_cast<int>(127), // Max: 127 (a chip tulajdonság tartománya)
+        static_cast<int>(1),   // Step: 1
+        nullptr,               // Nincs élő előnézet, a küszöb csak a következő seek-nél számít
+        [this, index, tempValuePtr, &configValue, unit](UIDialogBase *sender, MessageDialog::DialogResult dialogResult) {
+            if (dialogResult == MessageDialog::DialogResult::Accepted) {
+                configValue = static_cast<uint8_t>(*tempValuePtr);
+                config.checkSave();
+                settingItems[index].value = String(configValue) + " " + unit;
+                updateListItem(index);
+            }
+        },
+        Rect(-1, -1, 280, 0));
+    this->showDialog(thresholdDialog);
+}
+
 /**
  * @brief Boolean beállítások váltása
  *
@@ -0,0 +1,157 @@
+/**
+ * @file ScreenWaterfall.cpp
+ * @brief Teljes képernyős, hardveresen görgetett audio waterfall képernyő implementáció
+ */
+
+#include "ScreenWaterfall.h"
+#include "AudioCore1Manager.h"
+#include "Config.h"
+#include "ScreenManager.h"
+#include "Si4735Manager.h"
+#include "TftHardwareScroll.h"
+#include "WaterfallPalette.h"
+#include "defines.h"
+
+#include <algorithm>
+#include <cmath>
+
+/**
+ * @brief Konstruktor
+ */
+ScreenWaterfall::ScreenWaterfall()
+    : UIScreen(SCREEN_NAME_WATERFALL), columnWriter_(ScreenWaterfallConstants::LABEL_WIDTH), maxFreqHz_(ScreenWaterfallConstants::MAX_FREQ_AM_HZ), smoothedPeak_(0.0f), binMap_() {}
+
+/**
+ * @brief Képernyő aktiválása: FFT méret beállítása, a dekóderek leválasztása
+ */
+void ScreenWaterfall::activate() {
+    UIScreen::activate();
+
+    const bool isFm = ::pSi4735Manager && ::pSi4735Manager->isCurrentDemodFM();
+    maxFreqHz_ = isFm ? ScreenWaterfallConstants::MAX_FREQ_FM_HZ : ScreenWaterfallConstants::MAX_FREQ_AM_HZ;
+    smoothedPeak_ = 0.0f;
+
+    // Ha a spektrum ki volt kapcsolva (Off mód), a mintavételezés szünetel: a waterfallhoz el kell indítani
+    if (AudioCore1Manager::isCore1Paused()) {
+        AudioCore1Manager::resumeCore1Audio();
+    }
+    AudioCore1Manager::setSampleDecoder(nullptr);
+    AudioCore1Manager::setFftSize(ScreenWaterfallConstants::FFT_SIZE);
+}
+
+/**
+ * @brief Képernyő deaktiválása: a görgetés kikapcsolása, a kijelző normál módba
+ * @details A visszatérő képernyő újra létrejön, a saját FFT méretét és dekóderét maga állítja be
+ */
+void ScreenWaterfall::deactivate() {
+    TftHardwareScroll::disable();
+    UIScreen::deactivate();
+}
+
+/**
+ * @brief Teljes képernyő kirajzolása: görgetési terület, frekvencia skála, üres kép
+ */
+void ScreenWaterfall::drawContent() {
+    tft.fillScreen(TFT_BLACK);
+    TftHardwareScroll::setArea(ScreenWaterfallConstants::LABEL_WIDTH);
+    drawFrequencyScale();
+    columnWriter_.clear();
+}
+
+/**
+ * @brief A frekvencia skála kirajzolása a rögzített bal oldali sávba
+ */
+void ScreenWaterfall::drawFrequencyScale() {
+    using namespace ScreenWaterfallConstants;
+
+    tft.fillRect(0, 0, LABEL_WIDTH, COLUMN_HEIGHT, TFT_BLACK);
+    tft.drawFastVLine(LABEL_WIDTH - 1, 0, COLUMN_HEIGHT, TFT_DARKGREY);
+
+    tft.setFreeFont();
+    tft.setTextSize(1);
+    tft.setTextColor(TFT_SILVER, TFT_BLACK);
+    tft.setTextDatum(MR_DATUM);
+
+    const float stepHz = maxFreqHz_ > MAX_FREQ_AM_HZ ? LABEL_STEP_FM_HZ : LABEL_STEP_AM_HZ;
+    const float spanHz = maxFreqHz_ - MIN_FREQ_HZ;
+    char buf[8];
+    for (float freqHz = stepHz; freqHz < maxFreqHz_; freqHz += stepHz) {
+        const int16_t y = COLUMN_HEIGHT - 1 - static_cast<int16_t>((freqHz - MIN_FREQ_HZ) * (COLUMN_HEIGHT - 1) / spanHz);
+        tft.drawFastHLine(LABEL_WIDTH - 5, y, 4, TFT_DARKGREY);
+        snprintf(buf, sizeof(buf), "%uk", static_cast<unsigned>(freqHz / 1000.0f));
+        tft.drawString(buf, LABEL_WIDTH - 7, y);
+    }
+
+    tft.setTextDatum(TL_DATUM);
+    tft.setTextColor(TFT_WHITE, TFT_BLACK);
+    tft.drawString("WFall", 2, 2);
+}
+
+/**
+ * @brief Főciklus: új FFT keretenként egy oszlop kirajzolása
+ */
+void ScreenWaterfall::handleOwnLoop() {
+    const float *magnitudeData = nullptr;
+    uint16_t fftSize = 0;
+    float binWidthHz = 0.0f;
+    float autoGain = 1.0f;
+
+    if (!AudioCore1Manager::getSpectrumData(&magnitudeData, &fftSize, &binWidthHz, &autoGain) || !magnitudeData || binWidthHz == 0.0f) {
+        return;
+    }
+
+    binMap_.update(ScreenWaterfallConstants::COLUMN_HEIGHT, ScreenWaterfallConstants::MIN_FREQ_HZ, maxFreqHz_, 1, fftSize, binWidthHz, BinAggregation::Max);
+    drawColumn(magnitudeData);
+}
+
+/**
+ * @brief Az új oszlop kirajzolása a következő memória sorba és a görgetési mutató léptetése
+ * @details Egyetlen 1 x COLUMN_HEIGHT címablak: a kép többi része a kijelző memóriájában marad,
+ *          a VSP léptetése után a most írt oszlop a jobb szélen, a legrégebbi a bal szélen jelenik meg.
+ */
+void ScreenWaterfall::drawColumn(const float *magnitudeData) {
+    using namespace ScreenWaterfallConstants;
+
+    // Kézi erősítés a konfigurációból, egyébként az előző keretekből simított maximum a célszintre
+    const bool isFm = maxFreqHz_ > MAX_FREQ_AM_HZ;
+    const float manualGain = isFm ? config.data.audioFftConfigFm : config.data.audioFftConfigAm;
+    const float scale = manualGain > 0.0f ? MANUAL_INPUT_SCALE * manualGain : AUTO_TARGET_LEVEL / std::max(smoothedPeak_, AUTO_MIN_PEAK);
+
+    // A puffer felülről lefelé: a legmagasabb frekvencia az első képpont
+    const uint16_t *palette = WaterfallPalette::get(config.data.waterfallPalette);
+    float framePeak = 0.0f;
+    for (uint16_t r = 0; r < COLUMN_HEIGHT; r++) {
+        const float magnitude = binMap_.aggregate(magnitudeData, r);
+        framePeak = std::max(framePeak, magnitude);
+
+        const float value = magnitude < NOISE_THRESHOLD ? 0.0f : std::min(magnitude * scale, 255.0f);
+        columnBuffer_[COLUMN_HEIGHT - 1 - r] = palette[static_cast<uint8_t>(value)];
+    }
+    smoothedPeak_ += (framePeak - smoothedPeak_) * AUTO_PEAK_SMOOTHING;
+
+    columnWriter_.pushColumn(0, COLUMN_HEIGHT, columnBuffer_);
+}
+
+/**
+ * @brief Érintés: a kép törlése
+ */
+bool ScreenWaterfall::handleTouch(const TouchEvent &event) {
+    if (!event.pressed) {
+        return UIScreen::handleTouch(event);
+    }
+    columnWriter_.clear();
+    return true;
+}
+
+/**
+ * @brief Rotary: klikk vissza az előző képernyőre
+ */
+bool ScreenWaterfall::handleRotary(const RotaryEvent &event) {
+    if (event.buttonState == RotaryEvent::ButtonState::Clicked) {
+        if (getScreenManager()) {
+            getScreenManager()->goBack();
+        }
+        return true;
+    }
+    return UIScreen::handleRotary(event);
+}
@@ -0,0 +1,222 @@
+/**
+ * @file ScreenWefax.cpp
+ * @brief WEFAX (HF időjárási fax) kép képernyő implementáció
+ */
+
+#include "ScreenWefax.h"
+#include "AudioCore1Manager.h"
+#include "Config.h"
+#include "ScreenManager.h"
+#include "defines.h"
+
+/**
+ * @brief Konstruktor
+ */
+ScreenWefax::ScreenWefax() : UIScreen(SCREEN_NAME_WEFAX), decoder_(nullptr), lastImageCounter_(0), cursorY_(ScreenWefaxConstants::IMAGE_Y), lastStatusMs_(0) {}
+
+/**
+ * @brief Képernyő aktiválása: a WEFAX dekóder bekapcsolása a core1-en
+ */
+void ScreenWefax::activate() {
+    UIScreen::activate();
+
+    decoder_ = AudioCore1Manager::getWefaxDecoder();
+    if (!decoder_) {
+        return;
+    }
+    decoder_->setSlantPpm(config.data.wefaxSlantPpm);
+
+    // Ha a spektrum ki volt kapcsolva (Off mód), a mintavételezés szünetel: a dekóderhez el kell indítani
+    if (AudioCore1Manager::isCore1Paused()) {
+        AudioCore1Manager::resumeCore1Audio();
+    }
+    AudioCore1Manager::setSampleDecoder(decoder_);
+
+    // A reset() Idle állapotba teszi a dekódert, a sor-gyűrű maradékát eldobjuk
+    while (decoder_->popRow(rowBuffer_)) {
+    }
+    lastImageCounter_ = decoder_->getImageCounter();
+    cursorY_ = ScreenWefaxConstants::IMAGE_Y;
+}
+
+/**
+ * @brief Képernyő deaktiválása: a dekóder leválasztása (a visszatérő képernyő állítja be a sajátját)
+ */
+void ScreenWefax::deactivate() {
+    AudioCore1Manager::setSampleDecoder(nullptr);
+    decoder_ = nullptr;
+    UIScreen::deactivate();
+}
+
+/**
+ * @brief Teljes képernyő kirajzolása (üres kép, állapotsor)
+ */
+void ScreenWefax::drawContent() {
+    tft.fillScreen(TFT_BLACK);
+    clearImage();
+    drawStatusBar();
+}
+
+/**
+ * @brief A kép területének törlése, a kurzor a tetejére
+ */
+void ScreenWefax::clearImage() {
+    tft.fillRect(0, ScreenWefaxConstants::IMAGE_Y, ::SCREEN_W, ::SCREEN_H - ScreenWefaxConstants::IMAGE_Y, TFT_BLACK);
+    cursorY_ = ScreenWefaxConstants::IMAGE_Y;
+    tft.drawFastHLine(0, cursorY_, ::SCREEN_W, ScreenWefaxConstants::CURSOR_COLOR);
+}
+
+/**
+ * @brief Főciklus: új kép figyelése, kész sorok kirajzolása, állapotsor frissítése
+ */
+void ScreenWefax::handleOwnLoop() {
+    if (!decoder_) {
+        return;
+    }
+
+    // Új kép (start hang vagy kézi indítás): a régi képet töröljük
+    const uint32_t imageCounter = decoder_->getImageCounter();
+    if (imageCounter != lastImageCounter_) {
+        lastImageCounter_ = imageCounter;
+        clearImage();
+    }
+
+    // Kész sorok kirajzolása (korlátozva, hogy a UI ne akadjon meg)
+    for (uint8_t i = 0; i < ScreenWefaxConstants::MAX_ROWS_PER_LOOP && decoder_->popRow(rowBuffer_); i++) {
+        drawRow();
+    }
+
+    if (millis() - lastStatusMs_ >= ScreenWefaxConstants::STATUS_REFRESH_MS) {
+        drawStatusBar();
+    }
+}
+
+/**
+ * @brief A soron következő kép sor kirajzolása a kurzor helyére
+ * @details Szürke -> RGB565 konverzió az egyetlen sor pufferbe, majd egy blokkban a kijelzőre.
+ *          Alul körbefordul, a kurzor vonal jelzi a következő sor helyét.
+ */
+void ScreenWefax::drawRow() {
+    const uint16_t width = std::min<uint16_t>(WefaxConstants::IMAGE_WIDTH, ::SCREEN_W);
+    for (uint16_t x = 0; x < width; x++) {
+        const uint8_t g = rowBuffer_[x];
+        lineBuffer_[x] = ((g & 0xF8) << 8) | ((g & 0xFC) << 3) | (g >> 3);
+    }
+
+    // A sor puffer natív bájtsorrendű RGB565
+    const bool swapBytes = tft.getSwapBytes();
+    tft.setSwapBytes(true);
+    tft.pushImage(0, cursorY_, width, 1, lineBuffer_);
+    tft.setSwapBytes(swapBytes);
+
+    if (++cursorY_ >= ::SCREEN_H) {
+        cursorY_ = ScreenWefaxConstants::IMAGE_Y;
+    }
+    tft.drawFastHLine(0, cursorY_, ::SCREEN_W, ScreenWefaxConstants::CURSOR_COLOR);
+}
+
+/**
+ * @brief Az állapotsor kirajzolása: állapot, sorszám, ferdeség korrekció, kezelési tipp
+ */
+void ScreenWefax::drawStatusBar() {
+    lastStatusMs_ = millis();
+
+    const char *stateText = "No decoder";
+    uint16_t stateColor = TFT_RED;
+    uint16_t rows = 0;
+    if (decoder_) {
+        rows = decoder_->getRowCount();
+        switch (decoder_->getState()) {
+            case WefaxDecoder::State::Idle:
+                stateText = "Waiting start";
+                stateColor = TFT_YELLOW;
+                break;
+            case WefaxDecoder::State::Phasing:
+                stateText = "Phasing";
+                stateColor = TFT_ORANGE;
+                break;
+            case WefaxDecoder::State::Image:
+                stateText = "Receiving";
+                stateColor = TFT_GREEN;
+                break;
+        }
+    }
+
+    tft.fillRect(0, 0, ::SCREEN_W, ScreenWefaxConstants::STATUS_BAR_HEIGHT, TFT_BLACK);
+    tft.setFreeFont();
+    tft.setTextSize(1);
+    tft.setTextDatum(ML_DATUM);
+    const int16_t y = ScreenWefaxConstants::STATUS_BAR_HEIGHT / 2;
+
+    char buf[32];
+    snprintf(buf, sizeof(buf), "WEFAX %u/%u", WefaxConstants::LINES_PER_MINUTE, WefaxConstants::IOC);
+    tft.setTextColor(TFT_WHITE, TFT_BLACK);
+    tft.drawString(buf, 4, y);
+
+    tft.setTextColor(stateColor, TFT_BLACK);
+    tft.drawString(stateText, 80, y);
+
+    snprintf(buf, sizeof(buf), "Row %u  Slant %+d ppm", rows, config.data.wefaxSlantPpm);
+    tft.setTextColor(TFT_CYAN, TFT_BLACK);
+    tft.drawString(buf, 170, y);
+
+    tft.setTextDatum(MR_DATUM);
+    tft.setTextColor(TFT_SILVER, TFT_BLACK);
+    tft.drawString("Tap:start Click:back", ::SCREEN_W - 4, y);
+}
+
+/**
+ * @brief Ferdeség korrekció módosítása és mentése a konfigurációba
+ * @param ppm Az új érték ppm-ben
+ */
+void ScreenWefax::changeSlant(int16_t ppm) {
+    config.data.wefaxSlantPpm = constrain(ppm, -WefaxConstants::MAX_SLANT_PPM, WefaxConstants::MAX_SLANT_PPM);
+    if (decoder_) {
+        decoder_->setSlantPpm(config.data.wefaxSlantPpm);
+    }
+    drawStatusBar();
+}
+
+/**
+ * @brief Érintés: kép kézi indítása (várakozás közben) vagy leállítása (vétel közben)
+ */
+bool ScreenWefax::handleTouch(const TouchEvent &event) {
+    if (!event.pressed || !decoder_) {
+        return UIScreen::handleTouch(event);
+    }
+
+    if (decoder_->getState() == WefaxDecoder::State::Idle) {
+        decoder_->requestStart();
+    } else {
+        decoder_->requestStop();
+    }
+    return true;
+}
+
+/**
+ * @brief Rotary: forgatás a ferdeség korrekció, klikk vissza, dupla klikk a korrekció nullázása
+ */
+bool ScreenWefax::handleRotary(const RotaryEvent &event) {
+    if (event.buttonState == RotaryEvent::ButtonState::Clicked) {
+        if (getScreenManager()) {
+            getScreenManager()->goBack();
+        }
+        return true;
+    }
+
+    if (event.buttonState == RotaryEvent::ButtonState::DoubleClicked) {
+        changeSlant(0);
+        return true;
+    }
+
+    if (event.direction == RotaryEvent::Direction::Up) {
+        changeSlant(config.data.wefaxSlantPpm + ScreenWefaxConstants::SLANT_STEP_PPM);
+        return true;
+    }
+    if (event.direction == RotaryEvent::Direction::Down) {
+        changeSlant(config.data.wefaxSlantPpm - ScreenWefaxConstants::SLANT_STEP_PPM);
+        return true;
+    }
+
+    return UIScreen::handleRotary(event);
+}
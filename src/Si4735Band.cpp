@@ -38,10 +38,9 @@ void Si4735Band::bandInit(bool sysStart) {
         si4735.setRdsConfig(1, 2, 2, 2, 2); // enable=1, threshold=2 (mint a working projektben)
 
         // Seek beállítások
-        si4735.setSeekFmRssiThreshold(2); // 2dB RSSI threshold
-        si4735.setSeekFmSrnThreshold(2);  // 2dB SNR threshold
-        si4735.setSeekFmSpacing(10);      // 10kHz seek lépésköz
-                                          // 87.5MHz - 108MHz között
+        setSeekThresholds();         // RSSI/SNR küszöbök a konfigból
+        si4735.setSeekFmSpacing(10); // 10kHz seek lépésköz
+                                     // 87.5MHz - 108MHz között
         si4735.setSeekFmLimits(currentBand.minimumFreq, currentBand.maximumFreq);
 
     } else {
@@ -57,6 +56,18 @@ void Si4735Band::bandInit(bool sysStart) {
     }
 }
 
+/**
+ * @brief Az FM seek RSSI/SNR küszöbeinek beállítása a chipen a konfig szerint
+ * @details Seek csak az FM képernyőn van, AM sávon a bandInit() alapértékei maradnak
+ */
+void Si4735Band::setSeekThresholds() {
+    if (getCurrentBandType() != FM_BAND_TYPE) {
+        return;
+    }
+    si4735.setSeekFmRssiThreshold(config.data.seekRssiThresholdFM);
+    si4735.setSeekFmSrnThreshold(config.data.seekSnrThresholdFM);
+}
+
 /**
  * SSB patch betöltése
  */
@@ -446,4 +457,47 @@ uint16_t Si4735Band::stepFrequency(int16_t rotaryValue) {
     }
 
     return currentBand.currFreq;
+}
+
+/**
+ * @brief CW automatikus nullázó hangolás (auto zero-beat)
+ * @param measuredToneHz A mért hangfrekvencia Hz-ben
+ * @return true ha történt áthangolás
+ */
+bool Si4735Band::cwZeroBeat(float measuredToneHz) {
+
+    if (!ssbLoaded || !isCurrentDemodCW() || measuredToneHz <= 0.0f) {
+        return false;
+    }
+
+    // USB-ben a hang a vételi frekvencia felett van: ha a hang magasabb a kívántnál, feljebb hangolunk
+    constexpr int16_t MIN_CORRECTION_HZ = 5; // Ennél kisebb eltérést nem korrigálunk
+    int16_t deltaHz = static_cast<int16_t>(lround(measuredToneHz - config.data.cwReceiverOffsetHz));
+    if (abs(deltaHz) < MIN_CORRECTION_HZ) {
+        return false;
+    }
+
+    // A finomhangolás ugyanúgy történik, mint a rotary-val: freqDec csökkentése = felfelé hangolás
+    BandTable &currentBand = getCurrentBand();
+    rtv::freqDec -= deltaHz;
+
+    // A BFO tartomány túllépésekor a chip frekvenciáját 16kHz-cel léptetjük (mint a ScreenAM rotary kezelésben)
+    if (rtv::freqDec <= -16000 || rtv::freqDec >= 16000) {
+        int16_t chipStep = rtv::freqDec < 0 ? 16 : -16;
+        uint16_t newFreq = currentBand.currFreq + chipStep;
+        if (newFreq < currentBand.minimumFreq || newFreq > currentBand.maximumFreq) {
+            rtv::freqDec += deltaHz; // Sávhatáron nem hangolunk át
+            return false;
+        }
+        rtv::freqDec += (chipStep > 0) ? 16000 : -16000;
+        si4735.setFrequency(newFreq);
+        currentBand.currFreq = si4735.getCurrentFrequency();
+    }
+
+    rtv::currentBFO = rtv::freqDec;
+    rtv::lastBFO = rtv::currentBFO;
+    si4735.setSSBBfo(config.data.cwReceiverOffsetHz + rtv::currentBFO + rtv::currentBFOmanu);
+
+    DEBUG("Si4735Band::cwZeroBeat() -> hang: %d Hz, korrekció: %d Hz, BFO: %d\n", static_cast<int>(measuredToneHz), deltaHz, rtv::currentBFO);
+    return true;
 }
\ No newline at end of file
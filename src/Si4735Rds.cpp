@@ -142,6 +142,42 @@ bool Si4735Rds::getRdsDateTime(uint16_t &year, uint16_t &month, uint16_t &day, u
     return si4735.getRdsDateTime(&year, &month, &day, &hour, &minute);
 }
 
+/**
+ * @brief Egy RDS csoport kivétele a chip RDS FIFO-jából
+ * @details Előbb csak az állapotot kérdezzük le (a FIFO telítettsége), a csoportot csak nem üres FIFO-ból vesszük ki,
+ *          így régi (már feldolgozott) blokk adat nem kerülhet be.
+ * @param group A kivett csoport adatai
+ * @return false, ha nincs RDS szinkron vagy a FIFO üres
+ */
+bool Si4735Rds::readRdsFifoGroup(RdsFifoGroup &group) {
+
+    // Ellenőrizzük, hogy FM módban vagyunk-e
+    if (!isCurrentBandFM()) {
+        return false;
+    }
+
+    // Csak állapot (STATUSONLY = 1): a FIFO nem változik
+    si4735.getRdsStatus(0, 0, 1);
+    if (!si4735.getRdsSync() || si4735.getNumRdsFifoUsed() == 0) {
+        return false;
+    }
+
+    // A legrégebbi csoport kivétele a FIFO-ból
+    si4735.getRdsStatus(0, 0, 0);
+    group.pi = si4735.getRdsPI();
+    group.pty = si4735.getRdsProgramType();
+    group.remaining = si4735.getNumRdsFifoUsed();
+
+    char *ps = si4735.getRdsText0A(); // Csak 0A csoportnál nem nullptr
+    if (ps != nullptr) {
+        strncpy(group.ps, ps, sizeof(group.ps) - 1);
+        group.ps[sizeof(group.ps) - 1] = '\0';
+    } else {
+        group.ps[0] = '\0';
+    }
+    return true;
+}
+
 /**
  * @brief Ellenőrzi, hogy elérhető-e RDS adat
  * @return true ha van érvényes RDS vétel
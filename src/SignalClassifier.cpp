@@ -0,0 +1,487 @@
+#include "SignalClassifier.h"
+#include "defines.h"
+#include "utils.h"
+#include <TFT_eSPI.h>
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+/**
+ * @brief Beállított bitek száma
+ */
+uint8_t countBits(uint32_t value) {
+    uint8_t count = 0;
+    while (value) {
+        value &= value - 1;
+        count++;
+    }
+    return count;
+}
+} // namespace
+
+/**
+ * @brief Konstruktor
+ */
+SignalClassifier::SignalClassifier()
+    : signalClass_(SignalClass::None), //
+      confidence_(0),                  //
+      lastUpdateMs_(0),                //
+      framesSinceReset_(0),            //
+      maxCostMicros_(0),               //
+      frameMicros_(0),                 //
+      resetRequested_(false),          //
+      amDemodulation_(false) {
+    reset();
+}
+
+/**
+ * @brief Az előzmények és a simított jellemzők törlése (core1)
+ */
+void SignalClassifier::reset() {
+    bandwidthHz_ = 0.0f;
+    flatness_ = 1.0f;
+    peakCount_ = 0.0f;
+    topStable_ = 0.0f;
+    pairStable_ = 0.0f;
+    envDip_ = 0.0f;
+    carrierShare_ = 0.0f;
+    sidebandShare_ = 0.0f;
+    pairShiftHz_ = 0.0f;
+    presentFrames_ = 0;
+
+    prevTopBin_ = -1;
+    lastPairLo_ = -1;
+    lastPairHi_ = -1;
+    presenceHistory_ = 0;
+    slotStartMicros_ = 0;
+    historySlots_ = 0;
+    lastFrameMicros_ = 0;
+
+    candidate_ = SignalClass::None;
+    candidateCount_ = 0;
+    std::fill(rawHistory_, rawHistory_ + SignalClassifierConstants::CONFIDENCE_FRAMES, SignalClass::None);
+    rawHistoryPos_ = 0;
+
+    signalClass_ = SignalClass::None;
+    confidence_ = 0;
+    framesSinceReset_ = 0;
+}
+
+/**
+ * @brief Zajszint becslés: a bin blokk-átlagok alsó negyede (a jelek nem húzzák fel, mint az átlagot)
+ */
+float SignalClassifier::estimateNoiseFloor(const float *magnitude, uint16_t lo, uint16_t hi) {
+    using namespace SignalClassifierConstants;
+
+    const uint16_t bins = hi - lo;
+    const uint8_t blocks = std::min<uint16_t>(bins / FLOOR_BLOCK_BINS, MAX_FLOOR_BLOCKS);
+    const uint16_t blockBins = bins / blocks;
+
+    uint16_t k = lo;
+    for (uint8_t b = 0; b < blocks; b++) {
+        float sum = 0.0f;
+        for (uint16_t j = 0; j < blockBins; j++) {
+            sum += magnitude[k++];
+        }
+        floorBlocks_[b] = sum / blockBins;
+    }
+
+    float *quartile = floorBlocks_ + blocks / 4;
+    std::nth_element(floorBlocks_, quartile, floorBlocks_ + blocks);
+    return *quartile;
+}
+
+/**
+ * @brief A jelenlét előzmény léptetése időrésekben
+ * @details A keretek ütemezése változó (core1 ciklus, dekóder mellett a gyűrűs puffer), ezért az előzmény
+ *          KEYING_SLOT_MS-os időrésekből áll: egy résen belüli több keret összevagyolódik, a keret nélküli
+ *          rések az előző állapotot tartják (nem számítanak be/ki váltásnak).
+ * @param present Volt-e jel a keretben
+ * @param nowMicros A keret ideje
+ */
+void SignalClassifier::updatePresenceHistory(bool present, uint32_t nowMicros) {
+    using namespace SignalClassifierConstants;
+
+    constexpr uint32_t slotMicros = KEYING_SLOT_MS * 1000UL;
+    const uint32_t elapsedSlots = (nowMicros - slotStartMicros_) / slotMicros;
+
+    // Első keret, vagy az egész előzménynél hosszabb szünet (pl. a core1 szünetelt): új előzmény
+    if (historySlots_ == 0 || elapsedSlots > KEYING_HISTORY) {
+        presenceHistory_ = present ? 1 : 0;
+        historySlots_ = 1;
+        slotStartMicros_ = nowMicros;
+        return;
+    }
+
+    if (elapsedSlots == 0) {
+        presenceHistory_ |= present ? 1 : 0;
+        return;
+    }
+
+    const uint32_t held = (presenceHistory_ & 1) ? (1UL << (elapsedSlots - 1)) - 1 : 0;
+    presenceHistory_ = (presenceHistory_ << elapsedSlots) | (held << 1) | (present ? 1 : 0);
+    historySlots_ = std::min<uint32_t>(historySlots_ + elapsedSlots, KEYING_HISTORY);
+    slotStartMicros_ += elapsedSlots * slotMicros;
+}
+
+/**
+ * @brief Egy FFT keret osztályozása (core1)
+ */
+void SignalClassifier::processFrame(const float *magnitude, uint16_t fftSize, float binWidthHz, const float *envelope) {
+    using namespace SignalClassifierConstants;
+
+    const uint32_t startMicros = micros();
+
+    if (resetRequested_) {
+        resetRequested_ = false;
+        reset();
+    }
+    if (!magnitude || !envelope || binWidthHz <= 0.0f) {
+        return;
+    }
+
+    const uint16_t hi = fftSize / 2;
+    const uint16_t lo = std::max<uint16_t>(1, static_cast<uint16_t>(ceilf(MIN_FREQ_HZ / binWidthHz)));
+    if (hi < lo + FLOOR_BLOCK_BINS * 4) {
+        return;
+    }
+
+    // Átfedő keret (az előző óta kevesebb mint fftSize új minta, pl. ütemezetlen hívásnál): ugyanazt a jelet ne számoljuk kétszer
+    const uint32_t frameMicros = static_cast<uint32_t>(1.0e6f / binWidthHz);
+    if (framesSinceReset_ > 0 && startMicros - lastFrameMicros_ < frameMicros) {
+        return;
+    }
+    lastFrameMicros_ = startMicros;
+
+    // 1. Zajszint
+    const float noiseFloor = estimateNoiseFloor(magnitude, lo, hi);
+
+    // 2. Egy menetben: legerősebb bin, csúcsok (csökkenő sorrendben), teljesítmény, log2 átlag a lapossághoz
+    const float peakThreshold = noiseFloor * PEAK_RATIO;
+    const float excessThreshold = noiseFloor * EXCESS_RATIO;
+    const float logEpsilon = noiseFloor * 1.0e-3f + 1.0e-12f;
+    uint16_t peakBin[MAX_PEAKS];
+    float peakMag[MAX_PEAKS];
+    uint8_t peaks = 0;
+    float top = 0.0f;
+    uint16_t topBin = lo;
+    float sumPower = 0.0f;
+    float sumLog2 = 0.0f;
+    float excessPower = 0.0f;
+
+    for (uint16_t k = lo; k < hi; k++) {
+        const float m = magnitude[k];
+        sumPower += m * m;
+        sumLog2 += Utils::fastLog2(m + logEpsilon);
+        if (m > excessThreshold) {
+            excessPower += (m - excessThreshold) * (m - excessThreshold);
+        }
+        if (m > top) {
+            top = m;
+            topBin = k;
+        }
+
+        // Lokális maximum: beszúrás a csökkenő sorrendű csúcs listába
+        if (m > peakThreshold && m > magnitude[k - 1] && (k + 1 >= hi || m >= magnitude[k + 1])) {
+            uint8_t pos = std::min<uint8_t>(peaks, MAX_PEAKS - 1);
+            if (peaks < MAX_PEAKS || m > peakMag[pos]) {
+                while (pos > 0 && peakMag[pos - 1] < m) {
+                    peakMag[pos] = peakMag[pos - 1];
+                    peakBin[pos] = peakBin[pos - 1];
+                    pos--;
+                }
+                peakMag[pos] = m;
+                peakBin[pos] = k;
+                if (peaks < MAX_PEAKS) {
+                    peaks++;
+                }
+            }
+        }
+    }
+
+    // Kikapcsolt FFT (csupa nulla spektrum): nincs mit osztályozni
+    if (top <= 0.0f) {
+        signalClass_ = SignalClass::None;
+        lastUpdateMs_ = millis();
+        return;
+    }
+
+    const bool present = top > noiseFloor * SIGNAL_PRESENT_RATIO;
+    updatePresenceHistory(present, startMicros);
+    if (framesSinceReset_ < UINT16_MAX) {
+        framesSinceReset_++;
+    }
+
+    // 3. A jellemzőket csak jelenlétkor frissítjük, különben a szünetek (CW) elmosnák őket
+    if (present) {
+        // Foglalt sávszélesség: a zaj küszöb feletti teljesítmény két szélén 5-5%-ot levágunk
+        const float edgePower = excessPower * (1.0f - OCCUPIED_FRACTION) * 0.5f;
+        uint16_t lowEdge = lo;
+        float cumulative = 0.0f;
+        for (uint16_t k = lo; k < hi; k++) {
+            const float excess = std::max(magnitude[k] - excessThreshold, 0.0f);
+            cumulative += excess * excess;
+            if (cumulative >= edgePower) {
+                lowEdge = k;
+                break;
+            }
+        }
+        uint16_t highEdge = hi - 1;
+        cumulative = 0.0f;
+        for (uint16_t k = hi - 1; k > lowEdge; k--) {
+            const float excess = std::max(magnitude[k] - excessThreshold, 0.0f);
+            cumulative += excess * excess;
+            if (cumulative >= edgePower) {
+                highEdge = k;
+                break;
+            }
+        }
+        const float bandwidthHz = (highEdge - lowEdge + 1) * binWidthHz;
+
+        // Spektrális laposság: mértani / számtani közép a teljesítményen, log2 tartományban
+        const uint16_t bins = hi - lo;
+        const float flatness = std::min(exp2f(2.0f * sumLog2 / bins - Utils::fastLog2(sumPower / bins)), 1.0f);
+
+        // Csúcsok a legerősebb -20 dB-én belül, és a második RTTY hang keresése a kereten belül
+        uint8_t strongPeaks = 0;
+        int16_t pairLo = -1;
+        int16_t pairHi = -1;
+        for (uint8_t i = 0; i < peaks; i++) {
+            if (peakMag[i] < peakMag[0] * PEAK_RELATIVE) {
+                break;
+            }
+            strongPeaks++;
+            const float shiftHz = abs(static_cast<int16_t>(peakBin[i]) - static_cast<int16_t>(peakBin[0])) * binWidthHz;
+            if (pairLo < 0 && i > 0 && peakMag[i] >= peakMag[0] * RTTY_TONE_RELATIVE && shiftHz >= RTTY_MIN_SHIFT_HZ && shiftHz <= RTTY_MAX_SHIFT_HZ) {
+                pairLo = std::min(peakBin[0], peakBin[i]);
+                pairHi = std::max(peakBin[0], peakBin[i]);
+            }
+        }
+
+        // Egy keret hossza (fftSize / fs) ~1 RTTY bitnyi, ezért a hangpárt a legerősebb csúcs keretek közötti ugrása is adja
+        if (pairLo < 0 && prevTopBin_ >= 0) {
+            const float shiftHz = abs(static_cast<int16_t>(topBin) - prevTopBin_) * binWidthHz;
+            if (shiftHz >= RTTY_MIN_SHIFT_HZ && shiftHz <= RTTY_MAX_SHIFT_HZ) {
+                pairLo = std::min<int16_t>(topBin, prevTopBin_);
+                pairHi = std::max<int16_t>(topBin, prevTopBin_);
+            }
+        }
+
+        // Stabilitás: az előző helyhez képest legfeljebb STABLE_TOLERANCE_HZ (de legalább 1 bin) elmozdulás
+        const int16_t tolerance = std::max<int16_t>(1, static_cast<int16_t>(STABLE_TOLERANCE_HZ / binWidthHz));
+        const bool topStable = prevTopBin_ >= 0 && abs(static_cast<int16_t>(topBin) - prevTopBin_) <= tolerance;
+        const bool pairStable = pairLo >= 0 && lastPairLo_ >= 0 && abs(pairLo - lastPairLo_) <= tolerance && abs(pairHi - lastPairHi_) <= tolerance;
+
+        // Burkoló beesések: a maximum felénél kisebb részblokkok aránya (a zaj nem, a PSK fázisváltás igen)
+        float envMax = envelope[0];
+        for (uint8_t b = 1; b < ENVELOPE_BLOCKS; b++) {
+            envMax = std::max(envMax, envelope[b]);
+        }
+        uint8_t dips = 0;
+        for (uint8_t b = 0; b < ENVELOPE_BLOCKS; b++) {
+            if (envelope[b] < envMax * ENVELOPE_DIP_LEVEL) {
+                dips++;
+            }
+        }
+        const float envDip = static_cast<float>(dips) / ENVELOPE_BLOCKS;
+
+        // Vivő: a legerősebb bin részesedése a sávból; oldalsávok: a zaj küszöb feletti teljesítmény a vivőn kívül
+        const float carrierShare = top * top / sumPower;
+        const int16_t guard = std::max<int16_t>(SIDEBAND_GUARD_BINS, static_cast<int16_t>(SIDEBAND_GUARD_HZ / binWidthHz));
+        float nearPower = 0.0f;
+        for (int16_t k = std::max<int16_t>(lo, topBin - guard); k <= std::min<int16_t>(hi - 1, topBin + guard); k++) {
+            const float excess = std::max(magnitude[k] - excessThreshold, 0.0f);
+            nearPower += excess * excess;
+        }
+        const float sidebandShare = excessPower > 0.0f ? 1.0f - nearPower / excessPower : 0.0f;
+
+        if (presentFrames_ == 0) {
+            bandwidthHz_ = bandwidthHz;
+            flatness_ = flatness;
+            peakCount_ = strongPeaks;
+            envDip_ = envDip;
+            carrierShare_ = carrierShare;
+            sidebandShare_ = sidebandShare;
+        } else {
+            bandwidthHz_ += SMOOTHING * (bandwidthHz - bandwidthHz_);
+            flatness_ += SMOOTHING * (flatness - flatness_);
+            peakCount_ += SMOOTHING * (strongPeaks - peakCount_);
+            envDip_ += SMOOTHING * (envDip - envDip_);
+            carrierShare_ += SMOOTHING * (carrierShare - carrierShare_);
+            sidebandShare_ += SMOOTHING * (sidebandShare - sidebandShare_);
+        }
+        topStable_ += SMOOTHING * ((topStable ? 1.0f : 0.0f) - topStable_);
+        pairStable_ += SMOOTHING * ((pairStable ? 1.0f : 0.0f) - pairStable_);
+        if (pairLo >= 0) {
+            pairShiftHz_ += SMOOTHING * ((pairHi - pairLo) * binWidthHz - pairShiftHz_);
+            lastPairLo_ = pairLo;
+            lastPairHi_ = pairHi;
+        }
+        if (presentFrames_ < UINT16_MAX) {
+            presentFrames_++;
+        }
+
+        prevTopBin_ = topBin;
+    }
+
+    publish(decide(binWidthHz));
+
+    // Futásidő: egy FFT keret ideje 1 / binWidthHz
+    const uint32_t cost = micros() - startMicros;
+    if (cost > maxCostMicros_) {
+        maxCostMicros_ = cost;
+    }
+    frameMicros_ = frameMicros;
+}
+
+/**
+ * @brief Döntési fa a simított jellemzőkön
+ * @param binWidthHz Egy bin szélessége (a keskeny jel határa legalább NARROW_MIN_BINS bin)
+ * @return A nyers (hiszterézis előtti) jeltípus
+ */
+SignalClass SignalClassifier::decide(float binWidthHz) const {
+    using namespace SignalClassifierConstants;
+
+    // Billentyűzés: a jelenlét aránya és a be/ki váltások száma az időrés előzményben
+    if (historySlots_ == 0 || presentFrames_ == 0) {
+        return SignalClass::Noise;
+    }
+    const uint32_t mask = (1UL << historySlots_) - 1;
+    const uint32_t history = presenceHistory_ & mask;
+    const float onRatio = static_cast<float>(countBits(history)) / historySlots_;
+    const uint8_t transitions = countBits((history ^ (history >> 1)) & (mask >> 1));
+    if (onRatio < NOISE_MAX_ON) {
+        return SignalClass::Noise;
+    }
+    const bool keyed = onRatio <= KEYED_MAX_ON && transitions >= KEYED_MIN_TRANSITIONS;
+
+    // Két stabil hang kevés más csúccsal: RTTY (keretenként gyakran csak az egyik hang látszik, így keskeny is lehet)
+    if (pairStable_ >= RTTY_MIN_PAIR_STABLE && peakCount_ <= RTTY_MAX_PEAKS && pairShiftHz_ >= RTTY_MIN_SHIFT_HZ && pairShiftHz_ <= RTTY_MAX_SHIFT_HZ) {
+        return SignalClass::RTTY;
+    }
+
+    // Keskeny jelek: CW, vivő oldalsávokkal (AM), PSK, vivő
+    if (bandwidthHz_ <= std::max(NARROW_BW_HZ, NARROW_MIN_BINS * binWidthHz)) {
+        if (keyed) {
+            return SignalClass::CW;
+        }
+        if (topStable_ >= AM_MIN_CARRIER_STABLE && sidebandShare_ >= AM_SIDEBAND_SHARE && peakCount_ >= AM_MIN_PEAKS) {
+            return SignalClass::AMVoice;
+        }
+        return envDip_ >= PSK_MIN_DIP ? SignalClass::PSK : SignalClass::Carrier;
+    }
+
+    // Széles, lapos spektrum: zaj
+    if (flatness_ >= NOISE_FLATNESS) {
+        return SignalClass::Noise;
+    }
+
+    // Közepes szélességű, beeső burkolójú jel: gyorsabb PSK változatok
+    if (bandwidthHz_ < VOICE_MIN_BW_HZ && envDip_ >= PSK_MIN_DIP) {
+        return SignalClass::PSK;
+    }
+
+    // Beszéd: AM ha stabil, erős vivője van (vagy AM demoduláció), különben SSB
+    if (amDemodulation_ || (topStable_ >= AM_MIN_CARRIER_STABLE && carrierShare_ >= AM_CARRIER_SHARE)) {
+        return SignalClass::AMVoice;
+    }
+    return SignalClass::SSBVoice;
+}
+
+/**
+ * @brief A nyers döntés közzététele hiszterézissel, a megbízhatóság frissítése
+ */
+void SignalClassifier::publish(SignalClass raw) {
+    using namespace SignalClassifierConstants;
+
+    if (raw == candidate_) {
+        if (candidateCount_ < HYSTERESIS_FRAMES) {
+            candidateCount_++;
+        }
+    } else {
+        candidate_ = raw;
+        candidateCount_ = 1;
+    }
+    if (candidateCount_ >= HYSTERESIS_FRAMES) {
+        signalClass_ = candidate_;
+    }
+
+    rawHistory_[rawHistoryPos_] = raw;
+    rawHistoryPos_ = (rawHistoryPos_ + 1) & (CONFIDENCE_FRAMES - 1);
+    uint8_t agree = 0;
+    for (uint8_t i = 0; i < CONFIDENCE_FRAMES; i++) {
+        if (rawHistory_[i] == signalClass_) {
+            agree++;
+        }
+    }
+    confidence_ = agree * 100 / CONFIDENCE_FRAMES;
+    lastUpdateMs_ = millis();
+}
+
+/**
+ * @brief Az aktuális jeltípus (core0-ról hívható)
+ */
+SignalClass SignalClassifier::getSignalClass() const {
+    if (millis() - lastUpdateMs_ > SignalClassifierConstants::RESULT_STALE_MS) {
+        return SignalClass::None;
+    }
+    return signalClass_;
+}
+
+/**
+ * @brief A futásidő statisztika kiolvasása és nullázása
+ */
+void SignalClassifier::takeCostStats(uint32_t &outMaxMicros, uint32_t &outFrameMicros) {
+    outMaxMicros = maxCostMicros_;
+    outFrameMicros = frameMicros_;
+    maxCostMicros_ = 0;
+}
+
+/**
+ * @brief Rövid címke a jeltípushoz
+ */
+const char *SignalClassifier::getLabel(SignalClass signalClass) {
+    switch (signalClass) {
+        case SignalClass::Noise:
+            return "Noise";
+        case SignalClass::Carrier:
+            return "Carr";
+        case SignalClass::CW:
+            return "CW";
+        case SignalClass::RTTY:
+            return "RTTY";
+        case SignalClass::PSK:
+            return "PSK";
+        case SignalClass::SSBVoice:
+            return "SSB";
+        case SignalClass::AMVoice:
+            return "AM";
+        default:
+            return "----";
+    }
+}
+
+/**
+ * @brief A jeltípus megjelenítési színe
+ */
+uint16_t SignalClassifier::getColor(SignalClass signalClass) {
+    switch (signalClass) {
+        case SignalClass::Noise:
+            return TFT_SILVER;
+        case SignalClass::Carrier:
+            return TFT_WHITE;
+        case SignalClass::CW:
+            return TFT_YELLOW;
+        case SignalClass::RTTY:
+            return TFT_CYAN;
+        case SignalClass::PSK:
+            return TFT_MAGENTA;
+        case SignalClass::SSBVoice:
+            return TFT_GREEN;
+        case SignalClass::AMVoice:
+            return TFT_ORANGE;
+        default:
+            return TFT_DARKGREY;
+    }
+}
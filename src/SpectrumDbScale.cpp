@@ -0,0 +1,115 @@
+#include "SpectrumDbScale.h"
+#include "Config.h"
+#include "utils.h"
+#include <algorithm>
+#include <cmath>
+
+// Statikus tagváltozók inicializálása
+float SpectrumDbScale::magnitudeTable_[256];
+bool SpectrumDbScale::magnitudeTableReady_ = false;
+
+/**
+ * @brief Konstruktor
+ * @details Az első példány építi fel a közös egység -> magnitúdó táblát (a képernyő felépítésekor, nem rajzolás közben)
+ */
+SpectrumDbScale::SpectrumDbScale()
+    : offsetUnits_(0.0f),      //
+      unitScale_(1.0f),        //
+      noiseFloorUnits_(-1.0f), //
+      windowLow_(0.0f),        //
+      windowRange_(1.0f) {
+    if (!magnitudeTableReady_) {
+        for (int i = 0; i < 256; i++) {
+            magnitudeTable_[i] = exp2f(i / DbScaleConstants::UNITS_PER_LOG2);
+        }
+        magnitudeTableReady_ = true;
+    }
+}
+
+/**
+ * @brief Keret kezdete: a teljes kivezérlésű szinusz binje legyen 0 dBFS (255 egység)
+ * @details A bemeneti erősítés a teljes skálát is ennyiszeresére tolja (log2-ben levonva): a dBFS érték és a zajszint
+ *          így az ADC bemenetre vonatkozik, az auto gain változásával nem mozdul.
+ */
+void SpectrumDbScale::beginFrame(uint16_t fftSize, float inputGain) {
+    using namespace DbScaleConstants;
+    const float fullScaleMagnitude = FULL_SCALE_AMPLITUDE * fftSize / 2 * WINDOW_COHERENT_GAIN * std::max(inputGain, 1e-3f);
+    offsetUnits_ = MAX_UNITS - UNITS_PER_LOG2 * Utils::fastLog2(fullScaleMagnitude);
+    unitScale_ = exp2f(-offsetUnits_ / UNITS_PER_LOG2);
+}
+
+/**
+ * @brief Magnitúdó -> dB egység
+ */
+uint8_t SpectrumDbScale::toUnits(float magnitude) const {
+    const float units = DbScaleConstants::UNITS_PER_LOG2 * Utils::fastLog2(magnitude) + offsetUnits_;
+    return static_cast<uint8_t>(constrain(units + 0.5f, 0.0f, DbScaleConstants::MAX_UNITS));
+}
+
+/**
+ * @brief dB egység -> magnitúdó (a közös relatív tábla az FFT mérethez skálázva)
+ */
+float SpectrumDbScale::toMagnitude(uint8_t units) const { return magnitudeTable_[units] * unitScale_; }
+
+/**
+ * @brief Zajszint becslés a keret egységeinek alsó percentiliséből, és az ablak elhelyezése fölé
+ * @details Hisztogram 2 dB-es vödrökkel: O(count), rendezés nélkül. A jelek a percentilis felett maradnak,
+ *          így a zajszint (és vele a háttér színe) erős jel mellett sem mozdul.
+ */
+void SpectrumDbScale::updateNoiseFloor(const uint8_t *units, uint16_t count) {
+    using namespace DbScaleConstants;
+    if (count == 0) {
+        return;
+    }
+
+    constexpr uint8_t BUCKETS = 256 >> FLOOR_BUCKET_SHIFT;
+    uint16_t histogram[BUCKETS] = {0};
+    for (uint16_t i = 0; i < count; i++) {
+        histogram[units[i] >> FLOOR_BUCKET_SHIFT]++;
+    }
+
+    const uint16_t target = static_cast<uint32_t>(count) * FLOOR_PERCENTILE / 100;
+    uint16_t cumulative = 0;
+    uint8_t bucket = 0;
+    for (; bucket < BUCKETS - 1; bucket++) {
+        cumulative += histogram[bucket];
+        if (cumulative > target) {
+            break;
+        }
+    }
+    const float floorUnits = (bucket << FLOOR_BUCKET_SHIFT) + (1 << FLOOR_BUCKET_SHIFT) / 2.0f; // A vödör közepe
+
+    noiseFloorUnits_ = noiseFloorUnits_ < 0.0f ? floorUnits : noiseFloorUnits_ + (floorUnits - noiseFloorUnits_) * FLOOR_SMOOTHING;
+    windowLow_ = noiseFloorUnits_ - FLOOR_MARGIN_DB * UNITS_PER_DB;
+    windowRange_ = std::max<float>(1.0f, config.data.spectrumDbRange * UNITS_PER_DB);
+}
+
+/**
+ * @brief dB egység -> szint az ablakon belül
+ */
+int SpectrumDbScale::toLevel(uint8_t units, int maxLevel) const {
+    const int level = static_cast<int>((units - windowLow_) * maxLevel / windowRange_);
+    return constrain(level, 0, maxLevel);
+}
+
+/**
+ * @brief A dB rács vonalai az aktuális ablakban
+ */
+uint8_t SpectrumDbScale::getGridLines(int maxLevel, int16_t *outLevels, int16_t *outDbfs, uint8_t maxLines) const {
+    using namespace DbScaleConstants;
+    const float lowDbfs = (windowLow_ - MAX_UNITS) / UNITS_PER_DB;
+    const float highDbfs = lowDbfs + windowRange_ / UNITS_PER_DB;
+
+    uint8_t count = 0;
+    for (int dbfs = static_cast<int>(std::ceil(lowDbfs / GRID_STEP_DB)) * GRID_STEP_DB; dbfs <= highDbfs && dbfs <= 0 && count < maxLines; dbfs += GRID_STEP_DB) {
+        outLevels[count] = static_cast<int16_t>((dbfs - lowDbfs) * maxLevel / (highDbfs - lowDbfs));
+        outDbfs[count] = static_cast<int16_t>(dbfs);
+        count++;
+    }
+    return count;
+}
+
+/**
+ * @brief A simított zajszint dBFS-ben
+ */
+float SpectrumDbScale::getNoiseFloorDbfs() const { return (std::max(noiseFloorUnits_, 0.0f) - DbScaleConstants::MAX_UNITS) / DbScaleConstants::UNITS_PER_DB; }
@@ -1,19 +1,18 @@
 #include "SpectrumVisualizationComponent.h"
 #include "AudioCore1Manager.h"
 #include "Config.h"
+#include "TftDmaManager.h"
+#include "WaterfallPalette.h"
 #include "defines.h"
 #include "utils.h"
 #include <cmath>
 #include <cstring>
 #include <vector>
 
-// Színprofilok
 namespace FftDisplayConstants {
-const uint16_t colors0[16] = {0x0000, 0x000F, 0x001F, 0x081F, 0x0810, 0x0800, 0x0C00, 0x1C00, 0xFC00, 0xFDE0, 0xFFE0, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF}; // Cold
-const uint16_t colors1[16] = {0x0000, 0x1000, 0x2000, 0x4000, 0x8000, 0xC000, 0xF800, 0xF8A0, 0xF9C0, 0xFD20, 0xFFE0, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF}; // Hot
-
 constexpr uint16_t MODE_INDICATOR_VISIBLE_TIMEOUT_MS = 10 * 1000; // A mód indikátor kiírásának láthatósága x másodpercig
 constexpr uint8_t SPECTRUM_FPS = 15;                              // FPS limitálás konstans, ez még élvezhető vizualizációt ad, maradjon így 20 FPS-en
+constexpr uint16_t TUNING_AID_LONG_PRESS_MS = 600;                // PSK/CW módban ennél hosszabb érintés módot vált, a rövidebb mód specifikus művelet
 
 }; // namespace FftDisplayConstants
 
@@ -42,6 +41,26 @@ namespace AnalyzerConstants {
 constexpr uint16_t ANALYZER_MIN_FREQ_HZ = 300;
 }; // namespace AnalyzerConstants
 
+// Spektrum nyomvonal konstansok (az egység a dB skáláé)
+namespace TraceConstants {
+constexpr uint32_t MAX_FRAME_GAP_MS = 1000;    // Hosszabb szünet után se ugorjon nagyot az átlag és a lecsengés
+constexpr uint16_t AVERAGE_COLOR = TFT_YELLOW; // Átlag nyomvonal színe
+constexpr uint16_t PEAK_COLOR = TFT_RED;       // Csúcstartás színe
+constexpr uint16_t MIN_COLOR = TFT_GREEN;      // Minimum tartás színe
+}; // namespace TraceConstants
+
+// Indexelt (8 bites) sprite konstansok: Waterfall és hangolási segéd
+namespace IndexedSpriteConstants {
+constexpr uint8_t OVERLAY_FIRST_INDEX = 248; // Alatta az intenzitás indexei, felette a rárajzolt jelölők színei
+constexpr uint16_t OVERLAY_COLORS[] = {TFT_BLACK, TFT_WHITE, TFT_GREEN, TFT_ORANGE, TFT_CYAN, TFT_YELLOW, TFT_MAGENTA, TFT_DARKGREY};
+static_assert(sizeof(OVERLAY_COLORS) / sizeof(OVERLAY_COLORS[0]) == 256 - OVERLAY_FIRST_INDEX, "A jelölő színek száma nem egyezik a fenntartott indexekkel");
+
+/**
+ * @brief Intenzitás (0..255) -> színtábla index (0..OVERLAY_FIRST_INDEX-1)
+ */
+constexpr uint8_t levelToIndex(uint8_t level) { return static_cast<uint8_t>((level * OVERLAY_FIRST_INDEX) >> 8); }
+}; // namespace IndexedSpriteConstants
+
 /**
  * @brief Konstruktor
  */
@@ -55,6 +74,8 @@ SpectrumVisualizationComponent::SpectrumVisualizationComponent(int x, int y, int
       frequencyLabelsDrawn_(false),                    //
       modeIndicatorHideTime_(0),                       //
       lastTouchTime_(0),                               //
+      tapTouchPending_(false),                         //
+      cwLockedFrequencyHz_(0.0f),                      //
       lastFrameTime_(0),                               //
       envelopeLastSmoothedValue_(0.0f),                //
       frameHistoryIndex_(0),                           //
@@ -63,10 +84,19 @@ SpectrumVisualizationComponent::SpectrumVisualizationComponent(int x, int y, int
       lastGainUpdateTime_(0),                          //
       sprite_(nullptr),                                //
       spriteCreated_(false),                           //
+      spriteMode_(DisplayMode::Off),                   //
       indicatorFontHeight_(0),                         //
       currentTuningAidType_(TuningAidType::CW_TUNING), //
       currentTuningAidMinFreqHz_(0.0f),                //
       currentTuningAidMaxFreqHz_(0.0f),                //
+      wabufLines_(0),                                  //
+      wabufLineLength_(0),                             //
+      wabufHead_(0),                                   //
+      indexLutPalette_(0xFF),                          //
+      tracesPrimed_(false),                            //
+      lastTraceMs_(0),                                 //
+      traceDecayRemainder_(0),                         //
+      binMap_(),                                       //
       isMutedDrawn(false) {
 
     maxDisplayFrequencyHz_ = radioMode_ == RadioMode::AM ? SpectrumVisualizationComponent::MAX_DISPLAY_FREQUENCY_AM : SpectrumVisualizationComponent::MAX_DISPLAY_FREQUENCY_FM;
@@ -79,11 +109,6 @@ SpectrumVisualizationComponent::SpectrumVisualizationComponent(int x, int y, int
         frameMaxHistory_[i] = 0.0f;
     }
 
-    // Waterfall buffer inicializálása
-    if (bounds.height > 0 && bounds.width > 0) {
-        wabuf.resize(bounds.height, std::vector<uint8_t>(bounds.width, 0));
-    }
-
     // Sprite inicializálása
     sprite_ = new TFT_eSprite(&tft);
 
@@ -98,7 +123,12 @@ SpectrumVisualizationComponent::SpectrumVisualizationComponent(int x, int y, int
  * @brief Destruktor
  */
 SpectrumVisualizationComponent::~SpectrumVisualizationComponent() {
+    // A minta-alapú dekóderek (PSK, CW skimmer, NAVTEX) ne fussanak tovább a komponens nélkül
+    if (currentMode_ == DisplayMode::PSKWaterfall || currentMode_ == DisplayMode::CWSkimmer || currentMode_ == DisplayMode::NAVTEXWaterfall) {
+        AudioCore1Manager::setSampleDecoder(nullptr);
+    }
     if (sprite_) {
+        TftDmaManager::cancel(sprite_);
         sprite_->deleteSprite();
         delete sprite_;
         sprite_ = nullptr;
@@ -202,7 +232,7 @@ bool SpectrumVisualizationComponent::isAutoGainMode() {
  * @brief Config értékek konvertálása
  */
 SpectrumVisualizationComponent::DisplayMode SpectrumVisualizationComponent::configValueToDisplayMode(uint8_t configValue) {
-    if (configValue <= static_cast<uint8_t>(DisplayMode::RTTYWaterfall)) {
+    if (configValue <= static_cast<uint8_t>(DisplayMode::NAVTEXWaterfall)) {
         return static_cast<DisplayMode>(configValue);
     }
     return DisplayMode::Off;
@@ -278,8 +308,8 @@ void SpectrumVisualizationComponent::draw() {
         return;
     }
 
-    // Biztonsági ellenőrzés: FM módban CW/RTTY módok nem engedélyezettek
-    if (radioMode_ == RadioMode::FM && (currentMode_ == DisplayMode::CWWaterfall || currentMode_ == DisplayMode::RTTYWaterfall)) {
+    // Biztonsági ellenőrzés: FM módban a dekóder/hangolássegéd módok nem engedélyezettek
+    if (radioMode_ == RadioMode::FM && isTuningAidMode(currentMode_)) {
         currentMode_ = DisplayMode::Waterfall; // Automatikus váltás Waterfall módra
     }
 
@@ -312,6 +342,9 @@ void SpectrumVisualizationComponent::draw() {
 
         case DisplayMode::CWWaterfall:
         case DisplayMode::RTTYWaterfall:
+        case DisplayMode::PSKWaterfall:
+        case DisplayMode::CWSkimmer:
+        case DisplayMode::NAVTEXWaterfall:
             renderCwOrRttyTuningAid();
             break;
     }
@@ -351,6 +384,31 @@ void SpectrumVisualizationComponent::draw() {
  * @brief Touch kezelés
  */
 bool SpectrumVisualizationComponent::handleTouch(const TouchEvent &touch) {
+
+    // PSK/NAVTEX módban a rövid érintés a vivőt választja ki, CW módban auto zero-beat-et indít, a hosszú érintés vált módot
+    bool tapHasAction = (currentMode_ == DisplayMode::PSKWaterfall) || (currentMode_ == DisplayMode::NAVTEXWaterfall) || (currentMode_ == DisplayMode::CWWaterfall && cwZeroBeatCallback_);
+    if (tapHasAction) {
+        if (touch.pressed && isPointInside(touch.x, touch.y)) {
+            lastTouchTime_ = millis();
+            tapTouchPending_ = true;
+            return true;
+        }
+        if (!touch.pressed && tapTouchPending_) {
+            tapTouchPending_ = false;
+            if (millis() - lastTouchTime_ >= FftDisplayConstants::TUNING_AID_LONG_PRESS_MS) {
+                cycleThroughModes();
+            } else if (currentMode_ == DisplayMode::PSKWaterfall) {
+                selectPskCarrierAt(touch.x);
+            } else if (currentMode_ == DisplayMode::NAVTEXWaterfall) {
+                selectNavtexCenterAt(touch.x);
+            } else {
+                cwZeroBeatCallback_();
+            }
+            return true;
+        }
+        return false;
+    }
+
     if (touch.pressed && isPointInside(touch.x, touch.y)) {
         lastTouchTime_ = millis();
         cycleThroughModes();
@@ -359,6 +417,58 @@ bool SpectrumVisualizationComponent::handleTouch(const TouchEvent &touch) {
     return false;
 }
 
+/**
+ * @brief A hangolássegéd egy X koordinátájához tartozó hangfrekvencia
+ * @param touchX Az érintés X koordinátája (képernyő)
+ * @return A frekvencia Hz-ben, 0 ha a hangolássegéd tartománya érvénytelen
+ */
+uint16_t SpectrumVisualizationComponent::tuningAidFrequencyAt(uint16_t touchX) const {
+
+    if (bounds.width <= 1 || currentTuningAidMaxFreqHz_ <= currentTuningAidMinFreqHz_) {
+        return 0;
+    }
+
+    int16_t c = constrain(static_cast<int16_t>(touchX) - bounds.x, 0, bounds.width - 1);
+    float ratio = static_cast<float>(c) / (bounds.width - 1);
+    return currentTuningAidMinFreqHz_ + static_cast<uint16_t>(std::round(ratio * (currentTuningAidMaxFreqHz_ - currentTuningAidMinFreqHz_)));
+}
+
+/**
+ * @brief PSK vivő kiválasztása a waterfall egy pontjának érintésével
+ * @param touchX Az érintés X koordinátája (képernyő)
+ */
+void SpectrumVisualizationComponent::selectPskCarrierAt(uint16_t touchX) {
+
+    Psk31Decoder *decoder = AudioCore1Manager::getPsk31Decoder();
+    uint16_t frequencyHz = tuningAidFrequencyAt(touchX);
+    if (!decoder || frequencyHz == 0) {
+        return;
+    }
+    frequencyHz = constrain(frequencyHz, Psk31Constants::MIN_CARRIER_FREQUENCY_HZ, Psk31Constants::MAX_CARRIER_FREQUENCY_HZ);
+
+    decoder->setCarrierFrequency(frequencyHz);
+    config.data.pskCarrierFrequencyHz = frequencyHz;
+    DEBUG("SpectrumVisualizationComponent: PSK vivő kiválasztva: %u Hz\n", frequencyHz);
+}
+
+/**
+ * @brief NAVTEX mark/space középfrekvencia kiválasztása a waterfall egy pontjának érintésével
+ * @param touchX Az érintés X koordinátája (képernyő)
+ */
+void SpectrumVisualizationComponent::selectNavtexCenterAt(uint16_t touchX) {
+
+    NavtexDecoder *decoder = AudioCore1Manager::getNavtexDecoder();
+    uint16_t frequencyHz = tuningAidFrequencyAt(touchX);
+    if (!decoder || frequencyHz == 0) {
+        return;
+    }
+    frequencyHz = constrain(frequencyHz, NavtexConstants::MIN_CENTER_FREQUENCY_HZ, NavtexConstants::MAX_CENTER_FREQUENCY_HZ);
+
+    decoder->setCenterFrequency(frequencyHz);
+    config.data.navtexCenterFrequencyHz = frequencyHz;
+    DEBUG("SpectrumVisualizationComponent: NAVTEX középfrekvencia kiválasztva: %u Hz\n", frequencyHz);
+}
+
 /**
  * @brief Keret rajzolása
  */
@@ -379,16 +489,21 @@ void SpectrumVisualizationComponent::drawFrame() {
  */
 void SpectrumVisualizationComponent::manageSpriteForMode(DisplayMode modeToPrepareFor) {
 
-    if (spriteCreated_) { // Ha létezik sprite egy korábbi módból
+    // Ugyanahhoz a módhoz, változatlan méretben már kész a sprite: megmarad (az indexelt waterfall előzménye is)
+    int graphH = getGraphHeight();
+    bool keepSprite = spriteCreated_ && spriteMode_ == modeToPrepareFor && sprite_->width() == bounds.width && sprite_->height() == graphH;
+
+    if (spriteCreated_ && !keepSprite) { // Ha létezik sprite egy korábbi módból
+        TftDmaManager::cancel(sprite_);
         sprite_->deleteSprite();
         spriteCreated_ = false;
     }
 
     // Sprite használata MINDEN módhoz (kivéve Off)
-    if (modeToPrepareFor != DisplayMode::Off) {
-        int graphH = getGraphHeight();
+    if (modeToPrepareFor != DisplayMode::Off && !keepSprite) {
+        spriteMode_ = modeToPrepareFor;
         if (bounds.width > 0 && graphH > 0) {
-            sprite_->setColorDepth(16); // RGB565
+            sprite_->setColorDepth(usesIndexedSprite(modeToPrepareFor) ? 8 : 16); // Indexelt vagy RGB565
             spriteCreated_ = sprite_->createSprite(bounds.width, graphH);
             if (spriteCreated_) {
                 sprite_->fillSprite(TFT_BLACK); // Kezdeti törlés
@@ -398,6 +513,14 @@ void SpectrumVisualizationComponent::manageSpriteForMode(DisplayMode modeToPrepa
         }
     }
 
+    // A waterfall gyűrűpuffer méretezése az új módhoz (csak méretváltozáskor foglal újra, üres előzménnyel)
+    resizeWaterfallBuffer(modeToPrepareFor);
+    resizeTraces(modeToPrepareFor);
+
+    // dB skála: egy keret egységeinek helye (a legtöbb egység a szélesség vagy a magasság), a zajszint újrabecslése
+    dbSlots_.assign(std::max(bounds.width, bounds.height), 0);
+    dbScale_.reset();
+
     // Teljes terület törlése mód váltáskor az előző grafikon eltávolításához
     if (modeToPrepareFor != lastRenderedMode_) {
 
@@ -412,13 +535,9 @@ void SpectrumVisualizationComponent::manageSpriteForMode(DisplayMode modeToPrepa
             sprite_->fillSprite(TFT_BLACK);
         }
 
-        // Envelope reset mód váltáskor
+        // Envelope reset mód váltáskor (a wabuf már üres, így tiszta vonallal kezdődik az envelope)
         if (modeToPrepareFor == DisplayMode::Envelope) {
             envelopeLastSmoothedValue_ = 0.0f; // Simított érték nullázása
-            // Wabuf buffer teljes törlése hogy tiszta vonallal kezdődjön az envelope
-            for (auto &row : wabuf) {
-                std::fill(row.begin(), row.end(), 0);
-            }
         }
     }
 }
@@ -442,6 +561,234 @@ int SpectrumVisualizationComponent::getEffectiveHeight() const {
     return bounds.height + getIndicatorHeight(); // Keret + indicator alatta
 }
 
+/**
+ * @brief A waterfall gyűrűpuffer méretezése a módhoz
+ * @details Csak az Envelope használja: bounds.width időoszlop, egyenként bounds.height amplitúdó értékkel.
+ *          A Waterfall és a hangolási segéd előzménye maga az indexelt sprite, a többi mód sem használja, ott a memória felszabadul.
+ * @param mode Az a mód, amelyhez a puffert elő kell készíteni
+ */
+void SpectrumVisualizationComponent::resizeWaterfallBuffer(DisplayMode mode) {
+    uint16_t lines = 0;
+    uint16_t lineLength = 0;
+    if (bounds.width > 0 && bounds.height > 0 && mode == DisplayMode::Envelope) {
+        lines = bounds.width;
+        lineLength = bounds.height;
+    }
+
+    // Változatlan méretnél az előzmény megmarad (a sprite újrakezelése nem törli a waterfallt)
+    if (lines == wabufLines_ && lineLength == wabufLineLength_ && wabuf.size() == static_cast<size_t>(lines) * lineLength) {
+        return;
+    }
+
+    wabufLines_ = lines;
+    wabufLineLength_ = lineLength;
+    wabufHead_ = 0;
+    if (lines == 0) {
+        std::vector<uint8_t>().swap(wabuf);
+        return;
+    }
+    wabuf.assign(static_cast<size_t>(lines) * lineLength, 0);
+}
+
+/**
+ * @brief A waterfall előzmény törlése (a méret marad)
+ * @details Indexelt sprite-nál az előzmény maga a sprite, a fekete a 0. index
+ */
+void SpectrumVisualizationComponent::clearWaterfallBuffer() {
+    std::fill(wabuf.begin(), wabuf.end(), 0);
+    wabufHead_ = 0;
+    if (spriteCreated_ && sprite_->getColorDepth() == 8) {
+        sprite_->fillSprite(TFT_BLACK);
+    }
+}
+
+/**
+ * @brief Indexelt (8 bites) sprite-ot használ-e a mód
+ * @details A Waterfall és a hangolási segéd képpontja egy intenzitás index, a kirakáskor a színtábla bővíti RGB565-re
+ */
+bool SpectrumVisualizationComponent::usesIndexedSprite(DisplayMode mode) { return mode == DisplayMode::Waterfall || isTuningAidMode(mode); }
+
+/**
+ * @brief Az indexelt sprite színtáblájának felépítése, ha a paletta változott
+ * @details 0..OVERLAY_FIRST_INDEX-1: a paletta egyenletesen mintavételezve, felette a jelölők színei.
+ *          A tábla kijelző bájtsorrendű, így a DMA puffer bővítése csak egy táblaolvasás képpontonként.
+ */
+void SpectrumVisualizationComponent::updateIndexLut() {
+    using namespace IndexedSpriteConstants;
+    if (indexLutPalette_ == config.data.waterfallPalette) {
+        return;
+    }
+    indexLutPalette_ = config.data.waterfallPalette;
+
+    const uint16_t *palette = WaterfallPalette::get(indexLutPalette_);
+    for (uint16_t i = 0; i < 256; i++) {
+        uint16_t color = i < OVERLAY_FIRST_INDEX ? palette[i * 255 / (OVERLAY_FIRST_INDEX - 1)] : OVERLAY_COLORS[i - OVERLAY_FIRST_INDEX];
+        indexLut_[i] = static_cast<uint16_t>((color >> 8) | (color << 8));
+    }
+}
+
+/**
+ * @brief A sprite rajzoló függvényeinek átadandó szín
+ * @details Indexelt sprite-nál a jelölő szín fenntartott indexe RGB565 alakban (a sprite RGB332-re alakítva pont ezt az indexet tárolja),
+ *          a táblában nem szereplő szín a legközelebbi, a jelölők közül a fehér. 16 bites sprite-nál maga a szín.
+ */
+uint16_t SpectrumVisualizationComponent::spriteColor(uint16_t color) const {
+    using namespace IndexedSpriteConstants;
+    if (sprite_->getColorDepth() != 8) {
+        return color;
+    }
+    uint8_t index = OVERLAY_FIRST_INDEX + 1; // TFT_WHITE
+    for (uint8_t i = 0; i < sizeof(OVERLAY_COLORS) / sizeof(OVERLAY_COLORS[0]); i++) {
+        if (OVERLAY_COLORS[i] == color) {
+            index = OVERLAY_FIRST_INDEX + i;
+            break;
+        }
+    }
+    return tft.color8to16(index);
+}
+
+/**
+ * @brief A sprite kirakásának előjegyzése (indexelt sprite-nál a színtáblával)
+ */
+void SpectrumVisualizationComponent::queueSpritePush() {
+    if (sprite_->getColorDepth() == 8) {
+        updateIndexLut();
+        TftDmaManager::queueSprite(sprite_, bounds.x, bounds.y, indexLut_);
+    } else {
+        TftDmaManager::queueSprite(sprite_, bounds.x, bounds.y);
+    }
+}
+
+/**
+ * @brief Új sor a gyűrűpufferbe: a fej léptetése, a legrégebbi sor felülírható
+ * @return A kitöltendő új sor (wabufLineLength_ bájt)
+ */
+uint8_t *SpectrumVisualizationComponent::pushWaterfallLine() {
+    if (++wabufHead_ >= wabufLines_) {
+        wabufHead_ = 0;
+    }
+    return &wabuf[static_cast<size_t>(wabufHead_) * wabufLineLength_];
+}
+
+/**
+ * @brief Egy korábbi sor a gyűrűpufferből
+ * @param age A sor kora (0: a legújabb, wabufLines_ - 1: a legrégebbi)
+ */
+const uint8_t *SpectrumVisualizationComponent::getWaterfallLine(uint16_t age) const {
+    uint16_t line = wabufHead_ >= age ? wabufHead_ - age : wabufHead_ + wabufLines_ - age;
+    return &wabuf[static_cast<size_t>(line) * wabufLineLength_];
+}
+
+/**
+ * @brief A spektrum nyomvonalak méretezése a módhoz
+ * @details Csak a SpectrumHighRes használja (képpontonként egy érték), a többi módban a memória felszabadul.
+ *          A renderelés keretenként már nem foglal, csak ezeket a tömböket frissíti.
+ */
+void SpectrumVisualizationComponent::resizeTraces(DisplayMode mode) {
+    tracesPrimed_ = false;
+    traceDecayRemainder_ = 0;
+    if (mode != DisplayMode::SpectrumHighRes || bounds.width == 0) {
+        std::vector<uint8_t>().swap(tracePeak_);
+        std::vector<uint8_t>().swap(traceMin_);
+        std::vector<uint16_t>().swap(traceAvg_);
+        return;
+    }
+    tracePeak_.assign(bounds.width, 0);
+    traceMin_.assign(bounds.width, 0);
+    traceAvg_.assign(bounds.width, 0);
+}
+
+/**
+ * @brief A keret nyomvonal lépéseinek számítása az előző keret óta eltelt időből
+ * @details Átlag: alpha = dt / (tau + dt), így az időállandó az FPS-től független.
+ *          Lecsengés: tracePeakDecayDbPerSec * dt, a töredék a következő keretre marad.
+ */
+SpectrumVisualizationComponent::TraceFrameStep SpectrumVisualizationComponent::beginTraceFrame() {
+    const uint32_t now = millis();
+    const uint32_t dt = tracesPrimed_ ? std::min(now - lastTraceMs_, TraceConstants::MAX_FRAME_GAP_MS) : 0;
+    lastTraceMs_ = now;
+
+    TraceFrameStep step;
+    step.prime = !tracesPrimed_;
+    tracesPrimed_ = true;
+
+    const uint32_t tau = std::max<uint32_t>(1, config.data.traceAverageMs);
+    step.avgAlphaQ8 = static_cast<uint16_t>(std::max<uint32_t>(1, dt * 256 / (tau + dt)));
+
+    traceDecayRemainder_ += static_cast<uint32_t>(config.data.tracePeakDecayDbPerSec * TraceConstants::UNITS_PER_DB) * dt;
+    step.decayUnits = static_cast<uint8_t>(std::min<uint32_t>(255, traceDecayRemainder_ / 1000));
+    traceDecayRemainder_ %= 1000;
+    return step;
+}
+
+/**
+ * @brief Egy képpont nyomvonalainak frissítése
+ * @param slot A képpont indexe
+ * @param traceDb A pillanatnyi érték dB egységben (SpectrumDbScale::toUnits)
+ * @param step A keret lépései (beginTraceFrame)
+ */
+void SpectrumVisualizationComponent::updateTraceSlot(uint16_t slot, uint8_t traceDb, const TraceFrameStep &step) {
+    if (step.prime) {
+        traceAvg_[slot] = static_cast<uint16_t>(traceDb) << 8;
+        tracePeak_[slot] = traceDb;
+        traceMin_[slot] = traceDb;
+        return;
+    }
+
+    const int32_t avgDiff = (static_cast<int32_t>(traceDb) << 8) - traceAvg_[slot];
+    traceAvg_[slot] = static_cast<uint16_t>(traceAvg_[slot] + ((avgDiff * step.avgAlphaQ8) >> 8));
+
+    const uint8_t decayedPeak = tracePeak_[slot] > step.decayUnits ? tracePeak_[slot] - step.decayUnits : 0;
+    tracePeak_[slot] = std::max(traceDb, decayedPeak);
+
+    const uint8_t releasedMin = traceMin_[slot] < 255 - step.decayUnits ? traceMin_[slot] + step.decayUnits : 255;
+    traceMin_[slot] = std::min(traceDb, releasedMin);
+}
+
+/**
+ * @brief A bekapcsolt nyomvonalak kirajzolása egy képpont oszlopba, az előző oszlophoz kötve
+ * @param slot A képpont oszlop
+ * @param graphH A grafikon magassága
+ * @param adaptiveScale A bar-ok skálája lineáris skálán (dB skálán a nyomvonal a dB ablakban jelenik meg)
+ * @param traceMask A megjelenítendő nyomvonalak (SpectrumTraceFlags)
+ * @param prevY Nyomvonalanként az előző oszlop Y koordinátája
+ */
+void SpectrumVisualizationComponent::drawTraceOverlays(uint16_t slot, int graphH, float adaptiveScale, uint8_t traceMask, int16_t (&prevY)[3]) {
+    const uint8_t traceDb[3] = {static_cast<uint8_t>(traceAvg_[slot] >> 8), tracePeak_[slot], traceMin_[slot]};
+    constexpr uint8_t flags[3] = {SpectrumTraceFlags::AVERAGE, SpectrumTraceFlags::PEAK, SpectrumTraceFlags::MIN};
+    constexpr uint16_t colors[3] = {TraceConstants::AVERAGE_COLOR, TraceConstants::PEAK_COLOR, TraceConstants::MIN_COLOR};
+
+    for (uint8_t t = 0; t < 3; t++) {
+        if (!(traceMask & flags[t])) {
+            continue;
+        }
+        const int height = config.data.spectrumLogScale ? dbScale_.toLevel(traceDb[t], graphH - 1) : constrain(static_cast<int>(dbScale_.toMagnitude(traceDb[t]) * adaptiveScale), 0, graphH - 1);
+        const int16_t y = graphH - 1 - height;
+        if (slot == 0) {
+            sprite_->drawPixel(slot, y, colors[t]);
+        } else {
+            sprite_->drawLine(slot - 1, prevY[t], slot, y, colors[t]);
+        }
+        prevY[t] = y;
+    }
+}
+
+/**
+ * @brief A keret kijelző egységeinek dB értéke a dbSlots_ pufferbe, majd a zajszint és az ablak frissítése
+ * @param magnitudeData A magnitúdó spektrum (a bin leképező tábla már a slots egységre áll)
+ * @param slots A kijelző egységek száma
+ * @param fftSize Az FFT mérete
+ * @param inputGain A core1 által az FFT bemenetére alkalmazott erősítés (a dBFS skála visszaosztja)
+ */
+void SpectrumVisualizationComponent::computeDbSlots(const float *magnitudeData, uint16_t slots, uint16_t fftSize, float inputGain) {
+    slots = std::min<uint16_t>(slots, dbSlots_.size());
+    dbScale_.beginFrame(fftSize, inputGain);
+    for (uint16_t i = 0; i < slots; i++) {
+        dbSlots_[i] = dbScale_.toUnits(binMap_.aggregate(magnitudeData, i));
+    }
+    dbScale_.updateNoiseFloor(dbSlots_.data(), slots);
+}
+
 /**
  * @brief FFT paraméterek beállítása az aktuális módhoz
  */
@@ -451,6 +798,26 @@ void SpectrumVisualizationComponent::setFftParametersForDisplayMode() {
     // Core1 AudioManager használatával FFT méret beállítása
     if (AudioCore1Manager::isRunning()) {
 
+        // PSK, CW skimmer és NAVTEX módban a minta-alapú dekóder fut a core1-en, minden más módban kikapcsoljuk
+        // (az Off mód szüneteltetése előtt, hogy a folyamatos mintavételezés se fusson feleslegesen)
+        if (currentMode_ == DisplayMode::PSKWaterfall) {
+            Psk31Decoder *decoder = AudioCore1Manager::getPsk31Decoder();
+            if (decoder) {
+                decoder->setCarrierFrequency(config.data.pskCarrierFrequencyHz);
+            }
+            AudioCore1Manager::setSampleDecoder(decoder);
+        } else if (currentMode_ == DisplayMode::CWSkimmer) {
+            AudioCore1Manager::setSampleDecoder(AudioCore1Manager::getCwSkimmer());
+        } else if (currentMode_ == DisplayMode::NAVTEXWaterfall) {
+            NavtexDecoder *decoder = AudioCore1Manager::getNavtexDecoder();
+            if (decoder) {
+                decoder->setCenterFrequency(config.data.navtexCenterFrequencyHz);
+            }
+            AudioCore1Manager::setSampleDecoder(decoder);
+        } else {
+            AudioCore1Manager::setSampleDecoder(nullptr);
+        }
+
         { // FFT méret beállítása
             uint16_t optimalFftSize = getOptimalFftSizeForMode(currentMode_);
 
@@ -482,6 +849,12 @@ void SpectrumVisualizationComponent::setFftParametersForDisplayMode() {
         } else if (currentMode_ == DisplayMode::RTTYWaterfall) {
             // RTTY waterfall esetén a CW dekóder nem szükséges
             setTuningAidType(TuningAidType::RTTY_TUNING);
+        } else if (currentMode_ == DisplayMode::PSKWaterfall) {
+            setTuningAidType(TuningAidType::PSK_TUNING);
+        } else if (currentMode_ == DisplayMode::CWSkimmer) {
+            setTuningAidType(TuningAidType::CW_SKIMMER_TUNING);
+        } else if (currentMode_ == DisplayMode::NAVTEXWaterfall) {
+            setTuningAidType(TuningAidType::NAVTEX_TUNING);
         }
     } else {
         // Ha nem fut a Core1, akkor is beállítjuk a típust, hogy a UI konzisztens maradjon
@@ -498,7 +871,7 @@ void SpectrumVisualizationComponent::cycleThroughModes() {
 
     int nextMode = static_cast<int>(currentMode_) + 1;
 
-    // FM módban kihagyjuk a CW és RTTY hangolási segéd módokat
+    // FM módban kihagyjuk a CW, RTTY, PSK, skimmer és NAVTEX hangolási segéd módokat
     if (radioMode_ == RadioMode::FM) {
         if (nextMode == static_cast<int>(DisplayMode::CWWaterfall)) {
             nextMode = static_cast<int>(DisplayMode::Off); // Ugrás az Off módra, mert FM-en nincs CW
@@ -509,7 +882,7 @@ void SpectrumVisualizationComponent::cycleThroughModes() {
         }
     } else {
         // AM módban minden mód elérhető
-        if (nextMode > static_cast<int>(DisplayMode::RTTYWaterfall)) {
+        if (nextMode > static_cast<int>(DisplayMode::NAVTEXWaterfall)) {
             nextMode = static_cast<int>(DisplayMode::Off);
         }
     }
@@ -552,8 +925,8 @@ void SpectrumVisualizationComponent::loadModeFromConfig() {
     uint8_t configValue = (radioMode_ == RadioMode::AM) ? config.data.audioModeAM : config.data.audioModeFM;
     DisplayMode configMode = configValueToDisplayMode(configValue);
 
-    // FM módban CW/RTTY módok nem engedélyezettek
-    if (radioMode_ == RadioMode::FM && (configMode == DisplayMode::CWWaterfall || configMode == DisplayMode::RTTYWaterfall)) {
+    // FM módban a dekóder/hangolássegéd módok nem engedélyezettek
+    if (radioMode_ == RadioMode::FM && isTuningAidMode(configMode)) {
         configMode = DisplayMode::Waterfall; // Alapértelmezés FM módban
     }
 
@@ -583,8 +956,8 @@ void SpectrumVisualizationComponent::setModeIndicatorVisible(bool visible) {
  * @brief Ellenőrzi, hogy egy megjelenítési mód elérhető-e az aktuális rádió módban
  */
 bool SpectrumVisualizationComponent::isModeAvailable(DisplayMode mode) const {
-    // FM módban CW és RTTY hangolási segéd módok nem elérhetők
-    if (radioMode_ == RadioMode::FM && (mode == DisplayMode::CWWaterfall || mode == DisplayMode::RTTYWaterfall)) {
+    // FM módban a dekóder/hangolássegéd módok nem elérhetők
+    if (radioMode_ == RadioMode::FM && isTuningAidMode(mode)) {
         return false;
     }
 
@@ -672,13 +1045,12 @@ void SpectrumVisualizationComponent::renderSpectrumLowRes() {
     // Ha nincs friss adat vagy nincs magnitude adat, ne rajzoljunk újra (megelőzzük a villogást)
     if (!dataAvailable || !magnitudeData || currentBinWidthHz == 0) {
         // Csak a sprite kirakása a korábbi tartalommal
-        sprite_->pushSprite(bounds.x, bounds.y);
+        queueSpritePush();
         return;
     }
 
-    const int min_bin_idx_low_res = std::max(2, static_cast<int>(std::round(AnalyzerConstants::ANALYZER_MIN_FREQ_HZ / currentBinWidthHz)));
-    const int max_bin_idx_low_res = std::min(static_cast<int>(actualFftSize / 2 - 1), static_cast<int>(std::round(maxDisplayFrequencyHz_ / currentBinWidthHz)));
-    const int num_bins_in_low_res_range = std::max(1, max_bin_idx_low_res - min_bin_idx_low_res + 1);
+    // Sávonként a hozzá tartozó binek maximuma (a tábla csak paraméter változáskor épül újra)
+    binMap_.update(LOW_RES_BANDS, AnalyzerConstants::ANALYZER_MIN_FREQ_HZ, maxDisplayFrequencyHz_, 2, actualFftSize, currentBinWidthHz, BinAggregation::Max);
 
     // Adaptív autogain használata
     float adaptiveScale = getAdaptiveScale(SensitivityConstants::AMPLITUDE_SCALE);
@@ -689,22 +1061,20 @@ void SpectrumVisualizationComponent::renderSpectrumLowRes() {
     float band_magnitudes[LOW_RES_BANDS] = {0.0f};
 
     // magnitudeData már garantáltan nem nullptr itt
-    for (int i = min_bin_idx_low_res; i <= max_bin_idx_low_res; i++) {
-        uint8_t band_idx = getBandVal(i, min_bin_idx_low_res, num_bins_in_low_res_range, LOW_RES_BANDS);
-        if (band_idx < LOW_RES_BANDS) {
-            float magnitude = magnitudeData[i];
-
-            // DEBUG: Magnitude értékek kiírása (csak néhány bin-re a spam elkerülése végett)
-            // if (i % 10 == 0) {
-            //     DEBUG("LowRes magnitude[%d]: %s (threshold: %s)\n", i, Utils::floatToString(magnitude, 6).c_str(), Utils::floatToString(NOISE_THRESHOLD, 6).c_str());
-            // }
+    for (int band_idx = 0; band_idx < LOW_RES_BANDS; band_idx++) {
+        float magnitude = binMap_.aggregate(magnitudeData, band_idx);
 
-            // Zajküszöb alkalmazása
-            if (magnitude < NOISE_THRESHOLD) {
-                magnitude = 0.0f;
-            }
-            band_magnitudes[band_idx] = std::max(band_magnitudes[band_idx], magnitude);
+        // Zajküszöb alkalmazása
+        if (magnitude < NOISE_THRESHOLD) {
+            magnitude = 0.0f;
         }
+        band_magnitudes[band_idx] = magnitude;
+    }
+
+    // dB skála: sávonként dB érték, a zajszint a sávok alsó percentilise
+    const bool logScale = config.data.spectrumLogScale;
+    if (logScale) {
+        computeDbSlots(magnitudeData, LOW_RES_BANDS, actualFftSize, currentAutoGain);
     }
 
     // Legnagyobb érték megkeresése az adaptív autogain számára
@@ -722,7 +1092,7 @@ void SpectrumVisualizationComponent::renderSpectrumLowRes() {
 
         // Adaptív magnitúdó skálázás - egységes logika: nagyobb scale = nagyobb érzékenység
         float magnitude = band_magnitudes[band_idx];
-        int dsize = static_cast<int>(magnitude * adaptiveScale);
+        int dsize = logScale ? dbScale_.toLevel(dbSlots_[band_idx], actual_low_res_peak_max_height) : static_cast<int>(magnitude * adaptiveScale);
         dsize = constrain(dsize, 0, actual_low_res_peak_max_height);
 
         if (dsize > Rpeak_[band_idx] && band_idx < MAX_SPECTRUM_BANDS) {
@@ -751,10 +1121,12 @@ void SpectrumVisualizationComponent::renderSpectrumLowRes() {
     }
 
     // Adaptív autogain frissítése
-    updateFrameBasedGain(maxMagnitude);
+    if (!logScale) {
+        updateFrameBasedGain(maxMagnitude);
+    }
 
     // Sprite kirakása a képernyőre
-    sprite_->pushSprite(bounds.x, bounds.y);
+    queueSpritePush();
 
     // Frekvencia feliratok rajzolása, ha még nem történt meg
     renderFrequencyLabels(AnalyzerConstants::ANALYZER_MIN_FREQ_HZ, maxDisplayFrequencyHz_);
@@ -787,52 +1159,78 @@ void SpectrumVisualizationComponent::renderSpectrumHighRes() {
     // Ha nincs friss adat vagy nincs magnitude adat, ne rajzoljunk újra (megelőzzük a villogást)
     if (!dataAvailable || !magnitudeData || currentBinWidthHz == 0) {
         // Csak a sprite kirakása a korábbi tartalommal
-        sprite_->pushSprite(bounds.x, bounds.y);
+        queueSpritePush();
         return;
     }
 
-    // Use Nyquist frequency for mapping
-    const int min_bin_idx_for_display = std::max(2, static_cast<int>(std::round(AnalyzerConstants::ANALYZER_MIN_FREQ_HZ / currentBinWidthHz)));
-    const int max_bin_idx_for_display = static_cast<int>(actualFftSize / 2 - 1);
-    const int num_bins_in_display_range = std::max(1, max_bin_idx_for_display - min_bin_idx_for_display + 1);
+    // A teljes tartomány a Nyquist frekvenciáig, képpontonként a binek maximuma
+    binMap_.update(bounds.width, AnalyzerConstants::ANALYZER_MIN_FREQ_HZ, currentBinWidthHz * actualFftSize / 2, 2, actualFftSize, currentBinWidthHz, BinAggregation::Max);
 
-    // Adaptív autogain használata
+    // Adaptív autogain használata (csak lineáris skálán)
+    const bool logScale = config.data.spectrumLogScale;
     float adaptiveScale = getAdaptiveScale(SensitivityConstants::AMPLITUDE_SCALE);
     float maxMagnitude = 0.0f;
 
     // Zajküszöb - alacsony szintű zajt nullázza
     constexpr float NOISE_THRESHOLD = 0.003f; // Experimentális érték, finomhangolható
 
-    for (int screen_pixel_x = 0; screen_pixel_x < bounds.width; ++screen_pixel_x) {
-        int fft_bin_index;
-        if (bounds.width == 1) {
-            fft_bin_index = min_bin_idx_for_display;
-        } else {
-            float ratio = static_cast<float>(screen_pixel_x) / (bounds.width - 1);
-            fft_bin_index = min_bin_idx_for_display + static_cast<int>(std::round(ratio * (num_bins_in_display_range - 1)));
-        }
-        fft_bin_index = constrain(fft_bin_index, 0, static_cast<int>(actualFftSize / 2 - 1));
+    // Nyomvonalak: a keret lépései egyszer, utána képpontonként O(1)
+    const uint8_t traceMask = traceAvg_.size() == static_cast<size_t>(bounds.width) ? (config.data.spectrumTraces & SpectrumTraceFlags::ALL) : 0;
+    TraceFrameStep traceStep = {};
+    int16_t prevTraceY[3] = {0, 0, 0};
+    if (traceMask) {
+        traceStep = beginTraceFrame();
+    } else {
+        tracesPrimed_ = false; // Bekapcsoláskor a pillanatnyi spektrumról induljanak
+    }
 
-        float magnitude = magnitudeData[fft_bin_index];
+    // dB értékek (a dB skálához és a nyomvonalakhoz), zajszint és ablak
+    if (logScale || traceMask) {
+        computeDbSlots(magnitudeData, bounds.width, actualFftSize, currentAutoGain);
+    }
 
-        // DEBUG: Magnitude értékek kiírása (csak néhány oszlopra a spam elkerülése végett)
-        // if (screen_pixel_x % 20 == 0) {
-        //     DEBUG("HighRes magnitude[%d]: %s (threshold: %s)\n", fft_bin_index, Utils::floatToString(magnitude, 6).c_str(), Utils::floatToString(NOISE_THRESHOLD, 6).c_str());
-        // }
+    // dB rács: a vonalak sora keretenként egyszer, oszloponként csak képpontok
+    constexpr uint8_t MAX_GRID_LINES = 16;
+    int16_t gridY[MAX_GRID_LINES];
+    int16_t gridDbfs[MAX_GRID_LINES];
+    const uint8_t gridLines = logScale ? dbScale_.getGridLines(graphH - 1, gridY, gridDbfs, MAX_GRID_LINES) : 0;
+    for (uint8_t g = 0; g < gridLines; g++) {
+        gridY[g] = graphH - 1 - gridY[g];
+    }
 
-        // Zajküszöb alkalmazása
-        if (magnitude < NOISE_THRESHOLD) {
-            magnitude = 0.0f;
-        }
+    for (int screen_pixel_x = 0; screen_pixel_x < bounds.width; ++screen_pixel_x) {
 
-        maxMagnitude = std::max(maxMagnitude, static_cast<float>(magnitude));
+        // A nyomvonalak a zajküszöb előtti értéket kapják (a minimum tartás épp a zajszintet mutatja)
+        if (traceMask) {
+            updateTraceSlot(screen_pixel_x, dbSlots_[screen_pixel_x], traceStep);
+        }
 
-        // Előbb töröljük a pixel oszlopot (fekete vonal)
+        // Előbb töröljük a pixel oszlopot (fekete vonal), a rács pontozva (minden második oszlop)
         sprite_->drawFastVLine(screen_pixel_x, 0, graphH, TFT_BLACK);
+        if ((screen_pixel_x & 1) == 0) {
+            for (uint8_t g = 0; g < gridLines; g++) {
+                sprite_->drawPixel(screen_pixel_x, gridY[g], DbScaleConstants::GRID_COLOR);
+            }
+        }
 
-        // Amplitúdó skálázás - adaptív autogain-nel - egységes logika: nagyobb scale = nagyobb érzékenység
-        int scaled_magnitude = static_cast<int>(magnitude * adaptiveScale);
-        scaled_magnitude = constrain(scaled_magnitude, 0, graphH - 1);
+        int scaled_magnitude;
+        if (logScale) {
+            // dB skála: az oszlop magassága a zajszinthez rögzített ablakban
+            scaled_magnitude = dbScale_.toLevel(dbSlots_[screen_pixel_x], graphH - 1);
+        } else {
+            float magnitude = binMap_.aggregate(magnitudeData, screen_pixel_x);
+
+            // Zajküszöb alkalmazása
+            if (magnitude < NOISE_THRESHOLD) {
+                magnitude = 0.0f;
+            }
+
+            maxMagnitude = std::max(maxMagnitude, static_cast<float>(magnitude));
+
+            // Amplitúdó skálázás - adaptív autogain-nel - egységes logika: nagyobb scale = nagyobb érzékenység
+            scaled_magnitude = static_cast<int>(magnitude * adaptiveScale);
+            scaled_magnitude = constrain(scaled_magnitude, 0, graphH - 1);
+        }
 
         if (scaled_magnitude > 0) {
             int y_bar_start = graphH - 1 - scaled_magnitude;
@@ -845,13 +1243,32 @@ void SpectrumVisualizationComponent::renderSpectrumHighRes() {
                 sprite_->drawFastVLine(screen_pixel_x, y_bar_start, bar_actual_height, TFT_SKYBLUE);
             }
         }
+
+        if (traceMask) {
+            drawTraceOverlays(screen_pixel_x, graphH, adaptiveScale, traceMask, prevTraceY);
+        }
+    }
+
+    // dB rács feliratok a bal szélen (ha a vonalak elég ritkák)
+    if (gridLines > 1 && gridY[0] - gridY[1] >= DbScaleConstants::GRID_MIN_SPACING_PX) {
+        sprite_->setFreeFont();
+        sprite_->setTextSize(1);
+        sprite_->setTextDatum(ML_DATUM);
+        sprite_->setTextColor(DbScaleConstants::GRID_LABEL_COLOR);
+        char label[6];
+        for (uint8_t g = 0; g < gridLines; g++) {
+            snprintf(label, sizeof(label), "%d", gridDbfs[g]);
+            sprite_->drawString(label, 1, constrain(gridY[g], 4, graphH - 5));
+        }
     }
 
     // Adaptív autogain frissítése
-    updateFrameBasedGain(maxMagnitude);
+    if (!logScale) {
+        updateFrameBasedGain(maxMagnitude);
+    }
 
     // Sprite kirakása a képernyőre
-    sprite_->pushSprite(bounds.x, bounds.y);
+    queueSpritePush();
 
     // Frekvencia feliratok rajzolása, ha még nem történt meg
     renderFrequencyLabels(AnalyzerConstants::ANALYZER_MIN_FREQ_HZ, maxDisplayFrequencyHz_);
@@ -877,7 +1294,7 @@ void SpectrumVisualizationComponent::renderOscilloscope() {
     bool dataAvailable = getCore1OscilloscopeData(&osciData, &sampleCount);
 
     if (!dataAvailable || !osciData || sampleCount <= 0) {
-        sprite_->pushSprite(bounds.x, bounds.y);
+        queueSpritePush();
         return;
     }
 
@@ -909,7 +1326,7 @@ void SpectrumVisualizationComponent::renderOscilloscope() {
         prev_x = x_pos;
         prev_y = y_pos;
     }
-    sprite_->pushSprite(bounds.x, bounds.y);
+    queueSpritePush();
 }
 
 /**
@@ -919,7 +1336,7 @@ void SpectrumVisualizationComponent::renderEnvelope() {
     // Audio feldolgozás Core1-en történik, AudioCore1Manager-en keresztül
 
     int graphH = getGraphHeight();
-    if (!spriteCreated_ || bounds.width == 0 || graphH <= 0 || wabuf.empty() || wabuf[0].empty()) {
+    if (!spriteCreated_ || bounds.width == 0 || graphH <= 0 || wabuf.empty()) {
         if (!spriteCreated_) {
             DEBUG("SpectrumVisualizationComponent::renderEnvelope - Sprite nincs létrehozva\n");
         }
@@ -937,19 +1354,15 @@ void SpectrumVisualizationComponent::renderEnvelope() {
     if (!dataAvailable || currentBinWidthHz == 0)
         currentBinWidthHz = (AudioProcessorConstants::MAX_SAMPLING_FREQUENCY / AudioProcessorConstants::DEFAULT_FFT_SAMPLES);
 
-    // 1. Adatok eltolása balra a wabuf-ban
-    for (int r = 0; r < bounds.height; ++r) { // Teljes bounds.height
-        for (uint32_t c = 0; c < bounds.width - 1; ++c) {
-            wabuf[r][c] = wabuf[r][c + 1];
-        }
-    }
+    // 1. Új időoszlop a wabuf gyűrűpufferben (a régi oszlopok nem mozdulnak)
+    uint8_t *newColumn = pushWaterfallLine();
 
     // Ennél az értéknél (512 minta -> 40, 64 minta -> 20) nem látszanak a tüskék, ill jól jelenik meg ...
     constexpr uint32_t ENVELOPE_BIN_NMUMBER = 20; // Az envelope-hoz használt bin szám
 
-    const int min_bin_for_env = std::max(10, static_cast<int>(std::round(AnalyzerConstants::ANALYZER_MIN_FREQ_HZ / currentBinWidthHz)));
-    const int max_bin_for_env = std::min(static_cast<int>(actualFftSize / ENVELOPE_BIN_NMUMBER - 1), static_cast<int>(std::round(maxDisplayFrequencyHz_ * 0.2f / currentBinWidthHz)));
-    const int num_bins_in_env_range = std::max(1, max_bin_for_env - min_bin_for_env + 1);
+    // Soronként a binek átlaga (a tüskék ellen), a tábla csak paraméter változáskor épül újra
+    const float maxEnvelopeFreqHz = std::min(maxDisplayFrequencyHz_ * 0.2f, currentBinWidthHz * (actualFftSize / ENVELOPE_BIN_NMUMBER - 1));
+    binMap_.update(bounds.height, AnalyzerConstants::ANALYZER_MIN_FREQ_HZ, maxEnvelopeFreqHz, 10, actualFftSize, currentBinWidthHz, BinAggregation::Mean);
 
     // Frame-alapú adaptív skálázás envelope-hoz
     float adaptiveScale = getAdaptiveScale(SensitivityConstants::ENVELOPE_INPUT_GAIN);
@@ -962,10 +1375,7 @@ void SpectrumVisualizationComponent::renderEnvelope() {
 
     // Minden sort feldolgozunk a teljes felbontásért
     for (uint32_t r = 0; r < bounds.height; ++r) {
-        // 'r' (0 to bounds.height-1) leképezése FFT bin indexre a szűkített tartományon belül
-        int fft_bin_index = min_bin_for_env + static_cast<int>(std::round(static_cast<float>(r) / std::max(1, (bounds.height - 1)) * (num_bins_in_env_range - 1)));
-        fft_bin_index = constrain(fft_bin_index, min_bin_for_env, max_bin_for_env); // Finomabb gain alkalmazás envelope-hez
-        float rawMagnitude = magnitudeData[fft_bin_index];
+        float rawMagnitude = binMap_.aggregate(magnitudeData, r);
 
         // KRITIKUS: Infinity és NaN értékek szűrése!
         if (!isfinite(rawMagnitude) || rawMagnitude < 0.0) {
@@ -983,7 +1393,7 @@ void SpectrumVisualizationComponent::renderEnvelope() {
         maxRawMagnitude = std::max(maxRawMagnitude, static_cast<float>(rawMagnitude));
         maxGainedVal = std::max(maxGainedVal, static_cast<float>(gained_val));
 
-        wabuf[r][bounds.width - 1] = static_cast<uint8_t>(constrain(gained_val, 0.0, 255.0));
+        newColumn[r] = static_cast<uint8_t>(constrain(gained_val, 0.0, 255.0));
     }
 
     // 3. Sprite törlése és burkológörbe kirajzolása
@@ -1002,10 +1412,12 @@ void SpectrumVisualizationComponent::renderEnvelope() {
         int count_val_in_col = 0;
         bool column_has_signal = false;
 
+        // A bal szélső oszlop a legrégebbi, a jobb szélső a legújabb
+        const uint8_t *column = getWaterfallLine(bounds.width - 1 - c);
         for (int r_wabuf = 0; r_wabuf < bounds.height; ++r_wabuf) { // Teljes bounds.height
-            if (wabuf[r_wabuf][c] > ENVELOPE_NOISE_THRESHOLD) {
+            if (column[r_wabuf] > ENVELOPE_NOISE_THRESHOLD) {
                 column_has_signal = true;
-                sum_val_in_col += wabuf[r_wabuf][c];
+                sum_val_in_col += column[r_wabuf];
                 count_val_in_col++;
             }
         }
@@ -1070,7 +1482,7 @@ void SpectrumVisualizationComponent::renderEnvelope() {
         }
     }
 
-    sprite_->pushSprite(bounds.x, bounds.y);
+    queueSpritePush();
 }
 
 /**
@@ -1080,7 +1492,7 @@ void SpectrumVisualizationComponent::renderWaterfall() {
     // Audio feldolgozás Core1-en történik, AudioCore1Manager-en keresztül
 
     int graphH = getGraphHeight();
-    if (!spriteCreated_ || bounds.width == 0 || graphH <= 0 || wabuf.empty() || wabuf[0].empty()) {
+    if (!spriteCreated_ || bounds.width == 0 || graphH <= 0) {
         if (!spriteCreated_) {
             DEBUG("SpectrumVisualizationComponent::renderWaterfall - Sprite nincs létrehozva\n");
         }
@@ -1098,80 +1510,65 @@ void SpectrumVisualizationComponent::renderWaterfall() {
     // Ha nincs friss adat, ne frissítsük a waterfall buffert - megelőzzük a hamis mintákat
     if (!dataAvailable || !magnitudeData || currentBinWidthHz == 0) {
         // Csak a sprite kirakása a korábbi tartalommal
-        sprite_->pushSprite(bounds.x, bounds.y);
+        queueSpritePush();
         return;
     }
 
     // DEBUG("SpectrumVisualizationComponent::renderWaterfall - maxDisplayFrequencyHz_: %d, actualFftSize: %d, currentBinWidthHz: %s\n", //
     //       maxDisplayFrequencyHz_, actualFftSize, Utils::floatToString(currentBinWidthHz).c_str());
 
-    // 1. Adatok eltolása balra a wabuf-ban (ez továbbra is szükséges a wabuf frissítéséhez)
-    for (int r = 0; r < bounds.height; ++r) { // A teljes bounds.height magasságon iterálunk a wabuf miatt
-        for (int c = 0; c < bounds.width - 1; ++c) {
-            wabuf[r][c] = wabuf[r][c + 1];
-        }
-    }
-
-    const int min_bin_for_wf = std::max(2, static_cast<int>(std::round(AnalyzerConstants::ANALYZER_MIN_FREQ_HZ / currentBinWidthHz)));
-    const int max_bin_for_wf = std::min(static_cast<int>(actualFftSize / 2 - 1), static_cast<int>(std::round(maxDisplayFrequencyHz_ / currentBinWidthHz)));
-    const int num_bins_in_wf_range = std::max(1, max_bin_for_wf - min_bin_for_wf + 1);
+    // 1. Sprite görgetése 1 pixellel balra: az előzmény maga az indexelt sprite, külön gyűrűpuffer nincs
+    sprite_->scroll(-1, 0);
 
-    // 2. Új adatok betöltése a wabuf jobb szélére (a wabuf továbbra is bounds.height magas)
+    // Soronként a binek maximuma, a tábla csak paraméter változáskor épül újra
+    binMap_.update(bounds.height, AnalyzerConstants::ANALYZER_MIN_FREQ_HZ, maxDisplayFrequencyHz_, 2, actualFftSize, currentBinWidthHz, BinAggregation::Max);
 
     // Adaptív autogain használata waterfall-hoz
     constexpr float NOISE_THRESHOLD = 0.003f; // Experimentális érték, finomhangolható
     float adaptiveScale = getAdaptiveScale(SensitivityConstants::WATERFALL_INPUT_SCALE);
     float maxMagnitude = 0.0f;
+    const bool logScale = config.data.spectrumLogScale;
+    if (logScale) {
+        // dB skála: a háttér a zajszinthez rögzített, a gyenge vivők a zaj felett kiemelkednek
+        computeDbSlots(magnitudeData, bounds.height, actualFftSize, currentAutoGain);
+    }
 
+    // 2. Az új (jobb szélső) oszlop képpontjai közvetlenül a sprite pufferbe, képpontonként egy intenzitás index
+    // A frekvencia sorok alulról felfelé nőnek, ezért az r-edik sor a sprite (graphH - 1 - r_scaled) pozíciójára kerül.
+    uint8_t *pixels = static_cast<uint8_t *>(sprite_->getPointer());
+    const int spriteWidth = sprite_->width();
     for (int r = 0; r < bounds.height; ++r) {
-        // 'r' (0 to bounds.height-1) leképezése FFT bin indexre a szűkített tartományon belül
-        int fft_bin_index = min_bin_for_wf + static_cast<int>(std::round(static_cast<float>(r) / std::max(1, (bounds.height - 1)) * (num_bins_in_wf_range - 1)));
-        fft_bin_index = constrain(fft_bin_index, min_bin_for_wf, max_bin_for_wf);
-
-        // Waterfall input scale - adaptív autogain-nel
-        double rawMagnitude = magnitudeData[fft_bin_index];
+        uint8_t finalValue;
+        if (logScale) {
+            finalValue = static_cast<uint8_t>(dbScale_.toLevel(dbSlots_[r], 255));
+        } else {
+            // Waterfall input scale - adaptív autogain-nel
+            double rawMagnitude = binMap_.aggregate(magnitudeData, r);
 
-        // DEBUG: Magnitude értékek kiírása (csak néhány sorra a spam elkerülése végett)
-        // if (r % 10 == 0) {
-        //     DEBUG("Waterfall magnitude[%d]: %s (threshold: %s)\n", fft_bin_index, Utils::floatToString(static_cast<float>(rawMagnitude), 6).c_str(), Utils::floatToString(NOISE_THRESHOLD, 6).c_str());
-        // }
+            // Zajküszöb alkalmazása
+            if (rawMagnitude < NOISE_THRESHOLD) {
+                rawMagnitude = 0.0;
+            }
 
-        // Zajküszöb alkalmazása
-        if (rawMagnitude < NOISE_THRESHOLD) {
-            rawMagnitude = 0.0;
+            maxMagnitude = std::max(maxMagnitude, static_cast<float>(rawMagnitude));
+            float scaledMagnitude = rawMagnitude * adaptiveScale;
+            finalValue = static_cast<uint8_t>(constrain(scaledMagnitude, 0.0, 255.0));
         }
 
-        maxMagnitude = std::max(maxMagnitude, static_cast<float>(rawMagnitude));
-        float scaledMagnitude = rawMagnitude * adaptiveScale;
-        uint8_t finalValue = static_cast<uint8_t>(constrain(scaledMagnitude, 0.0, 255.0));
-
-        wabuf[r][bounds.width - 1] = finalValue;
-    }
-
-    // 3. Sprite görgetése és új oszlop kirajzolása
-    sprite_->scroll(-1, 0); // Tartalom görgetése 1 pixellel balra
-
-    // Az új (jobb szélső) oszlop kirajzolása a sprite-ra
-    // A sprite graphH magas, a wabuf bounds.height magas.
-    for (int r_wabuf = 0; r_wabuf < bounds.height; ++r_wabuf) {
-        // r_wabuf (0..bounds.height-1) leképezése y_on_sprite-ra (0..graphH-1)
-        // A vízesés "fentről lefelé" jelenik meg a képernyőn, de a wabuf sorai a frekvenciákat jelentik (alulról felfelé).
-        // Tehát a wabuf r-edik sorát a sprite (graphH - 1 - r_scaled) pozíciójára kell rajzolni.
-        int screen_y_relative_inverted = (r_wabuf * (graphH - 1)) / std::max(1, (bounds.height - 1));
+        int screen_y_relative_inverted = (r * (graphH - 1)) / std::max(1, (bounds.height - 1));
         int y_on_sprite = (graphH - 1 - screen_y_relative_inverted); // Y koordináta a sprite-on belül
-
-        if (y_on_sprite >= 0 && y_on_sprite < graphH) { // Biztosítjuk, hogy a sprite-on belül rajzolunk
-            constexpr int WF_GRADIENT = 100;
-            uint16_t color = valueToWaterfallColor(WF_GRADIENT * wabuf[r_wabuf][bounds.width - 1], 0.0f, 255.0f * WF_GRADIENT, 0); // Az új oszlop adata
-            sprite_->drawPixel(bounds.width - 1, y_on_sprite, color);                                                              // Rajzolás a sprite jobb szélére
+        if (y_on_sprite >= 0 && y_on_sprite < graphH) {                // Biztosítjuk, hogy a sprite-on belül rajzolunk
+            pixels[y_on_sprite * spriteWidth + spriteWidth - 1] = IndexedSpriteConstants::levelToIndex(finalValue);
         }
     }
 
     // Adaptív autogain frissítése
-    updateFrameBasedGain(maxMagnitude);
+    if (!logScale) {
+        updateFrameBasedGain(maxMagnitude);
+    }
 
     // Sprite kirakása a képernyőre
-    sprite_->pushSprite(bounds.x, bounds.y);
+    queueSpritePush();
 
     // Frekvencia feliratok rajzolása, ha még nem történt meg és nincs aktív mód indicator
     if (!modeIndicatorVisible_) {
@@ -1179,27 +1576,6 @@ void SpectrumVisualizationComponent::renderWaterfall() {
     }
 }
 
-/**
- * @brief Waterfall szín meghatározása
- */
-uint16_t SpectrumVisualizationComponent::valueToWaterfallColor(float val, float min_val, float max_val, byte colorProfileIndex) {
-    const uint16_t *colors = (colorProfileIndex == 0) ? FftDisplayConstants::colors0 : FftDisplayConstants::colors1;
-    byte color_size = 16;
-
-    if (val < min_val)
-        val = min_val;
-    if (val > max_val)
-        val = max_val;
-
-    int index = (int)((val - min_val) * (color_size - 1) / (max_val - min_val));
-    if (index < 0)
-        index = 0;
-    if (index >= color_size)
-        index = color_size - 1;
-
-    return colors[index];
-}
-
 /**
  * @brief Beállítja a hangolási segéd típusát (CW vagy RTTY).
  * @param type A beállítandó TuningAidType.
@@ -1214,10 +1590,14 @@ void SpectrumVisualizationComponent::setTuningAidType(TuningAidType type) {
     // Így a tuning aid spektrum sávszélessége a két RTTY frekvencia közötti távolság plusz kétszer 200 Hz.
     constexpr float RTTY_TUNING_AID_SPAN_HZ = 200.0f;
 
+    // PSK és NAVTEX: a teljes SSB hangsáv, hogy bármelyik jel kiválasztható legyen érintéssel
+    constexpr uint16_t PSK_TUNING_AID_MIN_FREQ_HZ = 300;
+    constexpr uint16_t PSK_TUNING_AID_MAX_FREQ_HZ = 2700;
+
     bool typeChanged = (currentTuningAidType_ != type);
     currentTuningAidType_ = type;
 
-    if (currentMode_ == DisplayMode::CWWaterfall || currentMode_ == DisplayMode::RTTYWaterfall) {
+    if (isTuningAidMode(currentMode_)) {
         uint16_t oldMinFreq = currentTuningAidMinFreqHz_;
         uint16_t oldMaxFreq = currentTuningAidMaxFreqHz_;
 
@@ -1234,6 +1614,13 @@ void SpectrumVisualizationComponent::setTuningAidType(TuningAidType type) {
             uint16_t max_freq = std::max(f_mark, f_space) + RTTY_TUNING_AID_SPAN_HZ;
             currentTuningAidMinFreqHz_ = min_freq;
             currentTuningAidMaxFreqHz_ = max_freq;
+        } else if (currentTuningAidType_ == TuningAidType::PSK_TUNING || currentTuningAidType_ == TuningAidType::NAVTEX_TUNING) {
+            currentTuningAidMinFreqHz_ = PSK_TUNING_AID_MIN_FREQ_HZ;
+            currentTuningAidMaxFreqHz_ = PSK_TUNING_AID_MAX_FREQ_HZ;
+        } else if (currentTuningAidType_ == TuningAidType::CW_SKIMMER_TUNING) {
+            // CW skimmer: a teljes keresési sáv
+            currentTuningAidMinFreqHz_ = CwSkimmerConstants::MIN_FREQUENCY_HZ;
+            currentTuningAidMaxFreqHz_ = CwSkimmerConstants::MAX_FREQUENCY_HZ;
         } else {
             // OFF_DECODER: alapértelmezett tartomány
             currentTuningAidMinFreqHz_ = 0.0f;
@@ -1242,9 +1629,7 @@ void SpectrumVisualizationComponent::setTuningAidType(TuningAidType type) {
 
         // Ha változott a frekvencia tartomány, invalidáljuk a buffert
         if (typeChanged || oldMinFreq != currentTuningAidMinFreqHz_ || oldMaxFreq != currentTuningAidMaxFreqHz_) {
-            for (auto &row : wabuf) {
-                std::fill(row.begin(), row.end(), 0);
-            }
+            clearWaterfallBuffer();
         }
     }
 }
@@ -1256,7 +1641,7 @@ void SpectrumVisualizationComponent::renderCwOrRttyTuningAid() {
     // Audio feldolgozás Core1-en történik, AudioCore1Manager-en keresztül
 
     int graphH = getGraphHeight();
-    if (!spriteCreated_ || bounds.width == 0 || graphH <= 0 || wabuf.empty() || wabuf[0].empty()) {
+    if (!spriteCreated_ || bounds.width == 0 || graphH <= 0) {
         if (!spriteCreated_) {
             DEBUG("SpectrumVisualizationComponent::renderTuningAid - Sprite nincs létrehozva\n");
         }
@@ -1280,38 +1665,45 @@ void SpectrumVisualizationComponent::renderCwOrRttyTuningAid() {
     sprite_->scroll(0, 1);
 
     // Waterfall paraméterek: tuning aid-hez a min-max frekvenciahatárok alapján
-    const int min_bin_for_tuning = std::max(2, static_cast<int>(std::round(currentTuningAidMinFreqHz_ / currentBinWidthHz)));
-    const int max_bin_for_tuning = std::min(static_cast<int>(actualFftSize / 2 - 1), static_cast<int>(std::round(currentTuningAidMaxFreqHz_ / currentBinWidthHz)));
-    const int num_bins_in_tuning_range = std::max(1, max_bin_for_tuning - min_bin_for_tuning + 1);
+    binMap_.update(bounds.width, currentTuningAidMinFreqHz_, currentTuningAidMaxFreqHz_, 2, actualFftSize, currentBinWidthHz, BinAggregation::Max);
 
     // Adaptív autogain használata waterfall-hoz
     float adaptiveScale = getAdaptiveScale(SensitivityConstants::WATERFALL_INPUT_SCALE);
     float maxMagnitude = 0.0f;
+    const bool logScale = config.data.spectrumLogScale;
+    if (logScale) {
+        computeDbSlots(magnitudeData, bounds.width, actualFftSize, currentAutoGain);
+    }
 
-    // 2. Új adatok betöltése a legfelső sorba és csak azt rajzoljuk ki
+    // 2. Új adatok közvetlenül a sprite legfelső sorába (y=0), képpontonként egy intenzitás index
+    uint8_t *newRow = static_cast<uint8_t *>(sprite_->getPointer());
     for (int c = 0; c < bounds.width; ++c) {
-        float ratio_in_display_width = (bounds.width <= 1) ? 0.0f : (static_cast<float>(c) / (bounds.width - 1));
-        int fft_bin_index = min_bin_for_tuning + static_cast<int>(std::round(ratio_in_display_width * (num_bins_in_tuning_range - 1)));
-        fft_bin_index = constrain(fft_bin_index, min_bin_for_tuning, max_bin_for_tuning);
-        double rawMagnitude = magnitudeData[fft_bin_index];
-        maxMagnitude = std::max(maxMagnitude, static_cast<float>(rawMagnitude));
-        double scaledMagnitude = rawMagnitude * adaptiveScale;
-        uint8_t finalValue = static_cast<uint8_t>(constrain(scaledMagnitude, 0.0, 255.0));
-        wabuf[0][c] = finalValue;
-
-        // Csak a legfelső sort rajzoljuk ki (y=0)
-        constexpr int WF_GRADIENT = 100;
-        uint16_t color = valueToWaterfallColor(WF_GRADIENT * finalValue, 0.0f, 255.0f * WF_GRADIENT, 0);
-        sprite_->drawPixel(c, 0, color);
+        uint8_t finalValue;
+        if (logScale) {
+            finalValue = static_cast<uint8_t>(dbScale_.toLevel(dbSlots_[c], 255));
+        } else {
+            double rawMagnitude = binMap_.aggregate(magnitudeData, c);
+            maxMagnitude = std::max(maxMagnitude, static_cast<float>(rawMagnitude));
+            double scaledMagnitude = rawMagnitude * adaptiveScale;
+            finalValue = static_cast<uint8_t>(constrain(scaledMagnitude, 0.0, 255.0));
+        }
+        newRow[c] = IndexedSpriteConstants::levelToIndex(finalValue);
     }
 
     // Adaptív autogain frissítése
-    updateFrameBasedGain(maxMagnitude);
+    if (!logScale) {
+        updateFrameBasedGain(maxMagnitude);
+    }
 
-    // Színek
-    constexpr uint16_t TUNING_AID_CW_TARGET_COLOR = TFT_GREEN;
-    constexpr uint16_t TUNING_AID_RTTY_SPACE_COLOR = TFT_CYAN;
-    constexpr uint16_t TUNING_AID_RTTY_MARK_COLOR = TFT_YELLOW;
+    // Színek (az indexelt sprite fenntartott jelölő indexei, lásd IndexedSpriteConstants::OVERLAY_COLORS)
+    const uint16_t TUNING_AID_CW_TARGET_COLOR = spriteColor(TFT_GREEN);
+    const uint16_t TUNING_AID_CW_AFC_COLOR = spriteColor(TFT_ORANGE);
+    const uint16_t TUNING_AID_RTTY_SPACE_COLOR = spriteColor(TFT_CYAN);
+    const uint16_t TUNING_AID_RTTY_MARK_COLOR = spriteColor(TFT_YELLOW);
+    const uint16_t TUNING_AID_PSK_CARRIER_COLOR = spriteColor(TFT_MAGENTA);
+    const uint16_t TUNING_AID_SKIMMER_KEY_DOWN_COLOR = spriteColor(TFT_YELLOW);
+    const uint16_t TUNING_AID_SKIMMER_KEY_UP_COLOR = spriteColor(TFT_DARKGREY);
+    const uint16_t TUNING_AID_NAVTEX_SYNC_COLOR = spriteColor(TFT_GREEN);
 
     uint16_t min_freq_displayed = currentTuningAidMinFreqHz_;
     uint16_t max_freq_displayed = currentTuningAidMaxFreqHz_;
@@ -1327,6 +1719,16 @@ void SpectrumVisualizationComponent::renderCwOrRttyTuningAid() {
                 uint16_t line_x = bounds.width / 2;
                 sprite_->drawFastVLine(line_x, 0, graphH, TUNING_AID_CW_TARGET_COLOR);
 
+                // Az AFC által követett hang jelölése (szaggatott vonal, hogy a célvonaltól megkülönböztethető legyen)
+                if (cwLockedFrequencyHz_ >= min_freq_displayed && cwLockedFrequencyHz_ <= max_freq_displayed) {
+                    float ratio_locked = (cwLockedFrequencyHz_ - min_freq_displayed) / displayed_span_hz;
+                    uint16_t line_x_locked = static_cast<uint16_t>(std::round(ratio_locked * (bounds.width - 1)));
+                    line_x_locked = constrain(line_x_locked, 0, bounds.width - 1);
+                    for (int y = 0; y < graphH; y += 4) {
+                        sprite_->drawFastVLine(line_x_locked, y, 2, TUNING_AID_CW_AFC_COLOR);
+                    }
+                }
+
             } else if (currentTuningAidType_ == TuningAidType::RTTY_TUNING) {
                 uint16_t f_mark = config.data.rttyMarkFrequencyHz;
                 uint16_t f_space = f_mark - config.data.rttyShiftHz;
@@ -1357,8 +1759,14 @@ void SpectrumVisualizationComponent::renderCwOrRttyTuningAid() {
                 uint16_t line_x = bounds.width / 2;
                 uint16_t label_y = graphH > 2 ? graphH - 2 : 0;
                 sprite_->fillRect(line_x - 25, label_y - 8, 50, 10, TFT_BLACK);
-                sprite_->setTextColor(TUNING_AID_CW_TARGET_COLOR, TFT_BLACK);
-                sprite_->drawString(String(config.data.cwReceiverOffsetHz) + "Hz", line_x, label_y);
+                if (cwLockedFrequencyHz_ > 0.0f) {
+                    // AFC zárás esetén a követett hang frekvenciáját írjuk ki
+                    sprite_->setTextColor(TUNING_AID_CW_AFC_COLOR, TFT_BLACK);
+                    sprite_->drawString(String(static_cast<uint16_t>(std::round(cwLockedFrequencyHz_))) + "Hz", line_x, label_y);
+                } else {
+                    sprite_->setTextColor(TUNING_AID_CW_TARGET_COLOR, TFT_BLACK);
+                    sprite_->drawString(String(config.data.cwReceiverOffsetHz) + "Hz", line_x, label_y);
+                }
 
             } else if (currentTuningAidType_ == TuningAidType::RTTY_TUNING) {
                 uint16_t f_mark = config.data.rttyMarkFrequencyHz;
@@ -1385,39 +1793,81 @@ void SpectrumVisualizationComponent::renderCwOrRttyTuningAid() {
                 }
             }
         }
+    } else if (currentTuningAidType_ == TuningAidType::PSK_TUNING && displayed_span_hz > 0) {
+
+        // PSK: az AFC által követett vivő jelölése (a kiválasztott vivő körül mozog)
+        Psk31Decoder *decoder = AudioCore1Manager::getPsk31Decoder();
+        if (decoder) {
+            float f_carrier = decoder->getTrackedFrequency();
+            if (f_carrier >= min_freq_displayed && f_carrier <= max_freq_displayed) {
+                float ratio_carrier = (f_carrier - min_freq_displayed) / displayed_span_hz;
+                uint16_t line_x = static_cast<uint16_t>(std::round(ratio_carrier * (bounds.width - 1)));
+                line_x = constrain(line_x, 0, bounds.width - 1);
+                sprite_->drawFastVLine(line_x, 0, graphH, TUNING_AID_PSK_CARRIER_COLOR);
+
+                // Címke: követett frekvencia és jelminőség
+                sprite_->setFreeFont();
+                sprite_->setTextSize(1);
+                sprite_->setTextDatum(BC_DATUM);
+                uint16_t label_x = constrain(line_x, 35, bounds.width - 35);
+                uint16_t label_y = graphH > 2 ? graphH - 2 : 0;
+                sprite_->fillRect(label_x - 35, label_y - 8, 70, 10, TFT_BLACK);
+                sprite_->setTextColor(TUNING_AID_PSK_CARRIER_COLOR, TFT_BLACK);
+                sprite_->drawString(String(static_cast<uint16_t>(std::round(f_carrier))) + "Hz " + String(decoder->getSignalQuality()) + "%", label_x, label_y);
+            }
+        }
+    } else if (currentTuningAidType_ == TuningAidType::CW_SKIMMER_TUNING && displayed_span_hz > 0) {
+
+        // CW skimmer: a csatornák billentyű állapota a legfelső sorban, a görgetéssel a waterfallon nyomot hagy
+        CwSkimmer *skimmer = AudioCore1Manager::getCwSkimmer();
+        if (skimmer) {
+            CwSkimmer::ChannelInfo info;
+            for (uint8_t slot = 0; slot < CwSkimmerConstants::MAX_CHANNELS; slot++) {
+                if (!skimmer->getChannelInfo(slot, info) || info.frequencyHz < min_freq_displayed || info.frequencyHz > max_freq_displayed) {
+                    continue;
+                }
+                float ratio_channel = static_cast<float>(info.frequencyHz - min_freq_displayed) / displayed_span_hz;
+                uint16_t line_x = static_cast<uint16_t>(std::round(ratio_channel * (bounds.width - 1)));
+                line_x = constrain(line_x, 1, bounds.width - 2);
+                sprite_->drawFastHLine(line_x - 1, 0, 3, info.keyDown ? TUNING_AID_SKIMMER_KEY_DOWN_COLOR : TUNING_AID_SKIMMER_KEY_UP_COLOR);
+            }
+        }
+    } else if (currentTuningAidType_ == TuningAidType::NAVTEX_TUNING && displayed_span_hz > 0) {
+
+        // NAVTEX: a mark (B, magasabb) és space (Y, alacsonyabb) hang vonala a kiválasztott középfrekvencia körül
+        NavtexDecoder *decoder = AudioCore1Manager::getNavtexDecoder();
+        if (decoder) {
+            float f_center = decoder->getCenterFrequency();
+            float f_tones[2] = {f_center - NavtexConstants::SHIFT_HZ / 2.0f, f_center + NavtexConstants::SHIFT_HZ / 2.0f};
+            uint16_t tone_colors[2] = {TUNING_AID_RTTY_SPACE_COLOR, TUNING_AID_RTTY_MARK_COLOR};
+            for (uint8_t t = 0; t < 2; t++) {
+                if (f_tones[t] >= min_freq_displayed && f_tones[t] <= max_freq_displayed) {
+                    float ratio_tone = (f_tones[t] - min_freq_displayed) / displayed_span_hz;
+                    uint16_t line_x = static_cast<uint16_t>(std::round(ratio_tone * (bounds.width - 1)));
+                    sprite_->drawFastVLine(constrain(line_x, 0, bounds.width - 1), 0, graphH, tone_colors[t]);
+                }
+            }
+
+            // Címke: középfrekvencia, szinkron állapot és a tárolt üzenetek száma
+            sprite_->setFreeFont();
+            sprite_->setTextSize(1);
+            sprite_->setTextDatum(BC_DATUM);
+            uint16_t label_x = bounds.width / 2;
+            uint16_t label_y = graphH > 2 ? graphH - 2 : 0;
+            sprite_->fillRect(label_x - 45, label_y - 8, 90, 10, TFT_BLACK);
+            sprite_->setTextColor(decoder->isSynchronized() ? TUNING_AID_NAVTEX_SYNC_COLOR : TUNING_AID_RTTY_MARK_COLOR, TFT_BLACK);
+            sprite_->drawString(String(static_cast<uint16_t>(std::round(f_center))) + "Hz " + (decoder->isSynchronized() ? "SYNC " : "") + String(decoder->getMessageCount()) + " msg", label_x,
+                                label_y);
+        }
     }
 
     // Sprite kirakása a képernyőre
-    sprite_->pushSprite(bounds.x, bounds.y);
-
-    // Adaptív autogain frissítése
-    updateFrameBasedGain(maxMagnitude);
+    queueSpritePush();
 
     // Frekvencia feliratok rajzolása, ha még nem történt meg
     renderFrequencyLabels(min_freq_displayed, max_freq_displayed);
 }
 
-/**
- * @brief Meghatározza, hogy egy adott FFT bin melyik alacsony felbontású sávhoz tartozik.
- * @param fft_bin_index Az FFT bin indexe.
- * @param min_bin_low_res A LowRes spektrumhoz figyelembe vett legalacsonyabb FFT bin index.
- * @param num_bins_low_res_range A LowRes spektrumhoz figyelembe vett FFT bin-ek száma.
- * @param total_bands A frekvenciasávok száma.
- * @return A sáv indexe (0-tól total_bands-1-ig).
- */
-uint8_t SpectrumVisualizationComponent::getBandVal(int fft_bin_index, int min_bin_low_res, int num_bins_low_res_range, int total_bands) {
-    if (fft_bin_index < min_bin_low_res || num_bins_low_res_range <= 0) {
-        return 0; // Vagy egy érvénytelen sáv index, ha szükséges
-    }
-    // Kiszámítjuk a relatív indexet a megadott tartományon belül
-    int relative_bin_index = fft_bin_index - min_bin_low_res;
-    if (relative_bin_index < 0)
-        return 0; // Elvileg nem fordulhat elő, ha fft_bin_index >= min_bin_low_res
-
-    // Leképezzük a relatív bin indexet (0-tól num_bins_low_res_range-1-ig) a total_bands sávokra
-    return constrain(relative_bin_index * total_bands / num_bins_low_res_range, 0, total_bands - 1);
-}
-
 /**
  * @brief Kirajzol egyetlen oszlopot/sávot (bar-t) az alacsony felbontású spektrumhoz.
  * @param band_idx A frekvenciasáv indexe, amelyhez az oszlop tartozik.
@@ -1536,6 +1986,15 @@ uint16_t SpectrumVisualizationComponent::getOptimalFftSizeForMode(DisplayMode mo
         case DisplayMode::RTTYWaterfall:
             return 256; // Maximum felbontás a spektrum analizáláshoz
 
+        case DisplayMode::PSKWaterfall:
+            return 512; // ~23Hz/bin 12kHz-en: a PSK31 jelek (~60Hz) még szétválnak, a vivő pontosan kiválasztható
+
+        case DisplayMode::CWSkimmer:
+            return 512; // ~23Hz/bin: a 100 Hz-re lévő CW jelek külön csúcsot adnak, a keresés mégis gyors
+
+        case DisplayMode::NAVTEXWaterfall:
+            return 512; // ~23Hz/bin: a 170 Hz-es shift két jól elkülönülő csíkot ad
+
         case DisplayMode::SpectrumHighRes:
             return 256; // Magas felbontású spektrum, ~150px széles a grafikon, így elég 256 FFT méret
 
@@ -1585,6 +2044,15 @@ const char *SpectrumVisualizationComponent::decodeModeToStr() {
         case DisplayMode::RTTYWaterfall:
             modeText = "RTTY Waterfall";
             break;
+        case DisplayMode::PSKWaterfall:
+            modeText = "PSK31 Waterfall";
+            break;
+        case DisplayMode::CWSkimmer:
+            modeText = "CW Skimmer";
+            break;
+        case DisplayMode::NAVTEXWaterfall:
+            modeText = "NAVTEX";
+            break;
         default:
             modeText = "Unknown";
             break;
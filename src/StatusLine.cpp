@@ -1,4 +1,5 @@
 #include "StatusLine.h"
+#include "AudioCore1Manager.h"
 #include "Config.h"
 #include "PicoSensorUtils.h"
 #include "Si4735Manager.h"
@@ -21,6 +22,7 @@ constexpr uint8_t BOX_WIDTH_ANTCAP = 40;            // Antenna kapacitás négyz
 constexpr uint8_t BOX_WIDTH_TEMP = 45;              // Hőmérséklet négyzet szélessége
 constexpr uint8_t BOX_WIDTH_VOLTAGE = 45;           // Feszültség négyzet szélessége
 constexpr uint8_t BOX_WIDTH_STATION_IN_MEMORY = 35; // Az állomás memóriában négyzet szélessége
+constexpr uint8_t BOX_WIDTH_SIGNAL_CLASS = 40;      // A jeltípus négyzet szélessége
 
 // Default színek a négyzetek kereteinek
 constexpr uint16_t BfoBoxColor = TFT_ORANGE;
@@ -33,6 +35,7 @@ constexpr uint16_t AntCapBoxColor = TFT_SILVER;          // Alapértelmezett Ant
 constexpr uint16_t TempBoxColor = TFT_YELLOW;            // Hőmérséklet színe
 constexpr uint16_t VoltageBoxColor = TFT_GREENYELLOW;    // Feszültség színe
 constexpr uint16_t StationInMemoryBoxColor = TFT_SILVER; // Az állomás memóriában színe
+constexpr uint16_t SignalClassBoxColor = TFT_DARKCYAN;   // A jeltípus keretének színe
 
 /**
  * @brief StatusLine konstruktor
@@ -45,6 +48,8 @@ constexpr uint16_t StationInMemoryBoxColor = TFT_SILVER; // Az állomás memóri
 StatusLine::StatusLine(int16_t x, int16_t y, const ColorScheme &colors) : UIComponent(Rect(x, y, ::SCREEN_W, STATUS_LINE_HEIGHT), colors) {
     initializeBoxes();
     stationInMemory = false; // Kezdetben nincs állomás a memóriában
+    shownSignalClass = SignalClass::None;
+    signalClassShown = false;
 }
 
 /**
@@ -92,6 +97,10 @@ void StatusLine::initializeBoxes() {
 
     // 9. a memória
     statusBoxes[9] = {currentX, BOX_WIDTH_STATION_IN_MEMORY, StationInMemoryBoxColor};
+    currentX += BOX_WIDTH_STATION_IN_MEMORY + GAP;
+
+    // 10. A jeltípus (core1 osztályozó)
+    statusBoxes[10] = {currentX, BOX_WIDTH_SIGNAL_CLASS, SignalClassBoxColor};
 }
 
 /**
@@ -104,7 +113,7 @@ void StatusLine::draw() {
 
     // Csak a ténylegesen használt terület törlése, nem a teljes bounds
     // Kiszámoljuk az utolsó négyzet végének pozícióját
-    uint16_t actualWidth = statusBoxes[9].x + statusBoxes[9].width;
+    uint16_t actualWidth = statusBoxes[STATUS_LINE_BOXES - 1].x + statusBoxes[STATUS_LINE_BOXES - 1].width;
     ::tft.fillRect(bounds.x, bounds.y, actualWidth, bounds.height, colors.screenBackground);
 
     // Négyzetek kereteinek kirajzolása
@@ -119,6 +128,8 @@ void StatusLine::draw() {
     updateTemperature();
     updateVoltage();
     updateStationInMemory(stationInMemory);
+    signalClassShown = false;
+    updateSignalClass();
 
     needsRedraw = false;
 }
@@ -321,4 +332,25 @@ void StatusLine::updateStationInMemory(bool isInMemo) {
     uint16_t color = StatusLine::stationInMemory ? TFT_GREEN : statusBoxes[9].color;
     clearBoxContent(9);
     drawTextInBox(9, "Memo", color);
-}
\ No newline at end of file
+}
+
+/**
+ * @brief A core1 jeltípus osztályozó eredményének kiírása (10. négyzet)
+ * @details Periodikusan hívható, csak változáskor rajzol. FM módban nincs osztályozás.
+ */
+void StatusLine::updateSignalClass() {
+    SignalClass signalClass = SignalClass::None;
+    SignalClassifier *classifier = AudioCore1Manager::getSignalClassifier();
+    if (classifier && ::pSi4735Manager && !::pSi4735Manager->isCurrentBandFM()) {
+        signalClass = classifier->getSignalClass();
+    }
+
+    if (signalClassShown && signalClass == shownSignalClass) {
+        return;
+    }
+    shownSignalClass = signalClass;
+    signalClassShown = true;
+
+    clearBoxContent(10);
+    drawTextInBox(10, SignalClassifier::getLabel(signalClass), SignalClassifier::getColor(signalClass));
+}
@@ -0,0 +1,220 @@
+#include "TftDmaManager.h"
+#include "defines.h"
+
+#include <algorithm>
+
+extern TFT_eSPI tft;
+
+// Statikus tagváltozók inicializálása
+bool TftDmaManager::enabled_ = false;
+bool TftDmaManager::busy_ = false;
+TFT_eSprite *TftDmaManager::pendingSprite_ = nullptr;
+int32_t TftDmaManager::pendingX_ = 0;
+int32_t TftDmaManager::pendingY_ = 0;
+const uint16_t *TftDmaManager::pendingLut_ = nullptr;
+uint16_t TftDmaManager::stripBuffers_[2][TftDmaConstants::STRIP_PIXELS];
+TFT_eSprite *TftDmaManager::stripSprite_ = nullptr;
+const uint16_t *TftDmaManager::stripLut_ = nullptr;
+int32_t TftDmaManager::stripX_ = 0;
+int32_t TftDmaManager::stripY_ = 0;
+int32_t TftDmaManager::stripRow_ = 0;
+int32_t TftDmaManager::stripRows_ = 1;
+uint8_t TftDmaManager::stripNext_ = 0;
+uint32_t TftDmaManager::startMicros_ = 0;
+uint32_t TftDmaManager::transferEstimateMicros_ = 0;
+uint32_t TftDmaManager::statFrames_ = 0;
+uint32_t TftDmaManager::statReclaimedMicros_ = 0;
+uint32_t TftDmaManager::statWaitMicros_ = 0;
+uint32_t TftDmaManager::lastStatsMs_ = 0;
+
+/**
+ * @brief A DMA csatorna inicializálása
+ */
+void TftDmaManager::init() {
+    enabled_ = tft.initDMA();
+    DEBUG("TftDmaManager: DMA %s\n", enabled_ ? "engedélyezve" : "nem elérhető, blokkoló kirakás");
+}
+
+/**
+ * @brief Sprite kirakásának előjegyzése
+ * @details Ha a DMA nem használható, azonnal blokkoló kirakás történik.
+ *          Egy képernyő loop alatt a későbbi előjegyzés felülírja a korábbit (csak a legfrissebb keret kerül ki).
+ */
+void TftDmaManager::queueSprite(TFT_eSprite *sprite, int32_t x, int32_t y, const uint16_t *indexLut) {
+    if (!sprite) {
+        return;
+    }
+    if (!enabled_ || (indexLut && sprite->width() > TFT_HEIGHT)) {
+        if (indexLut) {
+            pushIndexedBlocking(sprite, x, y, indexLut);
+        } else {
+            sprite->pushSprite(x, y);
+        }
+        return;
+    }
+    pendingSprite_ = sprite;
+    pendingX_ = x;
+    pendingY_ = y;
+    pendingLut_ = indexLut;
+}
+
+/**
+ * @brief Indexelt képpontok bővítése a színtábla alapján
+ */
+void TftDmaManager::expandIndexed(const uint8_t *src, uint16_t *dst, size_t pixels, const uint16_t *indexLut) {
+    for (size_t i = 0; i < pixels; i++) {
+        dst[i] = indexLut[src[i]];
+    }
+}
+
+/**
+ * @brief Indexelt sprite blokkoló kirakása soronként (DMA nélkül)
+ */
+void TftDmaManager::pushIndexedBlocking(TFT_eSprite *sprite, int32_t x, int32_t y, const uint16_t *indexLut) {
+    const int32_t w = std::min<int32_t>(sprite->width(), TFT_HEIGHT);
+    const int32_t h = sprite->height();
+    const uint8_t *src = static_cast<const uint8_t *>(sprite->getPointer());
+    uint16_t line[TFT_HEIGHT];
+
+    tft.startWrite();
+    const bool swapBytes = tft.getSwapBytes();
+    tft.setSwapBytes(false);
+    for (int32_t row = 0; row < h; row++) {
+        expandIndexed(src + row * sprite->width(), line, w, indexLut);
+        tft.pushImage(x, y + row, w, 1, line);
+    }
+    tft.setSwapBytes(swapBytes);
+    tft.endWrite();
+}
+
+/**
+ * @brief Az előjegyzett kirakás indítása
+ * @details A 16 bites sprite-ot a DMA közvetlenül a sprite memóriájából viszi ki (a teljes sprite másolása nélkül),
+ *          ezért a sprite az átvitel végéig nem módosulhat: a képernyő logika csak a waitIdle() után fut, a sprite
+ *          megszüntetése előtt a cancel() vár. Indexelt sprite-nál az első sáv indul, a többit a pumpStrips() indítja.
+ *          A CS az átvitel végéig aktív marad, ezért az SPI buszt a waitIdle() szabadítja fel.
+ */
+void TftDmaManager::startPending() {
+    if (!pendingSprite_) {
+        return;
+    }
+    waitIdle();
+
+    TFT_eSprite *sprite = pendingSprite_;
+    pendingSprite_ = nullptr;
+    const int32_t w = sprite->width();
+    const int32_t h = sprite->height();
+
+    // A sprite bájtsorrendje a kijelzőé, mint a pushSprite()-nál
+    tft.startWrite();
+    if (pendingLut_) {
+        stripSprite_ = sprite;
+        stripLut_ = pendingLut_;
+        stripX_ = pendingX_;
+        stripY_ = pendingY_;
+        stripRow_ = 0;
+        stripRows_ = std::max<int32_t>(1, TftDmaConstants::STRIP_PIXELS / w);
+        stripNext_ = 0;
+        expandStrip();
+        pumpStrips();
+    } else {
+        const bool swapBytes = tft.getSwapBytes();
+        tft.setSwapBytes(false);
+        tft.pushImageDMA(pendingX_, pendingY_, w, h, static_cast<uint16_t *>(sprite->getPointer()));
+        tft.setSwapBytes(swapBytes);
+    }
+
+    busy_ = true;
+    startMicros_ = micros();
+    transferEstimateMicros_ = static_cast<uint32_t>(static_cast<uint64_t>(w) * h * 16 * 1000000ULL / SPI_FREQUENCY);
+}
+
+/**
+ * @brief A következő indexelt sáv bővítése a soron következő sáv pufferbe
+ */
+void TftDmaManager::expandStrip() {
+    const int32_t w = stripSprite_->width();
+    const int32_t rows = std::min(stripRows_, stripSprite_->height() - stripRow_);
+    const uint8_t *src = static_cast<const uint8_t *>(stripSprite_->getPointer()) + stripRow_ * w;
+    expandIndexed(src, stripBuffers_[stripNext_], static_cast<size_t>(w) * rows, stripLut_);
+}
+
+/**
+ * @brief Indexelt sprite: a következő (már bővített) sáv indítása, ha az előző kiment
+ * @details A sáv indítása után a másik pufferbe azonnal bővül az azt követő sáv, így a bővítés az átvitellel párhuzamos.
+ * @return true ha van még hátralévő sáv vagy futó átvitel
+ */
+bool TftDmaManager::pumpStrips() {
+    if (tft.dmaBusy()) {
+        return true;
+    }
+    if (!stripSprite_) {
+        return false;
+    }
+
+    const int32_t w = stripSprite_->width();
+    const int32_t rows = std::min(stripRows_, stripSprite_->height() - stripRow_);
+    const bool swapBytes = tft.getSwapBytes();
+    tft.setSwapBytes(false);
+    tft.pushImageDMA(stripX_, stripY_ + stripRow_, w, rows, stripBuffers_[stripNext_]);
+    tft.setSwapBytes(swapBytes);
+
+    stripRow_ += rows;
+    stripNext_ ^= 1;
+    if (stripRow_ >= stripSprite_->height()) {
+        stripSprite_ = nullptr; // Az utolsó sáv fut, a waitIdle() zárja le
+    } else {
+        expandStrip();
+    }
+    return true;
+}
+
+/**
+ * @brief Fut-e még az indított átvitel
+ */
+bool TftDmaManager::isTransferring() { return busy_ && pumpStrips(); }
+
+/**
+ * @brief Várakozás a futó átvitel végére
+ * @details A visszanyert idő keretenként: amennyit a core0 az átvitel alatt mással tölthetett
+ *          (ha az átvitel még fut: az indítás óta eltelt idő, ha már véget ért: a becsült átviteli idő).
+ */
+void TftDmaManager::waitIdle() {
+    if (!busy_) {
+        return;
+    }
+
+    const uint32_t enterMicros = micros();
+    const uint32_t overlapMicros = enterMicros - startMicros_;
+    const bool stillBusy = stripSprite_ || tft.dmaBusy();
+    do {
+        tft.dmaWait();
+    } while (pumpStrips());
+    tft.endWrite();
+    busy_ = false;
+
+    const uint32_t waitMicros = micros() - enterMicros;
+    statFrames_++;
+    statWaitMicros_ += waitMicros;
+    statReclaimedMicros_ += stillBusy ? overlapMicros : std::min(overlapMicros, transferEstimateMicros_);
+
+    if (millis() - lastStatsMs_ >= TftDmaConstants::STATS_INTERVAL_MS) {
+        DEBUG("TftDmaManager: %u keret, visszanyert főciklus idő: %u us/keret, DMA várakozás: %u us/keret (becsült átvitel: %u us)\n", statFrames_, statReclaimedMicros_ / statFrames_,
+              statWaitMicros_ / statFrames_, transferEstimateMicros_);
+        statFrames_ = 0;
+        statReclaimedMicros_ = 0;
+        statWaitMicros_ = 0;
+        lastStatsMs_ = millis();
+    }
+}
+
+/**
+ * @brief A sprite-ra vonatkozó előjegyzés törlése
+ * @details A futó átvitel (indexelt sprite-nál a hátralévő sávok bővítése is) a sprite memóriájából dolgozik, ezért megvárjuk.
+ */
+void TftDmaManager::cancel(TFT_eSprite *sprite) {
+    if (pendingSprite_ == sprite) {
+        pendingSprite_ = nullptr;
+    }
+    waitIdle();
+}
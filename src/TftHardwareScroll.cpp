@@ -0,0 +1,76 @@
+#include "TftHardwareScroll.h"
+
+extern TFT_eSPI tft;
+
+namespace {
+constexpr uint8_t CMD_NORON = 0x13;    // Normal Display Mode ON: kilépés a görgetési módból
+constexpr uint8_t CMD_VSCRDEF = 0x33;  // Vertical Scrolling Definition: TFA, VSA, BFA
+constexpr uint8_t CMD_VSCRSADD = 0x37; // Vertical Scrolling Start Address: VSP
+} // namespace
+
+/**
+ * @brief A görgetési terület beállítása, VSP a terület elejére
+ */
+void TftHardwareScroll::setArea(uint16_t fixedWidth) {
+    const uint16_t tfa = fixedWidth;
+    const uint16_t vsa = TFT_HEIGHT - tfa;
+    const uint16_t bfa = 0;
+
+    tft.writecommand(CMD_VSCRDEF);
+    tft.writedata(tfa >> 8);
+    tft.writedata(tfa & 0xFF);
+    tft.writedata(vsa >> 8);
+    tft.writedata(vsa & 0xFF);
+    tft.writedata(bfa >> 8);
+    tft.writedata(bfa & 0xFF);
+
+    setStart(tfa);
+}
+
+/**
+ * @brief A görgetés kikapcsolása
+ */
+void TftHardwareScroll::disable() {
+    setArea(0);
+    tft.writecommand(CMD_NORON);
+}
+
+/**
+ * @brief A görgetési mutató beállítása
+ */
+void TftHardwareScroll::setStart(uint16_t vsp) {
+    tft.writecommand(CMD_VSCRSADD);
+    tft.writedata(vsp >> 8);
+    tft.writedata(vsp & 0xFF);
+}
+
+/**
+ * @brief Konstruktor
+ */
+TftScrollColumnWriter::TftScrollColumnWriter(uint16_t fixedWidth) : fixedWidth_(fixedWidth), writeRow_(fixedWidth) {}
+
+/**
+ * @brief A görgetett terület törlése, az írás a terület elejéről indul
+ */
+void TftScrollColumnWriter::clear() {
+    tft.fillRect(fixedWidth_, 0, TFT_HEIGHT - fixedWidth_, TFT_WIDTH, TFT_BLACK);
+    writeRow_ = fixedWidth_;
+    TftHardwareScroll::setStart(writeRow_);
+}
+
+/**
+ * @brief Egy oszlop kiírása a következő memória sorba és a görgetési mutató léptetése
+ * @details Egyetlen 1 x height címablak: a kép többi része a kijelző memóriájában marad.
+ */
+void TftScrollColumnWriter::pushColumn(int32_t y, uint16_t height, uint16_t *pixels) {
+    const bool swapBytes = tft.getSwapBytes();
+    tft.setSwapBytes(true);
+    tft.pushImage(writeRow_, y, 1, height, pixels);
+    tft.setSwapBytes(swapBytes);
+
+    // A következő írási sor a legrégebbi oszlop: ez kerül a görgetett terület bal szélére
+    if (++writeRow_ >= TFT_HEIGHT) {
+        writeRow_ = fixedWidth_;
+    }
+    TftHardwareScroll::setStart(writeRow_);
+}
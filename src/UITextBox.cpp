@@ -1,8 +1,13 @@
 #include "UITextBox.h"
 #include "defines.h" // For DEBUG
+#include <new>
+
+namespace {
+constexpr int16_t TEXT_PADDING = 5; // Belső margó a keret és a szöveg között
+} // namespace
 
 UITextBox::UITextBox(const Rect &bounds, const String &initialText)
-    : UIComponent(bounds), text(initialText), textColor(TFT_WHITE), bgColor(TFT_BLACK), textSize(2), textDatum(TL_DATUM), _sprite(&tft), _spriteCreated(false) {
+    : UIComponent(bounds), text(initialText), textColor(TFT_WHITE), bgColor(TFT_BLACK), textSize(2), textDatum(TL_DATUM), _sprite(&tft), _spriteCreated(false), streamMode_(false), fullRedrawPending_(true), pStream_(nullptr) {
     // Sprite létrehozása a konstruktorban
     if (bounds.width > 0 && bounds.height > 0) {
         _sprite.setColorDepth(16);
@@ -11,12 +16,15 @@ UITextBox::UITextBox(const Rect &bounds, const String &initialText)
             DEBUG("UITextBox: Sprite creation failed!\n");
         }
     }
+    streamClear();
+    updateStreamGeometry();
 }
 
 UITextBox::~UITextBox() {
     if (_spriteCreated) {
         _sprite.deleteSprite();
     }
+    delete pStream_;
 }
 
 void UITextBox::setBounds(const Rect &newBounds) {
@@ -32,16 +40,238 @@ void UITextBox::setBounds(const Rect &newBounds) {
             DEBUG("UITextBox: Sprite recreation failed!\n");
         }
     }
+    updateStreamGeometry();
+}
+
+void UITextBox::markForRedraw(bool markChildren) {
+    UIComponent::markForRedraw(markChildren);
+    fullRedrawPending_ = true; // Stream módban is a teljes tartalmat kell rajzolni
 }
 
 void UITextBox::setText(const String &newText) {
+    if (streamMode_) {
+        // Stream módban a tartalom cseréje: törlés, majd hozzáfűzés
+        streamClear();
+        appendText(newText.c_str());
+        markForRedraw();
+        return;
+    }
     if (text != newText) {
         text = newText;
         markForRedraw(); // Újrarajzolás kérése, ha a szöveg változik
     }
 }
 
-String UITextBox::getText() const { return text; }
+String UITextBox::getText() const {
+    if (!streamMode_) {
+        return text;
+    }
+    String result;
+    for (uint8_t r = 0; r < streamLineCount_; r++) {
+        if (r > 0) {
+            result += '\n';
+        }
+        result += pStream_->lines[(streamFirstLine_ + r) % STREAM_MAX_LINES];
+    }
+    return result;
+}
+
+/**
+ * @brief Stream (csak hozzáfűzés) mód be/kikapcsolása, a tartalom törlődik
+ * @details A sor-gyűrű csak stream módban foglal memóriát; ha a foglalás nem sikerül, normál mód marad
+ */
+void UITextBox::setStreamMode(bool enabled) {
+    if (enabled && pStream_ == nullptr) {
+        pStream_ = new (std::nothrow) StreamBuffer();
+        if (pStream_ == nullptr) {
+            DEBUG("UITextBox: Stream buffer allocation failed!\n");
+            enabled = false;
+        }
+    } else if (!enabled) {
+        delete pStream_;
+        pStream_ = nullptr;
+    }
+    streamMode_ = enabled;
+    text = "";
+    streamClear();
+    markForRedraw();
+}
+
+/**
+ * @brief Szöveg hozzáfűzése (stream módban csak a kirajzolásra váró pufferbe kerül)
+ */
+void UITextBox::appendText(const char *newText) {
+    if (newText == nullptr) {
+        return;
+    }
+    while (*newText) {
+        appendChar(*newText++);
+    }
+}
+
+/**
+ * @brief Egy karakter hozzáfűzése
+ * @details Ha a kirajzolásra váró puffer betelik (pl. dialógus alatt nincs rajzolás), a karakterek
+ * rajzolás nélkül kerülnek a sor-gyűrűbe, és a következő draw() a teljes tartalmat rajzolja ki
+ */
+void UITextBox::appendChar(char c) {
+    if (!streamMode_) {
+        text += c;
+        markForRedraw();
+        return;
+    }
+
+    uint8_t next = (pendingHead_ + 1) & (STREAM_PENDING_SIZE - 1);
+    if (next == pendingTail_) {
+        while (pendingTail_ != pendingHead_) {
+            streamPutChar(pStream_->pending[pendingTail_], false);
+            pendingTail_ = (pendingTail_ + 1) & (STREAM_PENDING_SIZE - 1);
+        }
+        streamPutChar(c, false);
+        markForRedraw();
+        return;
+    }
+    pStream_->pending[pendingHead_] = c;
+    pendingHead_ = next;
+    needsRedraw = true; // Csak a hozzáfűzött karaktereket kell kirajzolni
+}
+
+/**
+ * @brief A dobozba férő sorok és oszlopok számának újraszámítása (méret vagy betűméret változáskor)
+ */
+void UITextBox::updateStreamGeometry() {
+    streamColumns_ = constrain((bounds.width - 2 * TEXT_PADDING) / streamCharWidth(), 1, STREAM_MAX_COLUMNS);
+    streamRows_ = constrain((bounds.height - 2 * TEXT_PADDING) / streamLineHeight(), 1, STREAM_MAX_LINES);
+
+    // Ha kevesebb sor fér el, a legrégebbiek kiesnek
+    if (streamLineCount_ > streamRows_) {
+        streamFirstLine_ = (streamFirstLine_ + streamLineCount_ - streamRows_) % STREAM_MAX_LINES;
+        streamLineCount_ = streamRows_;
+    }
+    fullRedrawPending_ = true;
+}
+
+/**
+ * @brief A sor-gyűrű és a kirajzolásra váró puffer törlése
+ */
+void UITextBox::streamClear() {
+    if (pStream_ != nullptr) {
+        for (uint8_t i = 0; i < STREAM_MAX_LINES; i++) {
+            pStream_->lines[i][0] = '\0';
+        }
+    }
+    streamFirstLine_ = 0;
+    streamLineCount_ = 1;
+    streamColumn_ = 0;
+    pendingHead_ = 0;
+    pendingTail_ = 0;
+    fullRedrawPending_ = true;
+}
+
+/**
+ * @brief A sprite egy téglalapjának kirakása a képernyőre
+ */
+void UITextBox::streamPushRect(int16_t x, int16_t y, int16_t w, int16_t h) { _sprite.pushSprite(bounds.x + x, bounds.y + y, x, y, w, h); }
+
+/**
+ * @brief Új sor a kurzornál; ha a doboz tele van, egy sorral feljebb görget
+ * @param render Rajzoljunk-e (görgetés esetén a sprite egyetlen blokkmozgatása és kirakása)
+ * @return true ha görgetés történt
+ */
+bool UITextBox::streamNewLine(bool render) {
+    streamColumn_ = 0;
+    if (streamLineCount_ < streamRows_) {
+        streamLineCount_++;
+        streamCurrentLine()[0] = '\0';
+        return false;
+    }
+
+    streamFirstLine_ = (streamFirstLine_ + 1) % STREAM_MAX_LINES;
+    streamCurrentLine()[0] = '\0';
+    if (render) {
+        // A keret belseje egy sorral feljebb, az alul felszabaduló terület háttérszínnel töltődik
+        _sprite.setScrollRect(1, 1, bounds.width - 2, bounds.height - 2, bgColor);
+        _sprite.scroll(0, -streamLineHeight());
+        _sprite.pushSprite(bounds.x, bounds.y);
+    }
+    return true;
+}
+
+/**
+ * @brief Egy karakter a sor-gyűrűbe, opcionálisan kirajzolva a kurzornál
+ * @details Sor végén szótördelés: a félbemaradt szó a következő sorba kerül
+ */
+void UITextBox::streamPutChar(char c, bool render) {
+    if (c == '\n') {
+        streamNewLine(render);
+        return;
+    }
+    if (static_cast<uint8_t>(c) < ' ') {
+        return; // Vezérlőkarakterek (pl. '\r') kihagyása
+    }
+
+    const int16_t charWidth = streamCharWidth();
+    const int16_t lineHeight = streamLineHeight();
+
+    if (streamColumn_ >= streamColumns_) {
+        char *line = streamCurrentLine();
+        char carry[STREAM_MAX_COLUMNS + 1] = "";
+        int16_t rowY = TEXT_PADDING + (streamLineCount_ - 1) * lineHeight;
+        int16_t eraseX = 0;
+        int16_t eraseW = 0;
+
+        // A félbemaradt szó áthelyezése (ha nem az egész sor egyetlen szó)
+        char *lastSpace = (c != ' ') ? strrchr(line, ' ') : nullptr;
+        if (lastSpace != nullptr && lastSpace != line) {
+            uint8_t spacePos = lastSpace - line;
+            strcpy(carry, lastSpace + 1);
+            line[spacePos] = '\0';
+            eraseX = TEXT_PADDING + spacePos * charWidth;
+            eraseW = (streamColumn_ - spacePos) * charWidth;
+            if (render) {
+                _sprite.fillRect(eraseX, rowY, eraseW, lineHeight, bgColor);
+            }
+        }
+
+        bool scrolled = streamNewLine(render);
+        if (render && eraseW > 0 && !scrolled) {
+            streamPushRect(eraseX, rowY, eraseW, lineHeight);
+        }
+        for (const char *p = carry; *p; ++p) {
+            streamPutChar(*p, render);
+        }
+        if (c == ' ' && carry[0] == '\0') {
+            return; // Sor elején nem kezdünk szóközzel
+        }
+    }
+
+    char *line = streamCurrentLine();
+    line[streamColumn_] = c;
+    line[streamColumn_ + 1] = '\0';
+    if (render) {
+        int16_t x = TEXT_PADDING + streamColumn_ * charWidth;
+        int16_t y = TEXT_PADDING + (streamLineCount_ - 1) * lineHeight;
+        _sprite.drawChar(x, y, c, textColor, bgColor, textSize);
+        streamPushRect(x, y, charWidth, lineHeight);
+    }
+    streamColumn_++;
+}
+
+/**
+ * @brief A teljes stream tartalom kirajzolása a sor-gyűrűből
+ */
+void UITextBox::streamRenderFull() {
+    _sprite.fillSprite(bgColor);
+    _sprite.drawRect(0, 0, bounds.width, bounds.height, TFT_DARKGREY);
+    _sprite.setTextColor(textColor, bgColor);
+    _sprite.setTextDatum(TL_DATUM);
+    _sprite.setFreeFont();
+    _sprite.setTextSize(textSize);
+    for (uint8_t r = 0; r < streamLineCount_; r++) {
+        _sprite.drawString(pStream_->lines[(streamFirstLine_ + r) % STREAM_MAX_LINES], TEXT_PADDING, TEXT_PADDING + r * streamLineHeight());
+    }
+    _sprite.pushSprite(bounds.x, bounds.y);
+}
 
 void UITextBox::setTextColor(uint16_t fg, uint16_t bg) {
     textColor = fg;
@@ -55,6 +285,7 @@ void UITextBox::setTextSize(uint8_t size) {
     textSize = size;
     if (_spriteCreated)
         _sprite.setTextSize(textSize);
+    updateStreamGeometry();
     markForRedraw();
 }
 
@@ -70,6 +301,26 @@ void UITextBox::draw() {
         return;
     }
 
+    // Stream mód: csak a hozzáfűzött karakterek, vagy szükség esetén a teljes tartalom
+    if (streamMode_) {
+        if (fullRedrawPending_) {
+            while (pendingTail_ != pendingHead_) {
+                streamPutChar(pStream_->pending[pendingTail_], false);
+                pendingTail_ = (pendingTail_ + 1) & (STREAM_PENDING_SIZE - 1);
+            }
+            streamRenderFull();
+            fullRedrawPending_ = false;
+        } else {
+            _sprite.setFreeFont();
+            while (pendingTail_ != pendingHead_) {
+                streamPutChar(pStream_->pending[pendingTail_], true);
+                pendingTail_ = (pendingTail_ + 1) & (STREAM_PENDING_SIZE - 1);
+            }
+        }
+        needsRedraw = false;
+        return;
+    }
+
     // 1. Sprite háttér törlése
     _sprite.fillSprite(bgColor);
     _sprite.drawRect(0, 0, bounds.width, bounds.height, TFT_DARKGREY); // Keret a sprite-on belül
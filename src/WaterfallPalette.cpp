@@ -0,0 +1,104 @@
+#include "WaterfallPalette.h"
+
+#include <stddef.h>
+
+namespace {
+
+/**
+ * @brief Színátmenet pont: a pos értéknél a szín (r, g, b), közöttük lineáris átmenet
+ */
+struct PaletteStop {
+    uint8_t pos;
+    uint8_t r;
+    uint8_t g;
+    uint8_t b;
+};
+
+struct PaletteTable {
+    uint16_t colors[256];
+};
+
+/**
+ * @brief 256 elemes RGB565 tábla a színátmenet pontokból (fordítási időben)
+ * @param stops Növekvő pos szerinti pontok, az első pos = 0, az utolsó pos = 255
+ */
+template <size_t N> constexpr PaletteTable makePalette(const PaletteStop (&stops)[N]) {
+    PaletteTable table{};
+    size_t s = 0;
+    for (int i = 0; i < 256; i++) {
+        while (s + 2 < N && i > stops[s + 1].pos) {
+            s++;
+        }
+        const PaletteStop &a = stops[s];
+        const PaletteStop &b = stops[s + 1];
+        const int span = b.pos - a.pos;
+        const int t = span > 0 ? i - a.pos : 0;
+        const int r = span > 0 ? a.r + (b.r - a.r) * t / span : a.r;
+        const int g = span > 0 ? a.g + (b.g - a.g) * t / span : a.g;
+        const int bl = span > 0 ? a.b + (b.b - a.b) * t / span : a.b;
+        table.colors[i] = static_cast<uint16_t>(((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (bl >> 3));
+    }
+    return table;
+}
+
+constexpr PaletteStop CLASSIC_STOPS[] = {
+    {0, 0, 0, 0},        //
+    {48, 0, 0, 160},     //
+    {96, 0, 0, 255},     //
+    {144, 255, 128, 0},  //
+    {176, 255, 190, 0},  //
+    {192, 255, 255, 0},  //
+    {255, 255, 255, 255} //
+};
+
+constexpr PaletteStop GRAYSCALE_STOPS[] = {
+    {0, 0, 0, 0},        //
+    {255, 255, 255, 255} //
+};
+
+constexpr PaletteStop HIGH_CONTRAST_STOPS[] = {
+    {0, 0, 0, 0},        //
+    {40, 0, 0, 255},     //
+    {90, 0, 255, 255},   //
+    {140, 0, 255, 0},    //
+    {180, 255, 255, 0},  //
+    {220, 255, 0, 0},    //
+    {255, 255, 255, 255} //
+};
+
+constexpr PaletteStop NIGHT_RED_STOPS[] = {
+    {0, 0, 0, 0},      //
+    {200, 255, 0, 0},  //
+    {255, 255, 64, 32} //
+};
+
+constexpr PaletteTable PALETTES[] = {
+    makePalette(CLASSIC_STOPS),       // WaterfallPaletteType::Classic
+    makePalette(GRAYSCALE_STOPS),     // WaterfallPaletteType::Grayscale
+    makePalette(HIGH_CONTRAST_STOPS), // WaterfallPaletteType::HighContrast
+    makePalette(NIGHT_RED_STOPS),     // WaterfallPaletteType::NightRed
+};
+static_assert(sizeof(PALETTES) / sizeof(PALETTES[0]) == static_cast<size_t>(WaterfallPaletteType::Count), "Minden WaterfallPaletteType-hoz kell tábla");
+
+constexpr const char *PALETTE_NAMES[] = {"Classic", "Gray", "Contrast", "Night"};
+static_assert(sizeof(PALETTE_NAMES) / sizeof(PALETTE_NAMES[0]) == static_cast<size_t>(WaterfallPaletteType::Count), "Minden WaterfallPaletteType-hoz kell név");
+
+} // namespace
+
+namespace WaterfallPalette {
+
+const uint16_t *get(uint8_t paletteIndex) {
+    if (paletteIndex >= static_cast<uint8_t>(WaterfallPaletteType::Count)) {
+        paletteIndex = static_cast<uint8_t>(WaterfallPaletteType::Classic);
+    }
+    return PALETTES[paletteIndex].colors;
+}
+
+const char *getName(uint8_t paletteIndex) {
+    if (paletteIndex >= static_cast<uint8_t>(WaterfallPaletteType::Count)) {
+        paletteIndex = static_cast<uint8_t>(WaterfallPaletteType::Classic);
+    }
+    return PALETTE_NAMES[paletteIndex];
+}
+
+} // namespace WaterfallPalette
@@ -0,0 +1,494 @@
+#include "WefaxDecoder.h"
+#include "AudioProcessor.h"
+#include "defines.h"
+#include <cmath>
+#include <hardware/sync.h>
+
+namespace {
+
+constexpr uint8_t WHITE_LEVEL = 128;       // E feletti képpont fehérnek számít (fázisozás)
+constexpr float PHASING_MIN_WHITE = 0.02f; // Fázisozó sor: a fehér képpontok aránya 2%...
+constexpr float PHASING_MAX_WHITE = 0.15f; // ... és 15% között (névlegesen 5%)
+constexpr uint8_t PHASING_PULSE_BINS = 3;  // A fehér impulzus szélessége rekeszekben (5% ~ 24 képpont)
+
+/**
+ * @brief Gyors atan2 közelítés (~0.0001 rad hiba), az FPU nélküli core1 miatt
+ */
+float fastAtan2(float y, float x) {
+    const float ax = fabsf(x);
+    const float ay = fabsf(y);
+    const float mx = std::max(ax, ay);
+    if (mx < 1.0e-20f) {
+        return 0.0f;
+    }
+    const float a = std::min(ax, ay) / mx;
+    const float s = a * a;
+    float r = ((-0.0464964749f * s + 0.15931422f) * s - 0.327622764f) * s * a + a;
+    if (ay > ax) {
+        r = HALF_PI - r;
+    }
+    if (x < 0.0f) {
+        r = PI - r;
+    }
+    return y < 0.0f ? -r : r;
+}
+} // namespace
+
+int16_t WefaxDecoder::sinTable_[WefaxConstants::NCO_TABLE_SIZE];
+bool WefaxDecoder::sinTableReady_ = false;
+
+/**
+ * @brief Konstruktor
+ */
+WefaxDecoder::WefaxDecoder()
+    : rowHead_(0),              //
+      rowTail_(0),              //
+      state_(State::Idle),      //
+      imageCounter_(0),         //
+      rowCount_(0),             //
+      requestedSlantPpm_(0),    //
+      slantChanged_(false),     //
+      startRequested_(false),   //
+      stopRequested_(false) {
+
+    // NCO szinusz tábla (Q12) egyszeri feltöltése
+    if (!sinTableReady_) {
+        for (uint16_t i = 0; i < WefaxConstants::NCO_TABLE_SIZE; i++) {
+            sinTable_[i] = static_cast<int16_t>(std::lround(WefaxConstants::NCO_AMPLITUDE * sinf(TWO_PI * i / WefaxConstants::NCO_TABLE_SIZE)));
+        }
+        sinTableReady_ = true;
+    }
+
+    reset(AudioProcessorConstants::DEFAULT_AM_SAMPLING_FREQUENCY);
+}
+
+/**
+ * @brief Dekóder alaphelyzetbe állítása (a start hangra várakozó állapotba)
+ * @param samplingFrequency Az aktuális mintavételezési frekvencia Hz-ben
+ */
+void WefaxDecoder::reset(uint16_t samplingFrequency) {
+
+    samplingFrequency_ = samplingFrequency > 0 ? samplingFrequency : AudioProcessorConstants::DEFAULT_AM_SAMPLING_FREQUENCY;
+
+    // Decimálás ~4 kHz-re (integráló-ürítő), a +/-400 Hz löket és a képtartalom bőven belefér
+    decimationFactor_ = std::max(1, static_cast<int>(std::lround(static_cast<float>(samplingFrequency_) / WefaxConstants::TARGET_DECIMATED_RATE)));
+    decimatedRate_ = static_cast<float>(samplingFrequency_) / decimationFactor_;
+    decimationScale_ = 1.0f / (static_cast<float>(decimationFactor_) * 2048.0f * WefaxConstants::NCO_AMPLITUDE);
+    decimationCount_ = 0;
+    accI_ = 0;
+    accQ_ = 0;
+
+    // Hann ablakos sinc aluláteresztő: a keverés 2*1900 Hz-es tükörképét és a sávon kívüli zajt vágja
+    const float fc = WefaxConstants::LOWPASS_CUTOFF_HZ / decimatedRate_;
+    const int8_t mid = WefaxConstants::LOWPASS_TAPS / 2;
+    float sum = 0.0f;
+    for (int8_t n = 0; n < WefaxConstants::LOWPASS_TAPS; n++) {
+        const int8_t k = n - mid;
+        const float sinc = k == 0 ? 2.0f * fc : sinf(TWO_PI * fc * k) / (PI * k);
+        const float window = 0.5f - 0.5f * cosf(TWO_PI * (n + 1) / (WefaxConstants::LOWPASS_TAPS + 1));
+        lowpassTaps_[n] = sinc * window;
+        sum += lowpassTaps_[n];
+    }
+    for (uint8_t n = 0; n < WefaxConstants::LOWPASS_TAPS; n++) {
+        lowpassTaps_[n] /= sum;
+    }
+    memset(lowpassI_, 0, sizeof(lowpassI_));
+    memset(lowpassQ_, 0, sizeof(lowpassQ_));
+    lowpassPos_ = 0;
+
+    // Diszkriminátor: fázisléptetés -> frekvencia eltérés -> a löket arányában 0...255
+    prevI_ = 0.0f;
+    prevQ_ = 0.0f;
+    greyScale_ = decimatedRate_ / (TWO_PI * WefaxConstants::DEVIATION_HZ);
+
+    // Start/stop hang korrelátorok
+    const uint16_t toneHz[2] = {WefaxConstants::START_TONE_HZ, WefaxConstants::STOP_TONE_HZ};
+    for (uint8_t t = 0; t < 2; t++) {
+        toneRotI_[t] = cosf(TWO_PI * toneHz[t] / decimatedRate_);
+        toneRotQ_[t] = sinf(TWO_PI * toneHz[t] / decimatedRate_);
+        tonePhaseI_[t] = 1.0f;
+        tonePhaseQ_[t] = 0.0f;
+        toneAccI_[t] = 0.0f;
+        toneAccQ_[t] = 0.0f;
+    }
+    toneSum_ = 0.0f;
+    toneSumSq_ = 0.0f;
+    toneWindowPos_ = 0;
+    toneWindowLength_ = static_cast<uint16_t>(decimatedRate_ * WefaxConstants::TONE_WINDOW_MS / 1000.0f);
+    startHits_ = 0;
+    stopHits_ = 0;
+
+    // Függőleges méretarány: egy sor IOC * PI képpont széles, ezt IMAGE_WIDTH képpontra sűrítjük
+    linesPerRow_ = WefaxConstants::IOC * PI / WefaxConstants::IMAGE_WIDTH;
+
+    linePos_ = 0.0f;
+    slantChanged_ = false;
+    updateLineTiming();
+    endImage();
+
+    ncoPhase_ = 0;
+    ncoIncrement_ = static_cast<uint32_t>(WefaxConstants::CARRIER_HZ / samplingFrequency_ * 4294967296.0f);
+
+    DEBUG("WefaxDecoder::reset() -> Fs: %u Hz, decimálás: %u, Fs dec: %d Hz, minta/sor: %d\n", samplingFrequency_, decimationFactor_, static_cast<int>(decimatedRate_),
+          static_cast<int>(samplesPerLine_));
+}
+
+/**
+ * @brief A ferdeség korrekció beállítása (core0-ról hívható)
+ * @param ppm A mintavételi óra relatív hibája ppm-ben
+ */
+void WefaxDecoder::setSlantPpm(int16_t ppm) {
+    requestedSlantPpm_ = constrain(ppm, -WefaxConstants::MAX_SLANT_PPM, WefaxConstants::MAX_SLANT_PPM);
+    slantChanged_ = true; // A core1 a következő sor végén veszi át
+}
+
+/**
+ * @brief A sor hosszának (decimált mintában) újraszámítása a sorfrekvenciából és a ferdeség korrekcióból
+ */
+void WefaxDecoder::updateLineTiming() {
+    const float nominal = decimatedRate_ * 60.0f / WefaxConstants::LINES_PER_MINUTE;
+    samplesPerLine_ = nominal * (1.0f + requestedSlantPpm_ * 1.0e-6f);
+    pixelScale_ = WefaxConstants::IMAGE_WIDTH / samplesPerLine_;
+}
+
+/**
+ * @brief Egy kész sor kivétele a sor-gyűrűből (core0-ról hívható)
+ * @param dst Legalább IMAGE_WIDTH bájtos cél puffer
+ * @return true ha volt kész sor
+ */
+bool WefaxDecoder::popRow(uint8_t *dst) {
+    if (rowTail_ == rowHead_) {
+        return false;
+    }
+    memcpy(dst, rowRing_[rowTail_], WefaxConstants::IMAGE_WIDTH);
+    __dmb(); // A másolás befejeződjön, mielőtt a core1 felülírhatja a slotot
+    rowTail_ = (rowTail_ + 1) & (WefaxConstants::ROW_RING_SIZE - 1);
+    return true;
+}
+
+/**
+ * @brief Egy audio minta feldolgozása: NCO keverés és decimálás (fixpontos, teljes mintavételi frekvencián)
+ * @param sample DC-mentes ADC minta
+ */
+void WefaxDecoder::processSample(int16_t sample) {
+
+    const uint8_t idx = ncoPhase_ >> (32 - WefaxConstants::NCO_TABLE_BITS);
+    const int32_t s = sinTable_[idx];
+    const int32_t c = sinTable_[(idx + WefaxConstants::NCO_TABLE_SIZE / 4) & (WefaxConstants::NCO_TABLE_SIZE - 1)];
+    ncoPhase_ += ncoIncrement_;
+
+    // Keverés alapsávba: x * e^(-j*phi), a fekete -400 Hz-re, a fehér +400 Hz-re kerül
+    accI_ += sample * c;
+    accQ_ -= sample * s;
+
+    if (++decimationCount_ >= decimationFactor_) {
+        processDecimated(accI_ * decimationScale_, accQ_ * decimationScale_);
+        accI_ = 0;
+        accQ_ = 0;
+        decimationCount_ = 0;
+    }
+}
+
+/**
+ * @brief Decimált komplex minta feldolgozása: szűrés, FM diszkriminátor, tónus detektor és sorórajel
+ */
+void WefaxDecoder::processDecimated(float i, float q) {
+
+    // Kézi indítás/leállítás a core0-ról
+    if (startRequested_) {
+        startRequested_ = false;
+        beginImage(State::Image);
+    }
+    if (stopRequested_) {
+        stopRequested_ = false;
+        endImage();
+    }
+
+    // 1. FIR aluláteresztő (körkörös késleltető sor)
+    lowpassI_[lowpassPos_] = i;
+    lowpassQ_[lowpassPos_] = q;
+    float fi = 0.0f;
+    float fq = 0.0f;
+    uint8_t pos = lowpassPos_;
+    for (uint8_t n = 0; n < WefaxConstants::LOWPASS_TAPS; n++) {
+        fi += lowpassTaps_[n] * lowpassI_[pos];
+        fq += lowpassTaps_[n] * lowpassQ_[pos];
+        pos = pos == 0 ? WefaxConstants::LOWPASS_TAPS - 1 : pos - 1;
+    }
+    lowpassPos_ = (lowpassPos_ + 1) % WefaxConstants::LOWPASS_TAPS;
+
+    // 2. FM diszkriminátor: arg(z[n] * conj(z[n-1])), a löket arányában (-1: fekete, +1: fehér)
+    const float re = fi * prevI_ + fq * prevQ_;
+    const float im = fq * prevI_ - fi * prevQ_;
+    prevI_ = fi;
+    prevQ_ = fq;
+    const float deviation = fastAtan2(im, re) * greyScale_;
+
+    // A küszöb alatti vételnél fellépő FM kattanások ne nyomják el a hang detektort
+    detectTones(constrain(deviation, -1.0f, 1.0f));
+    if (state_ == State::Idle) {
+        return;
+    }
+
+    // 3. Képpont átlagolás: a sor egy képpontjára eső decimált minták átlaga
+    const int16_t x = static_cast<int16_t>(linePos_ * pixelScale_);
+    if (x != pixelX_) {
+        finishPixel();
+        pixelX_ = x;
+    }
+    const int16_t grey = constrain(static_cast<int16_t>(127.5f + deviation * 127.5f), 0, 255);
+    pixelSum_ += grey;
+    pixelCount_++;
+
+    // 4. Sorórajel
+    linePos_ += 1.0f;
+    if (linePos_ >= samplesPerLine_) {
+        linePos_ -= samplesPerLine_;
+        finishPixel();
+        pixelX_ = 0;
+        finishLine();
+    }
+}
+
+/**
+ * @brief APT start/stop hang detektor
+ * @details A start (300 Hz) és stop (450 Hz) hang a fekete és fehér szint közötti négyszög moduláció.
+ *          Ablakonként a diszkriminátor kimenetét mindkét hanggal korreláljuk (egy bines DFT); ha a hang
+ *          teljesítménye a kimenet varianciájának jelentős része, az ablak találatnak számít.
+ *          A képtartalom és a zaj teljesítménye szétterül, így nem ad találatot.
+ * @param deviation A diszkriminátor kimenete (-1: fekete, +1: fehér)
+ */
+void WefaxDecoder::detectTones(float deviation) {
+
+    for (uint8_t t = 0; t < 2; t++) {
+        const float pc = tonePhaseI_[t];
+        const float ps = tonePhaseQ_[t];
+        toneAccI_[t] += deviation * pc;
+        toneAccQ_[t] += deviation * ps;
+        tonePhaseI_[t] = pc * toneRotI_[t] - ps * toneRotQ_[t];
+        tonePhaseQ_[t] = pc * toneRotQ_[t] + ps * toneRotI_[t];
+    }
+    toneSum_ += deviation;
+    toneSumSq_ += deviation * deviation;
+
+    if (++toneWindowPos_ < toneWindowLength_) {
+        return;
+    }
+
+    // Ablak vége: egy szinuszos komponens teljesítménye 2 * |X|^2 / N^2, a variancia a teljes AC teljesítmény
+    const float n = static_cast<float>(toneWindowLength_);
+    const float mean = toneSum_ / n;
+    const float variance = toneSumSq_ / n - mean * mean;
+    bool tonePresent[2];
+    for (uint8_t t = 0; t < 2; t++) {
+        const float power = 2.0f * (toneAccI_[t] * toneAccI_[t] + toneAccQ_[t] * toneAccQ_[t]) / (n * n);
+        tonePresent[t] = variance > 0.0f && power > WefaxConstants::TONE_POWER_RATIO * variance;
+
+        // Forgató újranormálása (a kerekítési hiba ne halmozódjon), az ablak törlése
+        const float mag = sqrtf(tonePhaseI_[t] * tonePhaseI_[t] + tonePhaseQ_[t] * tonePhaseQ_[t]);
+        tonePhaseI_[t] /= mag;
+        tonePhaseQ_[t] /= mag;
+        toneAccI_[t] = 0.0f;
+        toneAccQ_[t] = 0.0f;
+    }
+    toneSum_ = 0.0f;
+    toneSumSq_ = 0.0f;
+    toneWindowPos_ = 0;
+    startHits_ = tonePresent[0] ? std::min<uint8_t>(startHits_ + 1, UINT8_MAX) : 0;
+    stopHits_ = tonePresent[1] ? std::min<uint8_t>(stopHits_ + 1, UINT8_MAX) : 0;
+
+    // Csak a felfutó élre reagálunk, a hang folytatódása nem indít új képet
+    if (startHits_ == WefaxConstants::TONE_DETECT_WINDOWS) {
+        DEBUG("WefaxDecoder: start hang\n");
+        beginImage(State::Phasing);
+    } else if (stopHits_ == WefaxConstants::TONE_DETECT_WINDOWS && state_ != State::Idle) {
+        DEBUG("WefaxDecoder: stop hang, %u sor\n", rowCount_);
+        flushRow();
+        endImage();
+    }
+}
+
+/**
+ * @brief Az aktuális képpont lezárása a sor pufferbe
+ */
+void WefaxDecoder::finishPixel() {
+    if (pixelCount_ > 0 && pixelX_ >= 0 && pixelX_ < WefaxConstants::IMAGE_WIDTH) {
+        lineBuf_[pixelX_] = pixelSum_ / pixelCount_;
+    }
+    pixelSum_ = 0;
+    pixelCount_ = 0;
+}
+
+/**
+ * @brief Egy teljes sor feldolgozása: fázisozás vagy kiadás
+ */
+void WefaxDecoder::finishLine() {
+
+    // Új ferdeség korrekció a core0-ról (sorhatáron, hogy a sor ne törjön)
+    if (slantChanged_) {
+        slantChanged_ = false;
+        updateLineTiming();
+    }
+
+    if (skipLine_) {
+        skipLine_ = false;
+        return;
+    }
+
+    if (state_ == State::Phasing) {
+        phasingElapsed_++;
+        if (isPhasingLine()) {
+            phasingTotal_++;
+            if (++phasingLines_ >= WefaxConstants::PHASING_ALIGN_LINES) {
+                alignToPhasing();
+            }
+            return;
+        }
+        // Nem fázisozó sor: ha már volt elég fázisozás (vagy lejárt az idő), ez már a kép első sora
+        if (phasingTotal_ < WefaxConstants::PHASING_MIN_LINES && phasingElapsed_ < WefaxConstants::PHASING_TIMEOUT_LINES) {
+            return;
+        }
+        if (phasingLines_ > 0) {
+            alignToPhasing();
+        }
+        state_ = State::Image;
+        DEBUG("WefaxDecoder: kép indul, %u fázisozó sor\n", phasingTotal_);
+        if (skipLine_) {
+            return;
+        }
+    }
+
+    accumulateRow();
+}
+
+/**
+ * @brief Fázisozó sor-e: a sor nagy része fekete, egy keskeny (~5%) fehér impulzussal
+ * @details A fehér képpontokat a fázisozó hisztogramba is gyűjti
+ */
+bool WefaxDecoder::isPhasingLine() {
+    uint16_t white = 0;
+    for (uint16_t x = 0; x < WefaxConstants::IMAGE_WIDTH; x++) {
+        if (lineBuf_[x] >= WHITE_LEVEL) {
+            white++;
+        }
+    }
+    const float ratio = static_cast<float>(white) / WefaxConstants::IMAGE_WIDTH;
+    if (ratio < PHASING_MIN_WHITE || ratio > PHASING_MAX_WHITE) {
+        return false;
+    }
+    constexpr uint8_t binWidth = WefaxConstants::IMAGE_WIDTH / PHASING_BINS;
+    for (uint16_t x = 0; x < WefaxConstants::IMAGE_WIDTH; x++) {
+        if (lineBuf_[x] >= WHITE_LEVEL && phasingHist_[x / binWidth] < UINT8_MAX) {
+            phasingHist_[x / binWidth]++;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Sorkezdet igazítása: a fehér impulzus közepe kerüljön a sor elejére
+ * @details A hisztogramban a legtöbb fehér képpontot tartalmazó (körkörös) impulzus szélességű ablakot keresi
+ */
+void WefaxDecoder::alignToPhasing() {
+    uint16_t bestSum = 0;
+    uint8_t bestBin = 0;
+    for (uint8_t b = 0; b < PHASING_BINS; b++) {
+        uint16_t sum = 0;
+        for (uint8_t k = 0; k < PHASING_PULSE_BINS; k++) {
+            sum += phasingHist_[(b + k) % PHASING_BINS];
+        }
+        if (sum > bestSum) {
+            bestSum = sum;
+            bestBin = b;
+        }
+    }
+    memset(phasingHist_, 0, sizeof(phasingHist_));
+    phasingLines_ = 0;
+
+    // Az impulzus közepe (képpontban) -> eltolás decimált mintában; az épp induló sor csonka lesz
+    constexpr uint8_t binWidth = WefaxConstants::IMAGE_WIDTH / PHASING_BINS;
+    const float centerX = (bestBin + PHASING_PULSE_BINS / 2.0f) * binWidth;
+    float offset = centerX / pixelScale_;
+    if (offset >= samplesPerLine_) {
+        offset -= samplesPerLine_;
+    }
+    linePos_ = samplesPerLine_ - offset;
+    if (linePos_ >= samplesPerLine_) {
+        linePos_ -= samplesPerLine_;
+    }
+    pixelX_ = static_cast<int16_t>(linePos_ * pixelScale_);
+    skipLine_ = offset > 0.5f;
+}
+
+/**
+ * @brief A sor hozzáadása a függőleges átlaghoz, kész kimeneti sor kiadása
+ */
+void WefaxDecoder::accumulateRow() {
+    for (uint16_t x = 0; x < WefaxConstants::IMAGE_WIDTH; x++) {
+        rowSum_[x] += lineBuf_[x];
+    }
+    rowLines_++;
+    rowPhase_ += 1.0f;
+    if (rowPhase_ >= linesPerRow_) {
+        rowPhase_ -= linesPerRow_;
+        flushRow();
+    }
+}
+
+/**
+ * @brief Az átlagolt sor betétele a sor-gyűrűbe (ha a core0 lemaradt, a sor elveszik)
+ */
+void WefaxDecoder::flushRow() {
+    if (rowLines_ == 0) {
+        return;
+    }
+    const uint8_t next = (rowHead_ + 1) & (WefaxConstants::ROW_RING_SIZE - 1);
+    if (next != rowTail_) {
+        uint8_t *dst = rowRing_[rowHead_];
+        for (uint16_t x = 0; x < WefaxConstants::IMAGE_WIDTH; x++) {
+            dst[x] = rowSum_[x] / rowLines_;
+        }
+        __dmb(); // A sor tartalma látható legyen, mielőtt a fej mozdul
+        rowHead_ = next;
+    }
+    rowCount_ = rowCount_ + 1;
+    memset(rowSum_, 0, sizeof(rowSum_));
+    rowLines_ = 0;
+}
+
+/**
+ * @brief Új kép kezdése
+ * @param state Phasing: start hang után, Image: kézi indítás (fázisozás nélkül)
+ */
+void WefaxDecoder::beginImage(State state) {
+    linePos_ = 0.0f;
+    pixelX_ = 0;
+    pixelSum_ = 0;
+    pixelCount_ = 0;
+    skipLine_ = false;
+    memset(lineBuf_, 0, sizeof(lineBuf_));
+    memset(phasingHist_, 0, sizeof(phasingHist_));
+    phasingLines_ = 0;
+    phasingTotal_ = 0;
+    phasingElapsed_ = 0;
+    memset(rowSum_, 0, sizeof(rowSum_));
+    rowLines_ = 0;
+    rowPhase_ = 0.0f;
+    rowCount_ = 0;
+    state_ = state;
+    imageCounter_ = imageCounter_ + 1;
+}
+
+/**
+ * @brief A kép lezárása, vissza a start hangra várakozásba
+ */
+void WefaxDecoder::endImage() {
+    state_ = State::Idle;
+    pixelX_ = 0;
+    pixelSum_ = 0;
+    pixelCount_ = 0;
+    skipLine_ = false;
+    memset(rowSum_, 0, sizeof(rowSum_));
+    rowLines_ = 0;
+    rowPhase_ = 0.0f;
+}
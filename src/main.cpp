@@ -28,6 +28,7 @@ RotaryEncoder rotaryEncoder = RotaryEncoder(PIN_ENCODER_CLK, PIN_ENCODER_DT, PIN
 RPI_PICO_Timer audioDecoderTimer(1); // 1-es timer használata
 
 //------------------ TFT
+#include "TftDmaManager.h"
 #include <TFT_eSPI.h>
 TFT_eSPI tft;
 uint16_t SCREEN_W;
@@ -79,6 +80,7 @@ void setup() {
     tft.init();
     tft.setRotation(1);
     tft.fillScreen(TFT_BLACK); // Fekete háttér a splash screen-hez
+    TftDmaManager::init();     // Sprite kirakás DMA-val (spektrum/waterfall)
 
     // UI komponensek számára képernyő méretek inicializálása
     SCREEN_W = tft.width();
@@ -299,39 +301,59 @@ void loop() {
         lasDebugMemoryInfo = millis();
     }
 #endif
-    //------------------- Touch esemény kezelése
-    uint16_t touchX, touchY;
-    bool touchedRaw = tft.getTouch(&touchX, &touchY);
-    bool validCoordinates = true;
-    if (touchedRaw) {
-        if (touchX > tft.width() || touchY > tft.height()) {
-            validCoordinates = false;
-        }
+    // SI4735 loop hívása, squelch és hardver némítás kezelése (I2C, az előző keret DMA átvitele alatt is futhat)
+    if (pSi4735Manager) {
+        pSi4735Manager->loop();
     }
 
-    static bool lastTouchState = false;
-    static uint16_t lastTouchX = 0, lastTouchY = 0;
-    bool touched = touchedRaw && validCoordinates;
-
-    // Touch press event (immediate response)
-    if (touched && !lastTouchState) {
-        TouchEvent touchEvent(touchX, touchY, true);
-        screenManager->handleTouch(touchEvent);
-        lastTouchX = touchX;
-        lastTouchY = touchY;
-    } else if (!touched && lastTouchState) { // Touch release event (immediate response)
-        TouchEvent touchEvent(lastTouchX, lastTouchY, false);
-        screenManager->handleTouch(touchEvent);
+    //------------------- Rotary Encoder olvasása (SPI nélkül, az átvitel alatt is)
+    RotaryEncoder::EncoderState encoderState = rotaryEncoder.read();
+    bool rotaryActive = encoderState.direction != RotaryEncoder::Direction::None || encoderState.buttonState != RotaryEncoder::ButtonState::Open;
+
+    // A kijelző és az érintés vezérlő közös SPI buszon van, minden képernyő kód közvetlenül rajzol:
+    // amíg az előző keret DMA átvitele fut, nem várakozunk, hanem újrakezdjük a ciklust (a fenti munka tovább fut).
+    // Tekerés/gombnyomás esetén az eseményt nem tartjuk vissza, megvárjuk az átvitel végét.
+    if (!rotaryActive && TftDmaManager::isTransferring()) {
+        return;
     }
+    TftDmaManager::waitIdle();
 
-    lastTouchState = touched;
+    //------------------- Touch esemény kezelése
+#define TOUCH_POLL_INTERVAL 10 // Érintés olvasási periódus (msec), nem minden ciklusban foglaljuk az SPI buszt
+    static uint32_t lastTouchPoll = 0;
+    if (millis() - lastTouchPoll >= TOUCH_POLL_INTERVAL) {
+        lastTouchPoll = millis();
+
+        uint16_t touchX, touchY;
+        bool touchedRaw = tft.getTouch(&touchX, &touchY);
+        bool validCoordinates = true;
+        if (touchedRaw) {
+            if (touchX > tft.width() || touchY > tft.height()) {
+                validCoordinates = false;
+            }
+        }
 
-    //------------------- Rotary Encoder esemény kezelése
-    // Rotary Encoder olvasása
-    RotaryEncoder::EncoderState encoderState = rotaryEncoder.read();
+        static bool lastTouchState = false;
+        static uint16_t lastTouchX = 0, lastTouchY = 0;
+        bool touched = touchedRaw && validCoordinates;
+
+        // Touch press event (immediate response)
+        if (touched && !lastTouchState) {
+            TouchEvent touchEvent(touchX, touchY, true);
+            screenManager->handleTouch(touchEvent);
+            lastTouchX = touchX;
+            lastTouchY = touchY;
+        } else if (!touched && lastTouchState) { // Touch release event (immediate response)
+            TouchEvent touchEvent(lastTouchX, lastTouchY, false);
+            screenManager->handleTouch(touchEvent);
+        }
+
+        lastTouchState = touched;
+    }
 
+    //------------------- Rotary Encoder esemény kezelése
     // Rotary encoder eseményeinek továbbítása a ScreenManager-nek
-    if (encoderState.direction != RotaryEncoder::Direction::None || encoderState.buttonState != RotaryEncoder::ButtonState::Open) {
+    if (rotaryActive) {
 
         // RotaryEvent létrehozása a ScreenManager típusaival
         RotaryEvent::Direction direction = RotaryEvent::Direction::None;
@@ -362,10 +384,8 @@ void loop() {
         screenManager->loop();
     }
 
-    // SI4735 loop hívása, squelch és hardver némítás kezelése
-    if (pSi4735Manager) {
-        pSi4735Manager->loop();
-    }
+    // Az előjegyzett sprite kirakás indítása DMA-val: a következő ciklusok SPI-t nem használó része alatt fut
+    TftDmaManager::startPending();
 
     // // Core1 Audio Manager debug információk kiírása
     // static uint32_t lasAudioCore1ManagerDebugInfo = 0;
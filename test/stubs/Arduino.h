@@ -0,0 +1,49 @@
+/**
+ * @file Arduino.h
+ * @brief Minimális Arduino API a natív (host) tesztekhez
+ * @details Csak azt adja, amit a natívan fordított forrásfájlok ténylegesen használnak.
+ */
+#pragma once
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cmath>
+#include <cstdarg>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+#ifndef PI
+#define PI 3.1415926535897932384626433832795
+#define HALF_PI 1.5707963267948966192313216916398
+#define TWO_PI 6.283185307179586476925286766559
+#endif
+
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+
+/**
+ * @brief A program indulása óta eltelt idő ms-ban
+ */
+inline unsigned long millis() {
+    static const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
+#define A0 26
+#define A1 27
+
+/**
+ * @brief A Serial helyettesítője: a printf a szabványos kimenetre ír
+ */
+struct NativeSerial {
+    int printf(const char *fmt, ...) __attribute__((format(printf, 2, 3))) {
+        va_list args;
+        va_start(args, fmt);
+        const int n = vprintf(fmt, args);
+        va_end(args);
+        return n;
+    }
+};
+
+inline NativeSerial Serial;
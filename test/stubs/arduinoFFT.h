@@ -0,0 +1,8 @@
+/**
+ * @file arduinoFFT.h
+ * @brief Üres ArduinoFFT sablon a natív tesztekhez
+ * @details Az AudioProcessor.h csak tagként deklarálja, a natív tesztek az FFT-t nem használják.
+ */
+#pragma once
+
+template <typename T> class ArduinoFFT {};
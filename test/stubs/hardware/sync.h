@@ -0,0 +1,9 @@
+/**
+ * @file sync.h
+ * @brief A pico-sdk memória korlát helyettesítője a natív tesztekhez
+ */
+#pragma once
+
+#include <atomic>
+
+inline void __dmb() { std::atomic_thread_fence(std::memory_order_seq_cst); }
@@ -0,0 +1,317 @@
+/**
+ * @file test_main.cpp
+ * @brief A NavtexDecoder natív tesztje szintetikus SITOR-B (FEC) jellel
+ * @details 100 Bd, 170 Hz eltolású FSK az alapértelmezett 1000 Hz-es középfrekvencián, enyhe zajjal.
+ *          A DX/RX karakterek 5 réssel eltolva, egymásba fésülve mennek; egyes karakterek DX (vagy RX)
+ *          példányába egybites hiba kerül (a 4B/3Y súly sérül), egy karakter mindkét példánya hibás.
+ *          Ugyanaz az EA01 üzenet háromszor jön (hibásan, hibátlanul, ismét hibásan), az EA00 kétszer.
+ */
+#include <unity.h>
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include "NavtexDecoder.h"
+
+namespace {
+constexpr uint16_t SAMPLING_FREQUENCY = 12000; // A core1 alapértelmezett AM mintavételi frekvenciája
+constexpr float AMPLITUDE = 1500.0f;           // A DC-mentes ADC minta amplitúdója
+constexpr float NOISE_AMPLITUDE = 300.0f;      // Egyenletes eloszlású zaj csúcsértéke
+constexpr uint32_t NOISE_SEED = 476;           // Ismételhető zaj
+constexpr float LEAD_IN_SECONDS = 0.37f;       // Csak zaj az adás előtt (tetszőleges bitfázis)
+constexpr uint16_t PREAMBLE_CHARS = 40;        // Fázisozó karakterek az első üzenet előtt
+constexpr uint16_t GAP_CHARS = 12;             // Fázisozó karakterek az üzenetek között (az utolsó RX döntésig)
+
+// CCIR-476 (ITU-R M.476) kódok, B = 1, az elsőként adott bit a legmagasabb helyiértékű
+constexpr uint8_t CODE_LTRS = 0x5A;
+constexpr uint8_t CODE_FIGS = 0x36;
+constexpr uint8_t CODE_CR = 0x78;
+constexpr uint8_t CODE_LF = 0x6C;
+constexpr uint8_t CODE_SPACE = 0x5C;
+constexpr uint8_t CODE_ALPHA = 0x0F; // Fázisozó jel 1 (DX rés)
+constexpr uint8_t CODE_REP = 0x66;   // Fázisozó jel 2 (RX rés)
+constexpr uint8_t LETTER_CODES[26] = {0x47, 0x72, 0x1D, 0x53, 0x56, 0x1B, 0x35, 0x69, 0x4D, 0x17, 0x1E, 0x65, 0x39,
+                                      0x59, 0x71, 0x2D, 0x2E, 0x55, 0x4B, 0x74, 0x4E, 0x3C, 0x27, 0x3A, 0x2B, 0x63};
+const char *DIGIT_LETTERS = "PQWERTYUIO"; // A 0-9 számjegyek betű párja (szám váltásban)
+constexpr uint8_t BIT_ERROR = 0x01;       // Egybites hiba: a 4B/3Y súly 3B/3Y vagy 5B/3Y lesz
+
+const char *MESSAGE_BODY = "GALE WARNING 7 SEA AREA 12";
+const char *MESSAGE_EA01 = "ZCZC EA01\r\nGALE WARNING 7 SEA AREA 12\r\nNNNN\r\n";
+const char *MESSAGE_EA00 = "ZCZC EA00\r\nGALE WARNING 7 SEA AREA 12\r\nNNNN\r\n";
+constexpr uint8_t UNCORRECTABLE_BODY_INDEX = 2; // A 'L' mindkét példánya hibás
+
+/**
+ * @brief SITOR-B FEC adó: karakter sor, DX/RX időrés beosztás és folytonos fázisú FSK moduláció
+ */
+class NavtexSignalGenerator {
+  public:
+    explicit NavtexSignalGenerator(NavtexDecoder &decoder) : decoder_(decoder), noise_(NOISE_SEED), phase_(0.0), sentSlots_(0) {}
+
+    /**
+     * @brief Fázisozó karakterek (DX résben alpha, RX résben rep)
+     */
+    void phasing(uint16_t count) {
+        for (uint16_t i = 0; i < count; i++) {
+            chars_.push_back({CODE_ALPHA, false, false});
+        }
+    }
+
+    /**
+     * @brief Szöveg kódolása CCIR-476 szerint, betű/szám váltással
+     * @return Az első karakter sorszáma a karakter sorban (a hibák beállításához)
+     */
+    size_t text(const char *str) {
+        const size_t first = chars_.size();
+        for (const char *p = str; *p != '\0'; p++) {
+            const char c = *p;
+            if (c >= 'A' && c <= 'Z') {
+                shift(false);
+                chars_.push_back({LETTER_CODES[c - 'A'], false, false});
+            } else if (c >= '0' && c <= '9') {
+                shift(true);
+                chars_.push_back({LETTER_CODES[DIGIT_LETTERS[c - '0'] - 'A'], false, false});
+            } else {
+                chars_.push_back({c == '\r' ? CODE_CR : (c == '\n' ? CODE_LF : CODE_SPACE), false, false});
+            }
+        }
+        return first;
+    }
+
+    /**
+     * @brief Egy karakter DX és/vagy RX példányának elrontása (egybites hiba)
+     */
+    void corrupt(size_t index, bool dx, bool rx) {
+        chars_[index].dxError = dx;
+        chars_[index].rxError = rx;
+    }
+
+    /**
+     * @brief Karakter sor indexe a szövegben: a váltó kódokat átugorva a szöveg n-edik karaktere
+     */
+    size_t indexOfText(size_t first, size_t n) const {
+        size_t index = first;
+        for (size_t seen = 0;; index++) {
+            if (chars_[index].code == CODE_LTRS || chars_[index].code == CODE_FIGS) {
+                continue;
+            }
+            if (seen++ == n) {
+                return index;
+            }
+        }
+    }
+
+    /**
+     * @brief Csak zaj (az adás előtt)
+     */
+    void silence(float seconds) {
+        const uint32_t count = seconds * SAMPLING_FREQUENCY;
+        for (uint32_t i = 0; i < count; i++) {
+            emit(0.0f);
+        }
+    }
+
+    /**
+     * @brief Az eddig sorba állított karakterek minden még el nem küldött időrésének adása
+     * @details A 2i. rés (DX) az i. karaktert, a 2i+1. rés (RX) az 5 réssel korábbi DX, azaz az (i-2). karakter ismétlését viszi
+     */
+    void transmit() {
+        const size_t slotCount = chars_.size() * 2;
+        for (; sentSlots_ < slotCount; sentSlots_++) {
+            const size_t i = sentSlots_ / 2;
+            uint8_t code;
+            if ((sentSlots_ & 1) == 0) {
+                code = chars_[i].code ^ (chars_[i].dxError ? BIT_ERROR : 0);
+            } else if (i < 2 || chars_[i - 2].code == CODE_ALPHA) {
+                code = CODE_REP;
+            } else {
+                code = chars_[i - 2].code ^ (chars_[i - 2].rxError ? BIT_ERROR : 0);
+            }
+            for (int8_t bit = 6; bit >= 0; bit--) {
+                sendBit((code >> bit) & 1);
+            }
+        }
+    }
+
+  private:
+    struct TxChar {
+        uint8_t code;
+        bool dxError;
+        bool rxError;
+    };
+
+    NavtexDecoder &decoder_;
+    std::mt19937 noise_;
+    double phase_;
+    size_t sentSlots_;
+    bool figures_ = false;
+    std::vector<TxChar> chars_;
+
+    void shift(bool figures) {
+        if (figures != figures_) {
+            figures_ = figures;
+            chars_.push_back({figures ? CODE_FIGS : CODE_LTRS, false, false});
+        }
+    }
+
+    /**
+     * @brief Egy bit: B (1) a magasabb, Y (0) az alacsonyabb hang
+     */
+    void sendBit(uint8_t bit) {
+        const double freq = NavtexConstants::DEFAULT_CENTER_FREQUENCY_HZ + (bit ? 0.5 : -0.5) * NavtexConstants::SHIFT_HZ;
+        const uint16_t count = SAMPLING_FREQUENCY / NavtexConstants::BAUD_RATE;
+        for (uint16_t i = 0; i < count; i++) {
+            phase_ += TWO_PI * freq / SAMPLING_FREQUENCY;
+            if (phase_ >= TWO_PI) {
+                phase_ -= TWO_PI;
+            }
+            emit(AMPLITUDE * std::sin(phase_));
+        }
+    }
+
+    void emit(float value) {
+        std::uniform_real_distribution<float> noise(-NOISE_AMPLITUDE, NOISE_AMPLITUDE);
+        decoder_.processSample(static_cast<int16_t>(std::lround(value + noise(noise_))));
+    }
+};
+
+/**
+ * @brief A tár állapota egy-egy üzenet után
+ */
+struct StoreSnapshot {
+    uint8_t count;
+    bool newestValid;
+    NavtexDecoder::Message newest;
+};
+
+NavtexDecoder decoder;
+bool synchronizedAfterPreamble = false;
+std::string liveText;
+std::vector<StoreSnapshot> snapshots;
+
+/**
+ * @brief Üzenet adása a következő fázisozó szünettel, majd a tár állapotának rögzítése
+ */
+void sendMessage(NavtexSignalGenerator &generator) {
+    generator.phasing(GAP_CHARS);
+    generator.transmit();
+
+    char c;
+    while (decoder.popDecodedChar(c)) {
+        liveText += c;
+    }
+    StoreSnapshot snapshot = {};
+    snapshot.count = decoder.getMessageCount();
+    snapshot.newestValid = decoder.getMessage(0, snapshot.newest);
+    snapshots.push_back(snapshot);
+}
+
+/**
+ * @brief A teljes szintetikus adás dekódolása
+ */
+void decodeSyntheticTransmission() {
+    decoder.reset(SAMPLING_FREQUENCY);
+    NavtexSignalGenerator generator(decoder);
+
+    generator.silence(LEAD_IN_SECONDS);
+    generator.phasing(PREAMBLE_CHARS);
+    generator.transmit();
+    synchronizedAfterPreamble = decoder.isSynchronized();
+
+    // 1. EA01: minden harmadik karakter DX példánya, minden ötödik RX példánya hibás, egy karakter javíthatatlan
+    size_t first = generator.text(MESSAGE_EA01);
+    const size_t body = generator.indexOfText(first, strlen("ZCZC EA01\r\n"));
+    const size_t length = generator.indexOfText(first, strlen(MESSAGE_EA01) - 1) + 1 - first;
+    for (size_t i = 0; i < length; i++) {
+        generator.corrupt(first + i, i % 3 == 0, i % 5 == 0 && i % 3 != 0);
+    }
+    generator.corrupt(generator.indexOfText(body, UNCORRECTABLE_BODY_INDEX), true, true);
+    sendMessage(generator);
+
+    // 2. EA01 hibátlanul: a jobb minőségű ismétlés a régi helyére kerül
+    generator.text(MESSAGE_EA01);
+    sendMessage(generator);
+
+    // 3. EA01 ismét javíthatatlan hibával: eldobva
+    first = generator.text(MESSAGE_EA01);
+    generator.corrupt(generator.indexOfText(first, strlen("ZCZC EA01\r\n") + UNCORRECTABLE_BODY_INDEX), true, true);
+    sendMessage(generator);
+
+    // 4-5. EA00 kétszer: a 00 sorszám mindig új üzenet
+    generator.text(MESSAGE_EA00);
+    sendMessage(generator);
+    generator.text(MESSAGE_EA00);
+    sendMessage(generator);
+}
+} // namespace
+
+void setUp() {}
+
+void tearDown() {}
+
+void test_navtex_fsk_synchronizes_on_phasing() {
+    TEST_ASSERT_TRUE(synchronizedAfterPreamble);
+    TEST_ASSERT_TRUE(decoder.isSynchronized());
+}
+
+void test_navtex_fec_recovers_single_copy_errors() {
+    const StoreSnapshot &first = snapshots[0];
+    TEST_ASSERT_EQUAL_UINT(1, first.count);
+    TEST_ASSERT_TRUE(first.newestValid);
+    TEST_ASSERT_EQUAL('E', first.newest.station);
+    TEST_ASSERT_EQUAL('A', first.newest.subject);
+    TEST_ASSERT_EQUAL_UINT(1, first.newest.serial);
+
+    // A DX vagy RX példányában hibás karakterek javultak, csak a kétszer hibás maradt jelölve
+    std::string expected = MESSAGE_BODY;
+    expected[UNCORRECTABLE_BODY_INDEX] = '*';
+    TEST_ASSERT_EQUAL_UINT(1, first.newest.errorCount);
+    TEST_ASSERT_EQUAL_STRING(expected.c_str(), first.newest.text);
+}
+
+void test_navtex_live_text_marks_uncorrectable_character() {
+    std::string expected = MESSAGE_BODY;
+    expected[UNCORRECTABLE_BODY_INDEX] = '*';
+    TEST_ASSERT_TRUE(liveText.find(expected) != std::string::npos);
+    TEST_ASSERT_TRUE(liveText.find(MESSAGE_BODY) != std::string::npos);
+}
+
+void test_navtex_store_replaces_with_better_copy() {
+    const StoreSnapshot &second = snapshots[1];
+    TEST_ASSERT_EQUAL_UINT(1, second.count);
+    TEST_ASSERT_EQUAL_UINT(0, second.newest.errorCount);
+    TEST_ASSERT_EQUAL_STRING(MESSAGE_BODY, second.newest.text);
+}
+
+void test_navtex_store_drops_worse_duplicate() {
+    const StoreSnapshot &third = snapshots[2];
+    TEST_ASSERT_EQUAL_UINT(1, third.count);
+    TEST_ASSERT_EQUAL_UINT(0, third.newest.errorCount);
+    TEST_ASSERT_EQUAL_STRING(MESSAGE_BODY, third.newest.text);
+}
+
+void test_navtex_store_keeps_every_serial_zero() {
+    TEST_ASSERT_EQUAL_UINT(2, snapshots[3].count);
+    TEST_ASSERT_EQUAL_UINT(3, snapshots[4].count);
+
+    NavtexDecoder::Message message;
+    TEST_ASSERT_TRUE(decoder.getMessage(0, message));
+    TEST_ASSERT_EQUAL_UINT(0, message.serial);
+    TEST_ASSERT_TRUE(decoder.getMessage(1, message));
+    TEST_ASSERT_EQUAL_UINT(0, message.serial);
+    TEST_ASSERT_TRUE(decoder.getMessage(2, message));
+    TEST_ASSERT_EQUAL_UINT(1, message.serial);
+}
+
+int main(int argc, char **argv) {
+    decodeSyntheticTransmission();
+
+    UNITY_BEGIN();
+    RUN_TEST(test_navtex_fsk_synchronizes_on_phasing);
+    RUN_TEST(test_navtex_fec_recovers_single_copy_errors);
+    RUN_TEST(test_navtex_live_text_marks_uncorrectable_character);
+    RUN_TEST(test_navtex_store_replaces_with_better_copy);
+    RUN_TEST(test_navtex_store_drops_worse_duplicate);
+    RUN_TEST(test_navtex_store_keeps_every_serial_zero);
+    return UNITY_END();
+}
@@ -0,0 +1,192 @@
+/**
+ * @file test_main.cpp
+ * @brief A WefaxDecoder natív tesztje szintetikus WEFAX jellel
+ * @details Start hang, fázisozó sorok, függőleges sáv minta és stop hang az 1900 Hz-es FM segédvivőn,
+ *          a dekódolt kép PGM fájlba kerül (wefax_test.pgm), az ellenőrzés a sorszámra és a képpontokra vonatkozik.
+ */
+#include <unity.h>
+
+#include <vector>
+
+#include "WefaxDecoder.h"
+
+namespace {
+constexpr uint16_t SAMPLING_FREQUENCY = 12000; // A core1 alapértelmezett AM mintavételi frekvenciája
+constexpr float AMPLITUDE = 1500.0f;           // A DC-mentes ADC minta amplitúdója
+constexpr float LINE_SECONDS = 0.5f;           // 120 LPM
+constexpr float START_TONE_SECONDS = 5.0f;     // Start hang hossza (az adásban 3 s, a detektor 1.5 s után jelez)
+constexpr float STOP_TONE_SECONDS = 5.0f;      // Stop hang hossza
+constexpr uint8_t PHASING_LINES = 20;          // Fázisozó sorok (az adásban 30 s = 60 sor)
+constexpr uint16_t IMAGE_LINES = 120;          // A sáv minta sorai
+constexpr uint8_t BAR_COUNT = 4;               // Függőleges sávok: fekete, fehér, fekete, fehér
+constexpr float PHASING_PULSE = 0.05f;         // A fázisozó impulzus a sor 5%-a, közepe a sor elején
+constexpr uint16_t BAR_MARGIN = 24;            // A sávhatárok ennyi képpontos környéke nem számít (átmenet, igazítási hiba)
+constexpr uint8_t BLACK_MAX = 48;              // Fekete sáv képpontjának felső határa
+constexpr uint8_t WHITE_MIN = 207;             // Fehér sáv képpontjának alsó határa
+const char *PGM_FILE_NAME = "wefax_test.pgm";
+
+/**
+ * @brief Az FM segédvivő előállítása: 1500 Hz fekete, 2300 Hz fehér, folytonos fázissal
+ */
+class WefaxSignalGenerator {
+  public:
+    explicit WefaxSignalGenerator(WefaxDecoder &decoder) : decoder_(decoder), phase_(0.0), time_(0.0) {}
+
+    std::vector<std::vector<uint8_t>> rows;
+
+    /**
+     * @brief APT hang: fekete/fehér négyszög moduláció a megadott frekvenciával
+     */
+    void tone(float toneHz, float seconds) {
+        const uint32_t count = seconds * SAMPLING_FREQUENCY;
+        for (uint32_t i = 0; i < count; i++) {
+            const double cycle = time_ * toneHz;
+            emit(cycle - std::floor(cycle) < 0.5 ? 1.0f : 0.0f);
+        }
+    }
+
+    /**
+     * @brief Fázisozó sor: fekete, a sor elején (körkörösen) középre igazított fehér impulzussal
+     */
+    void phasingLine() {
+        line([](float pos) { return pos < PHASING_PULSE / 2.0f || pos >= 1.0f - PHASING_PULSE / 2.0f ? 1.0f : 0.0f; });
+    }
+
+    /**
+     * @brief Képsor: BAR_COUNT egyforma függőleges sáv, a páratlanok fehérek
+     */
+    void barLine() {
+        line([](float pos) { return static_cast<uint8_t>(pos * BAR_COUNT) % 2 == 1 ? 1.0f : 0.0f; });
+    }
+
+  private:
+    WefaxDecoder &decoder_;
+    double phase_;
+    double time_;
+
+    template <typename Pattern> void line(Pattern pattern) {
+        const uint32_t count = LINE_SECONDS * SAMPLING_FREQUENCY;
+        for (uint32_t i = 0; i < count; i++) {
+            emit(pattern(static_cast<float>(i) / count));
+        }
+    }
+
+    /**
+     * @brief Egy minta a dekódernek, a kész sorok azonnali kivétele (a sor-gyűrű csak ROW_RING_SIZE mély)
+     * @param level 0: fekete, 1: fehér
+     */
+    void emit(float level) {
+        const double freq = WefaxConstants::CARRIER_HZ + (2.0f * level - 1.0f) * WefaxConstants::DEVIATION_HZ;
+        phase_ += TWO_PI * freq / SAMPLING_FREQUENCY;
+        if (phase_ >= TWO_PI) {
+            phase_ -= TWO_PI;
+        }
+        time_ += 1.0 / SAMPLING_FREQUENCY;
+        decoder_.processSample(static_cast<int16_t>(std::lround(AMPLITUDE * std::sin(phase_))));
+
+        std::vector<uint8_t> row(WefaxConstants::IMAGE_WIDTH);
+        while (decoder_.popRow(row.data())) {
+            rows.push_back(row);
+        }
+    }
+};
+
+WefaxDecoder decoder;
+std::vector<std::vector<uint8_t>> decodedRows;
+
+/**
+ * @brief A teljes szintetikus adás dekódolása és a kép kiírása PGM fájlba
+ */
+void decodeSyntheticImage() {
+    decoder.reset(SAMPLING_FREQUENCY);
+    WefaxSignalGenerator generator(decoder);
+
+    generator.tone(WefaxConstants::START_TONE_HZ, START_TONE_SECONDS);
+    for (uint8_t i = 0; i < PHASING_LINES; i++) {
+        generator.phasingLine();
+    }
+    for (uint16_t i = 0; i < IMAGE_LINES; i++) {
+        generator.barLine();
+    }
+    generator.tone(WefaxConstants::STOP_TONE_HZ, STOP_TONE_SECONDS);
+    decodedRows = generator.rows;
+
+    FILE *pgm = fopen(PGM_FILE_NAME, "wb");
+    if (pgm != nullptr) {
+        fprintf(pgm, "P5\n%u %u\n255\n", WefaxConstants::IMAGE_WIDTH, static_cast<unsigned>(decodedRows.size()));
+        for (const std::vector<uint8_t> &row : decodedRows) {
+            fwrite(row.data(), 1, row.size(), pgm);
+        }
+        fclose(pgm);
+    }
+}
+} // namespace
+
+void setUp() {}
+
+void tearDown() {}
+
+void test_wefax_returns_to_idle_after_stop_tone() {
+    TEST_ASSERT_EQUAL(static_cast<int>(WefaxDecoder::State::Idle), static_cast<int>(decoder.getState()));
+    TEST_ASSERT_EQUAL_UINT32(1, decoder.getImageCounter());
+}
+
+void test_wefax_row_count() {
+    // IOC 576: egy kimeneti sor 576 * PI / 480 ~ 3.77 bemeneti sor átlaga
+    const float linesPerRow = WefaxConstants::IOC * PI / WefaxConstants::IMAGE_WIDTH;
+    const int expected = static_cast<int>(IMAGE_LINES / linesPerRow + 0.5f);
+
+    TEST_ASSERT_EQUAL_UINT16(decodedRows.size(), decoder.getRowCount());
+    // A fázisozás utáni csonka sor kimarad, a stop hang felismeréséig (3 ablak = 3 sor) a hang is képsor
+    TEST_ASSERT_INT_WITHIN(2, expected, static_cast<int>(decodedRows.size()));
+}
+
+void test_wefax_bar_pattern() {
+    constexpr uint16_t barWidth = WefaxConstants::IMAGE_WIDTH / BAR_COUNT;
+    TEST_ASSERT_TRUE(decodedRows.size() > 3);
+
+    // Az utolsó sorokba már a stop hang is belekeveredik
+    for (size_t y = 0; y + 2 < decodedRows.size(); y++) {
+        const std::vector<uint8_t> &row = decodedRows[y];
+        for (uint16_t x = 0; x < WefaxConstants::IMAGE_WIDTH; x++) {
+            const uint16_t inBar = x % barWidth;
+            if (inBar < BAR_MARGIN || inBar >= barWidth - BAR_MARGIN) {
+                continue;
+            }
+            if ((x / barWidth) % 2 == 1) {
+                TEST_ASSERT_GREATER_OR_EQUAL_UINT8(WHITE_MIN, row[x]);
+            } else {
+                TEST_ASSERT_LESS_OR_EQUAL_UINT8(BLACK_MAX, row[x]);
+            }
+        }
+    }
+}
+
+void test_wefax_pgm_written() {
+    FILE *pgm = fopen(PGM_FILE_NAME, "rb");
+    TEST_ASSERT_NOT_NULL(pgm);
+    unsigned width = 0;
+    unsigned height = 0;
+    unsigned maxValue = 0;
+    TEST_ASSERT_EQUAL_INT(3, fscanf(pgm, "P5 %u %u %u", &width, &height, &maxValue));
+    fgetc(pgm); // A fejlécet lezáró egyetlen szóköz
+    TEST_ASSERT_EQUAL_UINT(WefaxConstants::IMAGE_WIDTH, width);
+    TEST_ASSERT_EQUAL_UINT(decodedRows.size(), height);
+    TEST_ASSERT_EQUAL_UINT(255, maxValue);
+
+    std::vector<uint8_t> pixels(width * height);
+    TEST_ASSERT_EQUAL_UINT(pixels.size(), fread(pixels.data(), 1, pixels.size(), pgm));
+    fclose(pgm);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(decodedRows.front().data(), pixels.data(), width);
+}
+
+int main(int argc, char **argv) {
+    decodeSyntheticImage();
+
+    UNITY_BEGIN();
+    RUN_TEST(test_wefax_returns_to_idle_after_stop_tone);
+    RUN_TEST(test_wefax_row_count);
+    RUN_TEST(test_wefax_bar_pattern);
+    RUN_TEST(test_wefax_pgm_written);
+    return UNITY_END();
+}